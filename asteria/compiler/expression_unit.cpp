@@ -111,8 +111,9 @@ generate_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts,
           auto qref = qctx->get_named_reference_opt(altr.name);
           if(qref) {
             // A reference declared later has been found.
-            // Record the context depth for later lookups.
-            AIR_Node::S_push_local_reference xnode = { altr.sloc, depth, altr.name };
+            // Record the context depth and slot for later lookups.
+            uint32_t slot = qctx->get_named_slot(altr.name);
+            AIR_Node::S_push_local_reference xnode = { altr.sloc, depth, slot, altr.name };
             code.emplace_back(::std::move(xnode));
             return;
           }
@@ -254,20 +255,6 @@ generate_code(cow_vector<AIR_Node>& code, const Compiler_Options& opts,
               code.mut_back() = ::std::move(xnode);
               return;
             }
-
-            if((rhs.type() == type_integer) && ((int32_t) rhs.as_integer() == rhs.as_integer())
-               && ::rocket::is_any_of(altr.xop,
-                     { xop_assign, xop_index, xop_cmp_eq, xop_cmp_ne, xop_cmp_un, xop_cmp_lt,
-                       xop_cmp_gt, xop_cmp_lte, xop_cmp_gte, xop_cmp_3way, xop_add, xop_sub,
-                       xop_mul, xop_div, xop_mod, xop_andb, xop_orb, xop_xorb, xop_addm, xop_subm,
-                       xop_mulm, xop_adds, xop_subs, xop_muls, xop_sll, xop_srl, xop_sla, xop_sra }
-                     )) {
-              // Fold this constant.
-              AIR_Node::S_apply_operator_bi32 xnode = { altr.sloc, altr.xop, altr.assign,
-                                                        (int32_t) rhs.as_integer() };
-              code.mut_back() = ::std::move(xnode);
-              return;
-            }
           }
         }
 
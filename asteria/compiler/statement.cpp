@@ -13,18 +13,21 @@
 namespace asteria {
 namespace {
 
-void
+uint32_t
 do_user_declare(Analytic_Context& ctx, cow_vector<phsh_string>* names_opt,
                 const phsh_string& name)
   {
     if(name.empty())
-      return;
+      return UINT32_MAX;
 
     // Inject this name.
     if(names_opt && !find(*names_opt, name))
       names_opt->emplace_back(name);
 
+    // Return its slot, which is allocated when the name is declared for the
+    // first time in this context.
     ctx.insert_named_reference(name);
+    return ctx.get_named_slot(name);
   }
 
 void
@@ -165,11 +168,11 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
         for(const auto& decl : altr.decls) {
           if(decl.names.size() == 1) {
             // Declare a scalar variable.
-            do_user_declare(ctx, names_opt, decl.names.at(0));
+            uint32_t slot = do_user_declare(ctx, names_opt, decl.names.at(0));
 
             if(decl.init.units.empty()) {
               // Declare a variable with default initialization.
-              AIR_Node::S_define_null_variable xnode_decl = { decl.sloc, altr.immutable,
+              AIR_Node::S_define_null_variable xnode_decl = { decl.sloc, altr.immutable, slot,
                                                               decl.names.at(0) };
               code.emplace_back(::std::move(xnode_decl));
             }
@@ -177,7 +180,7 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
               // Evaluate the initializer.
               do_generate_clear_stack(code);
 
-              AIR_Node::S_declare_variable xnode_decl = { decl.sloc, decl.names.at(0) };
+              AIR_Node::S_declare_variable xnode_decl = { decl.sloc, slot, decl.names.at(0) };
               code.emplace_back(::std::move(xnode_decl));
 
               // Generate code for the initializer.
@@ -197,6 +200,7 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
               // Declare variables with default initialization.
               for(uint32_t k = 1;  k != decl.names.size() - 1;  ++k) {
                 AIR_Node::S_define_null_variable xnode_decl = { decl.sloc, altr.immutable,
+                                                                ctx.get_named_slot(decl.names.at(k)),
                                                                 decl.names.at(k) };
                 code.emplace_back(::std::move(xnode_decl));
               }
@@ -206,7 +210,9 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
               do_generate_clear_stack(code);
 
               for(uint32_t k = 1;  k != decl.names.size() - 1;  ++k) {
-                AIR_Node::S_declare_variable xnode_decl = { decl.sloc, decl.names.at(k) };
+                AIR_Node::S_declare_variable xnode_decl = { decl.sloc,
+                                                            ctx.get_named_slot(decl.names.at(k)),
+                                                            decl.names.at(k) };
                 code.emplace_back(::std::move(xnode_decl));
               }
 
@@ -228,6 +234,7 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
               // Declare variables with default initialization.
               for(uint32_t k = 1;  k != decl.names.size() - 1;  ++k) {
                 AIR_Node::S_define_null_variable xnode_decl = { decl.sloc, altr.immutable,
+                                                                ctx.get_named_slot(decl.names.at(k)),
                                                                 decl.names.at(k) };
                 code.emplace_back(::std::move(xnode_decl));
               }
@@ -237,7 +244,9 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
               do_generate_clear_stack(code);
 
               for(uint32_t k = 1;  k != decl.names.size() - 1;  ++k) {
-                AIR_Node::S_declare_variable xnode_decl = { decl.sloc, decl.names.at(k) };
+                AIR_Node::S_declare_variable xnode_decl = { decl.sloc,
+                                                            ctx.get_named_slot(decl.names.at(k)),
+                                                            decl.names.at(k) };
                 code.emplace_back(::std::move(xnode_decl));
               }
 
@@ -260,10 +269,10 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
         const auto& altr = this->m_stor.as<S_function>();
 
         // Create a dummy reference for further name lookups.
-        do_user_declare(ctx, names_opt, altr.name);
+        uint32_t slot = do_user_declare(ctx, names_opt, altr.name);
 
         // Declare the function, which is effectively an immutable variable.
-        AIR_Node::S_declare_variable xnode_decl = { altr.sloc, altr.name };
+        AIR_Node::S_declare_variable xnode_decl = { altr.sloc, slot, altr.name };
         code.emplace_back(::std::move(xnode_decl));
 
         // Generate code
@@ -563,19 +572,19 @@ generate_code(cow_vector<AIR_Node>& code, Analytic_Context& ctx,
 
         for(const auto& decl : altr.decls) {
           // Structured bindings are not allowed.
-          do_user_declare(ctx, names_opt, decl.name);
+          uint32_t slot = do_user_declare(ctx, names_opt, decl.name);
 
           // Evaluate the initializer, which is required.
           do_generate_clear_stack(code);
 
-          AIR_Node::S_declare_reference xnode_decl = { decl.name };
+          AIR_Node::S_declare_reference xnode_decl = { slot, decl.name };
           code.emplace_back(::std::move(xnode_decl));
 
           // Generate code for the initializer.
           do_generate_subexpression(code, opts, global, ctx, ptc_aware_none, decl.init);
 
           // Initialize the reference.
-          AIR_Node::S_initialize_reference xnode_init = { decl.sloc, decl.name };
+          AIR_Node::S_initialize_reference xnode_init = { decl.sloc, slot, decl.name };
           code.emplace_back(::std::move(xnode_init));
         }
         return;
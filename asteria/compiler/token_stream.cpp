@@ -785,26 +785,24 @@ reload(stringR file, int start_line, tinybuf&& cbuf)
           throw Compiler_Error(Compiler_Error::M_status(),
                     compiler_status_conflict_marker_detected, reader.tell());
 
-      // Ensure this line is a valid UTF-8 string.
-      while(reader.navail() != 0) {
-        // Decode a code point.
-        char32_t cp;
-        auto tptr = reader.data();
-        if(!utf8_decode(cp, tptr, reader.navail()))
-          throw Compiler_Error(Compiler_Error::M_status(),
-                    compiler_status_utf8_sequence_invalid, reader.tell());
-
-        // Disallow plain null characters in source data.
-        if(cp == 0)
-          throw Compiler_Error(Compiler_Error::M_status(),
-                    compiler_status_null_character_disallowed, reader.tell());
-
-        // Accept this code point.
-        reader.consume(static_cast<size_t>(tptr - reader.data()));
+      // Ensure this line is a valid UTF-8 string. This is done in bulk.
+      auto vptr = reader.data();
+      bool valid = utf8_validate(vptr, reader.navail());
+
+      // Disallow plain null characters in source data.
+      size_t nvalid = static_cast<size_t>(vptr - reader.data());
+      auto nptr = static_cast<const char*>(::memchr(reader.data(), 0, nvalid));
+      if(nptr) {
+        reader.consume(static_cast<size_t>(nptr - reader.data()));
+        throw Compiler_Error(Compiler_Error::M_status(),
+                  compiler_status_null_character_disallowed, reader.tell());
       }
 
-      // Re-scan this line from the beginning.
-      reader.rewind();
+      if(!valid) {
+        reader.consume(nvalid);
+        throw Compiler_Error(Compiler_Error::M_status(),
+                  compiler_status_utf8_sequence_invalid, reader.tell());
+      }
 
       // Break this line down into tokens.
       while(reader.navail() != 0) {
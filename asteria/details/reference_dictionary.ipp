@@ -11,7 +11,8 @@ struct Bucket
   {
     Bucket* prev;
     Bucket* next;
-    void* padding_1;
+    uint32_t ordinal;  // number of elements before this one was inserted
+    uint32_t slot;     // index into the slot table; `UINT32_MAX` if unbound
     void* padding_2;
     union { phsh_string key;  };
     union { Reference ref;  };
@@ -182,12 +182,17 @@ class Global_Context;
 class Garbage_Collector;
 class Random_Engine;
 class Module_Loader;
+class Pattern_Cache;
+class Sampling_Profiler;
 class Variadic_Arguer;
 class Instantiated_Function;
 class AIR_Node;
 class Argument_Reader;
 class Binding_Generator;
 
+// Garbage collection
+using Variable_Worklist = cow_vector<Variable*>;
+
 // Compiler
 enum Punctuator : uint8_t;
 enum Keyword : uint8_t;
@@ -319,7 +324,7 @@ struct Abstract_Opaque
     // collection from running.
     virtual
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const = 0;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const = 0;
 
     // This function is called when a mutable reference is requested and the current
     // instance is shared. If this function returns a null pointer, the shared
@@ -358,7 +363,7 @@ struct Abstract_Function
     // collection from running.
     virtual
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const = 0;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const = 0;
 
     // This function may return a proper tail call wrapper.
     virtual
@@ -453,7 +458,7 @@ class cow_opaque
     describe(tinyfmt& fmt) const;
 
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
       {
         if(this->m_sptr)
           this->m_sptr->collect_variables(staged, temp);
@@ -645,7 +650,7 @@ class cow_function
     describe(tinyfmt& fmt) const;
 
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
       {
         if(this->m_sptr)
           this->m_sptr->collect_variables(staged, temp);
@@ -903,6 +908,8 @@ struct Compiler_Options_fragment<1>
     bool implicit_global_names = false;
 
     // Enable optimization.
+    // Level 3 enables the register tier for arithmetic expressions, which is
+    // experimental and has to be requested explicitly.
     uint8_t optimization_level = 2;
   };
 
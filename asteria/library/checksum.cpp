@@ -15,6 +15,107 @@
 namespace asteria {
 namespace {
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define ASTERIA_CRC32_PCLMUL  1
+#endif
+
+#ifdef ASTERIA_CRC32_PCLMUL
+// This is the algorithm from 'Fast CRC Computation for Generic Polynomials
+// Using PCLMULQDQ Instruction' by Intel, with bit-reflected constants for the
+// polynomial of zlib. `size` shall be a multiple of 16 and not less than 64.
+// The `crc32` instruction of SSE4.2 uses a different polynomial, so it can't
+// be used here.
+__attribute__((__target__("pclmul,sse4.1")))
+uint32_t
+do_crc32_pclmul(uint32_t crc, const unsigned char* bptr, size_t size) noexcept
+  {
+    ROCKET_ASSERT((size >= 64) && (size % 16 == 0));
+    const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+    const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+    // Fold four blocks of 16 bytes in parallel.
+    __m128i x1 = _mm_loadu_si128((const __m128i*) (bptr + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i*) (bptr + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i*) (bptr + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i*) (bptr + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+    bptr += 64;
+    size -= 64;
+
+    while(size >= 64) {
+      __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+      __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+      __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+      __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+      x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+      x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+      x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) (bptr + 0x00)));
+      x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*) (bptr + 0x10)));
+      x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*) (bptr + 0x20)));
+      x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*) (bptr + 0x30)));
+      bptr += 64;
+      size -= 64;
+    }
+
+    // Fold them into a single block, then fold remaining blocks into it.
+    for(__m128i xn : { x2, x3, x4 }) {
+      __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, xn), x5);
+    }
+
+    while(size >= 16) {
+      __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*) bptr)), x5);
+      bptr += 16;
+      size -= 16;
+    }
+
+    // Fold 128 bits into 64 bits.
+    __m128i x2r = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2r);
+    x2r = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2r);
+
+    // Perform Barrett reduction to 32 bits.
+    x2r = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+    x2r = _mm_clmulepi64_si128(_mm_and_si128(x2r, mask32), poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2r);
+    return (uint32_t) _mm_extract_epi32(x1, 1);
+  }
+#endif
+
+::uLong
+do_crc32_update(::uLong crc, const void* data, size_t size) noexcept
+  {
+    auto bptr = static_cast<const unsigned char*>(data);
+    size_t nrem = size;
+
+#ifdef ASTERIA_CRC32_PCLMUL
+    // Check for CPU features only once.
+    static const bool s_pclmul = __builtin_cpu_supports("pclmul")
+                                 && __builtin_cpu_supports("sse4.1");
+
+    if(s_pclmul && (nrem >= 64)) {
+      // Process as many blocks of 16 bytes as possible.
+      size_t nbulk = nrem & ~(size_t) 15;
+      crc = ~do_crc32_pclmul(~(uint32_t) crc, bptr, nbulk);
+      bptr += nbulk;
+      nrem -= nbulk;
+    }
+#endif
+
+    // Process remaining bytes with zlib.
+    return ::crc32_z(crc, bptr, nrem);
+  }
+
 class CRC32_Hasher final
   :
     public Abstract_Opaque
@@ -37,7 +138,7 @@ class CRC32_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -58,7 +159,7 @@ class CRC32_Hasher final
     void
     update(const void* data, size_t size) noexcept
       {
-        this->m_reg = ::crc32_z(this->m_reg, static_cast<const ::Byte*>(data), size);
+        this->m_reg = do_crc32_update(this->m_reg, data, size);
       }
 
     V_integer
@@ -146,7 +247,7 @@ class FNV1a32_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -274,7 +375,7 @@ class MD5_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -384,7 +485,7 @@ class SHA1_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -494,7 +595,7 @@ class SHA224_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -604,7 +705,7 @@ class SHA256_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -714,7 +815,7 @@ class SHA384_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -824,7 +925,7 @@ class SHA512_Hasher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
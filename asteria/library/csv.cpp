@@ -5,104 +5,183 @@
 #include "csv.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/binding_generator.hpp"
+#include "../runtime/global_context.hpp"
+#include "../llds/reference_stack.hpp"
 #include "../utils.hpp"
+#include "../../rocket/tinybuf_mmap.hpp"
+#include "../../rocket/linear_buffer.hpp"
+#include <fcntl.h>  // ::open()
 namespace asteria {
 namespace {
 
-V_array
-do_csv_parse(tinybuf& buf)
+// This is the state of a row that is being parsed. It is kept across calls
+// to `do_csv_parse_row()`, so a row that is not complete can be resumed
+// without parsing its lines again.
+struct CSV_Row_State
   {
-    V_array root;
     V_string* cell = nullptr;
+    size_t ncells = 0;
     bool quote_allowed = true;
     size_t quote_at_line = 0;
+    size_t nl_scanned = 0;  // characters after `bptr` without line breaks
+  };
+
+// Parses a row, which may span multiple lines if a cell is quoted and
+// contains line breaks. Characters are scanned with `memchr()`, which is
+// vectorized. Upon return, `bptr` points past the line break of the row.
+// Existent elements of `row` are reused, so a row can be parsed into the same
+// array repeatedly without reallocating its strings. If `select_opt` is not
+// null, only columns whose elements are `true` are stored, and the others
+// are set to null. If the end of input has not been reached (`eof` is false)
+// and a line is not terminated by a line break, `false` is returned, and
+// `bptr` points to the start of that line. The caller shall retry with more
+// characters from there, with the same `st` and `row`.
+bool
+do_csv_parse_row(CSV_Row_State& st, V_array& row, const char*& bptr, const char* eptr,
+                 size_t& nlines, bool eof, const cow_vector<bool>* select_opt)
+  {
+    V_string*& cell = st.cell;
+    size_t& ncells = st.ncells;
+    bool& quote_allowed = st.quote_allowed;
+    size_t& quote_at_line = st.quote_at_line;
 
-    // Read source file in lines.
-    cow_string line;
-    size_t nlines = 0;
-    while(getline(line, buf)) {
-      nlines ++;
+    auto do_new_cell = [&]
+      {
+        size_t col = ncells ++;
+        if(col == row.size())
+          row.emplace_back();
+
+        Value& val = row.mut(col);
+        if(select_opt && ((col >= select_opt->size()) || !(*select_opt)[col])) {
+          // Ignore this column.
+          val = nullopt;
+          cell = nullptr;
+          return;
+        }
 
-      // Remove the UTF-8 BOM, if any.
-      if((nlines == 1) && line.starts_with("\xEF\xBB\xBF", 3))
-        line.erase(0, 3);
+        if(!val.is_string())
+          val = V_string();
+
+        cell = &(val.mut_string());
+        cell->clear();
+      };
+
+    for(;;) {
+      // Get a line. CR LF pairs are converted to LF characters. Characters
+      // that have been scanned by a previous call are not scanned again.
+      const char* lptr = bptr;
+      auto nlptr = static_cast<const char*>(::memchr(lptr + st.nl_scanned, '\n',
+                                                     (size_t) (eptr - lptr) - st.nl_scanned));
+      if(!nlptr && !eof) {
+        st.nl_scanned = (size_t) (eptr - lptr);
+        return false;
+      }
 
-      // Convert CR LF pairs to LF characters.
-      if(line.ends_with(sref("\r")))
-        line.pop_back();
+      nlines ++;
+      st.nl_scanned = 0;
+      const char* lend = nlptr ? nlptr : eptr;
+      bptr = nlptr ? (nlptr + 1) : eptr;
 
-      // Start a new line if this is not in quotation.
-      if(quote_at_line == 0)
-        root.emplace_back(V_array());
+      if((lend != lptr) && (lend[-1] == '\r'))
+        lend --;
 
       // Parse the current line.
-      size_t offset = 0;
-      while(offset < line.size()) {
+      while(lptr < lend) {
         if(quote_at_line == 0) {
-          auto& row = root.mut_back().mut_array();
-
-          if(row.empty()) {
+          if(ncells == 0) {
             // We are not in quotation mode, so any character must start a value.
-            row.emplace_back(V_string());
-            cell = &(row.mut_back().mut_string());
+            do_new_cell();
           }
 
-          if(quote_allowed && (line[offset] == '\"')) {
+          if(quote_allowed && (*lptr == '\"')) {
             // Enter quotation mode to append text to `cell`.
-            offset ++;
+            lptr ++;
             quote_at_line = nlines;
             continue;
           }
 
           // Search for the next comma.
-          size_t epos = line.find(offset, ',');
-          if(epos == cow_string::npos) {
+          auto epos = static_cast<const char*>(::memchr(lptr, ',', (size_t) (lend - lptr)));
+          if(!epos) {
             // Accept all the remaining characters.
-            cell->append(line, offset);
+            if(cell)
+              cell->append(lptr, lend);
             quote_allowed = true;
             break;
           }
 
           // Accept all characters between them and re-enable quotation mode.
-          cell->append(line, offset, epos - offset);
-          offset = epos + 1;
+          if(cell)
+            cell->append(lptr, epos);
+          lptr = epos + 1;
           quote_allowed = true;
 
           // Create a new cell after the current one.
-          row.emplace_back(V_string());
-          cell = &(row.mut_back().mut_string());
+          do_new_cell();
           continue;
         }
 
         // Search for the closing double quotation mark.
-        size_t epos = line.find(offset, '\"');
-        if(epos == cow_string::npos) {
-          // Accept all the remaining characters, as well as the line break.
-          cell->append(line, offset);
-          cell->push_back('\n');
+        auto epos = static_cast<const char*>(::memchr(lptr, '\"', (size_t) (lend - lptr)));
+        if(!epos) {
+          // Accept all the remaining characters.
+          if(cell)
+            cell->append(lptr, lend);
           break;
         }
 
-        size_t dpos = epos + 1;
-        if(line[dpos] == '\"') {
+        const char* dpos = epos + 1;
+        if((dpos != lend) && (*dpos == '\"')) {
           // If the quotation mark is doubled (escaped), append the first one
           // and skip the other.
-          cell->append(line, offset, dpos - offset);
-          offset = dpos + 1;
+          if(cell)
+            cell->append(lptr, dpos);
+          lptr = dpos + 1;
           continue;
         }
 
         // Accept all characters between them and disable quotation mode.
-        cell->append(line, offset, epos - offset);
-        offset = epos + 1;
+        if(cell)
+          cell->append(lptr, epos);
+        lptr = epos + 1;
         quote_allowed = false;
         quote_at_line = 0;
       }
+
+      if(quote_at_line == 0)
+        break;
+
+      // If the line ends in quotation mode, the line break is part of the
+      // cell, and the row continues.
+      if(!nlptr)
+        ASTERIA_THROW(("Unmatched \" at line $1"), quote_at_line);
+
+      if(cell)
+        cell->push_back('\n');
     }
 
-    if(quote_at_line != 0)
-      ASTERIA_THROW(("Unmatched \" at line $1"), quote_at_line);
+    // Remove cells from the previous row.
+    row.erase(ncells);
+    st = CSV_Row_State();
+    return true;
+  }
+
+V_array
+do_csv_parse(const char* bptr, const char* eptr)
+  {
+    V_array root;
+    size_t nlines = 0;
+
+    // Remove the UTF-8 BOM, if any.
+    if((eptr - bptr >= 3) && (::memcmp(bptr, "\xEF\xBB\xBF", 3) == 0))
+      bptr += 3;
 
+    // Parse rows until the end of input.
+    CSV_Row_State st;
+    while(bptr != eptr) {
+      root.emplace_back(V_array());
+      do_csv_parse_row(st, root.mut_back().mut_array(), bptr, eptr, nlines, true, nullptr);
+    }
     return root;
   }
 
@@ -154,26 +233,137 @@ std_csv_format(V_array value)
 V_array
 std_csv_parse(V_string text)
   {
-    // Parse characters from the string.
-    ::rocket::tinybuf_str cbuf;
-    cbuf.set_string(text, tinybuf::open_read);
-    return do_csv_parse(cbuf);
+    // Parse characters from the string in place.
+    return do_csv_parse(text.data(), text.data() + text.size());
   }
 
 V_array
 std_csv_parse_file(V_string path)
   {
     // Try opening the file.
-    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "rb"));
-    if(!fp)
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY));
+    if(!fd)
       ASTERIA_THROW((
           "Could not open file '$1'",
-          "[`fopen()` failed: ${errno:full}]"),
+          "[`open()` failed: ${errno:full}]"),
           path);
 
-    // Parse characters from the file.
-    ::rocket::tinybuf_file cbuf(::std::move(fp));
-    return do_csv_parse(cbuf);
+    // Read the file into memory. It is not mapped, as the process would be
+    // killed by `SIGBUS` if someone truncated it while it was being parsed.
+    ::rocket::tinybuf_mmap cbuf;
+    cbuf.load(fd);
+
+    // Parse characters from the buffer in place.
+    return do_csv_parse(cbuf.gptr(), cbuf.gptr() + cbuf.gavail());
+  }
+
+V_integer
+std_csv_stream_file(Global_Context& global, V_string path, V_function callback,
+                    optV_array columns)
+  {
+    // Convert column indices to a mask for the tokenizer.
+    cow_vector<size_t> cols;
+    cow_vector<bool> select;
+    if(columns)
+      for(const auto& r : *columns) {
+        V_integer col = r.as_integer();
+        if((col < 0) || (col >= 0x1000000))
+          ASTERIA_THROW(("Column index out of range (index `$1`)"), col);
+
+        cols.emplace_back((size_t) col);
+        if((size_t) col >= select.size())
+          select.append((size_t) col + 1 - select.size(), false);
+        select.mut((size_t) col) = true;
+      }
+
+    // Try opening the file.
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY));
+    if(!fd)
+      ASTERIA_THROW((
+          "Could not open file '$1'",
+          "[`open()` failed: ${errno:full}]"),
+          path);
+
+    // Rows are parsed into the same array, whose strings are reused if the
+    // callback doesn't keep them.
+    Reference self;
+    Reference_Stack stack;
+    V_array row, out;
+    CSV_Row_State st;
+    V_integer nrows = 0;
+    size_t nlines = 0;
+    bool bom_checked = false;
+
+    auto do_parse_rows = [&](const char*& bptr, const char* eptr, bool eof)
+      {
+        // Remove the UTF-8 BOM, if any.
+        if(!bom_checked) {
+          if((eptr - bptr < 3) && !eof)
+            return;
+
+          if((eptr - bptr >= 3) && (::memcmp(bptr, "\xEF\xBB\xBF", 3) == 0))
+            bptr += 3;
+
+          bom_checked = true;
+        }
+
+        // A row that is still open at the end of input has an unmatched
+        // quotation mark, which has to be reported.
+        while((bptr != eptr) || (eof && (st.ncells != 0))) {
+          // If the row is incomplete, wait for more characters. Lines that
+          // have been parsed are not kept.
+          if(!do_csv_parse_row(st, row, bptr, eptr, nlines, eof, columns ? &select : nullptr))
+            return;
+
+          // Call the function but discard its return value.
+          stack.clear();
+          stack.push().set_temporary(nrows);
+          if(columns) {
+            // Pick requested columns in the requested order.
+            for(size_t col : cols)
+              if(col < row.size())
+                out.emplace_back(row[col]);
+              else
+                out.emplace_back(nullopt);
+
+            stack.push().set_temporary(::std::move(out));
+          }
+          else
+            stack.push().set_temporary(row);
+
+          self.clear();
+          callback.invoke(self, global, ::std::move(stack));
+          nrows ++;
+
+          // Release arguments, so buffers can be reused for the next row.
+          stack.clear();
+          stack.clear_red_zone();
+          self.clear();
+          out.clear();
+        }
+      };
+
+    // Read the file in chunks. It is not mapped, as the process would be
+    // killed by `SIGBUS` if someone truncated it while it was being parsed.
+    // An incomplete line is kept in the buffer until more characters are
+    // available, and complete lines are discarded after they are parsed.
+    ::rocket::linear_buffer buf;
+    for(;;) {
+      buf.reserve_after_end(0x10000);
+      ::ssize_t nread = ::read(fd, buf.mut_end(), buf.capacity_after_end());
+      if((nread < 0) && (errno != EINTR))
+        ASTERIA_THROW((
+            "Error reading file '$1'",
+            "[`read()` failed: ${errno:full}]"),
+            path);
+
+      buf.accept((nread > 0) ? (size_t) nread : 0);
+      const char* bptr = buf.data();
+      do_parse_rows(bptr, buf.end(), nread == 0);
+      buf.discard((size_t) (bptr - buf.data()));
+      if(nread == 0)
+        return nrows;
+    }
   }
 
 void
@@ -223,6 +413,25 @@ create_bindings_csv(V_object& result, API_Version /*version*/)
 
         reader.throw_no_matching_function_call();
       });
+
+    result.insert_or_assign(sref("stream_file"),
+      ASTERIA_BINDING(
+        "std.csv.stream_file", "path, callback, [columns]",
+        Global_Context& global, Argument_Reader&& reader)
+      {
+        V_string path;
+        V_function func;
+        optV_array cols;
+
+        reader.start_overload();
+        reader.required(path);
+        reader.required(func);
+        reader.optional(cols);
+        if(reader.end_overload())
+          return (Value) std_csv_stream_file(global, path, func, cols);
+
+        reader.throw_no_matching_function_call();
+      });
   }
 
 }  // namespace asteria
@@ -19,6 +19,11 @@ std_csv_parse(V_string text);
 V_array
 std_csv_parse_file(V_string path);
 
+// `std.csv.stream_file`
+V_integer
+std_csv_stream_file(Global_Context& global, V_string path, V_function callback,
+                    optV_array columns);
+
 // Create an object that is to be referenced as `std.csv`.
 void
 create_bindings_csv(V_object& result, API_Version version);
@@ -8,9 +8,10 @@
 #include "../runtime/global_context.hpp"
 #include "../llds/reference_stack.hpp"
 #include "../utils.hpp"
+#include "../../rocket/tinybuf_mmap.hpp"
 #include <sys/stat.h>  // ::stat(), ::fstat(), ::lstat(), ::mkdir(), ::fchmod()
 #include <dirent.h>  // ::opendir(), ::closedir()
-#include <fcntl.h>  // ::open()
+#include <fcntl.h>  // ::open(), ::posix_fadvise()
 #include <stdio.h>  // ::rename()
 #include <glob.h>  // ::glob(), ::globfree();
 namespace asteria {
@@ -473,12 +474,30 @@ std_filesystem_read(V_string path, optV_integer offset, optV_integer limit)
 
 V_integer
 std_filesystem_stream(Global_Context& global, V_string path, V_function callback,
-                      optV_integer offset, optV_integer limit)
+                      optV_integer offset, optV_integer limit, optV_object options)
   {
     if(offset && (*offset < 0))
       ASTERIA_THROW((
           "Negative file offset (offset `$1`)"), *offset);
 
+    // Get options. Chunks are small enough to stay in cache by default.
+    int64_t chunk_size = 0x40000;  // 256KiB
+    bool use_mmap = false;
+
+    if(options) {
+      auto qval = options->ptr(sref("chunk_size"));
+      if(qval && !qval->is_null()) {
+        chunk_size = qval->as_integer();
+        if((chunk_size <= 0) || (chunk_size > INT_MAX))
+          ASTERIA_THROW((
+              "Chunk size out of range (chunk_size `$1`)"), chunk_size);
+      }
+
+      qval = options->ptr(sref("mmap"));
+      if(qval)
+        use_mmap = qval->test();
+    }
+
     // Open the file for reading.
     ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY));
     if(!fd)
@@ -487,52 +506,101 @@ std_filesystem_stream(Global_Context& global, V_string path, V_function callback
           "[`open()` failed: ${errno:full}]"),
           path);
 
-    // We return data that have been read as a byte string.
+    int64_t roffset = offset.value_or(0);
+    int64_t rlimit = limit.value_or(INT64_MAX);
+
+    // Files are read sequentially, so ask for aggressive readahead. This is
+    // only a hint, so errors are ignored; for example, pipes don't support
+    // it at all.
+    ::posix_fadvise(fd, roffset, (rlimit == INT64_MAX) ? 0 : rlimit, POSIX_FADV_SEQUENTIAL);
+
+    // Map the file if requested. Only regular files can be mapped; others
+    // are read as usual. Some files, such as those in procfs, report a size
+    // of zero even though they are not empty, so they are read as usual, too.
+    ::rocket::tinybuf_mmap mbuf;
+    struct ::stat stb;
+    if(use_mmap && (::fstat(fd, &stb) == 0) && S_ISREG(stb.st_mode) && (stb.st_size > 0)) {
+      mbuf.open(fd);
+      mbuf.seek(roffset, tinybuf::seek_set);
+    }
+
+    // We return data that have been read as a byte string. If the callback
+    // doesn't keep it, its storage is reused for the next chunk.
     Reference self;
     Reference_Stack stack;
     V_string data;
-    int64_t roffset = offset.value_or(0);
-    int64_t rlimit = limit.value_or(INT64_MAX);
-    size_t nbatch = 0x100000;  // 1MiB
 
     for(;;) {
       // Don't read too many bytes at a time.
       if(rlimit <= 0)
         break;
 
-      nbatch = ::rocket::min(nbatch * 2, ::rocket::clamp_cast<size_t>(rlimit, 0, INT_MAX));
-      data.resize(nbatch, '/');
+      size_t nbatch = ::rocket::min((size_t) chunk_size, ::rocket::clamp_cast<size_t>(rlimit, 0, INT_MAX));
+      data.clear();
       ::ssize_t nread;
 
-      if(offset) {
-        // Use `roffset`. The file must be seekable in this case.
-        nread = ::pread(fd, data.mut_data(), nbatch, roffset);
-        if(nread < 0)
+      if(mbuf.mapped()) {
+        // The file may have been truncated since it was mapped, such as by
+        // the callback, and accessing pages past its end would raise
+        // `SIGBUS`, so check its size again. Bytes past the new end are
+        // treated as the end of the file, like `read()` does.
+        if(::fstat(fd, &stb) != 0)
           ASTERIA_THROW((
-              "Error reading file '$1'",
-              "[`pread()` failed: ${errno:full}]"),
+              "Could not get information about file '$1'",
+              "[`fstat()` failed: ${errno:full}]"),
               path);
+
+        int64_t nleft = stb.st_size - mbuf.tell();
+        size_t navail = ::rocket::clamp_cast<size_t>(nleft, 0, (int64_t) mbuf.gavail());
+
+        // Copy bytes from mapped pages.
+        nread = (::ssize_t) ::rocket::min(nbatch, navail);
+        data.append(mbuf.gptr(), (size_t) nread);
+        mbuf.gbump((size_t) nread);
       }
       else {
-        // Use the internal file pointer.
-        nread = ::read(fd, data.mut_data(), nbatch);
-        if(nread < 0)
-          ASTERIA_THROW((
-              "Error reading file '$1'",
-              "[`read()` failed: ${errno:full}]"),
-              path);
+        data.append(nbatch, '/');
+
+        if(offset) {
+          // Use `roffset`. The file must be seekable in this case.
+          nread = ::pread(fd, data.mut_data(), nbatch, roffset);
+          if(nread < 0)
+            ASTERIA_THROW((
+                "Error reading file '$1'",
+                "[`pread()` failed: ${errno:full}]"),
+                path);
+        }
+        else {
+          // Use the internal file pointer.
+          nread = ::read(fd, data.mut_data(), nbatch);
+          if(nread < 0)
+            ASTERIA_THROW((
+                "Error reading file '$1'",
+                "[`read()` failed: ${errno:full}]"),
+                path);
+        }
+        data.erase(data.begin() + nread, data.end());
+
+        // Start reading the next chunk while the callback is running.
+        if((nread != 0) && (rlimit > nread))
+          ::posix_fadvise(fd, roffset + nread, (::off_t) nbatch, POSIX_FADV_WILLNEED);
       }
-      data.erase(data.begin() + nread, data.end());
+
       if(nread == 0)
         break;
 
       // Call the function but discard its return value.
       stack.clear();
       stack.push().set_temporary(roffset);
-      stack.push().set_temporary(::std::move(data));
+      stack.push().set_temporary(data);
       self.clear();
       callback.invoke(self, global, ::std::move(stack));
 
+      // Release arguments, so the buffer can be reused.
+      stack.clear();
+      stack.clear_red_zone();
+      self.clear();
+
       roffset += nread;
       rlimit -= nread;
     }
@@ -826,20 +894,22 @@ create_bindings_filesystem(V_object& result, API_Version /*version*/)
 
     result.insert_or_assign(sref("stream"),
       ASTERIA_BINDING(
-        "std.filesystem.stream", "path, callback, [offset, [limit]]",
+        "std.filesystem.stream", "path, callback, [offset, [limit, [options]]]",
         Global_Context& global, Argument_Reader&& reader)
       {
         V_string path;
         V_function func;
         optV_integer off, lim;
+        optV_object opts;
 
         reader.start_overload();
         reader.required(path);
         reader.required(func);
         reader.optional(off);
         reader.optional(lim);
+        reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_filesystem_stream(global, path, func, off, lim);
+          return (Value) std_filesystem_stream(global, path, func, off, lim, opts);
 
         reader.throw_no_matching_function_call();
       });
@@ -49,7 +49,7 @@ std_filesystem_read(V_string path, optV_integer offset, optV_integer limit);
 
 // `std.filesystem.stream`
 V_integer
-std_filesystem_stream(Global_Context& global, V_string path, V_function callback, optV_integer offset, optV_integer limit);
+std_filesystem_stream(Global_Context& global, V_string path, V_function callback, optV_integer offset, optV_integer limit, optV_object options);
 
 // `std.filesystem.write`
 void
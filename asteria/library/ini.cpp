@@ -6,6 +6,8 @@
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/binding_generator.hpp"
 #include "../utils.hpp"
+#include "../../rocket/tinybuf_mmap.hpp"
+#include <fcntl.h>  // ::open()
 namespace asteria {
 namespace {
 
@@ -72,58 +74,66 @@ do_format_check_scalar(const Value& value)
     }
   }
 
+constexpr
+bool
+do_is_space(char c) noexcept
+  {
+    return (c == ' ') || (c == '\t');
+  }
+
 V_object
-do_ini_parse(tinybuf& buf)
+do_ini_parse(const char* bptr, const char* eptr)
   {
     V_object root;
     V_object* sink = &root;
 
-    // Read source file in lines.
-    cow_string line;
+    // Remove the UTF-8 BOM, if any.
+    if((eptr - bptr >= 3) && (::memcmp(bptr, "\xEF\xBB\xBF", 3) == 0))
+      bptr += 3;
+
+    // Read source text in lines. Lines are not copied; the search for line
+    // breaks uses `memchr()`, which is vectorized.
     size_t nlines = 0;
-    while(getline(line, buf)) {
+    while(bptr != eptr) {
       nlines ++;
-
-      // Remove the UTF-8 BOM, if any.
-      if((nlines == 1) && line.starts_with("\xEF\xBB\xBF", 3))
-        line.erase(0, 3);
-
-      // Convert CR LF pairs to LF characters.
-      if(line.ends_with(sref("\r")))
-        line.pop_back();
-
-      // Remove comments.
-      size_t pos = line.find_of(s_comment);
-      if(pos != cow_string::npos)
-        line.erase(pos);
+      const char* lptr = bptr;
+      auto nlptr = static_cast<const char*>(::memchr(lptr, '\n', (size_t) (eptr - lptr)));
+      const char* lend = nlptr ? nlptr : eptr;
+      bptr = nlptr ? (nlptr + 1) : eptr;
+
+      // Remove comments. Also, CR LF pairs are converted to LF characters.
+      const char* cptr = ::std::find_first_of(lptr, lend, s_comment, s_comment + 2);
+      if(cptr != lend)
+        lend = cptr;
+      else if((lend != lptr) && (lend[-1] == '\r'))
+        lend --;
 
       // Remove leading and trailing spaces.
       // Empty lines are ignored.
-      pos = line.find_not_of(s_space);
-      if(pos == cow_string::npos)
-        continue;
+      while((lptr != lend) && do_is_space(*lptr))
+        lptr ++;
 
-      line.erase(0, pos);
-      pos = line.rfind_not_of(s_space);
-      line.erase(pos + 1);
+      if(lptr == lend)
+        continue;
 
-      cow_string key = line;
-      cow_string value;
+      while(do_is_space(lend[-1]))
+        lend --;
 
       // if the line begins with an open bracket, it shall start a section.
-      if(line.front() == '[') {
-        if(line.back() != ']')
+      if(*lptr == '[') {
+        if((lend - lptr < 2) || (lend[-1] != ']'))
           ASTERIA_THROW(("Invalid section name on line $1"), nlines);
 
         // Trim the section name.
-        pos = line.find_not_of(1, s_space);
-        if(pos == line.size() - 1)
-          ASTERIA_THROW(("Empty section name on line $1"), nlines);
+        const char* nptr = lptr + 1;
+        while((nptr != lend - 1) && do_is_space(*nptr))
+          nptr ++;
 
-        // Make a copy of the section name that is just large enough.
-        key.assign(line, 1, line.size() - 2);
+        if(nptr == lend - 1)
+          ASTERIA_THROW(("Empty section name on line $1"), nlines);
 
         // Insert a new section.
+        cow_string key(lptr + 1, lend - 1);
         auto& sub = root.try_emplace(::std::move(key), V_object()).first->second;
         ROCKET_ASSERT(sub.is_object());
         sink = &(sub.mut_object());
@@ -131,20 +141,26 @@ do_ini_parse(tinybuf& buf)
       }
 
       // Otherwise, it shall be a property.
-      size_t eqpos = line.find('=');
-      if(eqpos != cow_string::npos) {
-        pos = line.rfind_not_of(eqpos - 1, s_space);
-        if(pos == cow_string::npos)
+      cow_string key, value;
+      auto eqptr = static_cast<const char*>(::memchr(lptr, '=', (size_t) (lend - lptr)));
+      if(eqptr) {
+        const char* kend = eqptr;
+        while((kend != lptr) && do_is_space(kend[-1]))
+          kend --;
+
+        if(kend == lptr)
           ASTERIA_THROW(("Empty property name on line $1"), nlines);
 
-        // Make copies of the key and value that are just large enough.
-        key.assign(line, 0, pos + 1);
-
         // Get the value without leading spaces.
-        pos = line.find_not_of(eqpos + 1, s_space);
-        if(pos != cow_string::npos)
-          value.assign(line, pos, line.size());
+        const char* vptr = eqptr + 1;
+        while((vptr != lend) && do_is_space(*vptr))
+          vptr ++;
+
+        key.assign(lptr, kend);
+        value.assign(vptr, lend);
       }
+      else
+        key.assign(lptr, lend);
 
       // Insert a new value.
       sink->insert_or_assign(::std::move(key), ::std::move(value));
@@ -216,26 +232,28 @@ std_ini_format(V_object value)
 V_object
 std_ini_parse(V_string text)
   {
-    // Parse characters from the string.
-    ::rocket::tinybuf_str cbuf;
-    cbuf.set_string(text, tinybuf::open_read);
-    return do_ini_parse(cbuf);
+    // Parse characters from the string in place.
+    return do_ini_parse(text.data(), text.data() + text.size());
   }
 
 V_object
 std_ini_parse_file(V_string path)
   {
     // Try opening the file.
-    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "rb"));
-    if(!fp)
+    ::rocket::unique_posix_fd fd(::open(path.safe_c_str(), O_RDONLY));
+    if(!fd)
       ASTERIA_THROW((
           "Could not open file '$1'",
-          "[`fopen()` failed: ${errno:full}]"),
+          "[`open()` failed: ${errno:full}]"),
           path);
 
-    // Parse characters from the file.
-    ::rocket::tinybuf_file cbuf(::std::move(fp));
-    return do_ini_parse(cbuf);
+    // Read the file into memory. It is not mapped, as the process would be
+    // killed by `SIGBUS` if someone truncated it while it was being parsed.
+    ::rocket::tinybuf_mmap cbuf;
+    cbuf.load(fd);
+
+    // Parse characters from the buffer in place.
+    return do_ini_parse(cbuf.gptr(), cbuf.gptr() + cbuf.gavail());
   }
 
 void
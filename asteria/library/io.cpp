@@ -5,6 +5,8 @@
 #include "io.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/binding_generator.hpp"
+#include "../runtime/global_context.hpp"
+#include "../llds/reference_stack.hpp"
 #include "../utils.hpp"
 namespace asteria {
 namespace {
@@ -117,53 +119,145 @@ do_format_write_utf8_common(const IOF_Sentry& sentry, const V_string& templ, con
     return do_write_utf8_common(sentry, fmt.get_string());
   }
 
+// This is the line buffer for `getline()`, which is protected by the lock
+// of `stdin`.
+struct Line_Buffer
+  {
+    char* data = nullptr;
+    size_t cap = 0;
+
+    ~Line_Buffer()
+      {
+        ::free(this->data);
+      }
+  }
+  s_stdin_line;
+
+bool
+do_read_line_common(const IOF_Sentry& sentry, V_string& line)
+  {
+    // `getline()` searches the stream buffer for the line break in bulk,
+    // without decoding characters one by one.
+    ::ssize_t nread = ::getline(&(s_stdin_line.data), &(s_stdin_line.cap), sentry);
+    if((nread < 0) && ::ferror(sentry))
+      ASTERIA_THROW((
+          "Error reading standard input",
+          "[`getline()` failed: ${errno:full}]"));
+
+    if(nread < 0)
+      return false;
+
+    // The terminating LF, if any, is not included.
+    size_t len = (size_t) nread;
+    if((len != 0) && (s_stdin_line.data[len - 1] == '\n'))
+      len --;
+
+    const char* pos = s_stdin_line.data;
+    if(!utf8_validate(pos, len))
+      ASTERIA_THROW((
+          "Invalid UTF-8 string from standard input (length `$1`)"),
+          len);
+
+    line.assign(s_stdin_line.data, len);
+    return true;
+  }
+
 }  // namespace
 
 optV_integer
 std_io_getc()
   {
-    wint_t wch;
-    const IOF_Sentry sentry(stdin, iof_mode_input_wide);
+    char mbs[4];
+    size_t nread = 0;
+    const IOF_Sentry sentry(stdin, iof_mode_input_narrow);
 
-    wch = ::fgetwc(sentry);
-    if((wch == WEOF) && ::ferror(sentry))
+    int ch = ::getc_unlocked(sentry);
+    if((ch == EOF) && ::ferror(sentry))
       ASTERIA_THROW((
           "Error reading standard input",
-          "[`fgetwc()` failed: ${errno:full}]"));
+          "[`getc_unlocked()` failed: ${errno:full}]"));
 
-    if(wch == WEOF)
+    if(ch == EOF)
       return nullopt;
 
-    return (int64_t)(uint32_t) wch;
-  }
-
-optV_string
-std_io_getln()
-  {
-    cow_string u8str;
-    wint_t wch;
-    const IOF_Sentry sentry(stdin, iof_mode_input_wide);
+    // Get the number of bytes in this code point, then read the others.
+    size_t u8len = 1U + (ch >= 0xC0) + (ch >= 0xE0) + (ch >= 0xF0);
+    mbs[nread++] = (char) ch;
 
-    for(;;) {
-      wch = ::fgetwc(sentry);
-      if((wch == WEOF) && ::ferror(sentry))
+    while(nread < u8len) {
+      ch = ::getc_unlocked(sentry);
+      if((ch == EOF) && ::ferror(sentry))
         ASTERIA_THROW((
             "Error reading standard input",
-            "[`fgetwc()` failed: ${errno:full}]"));
+            "[`getc_unlocked()` failed: ${errno:full}]"));
 
-      if((wch == L'\n') || (wch == WEOF))
+      if(ch == EOF)
         break;
 
-      if(!utf8_encode(u8str, (char32_t) wch))
-        ASTERIA_THROW((
-            "Invalid UTF code point from standard input (value `$1`)"),
-            wch);
+      // If this is not a continuation byte, it starts the next character, so
+      // put it back.
+      if((ch & 0xC0) != 0x80) {
+        ::ungetc(ch, sentry);
+        break;
+      }
+
+      mbs[nread++] = (char) ch;
     }
 
-    if((wch == WEOF) && u8str.empty())
+    char32_t cp;
+    const char* pos = mbs;
+    if(!utf8_decode(cp, pos, nread) || (pos != mbs + nread))
+      ASTERIA_THROW((
+          "Invalid UTF-8 sequence from standard input (length `$1`)"),
+          nread);
+
+    return (int64_t) cp;
+  }
+
+optV_string
+std_io_getln()
+  {
+    V_string line;
+    const IOF_Sentry sentry(stdin, iof_mode_input_narrow);
+
+    if(!do_read_line_common(sentry, line))
       return nullopt;
 
-    return ::std::move(u8str);
+    return ::std::move(line);
+  }
+
+V_integer
+std_io_lines(Global_Context& global, V_function callback)
+  {
+    // The line is passed to `callback`, and its storage is reused if
+    // `callback` doesn't keep it.
+    Reference self;
+    Reference_Stack stack;
+    V_string line;
+    V_integer nlines = 0;
+
+    for(;;) {
+      // Don't hold the lock while calling `callback`.
+      {
+        const IOF_Sentry sentry(stdin, iof_mode_input_narrow);
+        if(!do_read_line_common(sentry, line))
+          break;
+      }
+
+      // Call the function but discard its return value.
+      stack.clear();
+      stack.push().set_temporary(nlines);
+      stack.push().set_temporary(line);
+      self.clear();
+      callback.invoke(self, global, ::std::move(stack));
+      nlines ++;
+
+      // Release arguments, so the line can be reused.
+      stack.clear();
+      stack.clear_red_zone();
+      self.clear();
+    }
+    return nlines;
   }
 
 optV_integer
@@ -325,6 +419,21 @@ create_bindings_io(V_object& result, API_Version /*version*/)
         reader.throw_no_matching_function_call();
       });
 
+    result.insert_or_assign(sref("lines"),
+      ASTERIA_BINDING(
+        "std.io.lines", "callback",
+        Global_Context& global, Argument_Reader&& reader)
+      {
+        V_function func;
+
+        reader.start_overload();
+        reader.required(func);
+        if(reader.end_overload())
+          return (Value) std_io_lines(global, func);
+
+        reader.throw_no_matching_function_call();
+      });
+
     result.insert_or_assign(sref("putc"),
       ASTERIA_BINDING(
         "std.io.putc", "value",
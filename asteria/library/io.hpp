@@ -15,6 +15,10 @@ std_io_getc();
 optV_string
 std_io_getln();
 
+// `std.io.lines`
+V_integer
+std_io_lines(Global_Context& global, V_function callback);
+
 // `std.io.putc`
 optV_integer
 std_io_putc(V_integer value);
@@ -6,7 +6,7 @@
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/binding_generator.hpp"
 #include "../runtime/global_context.hpp"
-#include "../compiler/token_stream.hpp"
+#include "../llds/reference_stack.hpp"
 #include "../compiler/compiler_error.hpp"
 #include "../compiler/enums.hpp"
 #include "../utils.hpp"
@@ -418,22 +418,557 @@ do_format_nonrecursive(const Value& value, bool json5, Indenter&& indent)
     return do_format_nonrecursive(value, json5, indent);
   }
 
-opt<Punctuator>
-do_accept_punctuator_opt(Token_Stream& tstrm, initializer_list<Punctuator> accept)
+// This is a byte-level scanner for JSON text. If no stream buffer is given,
+// text is scanned in place; otherwise it is read from the stream buffer in
+// chunks, so a file is parsed with constant extra memory.
+class JSON_Scanner
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok)
-      return nullopt;
+  private:
+    tinybuf* m_cbuf = nullptr;
+    cow_string m_chunk;
+    const char* m_bptr = nullptr;
+    const char* m_rptr = nullptr;
+    const char* m_eptr = nullptr;
+
+    // These are used to calculate source locations. Offsets are relative to
+    // the beginning of input.
+    int64_t m_boff = 0;
+    int64_t m_loff = 0;
+    int m_line = 1;
+
+  public:
+    explicit
+    JSON_Scanner(const char* text, size_t size) noexcept
+      :
+        m_bptr(text), m_rptr(text), m_eptr(text + size)
+      { }
+
+    explicit
+    JSON_Scanner(tinybuf& cbuf) noexcept
+      :
+        m_cbuf(&cbuf)
+      { }
+
+    // Pointers refer to `m_chunk`, which may be stored in place.
+    JSON_Scanner(const JSON_Scanner&) = delete;
+    JSON_Scanner& operator=(const JSON_Scanner&) = delete;
+
+  private:
+    bool
+    do_refill();
+
+    void
+    do_mark_line_break(const char* next) noexcept
+      {
+        this->m_line ++;
+        this->m_loff = this->m_boff + (next - this->m_bptr);
+      }
+
+  public:
+    const char*
+    data() const noexcept
+      { return this->m_rptr;  }
+
+    size_t
+    navail() const noexcept
+      { return (size_t) (this->m_eptr - this->m_rptr);  }
+
+    bool
+    ensure(size_t n)
+      {
+        while(this->navail() < n)
+          if(!this->do_refill())
+            return false;
+
+        return true;
+      }
+
+    int
+    peek(size_t k = 0)
+      {
+        if(!this->ensure(k + 1))
+          return -1;
+
+        return (uint8_t) this->m_rptr[k];
+      }
+
+    void
+    consume(size_t n) noexcept
+      {
+        ROCKET_ASSERT(n <= this->navail());
+        this->m_rptr += n;
+      }
+
+    Source_Location
+    tell() const
+      {
+        int64_t off = this->m_boff + (this->m_rptr - this->m_bptr);
+        return Source_Location(sref("[JSON text]"), this->m_line, (int) (off - this->m_loff) + 1);
+      }
+
+    // Skips characters up to the next line break, which is not consumed.
+    void
+    skip_line();
+
+    // Skips spaces and comments.
+    void
+    skip_spaces();
 
-    if(!qtok->is_punctuator())
-      return nullopt;
+    // Accepts a string literal, which shall begin with `head`.
+    void
+    accept_string(cow_string& val, char head);
+  };
+
+bool
+JSON_Scanner::
+do_refill()
+  {
+    if(!this->m_cbuf)
+      return false;
+
+    if(this->m_chunk.empty())
+      this->m_chunk.append(16384, '\0');
+
+    // Move unconsumed characters to the beginning of the chunk, then fill
+    // the remaining space.
+    char* bptr = this->m_chunk.mut_data();
+    size_t nkeep = this->navail();
+    if(nkeep != 0)
+      ::memmove(bptr, this->m_rptr, nkeep);
+
+    this->m_boff += this->m_rptr - this->m_bptr;
+    size_t nread = this->m_cbuf->getn(bptr + nkeep, this->m_chunk.size() - nkeep);
+
+    this->m_bptr = bptr;
+    this->m_rptr = bptr;
+    this->m_eptr = bptr + nkeep + nread;
+    return nread != 0;
+  }
 
-    auto punct = qtok->as_punctuator();
-    if(::rocket::is_none_of(punct, accept))
-      return nullopt;
+void
+JSON_Scanner::
+skip_line()
+  {
+    for(;;) {
+      auto lptr = (const char*) ::memchr(this->m_rptr, '\n', this->navail());
+      if(lptr) {
+        this->m_rptr = lptr;
+        return;
+      }
 
-    tstrm.shift();
-    return punct;
+      this->m_rptr = this->m_eptr;
+      if(!this->do_refill())
+        return;
+    }
+  }
+
+void
+JSON_Scanner::
+skip_spaces()
+  {
+    for(;;) {
+      // Skip spaces in the current window. Line breaks are counted.
+      const char* sptr = this->m_rptr;
+
+#ifdef __SSE2__
+      while(this->m_eptr - sptr >= 16) {
+        __m128i t = _mm_loadu_si128((const __m128i*) sptr);
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(t, _mm_set1_epi8(' ')),
+                                  _mm_and_si128(_mm_cmpgt_epi8(t, _mm_set1_epi8('\t' - 1)),
+                                                _mm_cmplt_epi8(t, _mm_set1_epi8('\r' + 1))));
+
+        // `n` is the number of leading spaces, which is at most 16.
+        uint32_t n = (uint32_t) ROCKET_TZCNT32(~(uint32_t) _mm_movemask_epi8(ws));
+        uint32_t nls = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(t, _mm_set1_epi8('\n')));
+        nls &= (1U << n) - 1U;
+        if(nls != 0) {
+          this->m_line += ROCKET_POPCNT32(nls);
+          this->m_loff = this->m_boff + (sptr - this->m_bptr) + 32 - ROCKET_LZCNT32(nls);
+        }
+
+        sptr += n;
+        if(n != 16)
+          break;
+      }
+#endif
+
+      while((sptr != this->m_eptr) && is_cmask(*sptr, cmask_space)) {
+        sptr ++;
+        if(sptr[-1] == '\n')
+          this->do_mark_line_break(sptr);
+      }
+
+      this->m_rptr = sptr;
+      if(sptr == this->m_eptr) {
+        if(!this->do_refill())
+          return;
+
+        continue;
+      }
+
+      // Check for comments.
+      if(*sptr != '/')
+        return;
+
+      int next = this->peek(1);
+      if(next == '/') {
+        // Skip a line comment.
+        this->consume(2);
+        this->skip_line();
+      }
+      else if(next == '*') {
+        // Skip a block comment.
+        auto sloc = this->tell();
+        this->consume(2);
+
+        for(;;) {
+          if(!this->ensure(2))
+            throw Compiler_Error(Compiler_Error::M_status(),
+                      compiler_status_block_comment_unclosed, sloc);
+
+          if((this->m_rptr[0] == '*') && (this->m_rptr[1] == '/')) {
+            this->consume(2);
+            break;
+          }
+
+          this->consume(1);
+          if(this->m_rptr[-1] == '\n')
+            this->do_mark_line_break(this->m_rptr);
+        }
+      }
+      else
+        return;
+    }
+  }
+
+void
+JSON_Scanner::
+accept_string(cow_string& val, char head)
+  {
+    ROCKET_ASSERT(this->peek() == (uint8_t) head);
+    auto sloc = this->tell();
+    this->consume(1);
+
+    for(;;) {
+      // Copy plain characters in bulk. This stops at a quotation mark, a
+      // backslash, a control character or a non-ASCII character.
+      const char* sptr = this->m_rptr;
+
+#ifdef __SSE2__
+      while(this->m_eptr - sptr >= 16) {
+        // Non-ASCII characters are negative, so they compare less than spaces.
+        __m128i t = _mm_loadu_si128((const __m128i*) sptr);
+        __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(t, _mm_set1_epi8(head)),
+                                                 _mm_cmpeq_epi8(t, _mm_set1_epi8('\\'))),
+                                    _mm_cmplt_epi8(t, _mm_set1_epi8(' ')));
+
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(stop);
+        if(mask != 0) {
+          sptr += ROCKET_TZCNT32(mask);
+          break;
+        }
+
+        sptr += 16;
+      }
+#endif
+
+      while((sptr != this->m_eptr) && (*sptr != head) && (*sptr != '\\')
+            && ((uint8_t) *sptr >= 0x20) && ((uint8_t) *sptr <= 0x7F))
+        sptr ++;
+
+      val.append(this->m_rptr, (size_t) (sptr - this->m_rptr));
+      this->m_rptr = sptr;
+
+      // Check the character that stopped us.
+      int next = this->peek();
+      if((next < 0) || (next == '\n'))
+        throw Compiler_Error(Compiler_Error::M_status(),
+                  compiler_status_string_literal_unclosed, sloc);
+
+      if(next == (uint8_t) head) {
+        // The end of this string is encountered. Finish.
+        this->consume(1);
+        return;
+      }
+
+      if(next == 0)
+        throw Compiler_Error(Compiler_Error::M_status(),
+                  compiler_status_null_character_disallowed, this->tell());
+
+      if(next >= 0x80) {
+        // Validate and copy a UTF-8 sequence.
+        this->ensure(4);
+        char32_t cp;
+        const char* tptr = this->m_rptr;
+        if(!utf8_decode(cp, tptr, this->navail()))
+          throw Compiler_Error(Compiler_Error::M_status(),
+                    compiler_status_utf8_sequence_invalid, this->tell());
+
+        val.append(this->m_rptr, (size_t) (tptr - this->m_rptr));
+        this->m_rptr = tptr;
+        continue;
+      }
+
+      if(next != '\\') {
+        // Copy other control characters as is.
+        val.push_back((char) next);
+        this->consume(1);
+        continue;
+      }
+
+      // Translate this escape sequence.
+      next = this->peek(1);
+      if(next < 0)
+        throw Compiler_Error(Compiler_Error::M_status(),
+                  compiler_status_escape_sequence_incomplete, this->tell());
+
+      this->consume(2);
+      int xcnt = 0;
+
+      switch(next) {
+        case '\'':
+        case '\"':
+        case '\\':
+        case '?':
+        case '/':
+          val.push_back((char) next);
+          break;
+
+        case 'a':
+          val.push_back('\a');
+          break;
+
+        case 'b':
+          val.push_back('\b');
+          break;
+
+        case 'f':
+          val.push_back('\f');
+          break;
+
+        case 'n':
+          val.push_back('\n');
+          break;
+
+        case 'r':
+          val.push_back('\r');
+          break;
+
+        case 't':
+          val.push_back('\t');
+          break;
+
+        case 'v':
+          val.push_back('\v');
+          break;
+
+        case '0':
+          val.push_back('\0');
+          break;
+
+        case 'Z':
+          val.push_back('\x1A');
+          break;
+
+        case 'e':
+          val.push_back('\x1B');
+          break;
+
+        case 'U':
+          xcnt += 2;
+          // Fallthrough
+        case 'u':
+          xcnt += 2;
+          // Fallthrough
+        case 'x': {
+          // How many hex digits are there?
+          xcnt += 2;
+
+          // Read hex digits.
+          char32_t cp = 0;
+          for(int i = 0;  i < xcnt;  ++i) {
+            int c = this->peek();
+            if(c < 0)
+              throw Compiler_Error(Compiler_Error::M_status(),
+                        compiler_status_escape_sequence_incomplete, this->tell());
+
+            if(!is_cmask((char) c, cmask_xdigit))
+              throw Compiler_Error(Compiler_Error::M_status(),
+                        compiler_status_escape_sequence_invalid_hex, this->tell());
+
+            // Accumulate this digit.
+            this->consume(1);
+            uint32_t dval = (uint32_t) c | 0x20;
+
+            cp *= 16;
+            cp += (dval <= '9') ? (dval - '0') : (dval - 'a' + 10);
+          }
+
+          if(next == 'x') {
+            // Write the character verbatim.
+            val.push_back((char) cp);
+          }
+          else {
+            // Write a Unicode code point.
+            if(!utf8_encode(val, cp))
+              throw Compiler_Error(Compiler_Error::M_status(),
+                        compiler_status_escape_utf_code_point_invalid, this->tell());
+          }
+          break;
+        }
+
+        default:
+          throw Compiler_Error(Compiler_Error::M_status(),
+                    compiler_status_escape_sequence_unknown, this->tell());
+      }
+    }
+  }
+
+void
+do_accept_name(cow_string& name, JSON_Scanner& scan)
+  {
+    // identifier ::=
+    //   PCRE([A-Za-z_][A-Za-z_0-9]*)
+    int c = scan.peek();
+    while((c >= 0) && is_cmask((char) c, cmask_namei | cmask_digit)) {
+      name.push_back((char) c);
+      scan.consume(1);
+      c = scan.peek();
+    }
+  }
+
+void
+do_collect_digits(cow_string& tstr, JSON_Scanner& scan, uint8_t mask)
+  {
+    for(;;) {
+      // Skip a digit separator.
+      int c = scan.peek();
+      if(c == '`') {
+        scan.consume(1);
+        continue;
+      }
+
+      // Stop at an unwanted character.
+      if((c < 0) || !is_cmask((char) c, mask))
+        break;
+
+      // Collect a digit.
+      tstr.push_back((char) c);
+      scan.consume(1);
+    }
+  }
+
+double
+do_accept_number(JSON_Scanner& scan)
+  {
+    // This accepts the same numeric literals as the tokenizer of Asteria.
+    // All numbers are parsed as real numbers.
+    auto sloc = scan.tell();
+    cow_string tstr;
+    double sign = 1;
+    uint8_t mmask = cmask_digit;
+    int expch = 'e';
+
+    // Look for an explicit sign symbol.
+    int c = scan.peek();
+    if((c == '+') || (c == '-')) {
+      tstr.push_back((char) c);
+      scan.consume(1);
+      sign = (c == '-') ? -1 : 1;
+      c = scan.peek();
+    }
+
+    if((c >= 0) && is_cmask((char) c, cmask_namei)) {
+      // `nan`, `NaN`, `infinity` or `Infinity`
+      cow_string name;
+      do_accept_name(name, scan);
+
+      if((name == "nan") || (name == "NaN"))
+        return ::std::copysign(::std::numeric_limits<double>::quiet_NaN(), sign);
+
+      if((name == "infinity") || (name == "Infinity"))
+        return ::std::copysign(::std::numeric_limits<double>::infinity(), sign);
+
+      throw Compiler_Error(Compiler_Error::M_format(),
+                compiler_status_expression_expected, sloc,
+                "Value expected");
+    }
+
+    if((c < 0) || !is_cmask((char) c, cmask_digit))
+      throw Compiler_Error(Compiler_Error::M_format(),
+                compiler_status_expression_expected, sloc,
+                "Value expected");
+
+    if(c == '0') {
+      // Check the radix identifier.
+      int r = scan.peek(1) | 0x20;
+      if((r == 'b') || (r == 'x')) {
+        tstr.push_back('0');
+        tstr.push_back((char) scan.peek(1));
+        scan.consume(2);
+
+        // Accept the radix identifier.
+        mmask = cmask_xdigit;
+        expch = 'p';
+      }
+    }
+
+    // Accept the longest string composing the integral part.
+    do_collect_digits(tstr, scan, mmask);
+
+    // Check for a radix point. If one exists, the fractional part shall follow.
+    if(scan.peek() == '.') {
+      tstr.push_back('.');
+      scan.consume(1);
+      do_collect_digits(tstr, scan, mmask);
+    }
+
+    // Check for the exponent.
+    if((scan.peek() | 0x20) == expch) {
+      tstr.push_back((char) scan.peek());
+      scan.consume(1);
+
+      // Check for an optional sign symbol.
+      c = scan.peek();
+      if((c == '+') || (c == '-')) {
+        tstr.push_back((char) c);
+        scan.consume(1);
+      }
+
+      do_collect_digits(tstr, scan, cmask_digit);
+    }
+
+    // Any suffix will cause errors.
+    do_collect_digits(tstr, scan, cmask_alpha | cmask_digit);
+
+    ::rocket::ascii_numget numg;
+    if(numg.parse_D(tstr.data(), tstr.size()) != tstr.size())
+      throw Compiler_Error(Compiler_Error::M_status(),
+                compiler_status_numeric_literal_suffix_invalid, sloc);
+
+    double val;
+    numg.cast_D(val, -DBL_MAX, DBL_MAX);
+
+    if(numg.overflowed())
+      throw Compiler_Error(Compiler_Error::M_status(),
+                compiler_status_real_literal_overflow, sloc);
+
+    if(numg.underflowed())
+      throw Compiler_Error(Compiler_Error::M_status(),
+                compiler_status_real_literal_underflow, sloc);
+
+    return val;
+  }
+
+bool
+do_accept_punctuator(JSON_Scanner& scan, char punct)
+  {
+    scan.skip_spaces();
+    if(scan.peek() != punct)
+      return false;
+
+    scan.consume(1);
+    return true;
   }
 
 struct Xparse_array
@@ -451,32 +986,31 @@ struct Xparse_object
 using Xparse = ::rocket::variant<Xparse_array, Xparse_object>;
 
 void
-do_accept_object_key(Xparse_object& ctxo, Token_Stream& tstrm)
+do_accept_object_key(Xparse_object& ctxo, JSON_Scanner& scan)
   {
-    auto qtok = tstrm.peek_opt();
-    if(!qtok)
-      throw Compiler_Error(Compiler_Error::M_status(),
-                compiler_status_closing_brace_or_json5_key_expected, tstrm.next_sloc());
-
-    if(qtok->is_identifier())
-      ctxo.key = qtok->as_identifier();
-    else if(qtok->is_string_literal())
-      ctxo.key = qtok->as_string_literal();
+    scan.skip_spaces();
+    ctxo.key_sloc = scan.tell();
+
+    // Accept a string or an identifier.
+    cow_string name;
+    int c = scan.peek();
+    if((c == '\"') || (c == '\''))
+      scan.accept_string(name, (char) c);
+    else if((c >= 0) && is_cmask((char) c, cmask_namei))
+      do_accept_name(name, scan);
     else
       throw Compiler_Error(Compiler_Error::M_status(),
-                compiler_status_closing_brace_or_json5_key_expected, tstrm.next_sloc());
+                compiler_status_closing_brace_or_json5_key_expected, scan.tell());
 
-    ctxo.key_sloc = qtok->sloc();
-    tstrm.shift();
+    ctxo.key = ::std::move(name);
 
-    auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_colon });
-    if(!kpunct)
+    if(!do_accept_punctuator(scan, ':'))
       throw Compiler_Error(Compiler_Error::M_status(),
-                compiler_status_colon_expected, tstrm.next_sloc());
+                compiler_status_colon_expected, scan.tell());
   }
 
 Value
-do_parse_nonrecursive(Token_Stream& tstrm)
+do_parse_nonrecursive(JSON_Scanner& scan)
   {
     // Implement a non-recursive descent parser.
     Value value;
@@ -484,85 +1018,87 @@ do_parse_nonrecursive(Token_Stream& tstrm)
 
     // Accept a value. No other things such as closed brackets are allowed.
   parse_next:
-    auto qtok = tstrm.peek_opt();
-    if(!qtok)
-      throw Compiler_Error(Compiler_Error::M_format(),
-                compiler_status_expression_expected, tstrm.next_sloc(),
-                "Value expected");
+    scan.skip_spaces();
+    int c = scan.peek();
+    switch(c) {
+      case '[':
+        scan.consume(1);
 
-    if(qtok->is_punctuator()) {
-      // Accept an `[` or `{`.
-      if(qtok->as_punctuator() == punctuator_bracket_op) {
-        tstrm.shift();
-
-        auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl });
-        if(!kpunct) {
+        if(!do_accept_punctuator(scan, ']')) {
           stack.emplace_back(Xparse_array());
           goto parse_next;
         }
 
         // Accept an empty array.
         value = V_array();
-      }
-      else if(qtok->as_punctuator() == punctuator_brace_op) {
-        tstrm.shift();
+        break;
+
+      case '{':
+        scan.consume(1);
 
-        auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl });
-        if(!kpunct) {
+        if(!do_accept_punctuator(scan, '}')) {
           stack.emplace_back(Xparse_object());
-          do_accept_object_key(stack.mut_back().mut<Xparse_object>(), tstrm);
+          do_accept_object_key(stack.mut_back().mut<Xparse_object>(), scan);
           goto parse_next;
         }
 
         // Accept an empty object.
         value = V_object();
+        break;
+
+      case '\"':
+      case '\'': {
+        // Accept a UTF-8 string.
+        cow_string str;
+        scan.accept_string(str, (char) c);
+        value = ::std::move(str);
+        break;
       }
-      else
-        throw Compiler_Error(Compiler_Error::M_format(),
-                  compiler_status_expression_expected, tstrm.next_sloc(),
-                  "Value expected");
-    }
-    else if(qtok->is_identifier()) {
-      // Accept a literal.
-      if(qtok->as_identifier() == "null") {
-        tstrm.shift();
-        value = nullopt;
-      }
-      else if(qtok->as_identifier() == "true") {
-        tstrm.shift();
-        value = true;
-      }
-      else if(qtok->as_identifier() == "false") {
-        tstrm.shift();
-        value = false;
-      }
-      else if(qtok->as_identifier() == "Infinity") {
-        tstrm.shift();
-        value = ::std::numeric_limits<double>::infinity();
-      }
-      else if(qtok->as_identifier() == "NaN") {
-        tstrm.shift();
-        value = ::std::numeric_limits<double>::quiet_NaN();
+
+      case '+':
+      case '-':
+      case '0':
+      case '1':
+      case '2':
+      case '3':
+      case '4':
+      case '5':
+      case '6':
+      case '7':
+      case '8':
+      case '9':
+        // Accept a number.
+        value = do_accept_number(scan);
+        break;
+
+      default: {
+        if((c < 0) || !is_cmask((char) c, cmask_namei))
+          throw Compiler_Error(Compiler_Error::M_format(),
+                    compiler_status_expression_expected, scan.tell(),
+                    "Value expected");
+
+        // Accept a literal.
+        auto sloc = scan.tell();
+        cow_string name;
+        do_accept_name(name, scan);
+
+        if(name == "null")
+          value = nullopt;
+        else if(name == "true")
+          value = true;
+        else if(name == "false")
+          value = false;
+        else if((name == "Infinity") || (name == "infinity"))
+          value = ::std::numeric_limits<double>::infinity();
+        else if((name == "NaN") || (name == "nan"))
+          value = ::std::numeric_limits<double>::quiet_NaN();
+        else
+          throw Compiler_Error(Compiler_Error::M_format(),
+                    compiler_status_expression_expected, sloc,
+                    "Value expected");
+        break;
       }
-      else
-        throw Compiler_Error(Compiler_Error::M_format(),
-                  compiler_status_expression_expected, tstrm.next_sloc(),
-                  "Value expected");
     }
-    else if(qtok->is_real_literal()) {
-      // Accept a number.
-      value = qtok->as_real_literal();
-      tstrm.shift();
-    }
-    else if(qtok->is_string_literal()) {
-      // Accept a UTF-8 string.
-      value = qtok->as_string_literal();
-      tstrm.shift();
-    }
-    else
-      throw Compiler_Error(Compiler_Error::M_format(),
-                compiler_status_expression_expected, tstrm.next_sloc(),
-                "Value expected");
 
     while(stack.size()) {
       // Advance to the next element.
@@ -573,17 +1109,14 @@ do_parse_nonrecursive(Token_Stream& tstrm)
           ctxa.arr.emplace_back(::std::move(value));
 
           // Look for the next element.
-          auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl, punctuator_comma });
-          if(!kpunct)
-            throw Compiler_Error(Compiler_Error::M_status(),
-                      compiler_status_closing_bracket_or_comma_expected, tstrm.next_sloc());
-
-          if(*kpunct == punctuator_comma) {
+          if(do_accept_punctuator(scan, ',')) {
             // A closing bracket may still follow.
-            kpunct = do_accept_punctuator_opt(tstrm, { punctuator_bracket_cl });
-            if(!kpunct)
+            if(!do_accept_punctuator(scan, ']'))
               goto parse_next;
           }
+          else if(!do_accept_punctuator(scan, ']'))
+            throw Compiler_Error(Compiler_Error::M_status(),
+                      compiler_status_closing_bracket_or_comma_expected, scan.tell());
 
           // Close this array.
           value = ::std::move(ctxa.arr);
@@ -598,19 +1131,16 @@ do_parse_nonrecursive(Token_Stream& tstrm)
                       compiler_status_duplicate_key_in_object, ctxo.key_sloc);
 
           // Look for the next element.
-          auto kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl, punctuator_comma });
-          if(!kpunct)
-            throw Compiler_Error(Compiler_Error::M_status(),
-                      compiler_status_closing_brace_or_comma_expected, tstrm.next_sloc());
-
-          if(*kpunct == punctuator_comma) {
+          if(do_accept_punctuator(scan, ',')) {
             // A closing brace may still follow.
-            kpunct = do_accept_punctuator_opt(tstrm, { punctuator_brace_cl });
-            if(!kpunct) {
-              do_accept_object_key(stack.mut_back().mut<Xparse_object>(), tstrm);
+            if(!do_accept_punctuator(scan, '}')) {
+              do_accept_object_key(ctxo, scan);
               goto parse_next;
             }
           }
+          else if(!do_accept_punctuator(scan, '}'))
+            throw Compiler_Error(Compiler_Error::M_status(),
+                      compiler_status_closing_brace_or_comma_expected, scan.tell());
 
           // Close this object.
           value = ::std::move(ctxo.obj);
@@ -628,28 +1158,41 @@ do_parse_nonrecursive(Token_Stream& tstrm)
   }
 
 Value
-do_parse(tinybuf& cbuf)
-  {
-    // We reuse the lexer of Asteria here, allowing quite a few extensions e.g. binary numeric
-    // literals and comments.
-    Compiler_Options opts;
-    opts.escapable_single_quotes = true;
-    opts.keywords_as_identifiers = true;
-    opts.integers_as_reals = true;
-
-    Token_Stream tstrm(opts);
-    tstrm.reload(sref("[JSON text]"), 1, ::std::move(cbuf));
-    if(tstrm.empty())
+do_parse(JSON_Scanner& scan)
+  {
+    // Remove the UTF-8 BOM, if any.
+    if(scan.ensure(3) && (::memcmp(scan.data(), "\xEF\xBB\xBF", 3) == 0))
+      scan.consume(3);
+
+    // Discard the first line if it looks like a shebang.
+    if(scan.ensure(2) && (::memcmp(scan.data(), "#!", 2) == 0))
+      scan.skip_line();
+
+    scan.skip_spaces();
+    if(scan.peek() < 0)
       ASTERIA_THROW(("Empty JSON string"));
 
     // Parse a single value.
-    auto value = do_parse_nonrecursive(tstrm);
-    if(!tstrm.empty())
+    auto value = do_parse_nonrecursive(scan);
+    scan.skip_spaces();
+    if(scan.peek() >= 0)
       ASTERIA_THROW(("Excess text at end of JSON string"));
 
     return value;
   }
 
+void
+do_invoke_callback(Global_Context& global, const V_function& callback, int64_t index,
+                   Value&& value)
+  {
+    // Call the function but discard its return value.
+    Reference self;
+    Reference_Stack stack;
+    stack.push().set_temporary(index);
+    stack.push().set_temporary(::std::move(value));
+    callback.invoke(self, global, ::std::move(stack));
+  }
+
 }  // namespace
 
 V_string
@@ -673,10 +1216,9 @@ std_json_format(Value value, V_integer indent, optV_boolean json5)
 Value
 std_json_parse(V_string text)
   {
-    // Parse characters from the string.
-    ::rocket::tinybuf_str cbuf;
-    cbuf.set_string(text, tinybuf::open_read);
-    return do_parse(cbuf);
+    // Parse characters from the string in place.
+    JSON_Scanner scan(text.data(), text.size());
+    return do_parse(scan);
   }
 
 Value
@@ -692,7 +1234,72 @@ std_json_parse_file(V_string path)
 
     // Parse characters from the file.
     ::rocket::tinybuf_file cbuf(::std::move(fp));
-    return do_parse(cbuf);
+    JSON_Scanner scan(cbuf);
+    return do_parse(scan);
+  }
+
+V_integer
+std_json_stream_file(Global_Context& global, V_string path, V_function callback,
+                     optV_boolean lines)
+  {
+    // Try opening the file.
+    ::rocket::unique_posix_file fp(::fopen(path.safe_c_str(), "rb"));
+    if(!fp)
+      ASTERIA_THROW((
+          "Could not open file '$1'",
+          "[`fopen()` failed: ${errno:full}]"),
+          path);
+
+    // Parse characters from the file. Only one record is kept at a time.
+    ::rocket::tinybuf_file cbuf(::std::move(fp));
+    JSON_Scanner scan(cbuf);
+    int64_t count = 0;
+
+    // Remove the UTF-8 BOM, if any.
+    if(scan.ensure(3) && (::memcmp(scan.data(), "\xEF\xBB\xBF", 3) == 0))
+      scan.consume(3);
+
+    if(lines == true) {
+      // Each top-level value is a record.
+      for(;;) {
+        scan.skip_spaces();
+        if(scan.peek() < 0)
+          break;
+
+        auto value = do_parse_nonrecursive(scan);
+        do_invoke_callback(global, callback, count, ::std::move(value));
+        count ++;
+      }
+      return count;
+    }
+
+    // The file shall contain an array, whose elements are records.
+    if(!do_accept_punctuator(scan, '['))
+      ASTERIA_THROW(("JSON text not an array"));
+
+    if(!do_accept_punctuator(scan, ']'))
+      for(;;) {
+        auto value = do_parse_nonrecursive(scan);
+        do_invoke_callback(global, callback, count, ::std::move(value));
+        count ++;
+
+        // Look for the next element. A closing bracket may follow a comma.
+        if(do_accept_punctuator(scan, ',')) {
+          if(do_accept_punctuator(scan, ']'))
+            break;
+        }
+        else if(do_accept_punctuator(scan, ']'))
+          break;
+        else
+          throw Compiler_Error(Compiler_Error::M_status(),
+                    compiler_status_closing_bracket_or_comma_expected, scan.tell());
+      }
+
+    scan.skip_spaces();
+    if(scan.peek() >= 0)
+      ASTERIA_THROW(("Excess text at end of JSON string"));
+
+    return count;
   }
 
 void
@@ -754,6 +1361,25 @@ create_bindings_json(V_object& result, API_Version /*version*/)
 
         reader.throw_no_matching_function_call();
       });
+
+    result.insert_or_assign(sref("stream_file"),
+      ASTERIA_BINDING(
+        "std.json.stream_file", "path, callback, [lines]",
+        Global_Context& global, Argument_Reader&& reader)
+      {
+        V_string path;
+        V_function func;
+        optV_boolean lines;
+
+        reader.start_overload();
+        reader.required(path);
+        reader.required(func);
+        reader.optional(lines);
+        if(reader.end_overload())
+          return (Value) std_json_stream_file(global, path, func, lines);
+
+        reader.throw_no_matching_function_call();
+      });
   }
 
 }  // namespace asteria
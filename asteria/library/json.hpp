@@ -22,6 +22,10 @@ std_json_parse(V_string text);
 Value
 std_json_parse_file(V_string path);
 
+// `std.json.stream_file`
+V_integer
+std_json_stream_file(Global_Context& global, V_string path, V_function callback, optV_boolean lines);
+
 // Create an object that is to be referenced as `std.json`.
 void
 create_bindings_json(V_object& result, API_Version version);
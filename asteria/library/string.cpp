@@ -5,8 +5,11 @@
 #include "string.hpp"
 #include "../runtime/argument_reader.hpp"
 #include "../runtime/binding_generator.hpp"
+#include "../runtime/global_context.hpp"
+#include "../runtime/pattern_cache.hpp"
 #include "../utils.hpp"
 #include <iconv.h>
+#include <strings.h>
 #define PCRE2_CODE_UNIT_WIDTH 8
 #include <pcre2.h>
 namespace asteria {
@@ -309,6 +312,28 @@ operator<<(tinyfmt& fmt, const PCRE2_Error& err)
     return fmt << err.c_str();
   }
 
+uint32_t
+do_pcre2_options(const optV_array& opts)
+  {
+    uint32_t bits = PCRE2_NEVER_UTF | PCRE2_NEVER_UCP;
+    if(opts) {
+      for(const auto& opt : *opts)
+        if(do_streq_ci(opt.as_string(), sref("caseless")))
+          bits |= PCRE2_CASELESS;
+        else if(do_streq_ci(opt.as_string(), sref("dotall")))
+          bits |= PCRE2_DOTALL;
+        else if(do_streq_ci(opt.as_string(), sref("extended")))
+          bits |= PCRE2_EXTENDED;
+        else if(do_streq_ci(opt.as_string(), sref("multiline")))
+          bits |= PCRE2_MULTILINE;
+        else if(!opt.as_string().empty())
+          ASTERIA_THROW((
+              "Invalid option for regular expression: $1"),
+              opt);
+    }
+    return bits;
+  }
+
 class PCRE2_Matcher final
   :
     public Abstract_Opaque
@@ -325,28 +350,11 @@ class PCRE2_Matcher final
 
   public:
     explicit
-    PCRE2_Matcher(const V_string& patt, const optV_array& opts)
+    PCRE2_Matcher(const V_string& patt, uint32_t opts)
       :
-        m_patt(patt), m_opts(PCRE2_NEVER_UTF | PCRE2_NEVER_UCP),
+        m_patt(patt), m_opts(opts),
         m_code(::pcre2_code_free), m_match(::pcre2_match_data_free)
       {
-        // Check options.
-        if(opts) {
-          for(const auto& opt : *opts)
-            if(do_streq_ci(opt.as_string(), sref("caseless")))
-              this->m_opts |= PCRE2_CASELESS;
-            else if(do_streq_ci(opt.as_string(), sref("dotall")))
-              this->m_opts |= PCRE2_DOTALL;
-            else if(do_streq_ci(opt.as_string(), sref("extended")))
-              this->m_opts |= PCRE2_EXTENDED;
-            else if(do_streq_ci(opt.as_string(), sref("multiline")))
-              this->m_opts |= PCRE2_MULTILINE;
-            else if(!opt.as_string().empty())
-              ASTERIA_THROW((
-                  "Invalid option for regular expression: $1"),
-                  opt);
-        }
-
         // Compile the regular expression.
         int err;
         size_t off;
@@ -372,6 +380,12 @@ class PCRE2_Matcher final
               "[`pcre2_code_copy()` failed]"));
       }
 
+    explicit
+    PCRE2_Matcher(const V_string& patt, const optV_array& opts)
+      :
+        PCRE2_Matcher(patt, do_pcre2_options(opts))
+      { }
+
   private:
     void
     do_initialize_match_data()
@@ -417,7 +431,7 @@ class PCRE2_Matcher final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -429,6 +443,14 @@ class PCRE2_Matcher final
         return ptr;
       }
 
+    void
+    jit_compile() noexcept
+      {
+        // If JIT is not available, the interpreter is used. This is not an
+        // error, so the result is ignored.
+        ::pcre2_jit_compile(this->m_code, PCRE2_JIT_COMPLETE);
+      }
+
     opt<pair<V_integer, V_integer>>
     find(const V_string& text, V_integer from, optV_integer length)
       {
@@ -556,6 +578,24 @@ class PCRE2_Matcher final
       }
   };
 
+refcnt_ptr<PCRE2_Matcher>
+do_get_cached_matcher(Global_Context& global, const V_string& patt, const optV_array& opts)
+  {
+    // Patterns for the `pcre_*` functions are usually literals, so compiled
+    // ones are cached, which also makes JIT compilation worthwhile.
+    uint32_t bits = do_pcre2_options(opts);
+    phsh_string key(patt);
+    const auto cache = global.pattern_cache();
+    auto comp = dynamic_pointer_cast<PCRE2_Matcher>(cache->find_opt(key, bits));
+    if(comp)
+      return comp;
+
+    comp = ::rocket::make_refcnt<PCRE2_Matcher>(patt, bits);
+    comp->jit_compile();
+    cache->insert(key, bits, comp);
+    return comp;
+  }
+
 void
 do_construct_PCRE(V_object& result, V_string pattern, optV_array options)
   {
@@ -716,6 +756,79 @@ struct iconv_closer
       { return ::iconv_close(cd);  }
   };
 
+enum UTF_Form : uint8_t
+  {
+    utf_form_other  = 0,
+    utf_form_8      = 1,
+    utf_form_16le   = 2,
+    utf_form_32le   = 3,
+  };
+
+// Conversions between UTF-8 and other Unicode encodings are performed
+// without iconv. Code units are stored in native byte order, so only
+// little-endian forms are recognized on little-endian machines.
+UTF_Form
+do_classify_encoding(const char* enc) noexcept
+  {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if(::strcasecmp(enc, "UTF-8") == 0)
+      return utf_form_8;
+
+    if(::strcasecmp(enc, "UTF-16LE") == 0)
+      return utf_form_16le;
+
+    if(::strcasecmp(enc, "UTF-32LE") == 0)
+      return utf_form_32le;
+#endif
+    return utf_form_other;
+  }
+
+// Returns the offset of the first invalid byte, or `SIZE_MAX` on success.
+size_t
+do_convert_unicode(V_string& output, UTF_Form to_form, UTF_Form from_form, const V_string& text)
+  {
+    if(from_form == utf_form_8) {
+      const char* pos = text.data();
+      bool valid = false;
+
+      if(to_form == utf_form_8) {
+        valid = utf8_validate(pos, text.size());
+        output = text;
+      }
+      else if(to_form == utf_form_16le) {
+        cow_u16string temp;
+        valid = utf8_to_utf16(temp, pos, text.size());
+        output.append((const char*) temp.data(), temp.size() * 2);
+      }
+      else if(to_form == utf_form_32le) {
+        cow_u32string temp;
+        valid = utf8_to_utf32(temp, pos, text.size());
+        output.append((const char*) temp.data(), temp.size() * 4);
+      }
+      return valid ? SIZE_MAX : (size_t) (pos - text.data());
+    }
+
+    if(from_form == utf_form_16le) {
+      // Copy code units, as `text` may not be aligned.
+      cow_u16string temp;
+      temp.append(text.size() / 2, u'\0');
+      ::memcpy(temp.mut_data(), text.data(), temp.size() * 2);
+
+      const char16_t* pos = temp.data();
+      bool valid = utf16_to_utf8(output, pos, temp.size()) && (text.size() % 2 == 0);
+      return valid ? SIZE_MAX : (size_t) (pos - temp.data()) * 2;
+    }
+
+    ROCKET_ASSERT(from_form == utf_form_32le);
+    cow_u32string temp;
+    temp.append(text.size() / 4, U'\0');
+    ::memcpy(temp.mut_data(), text.data(), temp.size() * 4);
+
+    const char32_t* pos = temp.data();
+    bool valid = utf32_to_utf8(output, pos, temp.size()) && (text.size() % 4 == 0);
+    return valid ? SIZE_MAX : (size_t) (pos - temp.data()) * 4;
+  }
+
 }  // namespace
 
 V_string
@@ -1561,15 +1674,8 @@ std_string_url_query_decode(V_string text)
 V_boolean
 std_string_utf8_validate(V_string text)
   {
-    size_t offset = 0;
-    while(offset < text.size()) {
-      // Try decoding a code point.
-      char32_t cp;
-      if(!utf8_decode(cp, text, offset))
-        // This sequence is invalid.
-        return false;
-    }
-    return true;
+    const char* pos = text.data();
+    return utf8_validate(pos, text.size());
   }
 
 V_string
@@ -1593,19 +1699,22 @@ std_string_utf8_encode(V_integer code_point, optV_boolean permissive)
 V_string
 std_string_utf8_encode(V_array code_points, optV_boolean permissive)
   {
+    cow_u32string temp;
+    temp.reserve(code_points.size());
+    for(const auto& elem : code_points)
+      temp.push_back(::rocket::clamp_cast<char32_t>(elem.as_integer(), -1, INT32_MAX));
+
+    // Encode code points in bulk.
     V_string text;
-    text.reserve(code_points.size() * 3);
-    for(const auto& elem : code_points) {
-      // Try encoding the code point.
-      V_integer value = elem.as_integer();
-      auto cp = ::rocket::clamp_cast<char32_t>(value, -1, INT32_MAX);
-      if(!utf8_encode(text, cp)) {
-        // This comparison with `true` is by intention, because it may be unset.
-        if(permissive != true)
-          ASTERIA_THROW(("Invalid UTF code point (value `$1`)"), value);
-
-        utf8_encode(text, 0xFFFD);
-      }
+    const char32_t* pos = temp.data();
+    while(!utf32_to_utf8(text, pos, (size_t) (temp.data() + temp.size() - pos))) {
+      // This comparison with `true` is by intention, because it may be unset.
+      if(permissive != true)
+        ASTERIA_THROW(("Invalid UTF code point (value `$1`)"),
+                      code_points[(size_t) (pos - temp.data())].as_integer());
+
+      utf8_encode(text, 0xFFFD);
+      pos ++;
     }
     return text;
   }
@@ -1616,18 +1725,23 @@ std_string_utf8_decode(V_string text, optV_boolean permissive)
     V_array code_points;
     code_points.reserve(text.size());
 
-    size_t offset = 0;
-    while(offset < text.size()) {
-      // Try decoding a code point.
-      char32_t cp;
-      if(!utf8_decode(cp, text, offset)) {
-        // This comparison with `true` is by intention, because it may be unset.
-        if(permissive != true)
-          ASTERIA_THROW(("Invalid UTF-8 string"));
+    // Decode code points in bulk.
+    cow_u32string temp;
+    const char* pos = text.data();
+    for(;;) {
+      temp.clear();
+      bool valid = utf8_to_utf32(temp, pos, (size_t) (text.data() + text.size() - pos));
+      for(char32_t cp : temp)
+        code_points.emplace_back(V_integer(cp));
 
-        cp = text[offset++] & 0xFF;
-      }
-      code_points.emplace_back(V_integer(cp));
+      if(valid)
+        break;
+
+      // This comparison with `true` is by intention, because it may be unset.
+      if(permissive != true)
+        ASTERIA_THROW(("Invalid UTF-8 string"));
+
+      code_points.emplace_back(V_integer((uint8_t) *(pos++)));
     }
     return code_points;
   }
@@ -1694,31 +1808,43 @@ std_string_PCRE_replace(V_opaque& m, V_string text, V_integer from, optV_integer
   }
 
 opt<pair<V_integer, V_integer>>
-std_string_pcre_find(V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options)
+std_string_pcre_find(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options)
   {
-    PCRE2_Matcher m(pattern, options);
-    return m.find(text, from, length);
+    auto m = do_get_cached_matcher(global, pattern, options);
+    return m->find(text, from, length);
   }
 
 optV_array
-std_string_pcre_match(V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options)
+std_string_pcre_match(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options)
   {
-    PCRE2_Matcher m(pattern, options);
-    return m.match(text, from, length);
+    auto m = do_get_cached_matcher(global, pattern, options);
+    return m->match(text, from, length);
   }
 
 optV_object
-std_string_pcre_named_match(V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options)
+std_string_pcre_named_match(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options)
   {
-    PCRE2_Matcher m(pattern, options);
-    return m.named_match(text, from, length);
+    auto m = do_get_cached_matcher(global, pattern, options);
+    return m->named_match(text, from, length);
   }
 
 V_string
-std_string_pcre_replace(V_string text, V_integer from, optV_integer length, V_string pattern, V_string replacement, optV_array options)
+std_string_pcre_replace(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, V_string replacement, optV_array options)
   {
-    PCRE2_Matcher m(pattern, options);
-    return m.replace(text, from, length, replacement);
+    auto m = do_get_cached_matcher(global, pattern, options);
+    return m->replace(text, from, length, replacement);
+  }
+
+V_object
+std_string_pcre_cache_stats(Global_Context& global)
+  {
+    const auto cache = global.pattern_cache();
+    V_object result;
+    result.try_emplace(sref("hits"), static_cast<V_integer>(cache->count_hits()));
+    result.try_emplace(sref("misses"), static_cast<V_integer>(cache->count_misses()));
+    result.try_emplace(sref("size"), static_cast<V_integer>(cache->size()));
+    result.try_emplace(sref("capacity"), static_cast<V_integer>(cache->capacity()));
+    return result;
   }
 
 V_string
@@ -1729,6 +1855,20 @@ std_string_iconv(V_string to_encoding, V_string text, optV_string from_encoding)
     if(from_encoding)
       from_enc = from_encoding->safe_c_str();
 
+    // Convert between UTF-8 and other Unicode encodings in bulk.
+    UTF_Form to_form = do_classify_encoding(to_enc);
+    UTF_Form from_form = do_classify_encoding(from_enc);
+    if(to_form && from_form && ((to_form == utf_form_8) || (from_form == utf_form_8))) {
+      V_string output;
+      size_t erroff = do_convert_unicode(output, to_form, from_form, text);
+      if(erroff != SIZE_MAX)
+        ASTERIA_THROW((
+               "Invalid input byte to encoding `$1` from `$2` at offset `$3`"),
+               to_enc, from_enc, erroff);
+
+      return output;
+    }
+
     // Create the descriptor.
     ::rocket::unique_handle<::iconv_t, iconv_closer> qcd;
     if(!qcd.reset(::iconv_open(to_enc, from_enc)))
@@ -2534,7 +2674,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     result.insert_or_assign(sref("pcre_find"),
       ASTERIA_BINDING(
         "std.string.pcre_find", "text, [from, [length]], pattern, [options]",
-        Argument_Reader&& reader)
+        Global_Context& global, Argument_Reader&& reader)
       {
         V_string text, patt;
         V_integer from;
@@ -2547,7 +2687,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_find(text, 0, nullopt, patt, opts);
+          return (Value) std_string_pcre_find(global, text, 0, nullopt, patt, opts);
 
         reader.load_state(0);
         reader.required(from);
@@ -2555,14 +2695,14 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_find(text, from, nullopt, patt, opts);
+          return (Value) std_string_pcre_find(global, text, from, nullopt, patt, opts);
 
         reader.load_state(0);
         reader.optional(len);
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_find(text, from, len, patt, opts);
+          return (Value) std_string_pcre_find(global, text, from, len, patt, opts);
 
         reader.throw_no_matching_function_call();
       });
@@ -2570,7 +2710,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     result.insert_or_assign(sref("pcre_match"),
       ASTERIA_BINDING(
         "std.string.pcre_match", "text, [from, [length]], pattern, [options]",
-        Argument_Reader&& reader)
+        Global_Context& global, Argument_Reader&& reader)
       {
         V_string text, patt;
         V_integer from;
@@ -2583,7 +2723,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_match(text, 0, nullopt, patt, opts);
+          return (Value) std_string_pcre_match(global, text, 0, nullopt, patt, opts);
 
         reader.load_state(0);
         reader.required(from);
@@ -2591,14 +2731,14 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_match(text, from, nullopt, patt, opts);
+          return (Value) std_string_pcre_match(global, text, from, nullopt, patt, opts);
 
         reader.load_state(0);
         reader.optional(len);
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_match(text, from, len, patt, opts);
+          return (Value) std_string_pcre_match(global, text, from, len, patt, opts);
 
         reader.throw_no_matching_function_call();
       });
@@ -2606,7 +2746,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     result.insert_or_assign(sref("pcre_named_match"),
       ASTERIA_BINDING(
         "std.string.pcre_named_match", "text, [from, [length]], pattern, [options]",
-        Argument_Reader&& reader)
+        Global_Context& global, Argument_Reader&& reader)
       {
         V_string text, patt;
         V_integer from;
@@ -2619,7 +2759,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_named_match(text, 0, nullopt, patt, opts);
+          return (Value) std_string_pcre_named_match(global, text, 0, nullopt, patt, opts);
 
         reader.load_state(0);
         reader.required(from);
@@ -2627,14 +2767,14 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_named_match(text, from, nullopt, patt, opts);
+          return (Value) std_string_pcre_named_match(global, text, from, nullopt, patt, opts);
 
         reader.load_state(0);
         reader.optional(len);
         reader.required(patt);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_named_match(text, from, len, patt, opts);
+          return (Value) std_string_pcre_named_match(global, text, from, len, patt, opts);
 
         reader.throw_no_matching_function_call();
       });
@@ -2642,7 +2782,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
     result.insert_or_assign(sref("pcre_replace"),
       ASTERIA_BINDING(
         "std.string.pcre_replace", "text, [from, [length]], pattern, replacement, [options]",
-        Argument_Reader&& reader)
+        Global_Context& global, Argument_Reader&& reader)
       {
         V_string text, patt, rep;
         V_integer from;
@@ -2656,7 +2796,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(rep);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_replace(text, 0, nullopt, patt, rep, opts);
+          return (Value) std_string_pcre_replace(global, text, 0, nullopt, patt, rep, opts);
 
         reader.load_state(0);
         reader.required(from);
@@ -2665,7 +2805,7 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(rep);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_replace(text, from, nullopt, patt, rep, opts);
+          return (Value) std_string_pcre_replace(global, text, from, nullopt, patt, rep, opts);
 
         reader.load_state(0);
         reader.optional(len);
@@ -2673,7 +2813,19 @@ create_bindings_string(V_object& result, API_Version /*version*/)
         reader.required(rep);
         reader.optional(opts);
         if(reader.end_overload())
-          return (Value) std_string_pcre_replace(text, from, len, patt, rep, opts);
+          return (Value) std_string_pcre_replace(global, text, from, len, patt, rep, opts);
+
+        reader.throw_no_matching_function_call();
+      });
+
+    result.insert_or_assign(sref("pcre_cache_stats"),
+      ASTERIA_BINDING(
+        "std.string.pcre_cache_stats", "",
+        Global_Context& global, Argument_Reader&& reader)
+      {
+        reader.start_overload();
+        if(reader.end_overload())
+          return (Value) std_string_pcre_cache_stats(global);
 
         reader.throw_no_matching_function_call();
       });
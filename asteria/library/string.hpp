@@ -180,19 +180,23 @@ std_string_PCRE_replace(V_opaque& m, V_string text, V_integer from, optV_integer
 
 // `std.string.pcre_find`.
 opt<pair<V_integer, V_integer>>
-std_string_pcre_find(V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options);
+std_string_pcre_find(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options);
 
 // `std.string.pcre_match`
 optV_array
-std_string_pcre_match(V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options);
+std_string_pcre_match(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options);
 
 // `std.string.pcre_named_match`
 optV_object
-std_string_pcre_named_match(V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options);
+std_string_pcre_named_match(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, optV_array options);
 
 // `std.string.pcre_replace`
 V_string
-std_string_pcre_replace(V_string text, V_integer from, optV_integer length, V_string pattern, V_string replacement, optV_array options);
+std_string_pcre_replace(Global_Context& global, V_string text, V_integer from, optV_integer length, V_string pattern, V_string replacement, optV_array options);
+
+// `std.string.pcre_cache_stats`
+V_object
+std_string_pcre_cache_stats(Global_Context& global);
 
 // `std.string.iconv`
 V_string
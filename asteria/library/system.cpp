@@ -7,6 +7,7 @@
 #include "../runtime/binding_generator.hpp"
 #include "../runtime/global_context.hpp"
 #include "../runtime/random_engine.hpp"
+#include "../runtime/module_loader.hpp"
 #include "../compiler/token_stream.hpp"
 #include "../compiler/compiler_error.hpp"
 #include "../compiler/enums.hpp"
@@ -528,6 +529,17 @@ std_system_load_conf(V_string path)
     return ::std::move(ctxo.obj);
   }
 
+V_object
+std_system_module_cache_stats(Global_Context& global)
+  {
+    const auto loader = global.module_loader();
+    V_object result;
+    result.try_emplace(sref("hits"), static_cast<V_integer>(loader->count_hits()));
+    result.try_emplace(sref("misses"), static_cast<V_integer>(loader->count_misses()));
+    result.try_emplace(sref("size"), static_cast<V_integer>(loader->count_cached_modules()));
+    return result;
+  }
+
 void
 create_bindings_system(V_object& result, API_Version /*version*/)
   {
@@ -689,6 +701,18 @@ create_bindings_system(V_object& result, API_Version /*version*/)
 
         reader.throw_no_matching_function_call();
       });
+
+    result.insert_or_assign(sref("module_cache_stats"),
+      ASTERIA_BINDING(
+        "std.system.module_cache_stats", "",
+        Global_Context& global, Argument_Reader&& reader)
+      {
+        reader.start_overload();
+        if(reader.end_overload())
+          return (Value) std_system_module_cache_stats(global);
+
+        reader.throw_no_matching_function_call();
+      });
   }
 
 }  // namespace asteria
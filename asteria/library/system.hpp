@@ -55,6 +55,10 @@ std_system_sleep(V_real duration);
 V_object
 std_system_load_conf(V_string path);
 
+// `std.system.module_cache_stats`
+V_object
+std_system_module_cache_stats(Global_Context& global);
+
 // Create an object that is to be referenced as `std.system`.
 void
 create_bindings_system(V_object& result, API_Version version);
@@ -78,7 +78,7 @@ class Deflator final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
@@ -270,7 +270,7 @@ class Inflator final
       }
 
     void
-    collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+    collect_variables(Variable_HashMap&, Variable_Worklist&) const final
       {
       }
 
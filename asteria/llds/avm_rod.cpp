@@ -143,6 +143,16 @@ append(Executor* exec, Uparam uparam, size_t sparam_size, Constructor* ctor_opt,
     return head;
   }
 
+void
+AVM_Rod::
+replace_executor(const Header* head, Executor* exec) noexcept
+  {
+    if(head->meta_ver == 0)
+      const_cast<Header*>(head)->pv_exec = exec;
+    else
+      head->pv_meta->exec = exec;
+  }
+
 void
 AVM_Rod::
 finalize()
@@ -198,7 +208,7 @@ execute(Executive_Context& ctx) const
 
 void
 AVM_Rod::
-collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
   {
     ptrdiff_t offset = -(ptrdiff_t) this->m_einit;
     while(offset != 0) {
@@ -82,6 +82,12 @@ class AVM_Rod
            void* ctor_arg, Destructor* dtor_opt, Variable_Collector* vcoll_opt,
            const Source_Location* sloc_opt);
 
+    // Replace the executor of a node that has been appended. This may be
+    // called by an executor on its own node, in which case the new executor
+    // will be called next time the node is executed.
+    static void
+    replace_executor(const Header* head, Executor* exec) noexcept;
+
     // Marks this rod ready for execution. No nodes may be appended hereafter.
     // This function serves as an optimization hint.
     void
@@ -92,7 +98,7 @@ class AVM_Rod
     execute(Executive_Context& ctx) const;
 
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const;
   };
 
 inline
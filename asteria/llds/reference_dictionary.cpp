@@ -5,26 +5,42 @@
 #include "reference_dictionary.hpp"
 #include "../utils.hpp"
 namespace asteria {
+namespace {
+
+using Bucket = details_reference_dictionary::Bucket;
+
+constexpr
+size_t
+do_get_block_count(size_t nbkt) noexcept
+  {
+    // A block contains `nbkt` buckets, the end bucket, and a slot table of
+    // `nbkt` pointers, rounded up to a whole number of buckets.
+    return nbkt + 1 + (nbkt * sizeof(Bucket*) + sizeof(Bucket) - 1) / sizeof(Bucket);
+  }
+
+}  // namespace
 
 void
 Reference_Dictionary::
 do_reallocate(uint32_t nbkt)
   {
-    if(nbkt >= 0x7FFE0000U / sizeof(Bucket))
+    if(nbkt >= 0x7FFE0000U / (sizeof(Bucket) + sizeof(Bucket*)))
       throw ::std::bad_alloc();
 
     ROCKET_ASSERT(nbkt >= this->m_size * 2);
     ::rocket::xmeminfo minfo;
     minfo.element_size = sizeof(Bucket);
-    minfo.count = nbkt + 1;
+    minfo.count = do_get_block_count(nbkt);
     ::rocket::xmemalloc(minfo);
 
     ::rocket::xmemzero(minfo);
-    minfo.count --;
+    minfo.count = (minfo.count - 1) * sizeof(Bucket) / (sizeof(Bucket) + sizeof(Bucket*));
+    ROCKET_ASSERT(minfo.count >= nbkt);
 
     auto new_eptr = (Bucket*) minfo.data + minfo.count;
     new_eptr->prev = new_eptr;
     new_eptr->next = new_eptr;
+    auto new_slots = (Bucket**) (new_eptr + 1);
 
     if(this->m_bptr) {
       auto eptr = this->m_bptr + this->m_nbkt;
@@ -34,9 +50,14 @@ do_reallocate(uint32_t nbkt)
         auto qrel = ::rocket::linear_probe((Bucket*) minfo.data, orel, orel, minfo.count,
                         [&](const Bucket&) { return false;  });
 
-        // Relocate the value into the new bucket.
+        // Relocate the value into the new bucket. The slot table only grows,
+        // so all bound slots remain valid.
         bcopy(qrel->key, eptr->next->key);
         bcopy(qrel->ref, eptr->next->ref);
+        qrel->ordinal = eptr->next->ordinal;
+        qrel->slot = eptr->next->slot;
+        if(qrel->slot != UINT32_MAX)
+          new_slots[qrel->slot] = qrel;
         qrel->attach(*new_eptr);
         eptr->next->detach();
       }
@@ -44,7 +65,7 @@ do_reallocate(uint32_t nbkt)
       ::rocket::xmeminfo rinfo;
       rinfo.element_size = sizeof(Bucket);
       rinfo.data = this->m_bptr;
-      rinfo.count = this->m_nbkt;
+      rinfo.count = do_get_block_count(this->m_nbkt);
       ::rocket::xmemfree(rinfo);
     }
 
@@ -68,7 +89,7 @@ do_deallocate() noexcept
     ::rocket::xmeminfo rinfo;
     rinfo.element_size = sizeof(Bucket);
     rinfo.data = this->m_bptr;
-    rinfo.count = this->m_nbkt;
+    rinfo.count = do_get_block_count(this->m_nbkt);
     ::rocket::xmemfree(rinfo);
 
     this->m_bptr = nullptr;
@@ -85,6 +106,8 @@ do_erase_range(uint32_t tpos, uint32_t tn) noexcept
       if(*qbkt) {
         // Destroy this bucket.
         this->m_size --;
+        if(qbkt->slot != UINT32_MAX)
+          this->do_slot_table()[qbkt->slot] = nullptr;
         qbkt->detach();
         ::rocket::destroy(&(qbkt->key));
         ::rocket::destroy(&(qbkt->ref));
@@ -106,14 +129,41 @@ do_erase_range(uint32_t tpos, uint32_t tn) noexcept
         // Relocate the value into the new bucket.
         bcopy(qrel->key, r.key);
         bcopy(qrel->ref, r.ref);
+        qrel->ordinal = r.ordinal;
+        qrel->slot = r.slot;
+        if(qrel->slot != UINT32_MAX)
+          this->do_slot_table()[qrel->slot] = qrel;
         qrel->attach(*eptr);
         return false;
       });
   }
 
+void
+Reference_Dictionary::
+do_bind_slot(Bucket* qbkt, uint32_t slot) noexcept
+  {
+    if(qbkt->slot == slot)
+      return;
+
+    // Unbind the old slot of this element, if any.
+    auto slots = this->do_slot_table();
+    if(qbkt->slot != UINT32_MAX)
+      slots[qbkt->slot] = nullptr;
+    qbkt->slot = UINT32_MAX;
+
+    if(slot >= this->m_nbkt)
+      return;
+
+    // Steal the slot from another element, if any.
+    if(slots[slot])
+      slots[slot]->slot = UINT32_MAX;
+    slots[slot] = qbkt;
+    qbkt->slot = slot;
+  }
+
 Reference&
 Reference_Dictionary::
-insert(phsh_stringR key, bool* newly_opt)
+insert(phsh_stringR key, bool* newly_opt, uint32_t slot)
   {
     if(this->m_size >= this->m_nbkt / 2)
       this->do_reallocate(this->m_size * 3 | 17);
@@ -126,15 +176,19 @@ insert(phsh_stringR key, bool* newly_opt)
     if(newly_opt)
       *newly_opt = !*qbkt;
 
-    if(*qbkt)
-      return qbkt->ref;
+    if(!*qbkt) {
+      // Construct a new element.
+      auto eptr = this->m_bptr + this->m_nbkt;
+      ::rocket::construct(&(qbkt->key), key);
+      ::rocket::construct(&(qbkt->ref));
+      qbkt->ordinal = this->m_size;
+      qbkt->slot = UINT32_MAX;
+      qbkt->attach(*eptr);
+      this->m_size ++;
+    }
 
-    // Construct a new element.
-    auto eptr = this->m_bptr + this->m_nbkt;
-    ::rocket::construct(&(qbkt->key), key);
-    ::rocket::construct(&(qbkt->ref));
-    qbkt->attach(*eptr);
-    this->m_size ++;
+    if(slot != UINT32_MAX)
+      this->do_bind_slot(qbkt, slot);
     return qbkt->ref;
   }
 
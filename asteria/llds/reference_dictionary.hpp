@@ -53,7 +53,14 @@ class Reference_Dictionary
     void
     do_erase_range(uint32_t tpos, uint32_t tn) noexcept;
 
-    Reference*
+    Bucket**
+    do_slot_table() const noexcept
+      {
+        // The slot table follows the end bucket, in the same block.
+        return reinterpret_cast<Bucket**>(this->m_bptr + this->m_nbkt + 1);
+      }
+
+    Bucket*
     do_xfind_opt(phsh_stringR key) const noexcept
       {
         if(this->m_nbkt == 0)
@@ -66,9 +73,23 @@ class Reference_Dictionary
 
         // The load factor is kept <= 0.5 so a bucket is always returned. If
         // probing has stopped on an empty bucket, then there is no match.
-        return *qbkt ? &(qbkt->ref) : nullptr;
+        return *qbkt ? qbkt : nullptr;
       }
 
+    Bucket*
+    do_xfind_slot_opt(uint32_t slot) const noexcept
+      {
+        // The slot table has as many entries as buckets. Slots beyond that
+        // are never bound, so lookups fall back to names.
+        if(slot >= this->m_nbkt)
+          return nullptr;
+
+        return this->do_slot_table()[slot];
+      }
+
+    void
+    do_bind_slot(Bucket* qbkt, uint32_t slot) noexcept;
+
   public:
     ~Reference_Dictionary()
       {
@@ -93,17 +114,57 @@ class Reference_Dictionary
     const Reference*
     find_opt(phsh_stringR key) const noexcept
       {
-        return this->do_xfind_opt(key);
+        auto qbkt = this->do_xfind_opt(key);
+        return qbkt ? &(qbkt->ref) : nullptr;
       }
 
     Reference*
     mut_find_opt(phsh_stringR key) noexcept
       {
-        return this->do_xfind_opt(key);
+        auto qbkt = this->do_xfind_opt(key);
+        return qbkt ? &(qbkt->ref) : nullptr;
+      }
+
+    // Slots are indices assigned to names by the compiler, so a local name can
+    // be located without hashing. A slot is bound to an element when it is
+    // inserted with a slot, or when it is found by name with `bind_slot_opt()`.
+    const Reference*
+    find_slot_opt(uint32_t slot) const noexcept
+      {
+        auto qbkt = this->do_xfind_slot_opt(slot);
+        return qbkt ? &(qbkt->ref) : nullptr;
+      }
+
+    Reference*
+    mut_find_slot_opt(uint32_t slot) noexcept
+      {
+        auto qbkt = this->do_xfind_slot_opt(slot);
+        return qbkt ? &(qbkt->ref) : nullptr;
+      }
+
+    Reference*
+    bind_slot_opt(phsh_stringR key, uint32_t slot) noexcept
+      {
+        auto qbkt = this->do_xfind_opt(key);
+        if(!qbkt)
+          return nullptr;
+
+        this->do_bind_slot(qbkt, slot);
+        return &(qbkt->ref);
+      }
+
+    // Gets the number of elements that had been inserted before `key`, which
+    // the compiler uses as its slot. If `key` is not found, `UINT32_MAX` is
+    // returned.
+    uint32_t
+    find_ordinal(phsh_stringR key) const noexcept
+      {
+        auto qbkt = this->do_xfind_opt(key);
+        return qbkt ? qbkt->ordinal : UINT32_MAX;
       }
 
     Reference&
-    insert(phsh_stringR key, bool* newly_opt);
+    insert(phsh_stringR key, bool* newly_opt, uint32_t slot = UINT32_MAX);
 
     bool
     erase(phsh_stringR key, Reference* refp_opt) noexcept;
@@ -61,7 +61,7 @@ clear_red_zone() noexcept
 
 void
 Reference_Stack::
-collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
   {
     for(uint32_t k = 0;  k != this->m_einit;  ++ k)
       this->m_bptr[k].collect_variables(staged, temp);
@@ -126,7 +126,7 @@ class Reference_Stack
       }
 
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const;
   };
 
 inline
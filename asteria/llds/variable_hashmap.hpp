@@ -85,6 +85,21 @@ class Variable_HashMap
 
     bool
     extract_variable(refcnt_ptr<Variable>& var) noexcept;
+
+    // Calls `func(var)` for each non-null variable. `func` shall not modify
+    // this map.
+    template<typename xFunc>
+    void
+    for_each_variable(xFunc&& func) const
+      {
+        if(this->m_size == 0)
+          return;
+
+        auto eptr = this->m_bptr + this->m_nbkt;
+        for(auto qbkt = eptr->next;  qbkt != eptr;  qbkt = qbkt->next)
+          if(qbkt->var_opt)
+            func(qbkt->var_opt);
+      }
   };
 
 inline
@@ -3,6 +3,8 @@
 
 #include "../precompiled.ipp"
 #include "fwd.hpp"
+#include "../simple_script.hpp"
+#include "../runtime/sampling_profiler.hpp"
 #include "../utils.hpp"
 #include "../../rocket/tinybuf_file.hpp"
 namespace asteria {
@@ -216,6 +218,86 @@ struct Handler_heredoc final
       }
   };
 
+struct Handler_profile final
+  :
+    Handler
+  {
+    const char*
+    cmd() const final
+      { return "profile";  }
+
+    const char*
+    oneline() const final
+      { return "start or stop the sampling profiler";  }
+
+    const char*
+    help() const final
+      { return
+//       1         2         3         4         5         6         7      |
+// 4567890123456789012345678901234567890123456789012345678901234567890123456|
+"""""""""""""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
+  profile start [INTERVAL]
+  profile stop [PATH]
+
+  Start or stop the sampling profiler. INTERVAL is the number of
+  microseconds of CPU time between samples, which is 1000 by default.
+  Samples are accumulated across snippets until the profiler is stopped,
+  when they are written to PATH in the folded-stack format, which can be
+  consumed by flame graph tools. If PATH is absent, samples are printed.
+)'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""""""""""+3;
+// 4567890123456789012345678901234567890123456789012345678901234567890123456|
+//       1         2         3         4         5         6         7      |
+      }
+
+    void
+    handle(cow_vector<cow_string>&& args) final
+      {
+        auto& prof = repl_script.global().sampling_profiler();
+
+        if((args.size() >= 1) && (args[0] == "start")) {
+          uint32_t interval = 1000;
+          if(args.size() > 1) {
+            ::rocket::ascii_numget numg;
+            uint64_t temp;
+            if(numg.parse_U(args[1].data(), args[1].size()) != args[1].size())
+              return repl_printf("! invalid interval: %s", args[1].c_str());
+
+            numg.cast_U(temp, 1, UINT32_MAX);
+            if(numg.overflowed())
+              return repl_printf("! interval out of range: %s", args[1].c_str());
+
+            interval = (uint32_t) temp;
+          }
+
+          prof.clear();
+          prof.start(interval);
+          return repl_printf("* profiling with an interval of %u microseconds", interval);
+        }
+
+        if((args.size() >= 1) && (args[0] == "stop")) {
+          if(!prof.active())
+            return repl_printf("! profiler not running");
+
+          prof.stop();
+          if(args.size() > 1) {
+            prof.write_folded_file(args[1].safe_c_str());
+            repl_printf("* %llu samples written to '%s'",
+                        (unsigned long long) prof.count_samples(), args[1].c_str());
+          }
+          else {
+            ::rocket::tinyfmt_str fmt;
+            prof.print_folded(fmt);
+            repl_printf("%s* %llu samples", fmt.c_str(),
+                        (unsigned long long) prof.count_samples());
+          }
+          prof.clear();
+          return;
+        }
+
+        repl_printf("! please specify either `start` or `stop`");
+      }
+  };
+
 struct Handler_source final
   :
     Handler
@@ -380,6 +462,7 @@ prepare_repl_commands()
     do_add_handler<Handler_exit>();
     do_add_handler<Handler_help>();
     do_add_handler<Handler_heredoc>();
+    do_add_handler<Handler_profile>();
     do_add_handler<Handler_source>();
   }
 
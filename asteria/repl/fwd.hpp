@@ -27,6 +27,7 @@ constexpr int repl_history_size = 1000;
 // These are global variables defined in 'globals.cpp'.
 extern bool repl_verbose;
 extern bool repl_interactive;
+extern bool repl_precompile;
 extern Simple_Script repl_script;
 extern atomic_relaxed<int> repl_signal;
 
@@ -35,6 +36,7 @@ extern cow_string repl_source;  // snippet text
 extern cow_string repl_file;  // name of snippet
 extern cow_vector<Value> repl_args;  // script arguments
 extern cow_string repl_heredoc;  // heredoc terminator
+extern cow_string repl_profile;  // file for profiler samples
 
 extern cow_string repl_last_source;
 extern cow_string repl_last_file;
@@ -97,6 +97,7 @@ struct Verbose_Hooks final
 
 bool repl_verbose;
 bool repl_interactive;
+bool repl_precompile;
 Simple_Script repl_script;
 atomic_relaxed<int> repl_signal;
 
@@ -105,6 +106,7 @@ cow_string repl_source;  // snippet text
 cow_string repl_file;  // name of snippet
 cow_vector<Value> repl_args;  // script arguments
 cow_string repl_heredoc;  // heredoc terminator
+cow_string repl_profile;  // file for profiler samples
 
 cow_string repl_last_source;
 cow_string repl_last_file;
@@ -18,12 +18,13 @@ do_print_help_and_exit(const char* self)
 //       1         2         3         4         5         6         7      |
 // 4567890123456789012345678901234567890123456789012345678901234567890123456|
 """""""""""""""""""""""""""""""""""""""""""""""""""""""""" R"'''''''''''''''(
-Usage: %s [OPTIONS] [[--] FILE [ARGUMENTS]...]
+Usage: %s [--precompile] [OPTIONS] [[--] FILE [ARGUMENTS]...]
 
   -h      show help message then exit
   -I      suppress interactive mode [default = auto]
   -i      force interactive mode [default = auto]
   -O[n]   set optimization level to `n` [default = 2]
+  -p FILE write folded call stacks of sampled execution to FILE
   -V      show version information then exit
   -v      enable verbose mode
 
@@ -46,6 +47,16 @@ In verbose mode, execution details are printed to standard error. It also
 prevents quick termination, which enables some tools such as valgrind to
 discover memory leaks upon exit.
 
+If `-p` is given in non-interactive mode, the script is profiled by a
+sampling profiler. Samples are written to FILE in the folded-stack format,
+which can be consumed by flame graph tools. In interactive mode, use the
+`profile` command instead.
+
+If `--precompile` is given, FILE is compiled and its code is written to
+`FILE.air` without being executed. When FILE is executed later, and that
+file matches both FILE and compiler options, code is loaded from it, and
+FILE is not parsed again.
+
 Visit the homepage at <%s>.
 Report bugs to <%s>.
 )'''''''''''''''" """"""""""""""""""""""""""""""""""""""""""""""""""""""""+1,
@@ -85,11 +96,12 @@ do_parse_command_line(int argc, char** argv)
   {
     bool help = false;
     bool version = false;
+    bool precompile = false;
 
     opt<bool> verbose, interactive;
     opt<int> optimize;
 
-    opt<cow_string> path;
+    opt<cow_string> path, profile;
     cow_vector<Value> args;
 
     // Check for some common options before calling `getopt()`.
@@ -99,11 +111,16 @@ do_parse_command_line(int argc, char** argv)
 
       if(::strcmp(argv[1], "--version") == 0)
         do_print_version_and_exit();
+
+      if(::strcmp(argv[1], "--precompile") == 0) {
+        precompile = true;
+        optind = 2;
+      }
     }
 
     // Parse command-line options.
     int ch;
-    while((ch = ::getopt(argc, argv, "+hIiO::Vv")) != -1) {
+    while((ch = ::getopt(argc, argv, "+hIiO::p:Vv")) != -1) {
       // Identify a single option.
       switch(ch) {
         case 'h':
@@ -126,6 +143,10 @@ do_parse_command_line(int argc, char** argv)
             optimize = optarg[0] - '0';
           continue;
 
+        case 'p':
+          profile = V_string(optarg);
+          continue;
+
         case 'V':
           version = true;
           continue;
@@ -161,9 +182,17 @@ do_parse_command_line(int argc, char** argv)
     if(verbose)
       repl_verbose = *verbose;
 
+    // Precompiled code can only be written for a file.
+    if(precompile && (!path || (*path == "-")))
+      exit_printf(exit_invalid_argument, "%s: `--precompile` requires a FILE.", argv[0]);
+
+    repl_precompile = precompile;
+
     // Interactive mode is enabled when no FILE is given (not even `-`) and
     // standard input is connected to a terminal.
-    if(interactive)
+    if(precompile)
+      repl_interactive = false;
+    else if(interactive)
       repl_interactive = *interactive;
     else
       repl_interactive = !path && ::isatty(STDIN_FILENO);
@@ -175,6 +204,10 @@ do_parse_command_line(int argc, char** argv)
     if(optimize)
       repl_script.mut_options().optimization_level = uint8_t(*optimize);
 
+    // Profiling is enabled when a file is given for samples.
+    if(profile)
+      repl_profile = ::std::move(*profile);
+
     // These arguments are always overwritten.
     repl_file = path.move_value_or(sref("-"));
     repl_args = ::std::move(args);
@@ -6,25 +6,66 @@
 #include "../simple_script.hpp"
 #include "../value.hpp"
 namespace asteria {
+namespace {
+
+void
+do_write_profile() noexcept
+  {
+    if(repl_profile.empty())
+      return;
+
+    try {
+      repl_script.stop_profiling();
+      repl_script.write_profile(repl_profile.c_str());
+    }
+    catch(exception& stdex) {
+      repl_printf("! could not write profile: %s", stdex.what());
+    }
+  }
+
+}  // namespace
 
 void
 load_and_execute_single_noreturn()
   {
-    // Load and parse the script.
+    // Load and parse the script. If a file is given, its precompiled code is
+    // preferred.
     try {
+      cow_string cache_path = repl_file + ".air";
       if(repl_file == "-")
         repl_script.reload_stdin();
-      else
-        repl_script.reload_file(repl_file.c_str());
+      else if(repl_precompile)
+        repl_script.precompile_file(repl_file.c_str(), cache_path.c_str());
+      else if(repl_script.reload_file_cached(repl_file.c_str(), cache_path.c_str())
+              && repl_verbose)
+        repl_printf("* loaded precompiled code from '%s'", cache_path.c_str());
     }
     catch(exception& stdex) {
       // Print the error and exit.
       exit_printf(exit_compiler_error, "! exception: %s", stdex.what());
     }
 
+    // In precompile mode, the script is not executed.
+    if(repl_precompile)
+      quick_exit();
+
     // Execute the script, passing all command-line arguments to it. If the
-    // script exits without returning a value, success is assumed.
-    auto ref = repl_script.execute(::std::move(repl_args));
+    // script exits without returning a value, success is assumed. If
+    // profiling is requested, samples are written even if the script throws
+    // an exception.
+    Reference ref;
+    try {
+      if(!repl_profile.empty())
+        repl_script.start_profiling();
+
+      ref = repl_script.execute(::std::move(repl_args));
+    }
+    catch(...) {
+      do_write_profile();
+      throw;
+    }
+    do_write_profile();
+
     if(ref.is_void())
       quick_exit();
 
@@ -50,6 +50,12 @@ class Abstract_Context
         return hint_opt ? *hint_opt : this->m_named_refs.insert(name, nullptr);
       }
 
+    Reference&
+    do_mut_named_reference(phsh_stringR name, uint32_t slot) const
+      {
+        return this->m_named_refs.insert(name, nullptr, slot);
+      }
+
     void
     do_clear_named_references() noexcept
       {
@@ -79,11 +85,37 @@ class Abstract_Context
         return qref;
       }
 
+    // This is the fast path for local references, whose slots have been
+    // assigned by the compiler. The slot is bound to the name when it is
+    // declared in, or looked up for the first time from, this context.
+    const Reference*
+    get_named_reference_opt(phsh_stringR name, uint32_t slot) const
+      {
+        auto qref = this->m_named_refs.find_slot_opt(slot);
+        if(ROCKET_EXPECT(qref))
+          return qref;
+
+        qref = this->m_named_refs.bind_slot_opt(name, slot);
+        if(!qref && name.rdstr().starts_with("__")
+           && this->do_create_lazy_reference_opt(nullptr, name))
+          qref = this->m_named_refs.bind_slot_opt(name, slot);
+        return qref;
+      }
+
+    // Gets the slot of a name at compile time. Slots are allocated in the
+    // order in which names are declared in an analytic context. If the name
+    // is not found, `UINT32_MAX` is returned.
+    uint32_t
+    get_named_slot(phsh_stringR name) const noexcept
+      {
+        return this->m_named_refs.find_ordinal(name);
+      }
+
     Reference&
-    insert_named_reference(phsh_stringR name)
+    insert_named_reference(phsh_stringR name, uint32_t slot = UINT32_MAX)
       {
         bool newly = false;
-        auto& ref = this->m_named_refs.insert(name, &newly);
+        auto& ref = this->m_named_refs.insert(name, &newly, slot);
         if(newly && name.rdstr().starts_with("__")) {
           // If a built-in reference has been inserted, it may have a default
           // value, so initialize it. DO NOT CALL THIS FUNCTION INSIDE
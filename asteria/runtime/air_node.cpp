@@ -14,6 +14,7 @@
 #include "variable.hpp"
 #include "ptc_arguments.hpp"
 #include "module_loader.hpp"
+#include "sampling_profiler.hpp"
 #include "air_optimizer.hpp"
 #include "../compiler/token_stream.hpp"
 #include "../compiler/statement_sequence.hpp"
@@ -50,7 +51,7 @@ do_return_rebound_opt(bool dirty, NodeT&& bound)
   }
 
 void
-do_collect_variables_for_each(Variable_HashMap& staged, Variable_HashMap& temp,
+do_collect_variables_for_each(Variable_HashMap& staged, Variable_Worklist& temp,
                               const cow_vector<AIR_Node>& code)
   {
     for(size_t i = 0;  i < code.size();  ++i)
@@ -61,8 +62,7 @@ void
 do_solidify_nodes(AVM_Rod& rod, const cow_vector<AIR_Node>& code)
   {
     rod.clear();
-    for(size_t i = 0;  i < code.size();  ++i)
-      code.at(i).solidify(rod);
+    AIR_Node::solidify_sequence(rod, code);
     rod.finalize();
   }
 
@@ -74,6 +74,29 @@ do_push_modifier_and_check(Reference& ref, XModT&& xmod)
     ref.dereference_readonly();
   }
 
+const Reference&
+do_get_local_reference(const Executive_Context& ctx, uint32_t depth, const phsh_string& name,
+                       uint32_t slot)
+  {
+    // Locate the target context.
+    const Executive_Context* qctx = &ctx;
+    for(uint32_t k = 0;  k != depth;  ++k)
+      qctx = qctx->get_parent_opt();
+
+    // Look for the name in the target context. This is usually an indexed load
+    // from the slot table.
+    auto qref = qctx->get_named_reference_opt(name, slot);
+    if(!qref)
+      throw Runtime_Error(Runtime_Error::M_format(),
+               "Undeclared identifier `$1`", name);
+
+    if(qref->is_invalid())
+      throw Runtime_Error(Runtime_Error::M_format(),
+               "Initialization of variable or reference `$1` bypassed", name);
+
+    return *qref;
+  }
+
 using Uparam  = AVM_Rod::Uparam;
 using Header  = AVM_Rod::Header;
 
@@ -775,851 +798,2977 @@ do_apply_binary_operator_with_integer(uint8_t uxop, Value& lhs, V_integer irhs)
     }
   }
 
-}  // namespace
-
-opt<Value>
-AIR_Node::
-get_constant_opt() const noexcept
-  {
-    switch(this->m_stor.index()) {
-      case index_push_bound_reference:
-        try {
-          const auto& altr = this->m_stor.as<S_push_bound_reference>();
-          if(altr.ref.is_temporary())
-            return altr.ref.dereference_readonly();
-        }
-        catch(...) { }
-        return nullopt;
-
-      case index_push_constant:
-        return this->m_stor.as<S_push_constant>().val;
-
-      default:
-        return nullopt;
-    }
-  }
-
-bool
-AIR_Node::
-is_terminator() const noexcept
+ROCKET_FLATTEN ROCKET_NEVER_INLINE
+AIR_Status
+do_apply_binary_operator(uint8_t uxop, Value& lhs, const Value& rhs)
   {
-    switch(static_cast<Index>(this->m_stor.index())) {
-      case index_clear_stack:
-      case index_declare_variable:
-      case index_initialize_variable:
-      case index_switch_statement:
-      case index_do_while_statement:
-      case index_while_statement:
-      case index_for_each_statement:
-      case index_for_statement:
-      case index_try_statement:
-      case index_assert_statement:
-      case index_check_argument:
-      case index_push_global_reference:
-      case index_push_local_reference:
-      case index_push_bound_reference:
-      case index_define_function:
-      case index_push_unnamed_array:
-      case index_push_unnamed_object:
-      case index_apply_operator:
-      case index_unpack_struct_array:
-      case index_unpack_struct_object:
-      case index_define_null_variable:
-      case index_single_step_trap:
-      case index_defer_expression:
-      case index_import_call:
-      case index_declare_reference:
-      case index_initialize_reference:
-      case index_catch_expression:
-      case index_push_constant:
-      case index_alt_clear_stack:
-      case index_coalesce_expression:
-      case index_member_access:
-      case index_apply_operator_bi32:
-        return false;
-
-      case index_throw_statement:
-      case index_return_statement:
-        return true;
+    switch(uxop) {
+      case xop_cmp_eq: {
+        // Check whether the two operands are equal. Unordered values are
+        // considered to be unequal.
+        lhs = lhs.compare_partial(rhs) == compare_equal;
+        return air_status_next;
+      }
 
-      case index_simple_status:
-        return this->m_stor.as<S_simple_status>().status != air_status_next;
+      case xop_cmp_ne: {
+        // Check whether the two operands are not equal. Unordered values are
+        // considered to be unequal.
+        lhs = lhs.compare_partial(rhs) != compare_equal;
+        return air_status_next;
+      }
 
-      case index_function_call:
-        return this->m_stor.as<S_function_call>().ptc != ptc_aware_none;
+      case xop_cmp_un: {
+        // Check whether the two operands are unordered.
+        lhs = lhs.compare_partial(rhs) == compare_unordered;
+        return air_status_next;
+      }
 
-      case index_variadic_call:
-        return this->m_stor.as<S_variadic_call>().ptc != ptc_aware_none;
+      case xop_cmp_lt: {
+        // Check whether the LHS operand is less than the RHS operand. If
+        // they are unordered, an exception shall be thrown.
+        lhs = lhs.compare_total(rhs) == compare_less;
+        return air_status_next;
+      }
 
-      case index_alt_function_call:
-        return this->m_stor.as<S_alt_function_call>().ptc != ptc_aware_none;
+      case xop_cmp_gt: {
+        // Check whether the LHS operand is greater than the RHS operand. If
+        // they are unordered, an exception shall be thrown.
+        lhs = lhs.compare_total(rhs) == compare_greater;
+        return air_status_next;
+      }
 
-      case index_execute_block: {
-        const auto& altr = this->m_stor.as<S_execute_block>();
-        return !altr.code_body.empty() && altr.code_body.back().is_terminator();
+      case xop_cmp_lte: {
+        // Check whether the LHS operand is less than or equal to the RHS
+        // operand. If they are unordered, an exception shall be thrown.
+        lhs = lhs.compare_total(rhs) != compare_greater;
+        return air_status_next;
       }
 
-      case index_if_statement: {
-        const auto& altr = this->m_stor.as<S_if_statement>();
-        return !altr.code_true.empty() && altr.code_true.back().is_terminator()
-               && !altr.code_false.empty() && altr.code_false.back().is_terminator();
+      case xop_cmp_gte: {
+        // Check whether the LHS operand is greater than or equal to the RHS
+        // operand. If they are unordered, an exception shall be thrown.
+        lhs = lhs.compare_total(rhs) != compare_less;
+        return air_status_next;
       }
 
-      case index_branch_expression: {
-        const auto& altr = this->m_stor.as<S_branch_expression>();
-        return !altr.code_true.empty() && altr.code_true.back().is_terminator()
-               && !altr.code_false.empty() && altr.code_false.back().is_terminator();
+      case xop_cmp_3way: {
+        // Defines a partial ordering on all values. For unordered operands,
+        // a string is returned, so `x <=> y` and `(x <=> y) <=> 0` produces
+        // the same result.
+        do_set_compare_result(lhs, lhs.compare_partial(rhs));
+        return air_status_next;
       }
 
-      default:
-        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
-    }
-  }
+      case xop_add: {
+        // Perform logical OR on two boolean values, or get the sum of two
+        // arithmetic values, or concatenate two strings.
+        if(lhs.is_real() && rhs.is_real()) {
+          V_real& val = lhs.mut_real();
+          V_real other = rhs.as_real();
 
-opt<AIR_Node>
-AIR_Node::
-rebind_opt(Abstract_Context& ctx) const
-  {
-    switch(static_cast<Index>(this->m_stor.index())) {
-      case index_clear_stack:
-      case index_declare_variable:
-      case index_initialize_variable:
-      case index_throw_statement:
-      case index_assert_statement:
-      case index_simple_status:
-      case index_check_argument:
-      case index_push_global_reference:
-      case index_push_bound_reference:
-      case index_function_call:
-      case index_push_unnamed_array:
-      case index_push_unnamed_object:
-      case index_apply_operator:
-      case index_unpack_struct_array:
-      case index_unpack_struct_object:
-      case index_define_null_variable:
-      case index_single_step_trap:
-      case index_variadic_call:
-      case index_import_call:
-      case index_declare_reference:
-      case index_initialize_reference:
-      case index_return_statement:
-      case index_push_constant:
-      case index_alt_clear_stack:
-      case index_alt_function_call:
-      case index_member_access:
-      case index_apply_operator_bi32:
-        return nullopt;
+          val += other;
+          return air_status_next;
+        }
 
-      case index_execute_block: {
-        const auto& altr = this->m_stor.as<S_execute_block>();
+        if(lhs.is_string() && rhs.is_string()) {
+          V_string& val = lhs.mut_string();
+          const V_string& other = rhs.as_string();
 
-        // Rebind the body in a nested scope.
-        bool dirty = false;
-        S_execute_block bound = altr;
+          val.append(other);
+          return air_status_next;
+        }
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+        if(lhs.is_boolean() && rhs.is_boolean()) {
+          V_boolean& val = lhs.mut_boolean();
+          V_boolean other = rhs.as_boolean();
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+          val |= other;
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Addition not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_if_statement: {
-        const auto& altr = this->m_stor.as<S_if_statement>();
+      case xop_sub: {
+        // Perform logical XOR on two boolean values, or get the difference
+        // of two arithmetic values.
+        if(lhs.is_real() && rhs.is_real()) {
+          V_real& val = lhs.mut_real();
+          V_real other = rhs.as_real();
 
-        // Rebind both branches in a nested scope.
-        bool dirty = false;
-        S_if_statement bound = altr;
+          // Overflow will result in an infinity, so this is safe.
+          val -= other;
+          return air_status_next;
+        }
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
-        do_rebind_nodes(dirty, bound.code_true, ctx_body);
-        do_rebind_nodes(dirty, bound.code_false, ctx_body);
+        if(lhs.is_boolean() && rhs.is_boolean()) {
+          V_boolean& val = lhs.mut_boolean();
+          V_boolean other = rhs.as_boolean();
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+          // Perform logical XOR of the operands.
+          val ^= other;
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Subtraction not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_switch_statement: {
-        const auto& altr = this->m_stor.as<S_switch_statement>();
+      case xop_mul: {
+         // Perform logical AND on two boolean values, or get the product of
+         // two arithmetic values, or duplicate a string or array by a given
+         // times.
+        if(lhs.is_real() && rhs.is_real()) {
+          V_real& val = lhs.mut_real();
+          V_real other = rhs.as_real();
 
-        // Rebind all labels and clauses.
-        bool dirty = false;
-        S_switch_statement bound = altr;
+          val *= other;
+          return air_status_next;
+        }
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
-        for(size_t k = 0;  k < bound.clauses.size();  ++k) {
-          // Labels are to be evaluated in the same scope as the condition
-          // expression, and are not parts of the body.
-          for(size_t i = 0;  i < bound.clauses.at(k).code_label.size();  ++i)
-            if(auto qnode = bound.clauses.at(k).code_label.at(i).rebind_opt(ctx))
-              do_set_rebound(dirty, bound.clauses.mut(k).code_label.mut(i), ::std::move(*qnode));
+        if(lhs.is_integer() && rhs.is_string()) {
+          V_integer count = lhs.as_integer();
+          lhs = rhs.as_string();
+          V_string& val = lhs.mut_string();
 
-          for(size_t i = 0;  i < bound.clauses.at(k).code_body.size();  ++i)
-            if(auto qnode = bound.clauses.at(k).code_body.at(i).rebind_opt(ctx_body))
-              do_set_rebound(dirty, bound.clauses.mut(k).code_body.mut(i), ::std::move(*qnode));
+          do_duplicate_sequence(val, count);
+          return air_status_next;
         }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
-      }
+        if(lhs.is_integer() && rhs.is_array()) {
+          V_integer count = lhs.as_integer();
+          lhs = rhs.as_array();
+          V_array& val = lhs.mut_array();
 
-      case index_do_while_statement: {
-        const auto& altr = this->m_stor.as<S_do_while_statement>();
+          do_duplicate_sequence(val, count);
+          return air_status_next;
+        }
 
-        // Rebind the body and the condition expression.
-        // The condition expression is not a part of the body.
-        bool dirty = false;
-        S_do_while_statement bound = altr;
+        if(lhs.is_boolean() && rhs.is_boolean()) {
+          V_boolean& val = lhs.mut_boolean();
+          V_boolean other = rhs.as_boolean();
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
-
-        do_rebind_nodes(dirty, bound.code_cond, ctx);
+          val &= other;
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Multiplication not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_while_statement: {
-        const auto& altr = this->m_stor.as<S_while_statement>();
+      case xop_div: {
+        // Get the quotient of two arithmetic values. If both operands are
+        // integers, the result is also an integer, truncated towards zero.
+        if(lhs.is_real() && rhs.is_real()) {
+          V_real& val = lhs.mut_real();
+          V_real other = rhs.as_real();
 
-        // Rebind the condition expression and the body.
-        // The condition expression is not a part of the body.
-        bool dirty = false;
-        S_while_statement bound = altr;
+          val /= other;
+          return air_status_next;
+        }
 
-        do_rebind_nodes(dirty, bound.code_cond, ctx);
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Division not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
+      }
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+      case xop_mod: {
+        // Get the remainder of two arithmetic values. The quotient is
+        // truncated towards zero. If both operands are integers, the result
+        // is also an integer.
+        if(lhs.is_real() && rhs.is_real()) {
+          V_real& val = lhs.mut_real();
+          V_real other = rhs.as_real();
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+          val = ::std::fmod(val, other);
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Modulo not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_for_each_statement: {
-        const auto& altr = this->m_stor.as<S_for_each_statement>();
+      case xop_andb: {
+        // Perform the bitwise AND operation on all bits of the operands. If
+        // the two operands have different lengths, the result is truncated
+        // to the same length as the shorter one.
+        if(lhs.is_string() && rhs.is_string()) {
+          V_string& val = lhs.mut_string();
+          const V_string& mask = rhs.as_string();
 
-        // Rebind the range initializer and the body.
-        // The range key and mapped references are declared in a dedicated scope
-        // where the initializer is to be evaluated. The body is to be executed
-        // in an inner scope, created and destroyed for each iteration.
-        bool dirty = false;
-        S_for_each_statement bound = altr;
+          if(val.size() > mask.size())
+            val.erase(mask.size());
+          auto maskp = mask.begin();
+          for(auto it = val.mut_begin();  it != val.end();  ++it, ++maskp)
+            *it = static_cast<char>(*it & *maskp);
+          return air_status_next;
+        }
 
-        Analytic_Context ctx_for(Analytic_Context::M_plain(), ctx);
-        if(!altr.name_key.empty())
-          ctx_for.insert_named_reference(altr.name_key);
-        ctx_for.insert_named_reference(altr.name_mapped);
-        do_rebind_nodes(dirty, bound.code_init, ctx_for);
+        if(lhs.is_boolean() && rhs.is_boolean()) {
+          V_boolean& val = lhs.mut_boolean();
+          V_boolean other = rhs.as_boolean();
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx_for);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+          val &= other;
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Bitwise AND not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_for_statement: {
-        const auto& altr = this->m_stor.as<S_for_statement>();
+      case xop_orb: {
+        // Perform the bitwise OR operation on all bits of the operands. If
+        // the two operands have different lengths, the result is padded to
+        // the same length as the longer one, with zeroes.
+        if(lhs.is_string() && rhs.is_string()) {
+          V_string& val = lhs.mut_string();
+          const V_string& mask = rhs.as_string();
 
-        // Rebind the initializer, condition expression and step expression. All
-        // these are declared in a dedicated scope where the initializer is to be
-        // evaluated. The body is to be executed in an inner scope, created and
-        // destroyed for each iteration.
-        bool dirty = false;
-        S_for_statement bound = altr;
+          if(val.size() < mask.size())
+            val.append(mask.size() - val.size(), 0);
+          auto valp = val.mut_begin();
+          for(auto it = mask.begin();  it != mask.end();  ++it, ++valp)
+            *valp = static_cast<char>(*valp | *it);
+          return air_status_next;
+        }
 
-        Analytic_Context ctx_for(Analytic_Context::M_plain(), ctx);
-        do_rebind_nodes(dirty, bound.code_init, ctx_for);
-        do_rebind_nodes(dirty, bound.code_cond, ctx_for);
-        do_rebind_nodes(dirty, bound.code_step, ctx_for);
+        if(lhs.is_boolean() && rhs.is_boolean()) {
+          V_boolean& val = lhs.mut_boolean();
+          V_boolean other = rhs.as_boolean();
 
-        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx_for);
-        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+          val |= other;
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Bitwise OR not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_try_statement: {
-        const auto& altr = this->m_stor.as<S_try_statement>();
+      case xop_xorb: {
+        // Perform the bitwise XOR operation on all bits of the operands. If
+        // the two operands have different lengths, the result is padded to
+        // the same length as the longer one, with zeroes.
+        if(lhs.is_string() && rhs.is_string()) {
+          V_string& val = lhs.mut_string();
+          const V_string& mask = rhs.as_string();
 
-        // Rebind the `try` and `catch` clauses.
-        bool dirty = false;
-        S_try_statement bound = altr;
+          if(val.size() < mask.size())
+            val.append(mask.size() - val.size(), 0);
+          auto valp = val.mut_begin();
+          for(auto it = mask.begin();  it != mask.end();  ++it, ++valp)
+            *valp = static_cast<char>(*valp ^ *it);
+          return air_status_next;
+        }
 
-        Analytic_Context ctx_try(Analytic_Context::M_plain(), ctx);
-        do_rebind_nodes(dirty, bound.code_try, ctx_try);
+        if(lhs.is_boolean() && rhs.is_boolean()) {
+          V_boolean& val = lhs.mut_boolean();
+          V_boolean other = rhs.as_boolean();
 
-        Analytic_Context ctx_catch(Analytic_Context::M_plain(), ctx);
-        ctx_catch.insert_named_reference(altr.name_except);
-        do_rebind_nodes(dirty, bound.code_catch, ctx_catch);
+          val ^= other;
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Bitwise XOR not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
       }
 
-      case index_push_local_reference: {
-        const auto& altr = this->m_stor.as<S_push_local_reference>();
+      case xop_addm:
+        // This should have been redirected to the fast path.
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Modular addition not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
 
-        // Get the context.
-        const Abstract_Context* qctx = &ctx;
-        for(uint32_t k = 0;  k != altr.depth;  ++k)
-          qctx = qctx->get_parent_opt();
+      case xop_subm:
+        // This should have been redirected to the fast path.
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Modular subtraction not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
 
-        if(qctx->is_analytic())
-          return nullopt;
+      case xop_mulm:
+        // This should have been redirected to the fast path.
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Modular multiplication not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
 
-        // Look for the name.
-        auto qref = qctx->get_named_reference_opt(altr.name);
-        if(!qref)
-          return nullopt;
-        else if(qref->is_invalid())
-          throw Runtime_Error(Runtime_Error::M_format(),
-                   "Initialization of variable or reference `$1` bypassed", altr.name);
+      case xop_adds:
+        // This should have been redirected to the fast path.
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Saturating addition not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
 
-        // Bind this reference.
-        S_push_bound_reference xnode = { *qref };
-        return ::std::move(xnode);
+      case xop_subs:
+        // This should have been redirected to the fast path.
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Saturating subtraction not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
+
+      case xop_muls:
+        // This should have been redirected to the fast path.
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Saturating multiplication not applicable (operands were `$1` and `$2`)",
+                 lhs, rhs);
+
+      default:
+        ROCKET_UNREACHABLE();
+    }
+  }
+
+ROCKET_FLATTEN ROCKET_NEVER_INLINE
+AIR_Status
+do_apply_unary_operator(uint8_t uxop, Value& rhs)
+  {
+    switch(uxop) {
+      case xop_pos: {
+        // This operator does nothing.
+        return air_status_next;
       }
 
-      case index_define_function: {
-        const auto& altr = this->m_stor.as<S_define_function>();
+      case xop_neg: {
+        // Get the additive inverse of the operand.
+        if(rhs.type() == type_integer) {
+          V_integer& val = rhs.mut_integer();
 
-        // Rebind the function body.
-        // This is the only scenario where names in the outer scope are visible
-        // to the body of a function.
-        bool dirty = false;
-        S_define_function bound = altr;
+          int64_t result;
+          if(ROCKET_SUB_OVERFLOW(0, val, &result))
+            throw Runtime_Error(Runtime_Error::M_format(),
+                     "Integer negation overflow (operand was `$1`)", val);
 
-        Analytic_Context ctx_func(Analytic_Context::M_function(), &ctx, altr.params);
-        do_rebind_nodes(dirty, bound.code_body, ctx_func);
+          val = result;
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+        if(rhs.type() == type_real) {
+          V_real& val = rhs.mut_real();
+
+          int64_t bits;
+          bcopy(bits, val);
+          bits ^= INT64_MIN;
+
+          bcopy(val, bits);
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Arithmetic negation not applicable (operand was `$1`)", rhs);
       }
 
-      case index_branch_expression: {
-        const auto& altr = this->m_stor.as<S_branch_expression>();
+      case xop_notb: {
+        // Flip all bits (of all bytes) in the operand.
+        if(rhs.type() == type_boolean) {
+          V_boolean& val = rhs.mut_boolean();
+          val = !val;
+          return air_status_next;
+        }
 
-        // Rebind both branches.
-        bool dirty = false;
-        S_branch_expression bound = altr;
+        if(rhs.type() == type_integer) {
+          V_integer& val = rhs.mut_integer();
+          val = ~val;
+          return air_status_next;
+        }
 
-        do_rebind_nodes(dirty, bound.code_true, ctx);
-        do_rebind_nodes(dirty, bound.code_false, ctx);
+        if(rhs.type() == type_string) {
+          V_string& val = rhs.mut_string();
+          for(auto it = val.mut_begin();  it != val.end();  ++it)
+            *it = static_cast<char>(*it ^ -1);
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "Bitwise NOT not applicable (operand was `$1`)", rhs);
       }
 
-      case index_defer_expression: {
-        const auto& altr = this->m_stor.as<S_defer_expression>();
+      case xop_notl: {
+        // Perform the builtin boolean conversion and negate the result.
+        rhs = !rhs.test();
+        return air_status_next;
+      }
 
-        // Rebind the expression.
-        bool dirty = false;
-        S_defer_expression bound = altr;
+      case xop_countof: {
+        // Get the number of elements in the operand.
+        if(rhs.type() == type_null) {
+          rhs = V_integer(0);
+          return air_status_next;
+        }
 
-        do_rebind_nodes(dirty, bound.code_body, ctx);
+        if(rhs.type() == type_string) {
+          rhs = V_integer(rhs.as_string().size());
+          return air_status_next;
+        }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
-      }
+        if(rhs.type() == type_array) {
+          rhs = V_integer(rhs.as_array().size());
+          return air_status_next;
+        }
 
-      case index_catch_expression: {
-        const auto& altr = this->m_stor.as<S_catch_expression>();
+        if(rhs.type() == type_object) {
+          rhs = V_integer(rhs.as_object().size());
+          return air_status_next;
+        }
 
-        // Rebind the expression.
-        bool dirty = false;
-        S_catch_expression bound = altr;
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`countof` not applicable (operand was `$1`)", rhs);
+      }
 
-        do_rebind_nodes(dirty, bound.code_body, ctx);
+      case xop_typeof: {
+        // Ge the type of the operand as a string.
+        rhs = ::rocket::sref(describe_type(rhs.type()));
+        return air_status_next;
+      }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+      case xop_sqrt: {
+        // Get the arithmetic square root of the operand, as a real number.
+        if(rhs.is_real()) {
+          rhs = ::std::sqrt(rhs.as_real());
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__sqrt` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_coalesce_expression: {
-        const auto& altr = this->m_stor.as<S_coalesce_expression>();
+      case xop_isnan: {
+        // Checks whether the operand is a NaN. The operand must be of an
+        // arithmetic type. An integer is never a NaN.
+        if(rhs.type() == type_integer) {
+          rhs = false;
+          return air_status_next;
+        }
 
-        // Rebind the null branch.
-        bool dirty = false;
-        S_coalesce_expression bound = altr;
+        if(rhs.type() == type_real) {
+          rhs = ::std::isnan(rhs.as_real());
+          return air_status_next;
+        }
 
-        do_rebind_nodes(dirty, bound.code_null, ctx);
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__isnan` not applicable (operand was `$1`)", rhs);
+      }
 
-        return do_return_rebound_opt(dirty, ::std::move(bound));
+      case xop_isinf: {
+        // Checks whether the operand is an infinity. The operand must be of
+        // an arithmetic type. An integer is never an infinity.
+        if(rhs.type() == type_integer) {
+          rhs = false;
+          return air_status_next;
+        }
+
+        if(rhs.type() == type_real) {
+          rhs = ::std::isinf(rhs.as_real());
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__isinf` not applicable (operand was `$1`)", rhs);
       }
 
-      default:
-        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
-    }
-  }
+      case xop_abs: {
+        // Get the absolute value of the operand.
+        if(rhs.type() == type_integer) {
+          V_integer& val = rhs.mut_integer();
 
-void
-AIR_Node::
-collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
-  {
-    switch(static_cast<Index>(this->m_stor.index())) {
-      case index_clear_stack:
-      case index_declare_variable:
-      case index_initialize_variable:
-      case index_throw_statement:
-      case index_assert_statement:
-      case index_simple_status:
-      case index_check_argument:
-      case index_push_global_reference:
-      case index_push_local_reference:
-      case index_function_call:
-      case index_push_unnamed_array:
-      case index_push_unnamed_object:
-      case index_apply_operator:
-      case index_unpack_struct_array:
-      case index_unpack_struct_object:
-      case index_define_null_variable:
-      case index_single_step_trap:
-      case index_variadic_call:
-      case index_import_call:
-      case index_declare_reference:
-      case index_initialize_reference:
-      case index_return_statement:
-      case index_alt_clear_stack:
-      case index_alt_function_call:
-      case index_member_access:
-      case index_apply_operator_bi32:
-        return;
+          V_integer neg_val;
+          if(ROCKET_SUB_OVERFLOW(0, val, &neg_val))
+            throw Runtime_Error(Runtime_Error::M_format(),
+                     "Integer negation overflow (operand was `$1`)", val);
 
-      case index_execute_block: {
-        const auto& altr = this->m_stor.as<S_execute_block>();
+          val ^= (val ^ neg_val) & (val >> 63);
+          return air_status_next;
+        }
 
-        // Collect variables from the body.
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        return;
-      }
+        if(rhs.type() == type_real) {
+          V_real& val = rhs.mut_real();
 
-      case index_if_statement: {
-        const auto& altr = this->m_stor.as<S_if_statement>();
+          double result = ::std::fabs(val);
 
-        // Collect variables from both branches.
-        do_collect_variables_for_each(staged, temp, altr.code_true);
-        do_collect_variables_for_each(staged, temp, altr.code_false);
-        return;
-      }
+          val = result;
+          return air_status_next;
+        }
 
-      case index_switch_statement: {
-        const auto& altr = this->m_stor.as<S_switch_statement>();
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__abs` not applicable (operand was `$1`)", rhs);
+      }
 
-        // Collect variables from all labels and clauses.
-        for(const auto& clause : altr.clauses) {
-          do_collect_variables_for_each(staged, temp, clause.code_label);
-          do_collect_variables_for_each(staged, temp, clause.code_body);
+      case xop_sign: {
+        // Get the sign bit of the operand as a boolean value.
+        if(rhs.type() == type_integer) {
+          rhs = rhs.as_integer() < 0;
+          return air_status_next;
         }
-        return;
-      }
 
-      case index_do_while_statement: {
-        const auto& altr = this->m_stor.as<S_do_while_statement>();
+        if(rhs.type() == type_real) {
+          rhs = ::std::signbit(rhs.as_real());
+          return air_status_next;
+        }
 
-        // Collect variables from the body and the condition expression.
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        do_collect_variables_for_each(staged, temp, altr.code_cond);
-        return;
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__sign` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_while_statement: {
-        const auto& altr = this->m_stor.as<S_while_statement>();
+      case xop_round: {
+        // Round the operand to the nearest integer of the same type.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the condition expression and the body.
-        do_collect_variables_for_each(staged, temp, altr.code_cond);
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        return;
+        if(rhs.type() == type_real) {
+          rhs.mut_real() = ::std::round(rhs.as_real());
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__round` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_for_each_statement: {
-        const auto& altr = this->m_stor.as<S_for_each_statement>();
+      case xop_floor: {
+        // Round the operand to the nearest integer of the same type,
+        // towards negative infinity.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the range initializer and the body.
-        do_collect_variables_for_each(staged, temp, altr.code_init);
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        return;
+        if(rhs.type() == type_real) {
+          rhs.mut_real() = ::std::floor(rhs.as_real());
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__floor` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_for_statement: {
-        const auto& altr = this->m_stor.as<S_for_statement>();
+      case xop_ceil: {
+        // Round the operand to the nearest integer of the same type,
+        // towards positive infinity.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the initializer, condition expression and
-        // step expression.
-        do_collect_variables_for_each(staged, temp, altr.code_init);
-        do_collect_variables_for_each(staged, temp, altr.code_cond);
-        do_collect_variables_for_each(staged, temp, altr.code_step);
-        return;
+        if(rhs.type() == type_real) {
+          rhs.mut_real() = ::std::ceil(rhs.as_real());
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__ceil` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_try_statement: {
-        const auto& altr = this->m_stor.as<S_try_statement>();
+      case xop_trunc: {
+        // Truncate the operand to the nearest integer towards zero.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the `try` and `catch` clauses.
-        do_collect_variables_for_each(staged, temp, altr.code_try);
-        do_collect_variables_for_each(staged, temp, altr.code_catch);
-        return;
+        if(rhs.type() == type_real) {
+          rhs.mut_real() = ::std::trunc(rhs.as_real());
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__trunc` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_push_bound_reference: {
-        const auto& altr = this->m_stor.as<S_push_bound_reference>();
+      case xop_iround: {
+        // Round the operand to the nearest integer.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the bound reference.
-        altr.ref.collect_variables(staged, temp);
-        return;
+        if(rhs.type() == type_real) {
+          rhs = safe_double_to_int64(::std::round(rhs.as_real()));
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__iround` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_define_function: {
-        const auto& altr = this->m_stor.as<S_define_function>();
+      case xop_ifloor: {
+        // Round the operand to the nearest integer towards negative infinity.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the function body.
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        return;
+        if(rhs.type() == type_real) {
+          rhs = safe_double_to_int64(::std::floor(rhs.as_real()));
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__ifloor` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_branch_expression: {
-        const auto& altr = this->m_stor.as<S_branch_expression>();
+      case xop_iceil: {
+        // Round the operand to the nearest integer towards positive infinity.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from both branches.
-        do_collect_variables_for_each(staged, temp, altr.code_true);
-        do_collect_variables_for_each(staged, temp, altr.code_false);
-        return;
+        if(rhs.type() == type_real) {
+          rhs = safe_double_to_int64(::std::ceil(rhs.as_real()));
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__iceil` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_defer_expression: {
-        const auto& altr = this->m_stor.as<S_defer_expression>();
+      case xop_itrunc: {
+        // Truncate the operand to the nearest integer towards zero.
+        if(rhs.type() == type_integer) {
+          return air_status_next;
+        }
 
-        // Collect variables from the expression.
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        return;
+        if(rhs.type() == type_real) {
+          rhs = safe_double_to_int64(::std::trunc(rhs.as_real()));
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__itrunc` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_catch_expression: {
-        const auto& altr = this->m_stor.as<S_catch_expression>();
+      case xop_lzcnt: {
+        // Get the number of leading zeroes in the operand.
+        if(rhs.type() == type_integer) {
+          V_integer& val = rhs.mut_integer();
 
-        // Collect variables from the expression.
-        do_collect_variables_for_each(staged, temp, altr.code_body);
-        return;
+          val = (int64_t) ROCKET_LZCNT64((uint64_t) val);
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__lzcnt` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_push_constant: {
-        const auto& altr = this->m_stor.as<S_push_constant>();
+      case xop_tzcnt: {
+        // Get the number of trailing zeroes in the operand.
+        if(rhs.type() == type_integer) {
+          V_integer& val = rhs.mut_integer();
 
-        // Collect variables from the expression.
-        altr.val.collect_variables(staged, temp);
-        return;
+          val = (int64_t) ROCKET_TZCNT64((uint64_t) val);
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__tzcnt` not applicable (operand was `$1`)", rhs);
       }
 
-      case index_coalesce_expression: {
-        const auto& altr = this->m_stor.as<S_coalesce_expression>();
+      case xop_popcnt: {
+        // Get the number of ones in the operand.
+        if(rhs.type() == type_integer) {
+          V_integer& val = rhs.mut_integer();
 
-        // Collect variables from the null branch.
-        do_collect_variables_for_each(staged, temp, altr.code_null);
-        return;
+          val = (int64_t) ROCKET_POPCNT64((uint64_t) val);
+          return air_status_next;
+        }
+
+        throw Runtime_Error(Runtime_Error::M_format(),
+                 "`__popcnt` not applicable (operand was `$1`)", rhs);
       }
 
       default:
-        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
+        ROCKET_UNREACHABLE();
     }
   }
 
-void
-AIR_Node::
-solidify(AVM_Rod& rod) const
-  {
-    switch(static_cast<Index>(this->m_stor.index())) {
-      case index_clear_stack: {
-        const auto& altr = this->m_stor.as<S_clear_stack>();
+// Registers of a register expression are allocated on the C stack. A larger
+// expression is split into multiple ones.
+constexpr uint32_t register_count_max = 8;
 
-        (void) altr;
+// This is the number of object layouts that a member access remembers.
+constexpr uint32_t member_cache_size = 4;
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* /*head*/) ROCKET_FLATTEN -> AIR_Status
-          {
-            ctx.stack().clear();
-            return air_status_next;
-          }
+// This is a polymorphic inline cache. The bucket of a key depends only on the
+// number of buckets, so it is shared by all objects of the same layout.
+// Entries are guesses and are always validated.
+struct Member_Cache
+  {
+    struct Entry
+      {
+        uint32_t nbkt;
+        uint32_t bkt;
+      };
+
+    mutable Entry entries[member_cache_size];
+    mutable uint32_t next;
+  };
+
+const Value*
+do_find_member_cached(uint32_t& hint, const V_object& obj, const phsh_string& key,
+                      const Member_Cache& cache)
+  {
+    // Look for an entry for this layout, or replace the oldest one.
+    uint32_t nbkt = static_cast<uint32_t>(obj.bucket_count());
+    uint32_t ci = 0;
+    while((ci != member_cache_size) && (cache.entries[ci].nbkt != nbkt))
+      ci ++;
+
+    size_t bkt = 0;
+    if(ci != member_cache_size)
+      bkt = cache.entries[ci].bkt;
+    else {
+      ci = cache.next;
+      cache.next = (ci + 1) % member_cache_size;
+    }
 
-          // Uparam
-          , Uparam()
+    // Validate the bucket and update the cache. The caller may store the
+    // bucket index into a modifier, so later dereferences are fast, too.
+    auto valp = obj.ptr_hint(bkt, key);
+    cache.entries[ci].nbkt = nbkt;
+    cache.entries[ci].bkt = static_cast<uint32_t>(bkt);
+    hint = static_cast<uint32_t>(bkt);
+    return valp;
+  }
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+bool
+do_is_register_xop(Xop xop, bool bi32) noexcept
+  {
+    // Shift operators are only supported with integer RHS operands.
+    if(bi32 && ::rocket::is_any_of(xop, { xop_sll, xop_srl, xop_sla, xop_sra }))
+      return true;
+
+    return ::rocket::is_any_of(xop,
+             { xop_cmp_eq, xop_cmp_ne, xop_cmp_un, xop_cmp_lt, xop_cmp_gt, xop_cmp_lte,
+               xop_cmp_gte, xop_cmp_3way, xop_add, xop_sub, xop_mul, xop_div, xop_mod,
+               xop_andb, xop_orb, xop_xorb, xop_addm, xop_subm, xop_mulm, xop_adds,
+               xop_subs, xop_muls });
+  }
 
-          // Collector
-          , nullptr
+bool
+do_is_unary_xop(Xop xop) noexcept
+  {
+    // These are the operators that are implemented by `do_apply_unary_operator()`.
+    return ::rocket::is_any_of(xop,
+             { xop_pos, xop_neg, xop_notb, xop_notl, xop_countof, xop_typeof, xop_sqrt,
+               xop_isnan, xop_isinf, xop_abs, xop_sign, xop_round, xop_floor, xop_ceil,
+               xop_trunc, xop_iround, xop_ifloor, xop_iceil, xop_itrunc, xop_lzcnt,
+               xop_tzcnt, xop_popcnt });
+  }
 
-          // Symbols
-          , nullptr
-        );
-        return;
-      }
+bool
+do_is_bi32_xop(Xop xop) noexcept
+  {
+    // These are the operators that accept an integer RHS operand which can be
+    // encoded in `S_apply_operator_bi32`.
+    return ::rocket::is_any_of(xop,
+             { xop_assign, xop_index, xop_cmp_eq, xop_cmp_ne, xop_cmp_un, xop_cmp_lt,
+               xop_cmp_gt, xop_cmp_lte, xop_cmp_gte, xop_cmp_3way, xop_add, xop_sub,
+               xop_mul, xop_div, xop_mod, xop_andb, xop_orb, xop_xorb, xop_addm, xop_subm,
+               xop_mulm, xop_adds, xop_subs, xop_muls, xop_sll, xop_srl, xop_sla, xop_sra });
+  }
 
-      case index_execute_block: {
-        const auto& altr = this->m_stor.as<S_execute_block>();
+bool
+do_is_foldable_constant(const Value& val) noexcept
+  {
+    // Only scalar values are folded, so the compiler will not create strings or
+    // arrays of arbitrary lengths.
+    return ::rocket::is_any_of(val.type(), { type_null, type_boolean, type_integer, type_real });
+  }
 
-        struct Sparam
-          {
-            AVM_Rod rod_body;
-          };
+// A binary operator records the types of its operands. After it has seen the
+// same types this many times in a row, it is replaced with an executor which
+// is specialized for them.
+constexpr uint8_t binary_feedback_threshold = 16;
 
-        Sparam sp2;
-        do_solidify_nodes(sp2.rod_body, altr.code_body);
+// This is the number of times that an operator may be deoptimized, before it
+// stops recording types.
+constexpr uint8_t binary_deopt_max = 4;
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+struct Binary_Feedback
+  {
+    mutable Type type;  // `type_null` if operands have different types
+    mutable uint8_t nhits;
+    mutable uint8_t ndeopts;
+  };
 
-            // Execute the block on a new context. The block may contain control
-            // statements, so the status shall be forwarded verbatim.
-            return do_execute_block(sp.rod_body, ctx);
-          }
+AIR_Status
+do_execute_binary_operator(Executive_Context& ctx, const Header* head);
 
-          // Uparam
-          , Uparam()
+AIR_Status
+do_deoptimize_binary_operator(const Header* head, Value& lhs, const Value& rhs)
+  {
+    // Restore the generic executor, which will start recording types again
+    // if this hasn't happened too many times.
+    const auto& fb = *reinterpret_cast<const Binary_Feedback*>(head->sparam);
+    fb.type = type_null;
+    fb.nhits = 0;
+    fb.ndeopts ++;
+    AVM_Rod::replace_executor(head, do_execute_binary_operator);
+
+    if(rhs.type() == type_integer)
+      return do_apply_binary_operator_with_integer(head->uparam.u1, lhs, rhs.as_integer());
+
+    return do_apply_binary_operator(head->uparam.u1, lhs, rhs);
+  }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+template<uint8_t xopT>
+ROCKET_FLATTEN
+AIR_Status
+do_execute_binary_int_int(Executive_Context& ctx, const Header* head)
+  {
+    const bool assign = head->uparam.b0;
+    const auto& rhs = ctx.stack().top().dereference_readonly();
+    ctx.stack().pop();
+    auto& top = ctx.stack().mut_top();
+    auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
+
+    if(ROCKET_UNEXPECT(!lhs.is_integer() || !rhs.is_integer()))
+      return do_deoptimize_binary_operator(head, lhs, rhs);
+
+    V_integer& val = lhs.mut_integer();
+    V_integer other = rhs.as_integer();
+    int64_t result;
+
+    // Errors, such as overflows, are reported by the generic path.
+    switch(xopT) {
+      case xop_cmp_eq:
+        lhs = val == other;
+        return air_status_next;
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_body.collect_variables(staged, temp);
-          }
+      case xop_cmp_ne:
+        lhs = val != other;
+        return air_status_next;
 
-          // Symbols
-          , nullptr
-        );
-        return;
-      }
+      case xop_cmp_lt:
+        lhs = val < other;
+        return air_status_next;
 
-      case index_declare_variable: {
-        const auto& altr = this->m_stor.as<S_declare_variable>();
+      case xop_cmp_gt:
+        lhs = val > other;
+        return air_status_next;
 
-        struct Sparam
-          {
-            phsh_string name;
-          };
+      case xop_cmp_lte:
+        lhs = val <= other;
+        return air_status_next;
 
-        Sparam sp2;
-        sp2.name = altr.name;
+      case xop_cmp_gte:
+        lhs = val >= other;
+        return air_status_next;
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            const auto& sloc = head->pv_meta->sloc;
+      case xop_add:
+        if(ROCKET_ADD_OVERFLOW(val, other, &result))
+          break;
+        val = result;
+        return air_status_next;
 
-            // Allocate a variable and inject it into the current context.
-            const auto gcoll = ctx.global().garbage_collector();
-            const auto var = gcoll->create_variable();
-            ctx.insert_named_reference(sp.name).set_variable(var);
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_variable_declare, sloc, sp.name);
+      case xop_sub:
+        if(ROCKET_SUB_OVERFLOW(val, other, &result))
+          break;
+        val = result;
+        return air_status_next;
 
-            // Push a copy of the reference onto the stack, which we will get
-            // back after the initializer finishes execution.
-            ctx.stack().push().set_variable(var);
-            return air_status_next;
-          }
+      case xop_mul:
+        if(ROCKET_MUL_OVERFLOW(val, other, &result))
+          break;
+        val = result;
+        return air_status_next;
 
-          // Uparam
-          , Uparam()
+      case xop_div:
+        if((other == 0) || ((val == INT64_MIN) && (other == -1)))
+          break;
+        val /= other;
+        return air_status_next;
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case xop_mod:
+        if((other == 0) || ((val == INT64_MIN) && (other == -1)))
+          break;
+        val %= other;
+        return air_status_next;
 
-          // Collector
-          , nullptr
+      case xop_andb:
+        val &= other;
+        return air_status_next;
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
+      case xop_orb:
+        val |= other;
+        return air_status_next;
 
-      case index_initialize_variable: {
-        const auto& altr = this->m_stor.as<S_initialize_variable>();
+      case xop_xorb:
+        val ^= other;
+        return air_status_next;
 
-        Uparam up2;
-        up2.b0 = altr.immutable;
+      case xop_addm:
+        ROCKET_ADD_OVERFLOW(val, other, &val);
+        return air_status_next;
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const bool immutable = head->uparam.b0;
+      case xop_subm:
+        ROCKET_SUB_OVERFLOW(val, other, &val);
+        return air_status_next;
 
-            // Read the value of the initializer. The initializer must not have
-            // been empty for this function.
-            const auto& val = ctx.stack().top().dereference_readonly();
-            ctx.stack().pop();
+      case xop_mulm:
+        ROCKET_MUL_OVERFLOW(val, other, &val);
+        return air_status_next;
 
-            // Get the variable back.
-            auto var = ctx.stack().top().unphase_variable_opt();
-            ctx.stack().pop();
-            ROCKET_ASSERT(var && !var->is_initialized());
+      default:
+        ROCKET_UNREACHABLE();
+    }
 
-            // Initialize it with this value.
-            var->initialize(val);
-            var->set_immutable(immutable);
-            return air_status_next;
-          }
+    return do_apply_binary_operator_with_integer(xopT, lhs, other);
+  }
 
-          // Uparam
-          , up2
+template<uint8_t xopT>
+ROCKET_FLATTEN
+AIR_Status
+do_execute_binary_real_real(Executive_Context& ctx, const Header* head)
+  {
+    const bool assign = head->uparam.b0;
+    const auto& rhs = ctx.stack().top().dereference_readonly();
+    ctx.stack().pop();
+    auto& top = ctx.stack().mut_top();
+    auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
+
+    if(ROCKET_UNEXPECT((lhs.type() != type_real) || (rhs.type() != type_real)))
+      return do_deoptimize_binary_operator(head, lhs, rhs);
+
+    V_real& val = lhs.mut_real();
+    V_real other = rhs.as_real();
+
+    // Unordered comparisons are reported by the generic path.
+    switch(xopT) {
+      case xop_cmp_eq:
+        lhs = val == other;
+        return air_status_next;
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+      case xop_cmp_ne:
+        lhs = val != other;
+        return air_status_next;
 
-          // Collector
-          , nullptr
+      case xop_cmp_lt:
+        if(::std::isunordered(val, other))
+          break;
+        lhs = val < other;
+        return air_status_next;
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
+      case xop_cmp_gt:
+        if(::std::isunordered(val, other))
+          break;
+        lhs = val > other;
+        return air_status_next;
 
-      case index_if_statement: {
-        const auto& altr = this->m_stor.as<S_if_statement>();
+      case xop_cmp_lte:
+        if(::std::isunordered(val, other))
+          break;
+        lhs = val <= other;
+        return air_status_next;
 
-        Uparam up2;
-        up2.b0 = altr.negative;
+      case xop_cmp_gte:
+        if(::std::isunordered(val, other))
+          break;
+        lhs = val >= other;
+        return air_status_next;
 
-        struct Sparam
-          {
-            AVM_Rod rod_true;
-            AVM_Rod rod_false;
-          };
+      case xop_add:
+        val += other;
+        return air_status_next;
 
-        Sparam sp2;
-        do_solidify_nodes(sp2.rod_true, altr.code_true);
-        do_solidify_nodes(sp2.rod_false, altr.code_false);
+      case xop_sub:
+        val -= other;
+        return air_status_next;
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const bool negative = head->uparam.b0;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+      case xop_mul:
+        val *= other;
+        return air_status_next;
 
-            // Read the condition and execute the corresponding branch as a block.
-            return (ctx.stack().top().dereference_readonly().test() != negative)
-                      ? do_execute_block(sp.rod_true, ctx)
-                      : do_execute_block(sp.rod_false, ctx);
-          }
+      case xop_div:
+        val /= other;
+        return air_status_next;
 
-          // Uparam
-          , up2
+      case xop_mod:
+        val = ::std::fmod(val, other);
+        return air_status_next;
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      default:
+        ROCKET_UNREACHABLE();
+    }
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_true.collect_variables(staged, temp);
-            sp.rod_false.collect_variables(staged, temp);
-          }
+    return do_apply_binary_operator(xopT, lhs, rhs);
+  }
 
-          // Symbols
-          , nullptr
-        );
-        return;
+AVM_Rod::Executor*
+do_get_specialized_binary_executor_opt(Type type, uint8_t uxop) noexcept
+  {
+#define do_specialize_(xop, func)  \
+      case xop:  \
+        return func<xop>
+
+    if(type == type_integer)
+      switch(uxop) {
+        do_specialize_(xop_cmp_eq, do_execute_binary_int_int);
+        do_specialize_(xop_cmp_ne, do_execute_binary_int_int);
+        do_specialize_(xop_cmp_lt, do_execute_binary_int_int);
+        do_specialize_(xop_cmp_gt, do_execute_binary_int_int);
+        do_specialize_(xop_cmp_lte, do_execute_binary_int_int);
+        do_specialize_(xop_cmp_gte, do_execute_binary_int_int);
+        do_specialize_(xop_add, do_execute_binary_int_int);
+        do_specialize_(xop_sub, do_execute_binary_int_int);
+        do_specialize_(xop_mul, do_execute_binary_int_int);
+        do_specialize_(xop_div, do_execute_binary_int_int);
+        do_specialize_(xop_mod, do_execute_binary_int_int);
+        do_specialize_(xop_andb, do_execute_binary_int_int);
+        do_specialize_(xop_orb, do_execute_binary_int_int);
+        do_specialize_(xop_xorb, do_execute_binary_int_int);
+        do_specialize_(xop_addm, do_execute_binary_int_int);
+        do_specialize_(xop_subm, do_execute_binary_int_int);
+        do_specialize_(xop_mulm, do_execute_binary_int_int);
       }
 
-      case index_switch_statement: {
-        const auto& altr = this->m_stor.as<S_switch_statement>();
+    if(type == type_real)
+      switch(uxop) {
+        do_specialize_(xop_cmp_eq, do_execute_binary_real_real);
+        do_specialize_(xop_cmp_ne, do_execute_binary_real_real);
+        do_specialize_(xop_cmp_lt, do_execute_binary_real_real);
+        do_specialize_(xop_cmp_gt, do_execute_binary_real_real);
+        do_specialize_(xop_cmp_lte, do_execute_binary_real_real);
+        do_specialize_(xop_cmp_gte, do_execute_binary_real_real);
+        do_specialize_(xop_add, do_execute_binary_real_real);
+        do_specialize_(xop_sub, do_execute_binary_real_real);
+        do_specialize_(xop_mul, do_execute_binary_real_real);
+        do_specialize_(xop_div, do_execute_binary_real_real);
+        do_specialize_(xop_mod, do_execute_binary_real_real);
+      }
 
-        struct Clause
-          {
-            AVM_Rod rod_label;
-            AVM_Rod rod_body;
-            cow_vector<phsh_string> names_added;
-          };
+#undef do_specialize_
+    return nullptr;
+  }
 
-        struct Sparam
-          {
-            cow_vector<Clause> clauses;
-          };
+void
+do_record_binary_feedback(const Header* head, const Value& lhs, const Value& rhs)
+  {
+    const auto& fb = *reinterpret_cast<const Binary_Feedback*>(head->sparam);
+    Type type = (lhs.type() == rhs.type()) ? lhs.type() : type_null;
+    if(type != fb.type) {
+      fb.type = type;
+      fb.nhits = 0;
+      return;
+    }
 
-        Sparam sp2;
-        for(const auto& clause : altr.clauses) {
-          auto& r = sp2.clauses.emplace_back();
-          do_solidify_nodes(r.rod_label, clause.code_label);
-          do_solidify_nodes(r.rod_body, clause.code_body);
-          r.names_added = clause.names_added;
-        }
+    if(++ fb.nhits < binary_feedback_threshold)
+      return;
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+    auto exec = do_get_specialized_binary_executor_opt(type, head->uparam.u1);
+    if(!exec) {
+      // There is nothing to specialize for, so stop recording.
+      fb.ndeopts = binary_deopt_max;
+      return;
+    }
 
-            // Read the value of the condition and find the target clause for it.
-            auto cond = ctx.stack().top().dereference_readonly();
-            uint32_t target_index = UINT32_MAX;
+    AVM_Rod::replace_executor(head, exec);
+  }
 
-            // This is different from the `switch` statement in C, where `case` labels must
-            // have constant operands.
-            for(uint32_t i = 0;  i < sp.clauses.size();  ++i) {
-              // This is a `default` clause if the condition is empty, and a `case` clause
-              // otherwise.
-              if(sp.clauses.at(i).rod_label.empty()) {
-                target_index = i;
-                continue;
-              }
+ROCKET_FLATTEN
+AIR_Status
+do_execute_binary_operator(Executive_Context& ctx, const Header* head)
+  {
+    const bool assign = head->uparam.b0;
+    const uint8_t uxop = head->uparam.u1;
+    const auto& fb = *reinterpret_cast<const Binary_Feedback*>(head->sparam);
+    const auto& rhs = ctx.stack().top().dereference_readonly();
+    ctx.stack().pop();
+    auto& top = ctx.stack().mut_top();
+    auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
+
+    if(fb.ndeopts < binary_deopt_max)
+      do_record_binary_feedback(head, lhs, rhs);
+
+    // The fast path should be a proper tail call.
+    if(rhs.type() == type_integer)
+      return do_apply_binary_operator_with_integer(uxop, lhs, rhs.as_integer());
+
+    return do_apply_binary_operator(uxop, lhs, rhs);
+  }
 
-              // Evaluate the operand and check whether it equals `cond`.
-              AIR_Status status = sp.clauses.at(i).rod_label.execute(ctx);
-              ROCKET_ASSERT(status == air_status_next);
-              if(ctx.stack().top().dereference_readonly().compare_partial(cond) == compare_equal) {
-                target_index = i;
-                break;
-              }
-            }
+}  // namespace
 
-            // Skip this statement if no matching clause has been found.
-            if(target_index >= sp.clauses.size())
-              return air_status_next;
+opt<Value>
+AIR_Node::
+get_constant_opt() const noexcept
+  {
+    switch(this->m_stor.index()) {
+      case index_push_bound_reference:
+        try {
+          const auto& altr = this->m_stor.as<S_push_bound_reference>();
+          if(altr.ref.is_temporary())
+            return altr.ref.dereference_readonly();
+        }
+        catch(...) { }
+        return nullopt;
 
-            // Jump to the target clause.
-            Executive_Context ctx_body(Executive_Context::M_plain(), ctx);
-            AIR_Status status = air_status_next;
-            try {
-              for(size_t i = 0;  i < sp.clauses.size();  ++i)
-                if(i < target_index) {
-                  // Inject bypassed variables into the scope.
-                  for(const auto& name : sp.clauses.at(i).names_added)
-                    ctx_body.insert_named_reference(name);
-                }
-                else {
-                  // Execute the body of this clause.
-                  status = sp.clauses.at(i).rod_body.execute(ctx_body);
-                  if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_switch })) {
-                    status = air_status_next;
-                    break;
-                  }
-                  else if(status != air_status_next)
-                    break;
-                }
-            }
-            catch(Runtime_Error& except) {
-              ctx_body.on_scope_exit_exceptional(except);
-              throw;
-            }
-            ctx_body.on_scope_exit_normal(status);
-            return status;
-          }
+      case index_push_constant:
+        return this->m_stor.as<S_push_constant>().val;
 
-          // Uparam
+      default:
+        return nullopt;
+    }
+  }
+
+bool
+AIR_Node::
+is_terminator() const noexcept
+  {
+    switch(static_cast<Index>(this->m_stor.index())) {
+      case index_clear_stack:
+      case index_declare_variable:
+      case index_initialize_variable:
+      case index_switch_statement:
+      case index_do_while_statement:
+      case index_while_statement:
+      case index_for_each_statement:
+      case index_for_statement:
+      case index_try_statement:
+      case index_assert_statement:
+      case index_check_argument:
+      case index_push_global_reference:
+      case index_push_local_reference:
+      case index_push_bound_reference:
+      case index_define_function:
+      case index_push_unnamed_array:
+      case index_push_unnamed_object:
+      case index_apply_operator:
+      case index_unpack_struct_array:
+      case index_unpack_struct_object:
+      case index_define_null_variable:
+      case index_single_step_trap:
+      case index_defer_expression:
+      case index_import_call:
+      case index_declare_reference:
+      case index_initialize_reference:
+      case index_catch_expression:
+      case index_push_constant:
+      case index_alt_clear_stack:
+      case index_coalesce_expression:
+      case index_member_access:
+      case index_apply_operator_bi32:
+      case index_register_expression:
+        return false;
+
+      case index_throw_statement:
+      case index_return_statement:
+        return true;
+
+      case index_simple_status:
+        return this->m_stor.as<S_simple_status>().status != air_status_next;
+
+      case index_function_call:
+        return this->m_stor.as<S_function_call>().ptc != ptc_aware_none;
+
+      case index_variadic_call:
+        return this->m_stor.as<S_variadic_call>().ptc != ptc_aware_none;
+
+      case index_alt_function_call:
+        return this->m_stor.as<S_alt_function_call>().ptc != ptc_aware_none;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<S_execute_block>();
+        return !altr.code_body.empty() && altr.code_body.back().is_terminator();
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<S_if_statement>();
+        return !altr.code_true.empty() && altr.code_true.back().is_terminator()
+               && !altr.code_false.empty() && altr.code_false.back().is_terminator();
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<S_branch_expression>();
+        return !altr.code_true.empty() && altr.code_true.back().is_terminator()
+               && !altr.code_false.empty() && altr.code_false.back().is_terminator();
+      }
+
+      default:
+        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
+    }
+  }
+
+opt<AIR_Node>
+AIR_Node::
+rebind_opt(Abstract_Context& ctx) const
+  {
+    switch(static_cast<Index>(this->m_stor.index())) {
+      case index_clear_stack:
+      case index_declare_variable:
+      case index_initialize_variable:
+      case index_throw_statement:
+      case index_assert_statement:
+      case index_simple_status:
+      case index_check_argument:
+      case index_push_global_reference:
+      case index_push_bound_reference:
+      case index_function_call:
+      case index_push_unnamed_array:
+      case index_push_unnamed_object:
+      case index_apply_operator:
+      case index_unpack_struct_array:
+      case index_unpack_struct_object:
+      case index_define_null_variable:
+      case index_single_step_trap:
+      case index_variadic_call:
+      case index_import_call:
+      case index_declare_reference:
+      case index_initialize_reference:
+      case index_return_statement:
+      case index_push_constant:
+      case index_alt_clear_stack:
+      case index_alt_function_call:
+      case index_member_access:
+      case index_apply_operator_bi32:
+        return nullopt;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<S_execute_block>();
+
+        // Rebind the body in a nested scope.
+        bool dirty = false;
+        S_execute_block bound = altr;
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<S_if_statement>();
+
+        // Rebind both branches in a nested scope.
+        bool dirty = false;
+        S_if_statement bound = altr;
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        do_rebind_nodes(dirty, bound.code_true, ctx_body);
+        do_rebind_nodes(dirty, bound.code_false, ctx_body);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<S_switch_statement>();
+
+        // Rebind all labels and clauses.
+        bool dirty = false;
+        S_switch_statement bound = altr;
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        for(size_t k = 0;  k < bound.clauses.size();  ++k) {
+          // Labels are to be evaluated in the same scope as the condition
+          // expression, and are not parts of the body.
+          for(size_t i = 0;  i < bound.clauses.at(k).code_label.size();  ++i)
+            if(auto qnode = bound.clauses.at(k).code_label.at(i).rebind_opt(ctx))
+              do_set_rebound(dirty, bound.clauses.mut(k).code_label.mut(i), ::std::move(*qnode));
+
+          for(size_t i = 0;  i < bound.clauses.at(k).code_body.size();  ++i)
+            if(auto qnode = bound.clauses.at(k).code_body.at(i).rebind_opt(ctx_body))
+              do_set_rebound(dirty, bound.clauses.mut(k).code_body.mut(i), ::std::move(*qnode));
+        }
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<S_do_while_statement>();
+
+        // Rebind the body and the condition expression.
+        // The condition expression is not a part of the body.
+        bool dirty = false;
+        S_do_while_statement bound = altr;
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        do_rebind_nodes(dirty, bound.code_cond, ctx);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<S_while_statement>();
+
+        // Rebind the condition expression and the body.
+        // The condition expression is not a part of the body.
+        bool dirty = false;
+        S_while_statement bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_cond, ctx);
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx);
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<S_for_each_statement>();
+
+        // Rebind the range initializer and the body.
+        // The range key and mapped references are declared in a dedicated scope
+        // where the initializer is to be evaluated. The body is to be executed
+        // in an inner scope, created and destroyed for each iteration.
+        bool dirty = false;
+        S_for_each_statement bound = altr;
+
+        Analytic_Context ctx_for(Analytic_Context::M_plain(), ctx);
+        if(!altr.name_key.empty())
+          ctx_for.insert_named_reference(altr.name_key);
+        ctx_for.insert_named_reference(altr.name_mapped);
+        do_rebind_nodes(dirty, bound.code_init, ctx_for);
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx_for);
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<S_for_statement>();
+
+        // Rebind the initializer, condition expression and step expression. All
+        // these are declared in a dedicated scope where the initializer is to be
+        // evaluated. The body is to be executed in an inner scope, created and
+        // destroyed for each iteration.
+        bool dirty = false;
+        S_for_statement bound = altr;
+
+        Analytic_Context ctx_for(Analytic_Context::M_plain(), ctx);
+        do_rebind_nodes(dirty, bound.code_init, ctx_for);
+        do_rebind_nodes(dirty, bound.code_cond, ctx_for);
+        do_rebind_nodes(dirty, bound.code_step, ctx_for);
+
+        Analytic_Context ctx_body(Analytic_Context::M_plain(), ctx_for);
+        do_rebind_nodes(dirty, bound.code_body, ctx_body);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<S_try_statement>();
+
+        // Rebind the `try` and `catch` clauses.
+        bool dirty = false;
+        S_try_statement bound = altr;
+
+        Analytic_Context ctx_try(Analytic_Context::M_plain(), ctx);
+        do_rebind_nodes(dirty, bound.code_try, ctx_try);
+
+        Analytic_Context ctx_catch(Analytic_Context::M_plain(), ctx);
+        ctx_catch.insert_named_reference(altr.name_except);
+        do_rebind_nodes(dirty, bound.code_catch, ctx_catch);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<S_push_local_reference>();
+
+        // Get the context.
+        const Abstract_Context* qctx = &ctx;
+        for(uint32_t k = 0;  k != altr.depth;  ++k)
+          if(!(qctx = qctx->get_parent_opt()))
+            throw Runtime_Error(Runtime_Error::M_format(),
+                     "Invalid depth of local reference `$1`", altr.name);
+
+        if(qctx->is_analytic())
+          return nullopt;
+
+        // Look for the name.
+        auto qref = qctx->get_named_reference_opt(altr.name, altr.slot);
+        if(!qref)
+          return nullopt;
+        else if(qref->is_invalid())
+          throw Runtime_Error(Runtime_Error::M_format(),
+                   "Initialization of variable or reference `$1` bypassed", altr.name);
+
+        // Bind this reference.
+        S_push_bound_reference xnode = { *qref };
+        return ::std::move(xnode);
+      }
+
+      case index_register_expression: {
+        const auto& altr = this->m_stor.as<S_register_expression>();
+
+        // Bind local references, like `S_push_local_reference`.
+        bool dirty = false;
+        S_register_expression bound = altr;
+
+        for(size_t k = 0;  k < altr.code.size();  ++k) {
+          const auto& insn = altr.code.at(k);
+          if(insn.opcode != regop_load_local)
+            continue;
+
+          // Get the context.
+          const Abstract_Context* qctx = &ctx;
+          for(uint32_t d = 0;  d != insn.depth;  ++d)
+            if(!(qctx = qctx->get_parent_opt()))
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Invalid depth of local reference `$1`", insn.name);
+
+          if(qctx->is_analytic())
+            continue;
+
+          // Look for the name.
+          auto qref = qctx->get_named_reference_opt(insn.name, insn.slot);
+          if(!qref)
+            continue;
+          else if(qref->is_invalid())
+            throw Runtime_Error(Runtime_Error::M_format(),
+                     "Initialization of variable or reference `$1` bypassed", insn.name);
+
+          // Bind this reference.
+          bound.code.mut(k).opcode = regop_load_bound;
+          bound.code.mut(k).ref = *qref;
+          dirty = true;
+        }
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<S_define_function>();
+
+        // Rebind the function body.
+        // This is the only scenario where names in the outer scope are visible
+        // to the body of a function.
+        bool dirty = false;
+        S_define_function bound = altr;
+
+        Analytic_Context ctx_func(Analytic_Context::M_function(), &ctx, altr.params);
+        do_rebind_nodes(dirty, bound.code_body, ctx_func);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<S_branch_expression>();
+
+        // Rebind both branches.
+        bool dirty = false;
+        S_branch_expression bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_true, ctx);
+        do_rebind_nodes(dirty, bound.code_false, ctx);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<S_defer_expression>();
+
+        // Rebind the expression.
+        bool dirty = false;
+        S_defer_expression bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_catch_expression: {
+        const auto& altr = this->m_stor.as<S_catch_expression>();
+
+        // Rebind the expression.
+        bool dirty = false;
+        S_catch_expression bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_body, ctx);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      case index_coalesce_expression: {
+        const auto& altr = this->m_stor.as<S_coalesce_expression>();
+
+        // Rebind the null branch.
+        bool dirty = false;
+        S_coalesce_expression bound = altr;
+
+        do_rebind_nodes(dirty, bound.code_null, ctx);
+
+        return do_return_rebound_opt(dirty, ::std::move(bound));
+      }
+
+      default:
+        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
+    }
+  }
+
+void
+AIR_Node::
+collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
+  {
+    switch(static_cast<Index>(this->m_stor.index())) {
+      case index_clear_stack:
+      case index_declare_variable:
+      case index_initialize_variable:
+      case index_throw_statement:
+      case index_assert_statement:
+      case index_simple_status:
+      case index_check_argument:
+      case index_push_global_reference:
+      case index_push_local_reference:
+      case index_function_call:
+      case index_push_unnamed_array:
+      case index_push_unnamed_object:
+      case index_apply_operator:
+      case index_unpack_struct_array:
+      case index_unpack_struct_object:
+      case index_define_null_variable:
+      case index_single_step_trap:
+      case index_variadic_call:
+      case index_import_call:
+      case index_declare_reference:
+      case index_initialize_reference:
+      case index_return_statement:
+      case index_alt_clear_stack:
+      case index_alt_function_call:
+      case index_member_access:
+      case index_apply_operator_bi32:
+        return;
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<S_execute_block>();
+
+        // Collect variables from the body.
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        return;
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<S_if_statement>();
+
+        // Collect variables from both branches.
+        do_collect_variables_for_each(staged, temp, altr.code_true);
+        do_collect_variables_for_each(staged, temp, altr.code_false);
+        return;
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<S_switch_statement>();
+
+        // Collect variables from all labels and clauses.
+        for(const auto& clause : altr.clauses) {
+          do_collect_variables_for_each(staged, temp, clause.code_label);
+          do_collect_variables_for_each(staged, temp, clause.code_body);
+        }
+        return;
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<S_do_while_statement>();
+
+        // Collect variables from the body and the condition expression.
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        do_collect_variables_for_each(staged, temp, altr.code_cond);
+        return;
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<S_while_statement>();
+
+        // Collect variables from the condition expression and the body.
+        do_collect_variables_for_each(staged, temp, altr.code_cond);
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        return;
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<S_for_each_statement>();
+
+        // Collect variables from the range initializer and the body.
+        do_collect_variables_for_each(staged, temp, altr.code_init);
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        return;
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<S_for_statement>();
+
+        // Collect variables from the initializer, condition expression and
+        // step expression.
+        do_collect_variables_for_each(staged, temp, altr.code_init);
+        do_collect_variables_for_each(staged, temp, altr.code_cond);
+        do_collect_variables_for_each(staged, temp, altr.code_step);
+        return;
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<S_try_statement>();
+
+        // Collect variables from the `try` and `catch` clauses.
+        do_collect_variables_for_each(staged, temp, altr.code_try);
+        do_collect_variables_for_each(staged, temp, altr.code_catch);
+        return;
+      }
+
+      case index_push_bound_reference: {
+        const auto& altr = this->m_stor.as<S_push_bound_reference>();
+
+        // Collect variables from the bound reference.
+        altr.ref.collect_variables(staged, temp);
+        return;
+      }
+
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<S_define_function>();
+
+        // Collect variables from the function body.
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        return;
+      }
+
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<S_branch_expression>();
+
+        // Collect variables from both branches.
+        do_collect_variables_for_each(staged, temp, altr.code_true);
+        do_collect_variables_for_each(staged, temp, altr.code_false);
+        return;
+      }
+
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<S_defer_expression>();
+
+        // Collect variables from the expression.
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        return;
+      }
+
+      case index_catch_expression: {
+        const auto& altr = this->m_stor.as<S_catch_expression>();
+
+        // Collect variables from the expression.
+        do_collect_variables_for_each(staged, temp, altr.code_body);
+        return;
+      }
+
+      case index_push_constant: {
+        const auto& altr = this->m_stor.as<S_push_constant>();
+
+        // Collect variables from the expression.
+        altr.val.collect_variables(staged, temp);
+        return;
+      }
+
+      case index_register_expression: {
+        const auto& altr = this->m_stor.as<S_register_expression>();
+
+        // Collect variables from constants and bound references.
+        for(const auto& insn : altr.code)
+          if(insn.opcode == regop_load_constant)
+            insn.val.collect_variables(staged, temp);
+          else if(insn.opcode == regop_load_bound)
+            insn.ref.collect_variables(staged, temp);
+        return;
+      }
+
+      case index_coalesce_expression: {
+        const auto& altr = this->m_stor.as<S_coalesce_expression>();
+
+        // Collect variables from the null branch.
+        do_collect_variables_for_each(staged, temp, altr.code_null);
+        return;
+      }
+
+      default:
+        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
+    }
+  }
+
+void
+AIR_Node::
+optimize(cow_vector<AIR_Node>& code, uint8_t level)
+  {
+    if(level < 1)
+      return;
+
+    // Optimize nested code first, except bodies of closures, which have been
+    // processed by their own optimizers.
+    for(size_t k = 0;  k < code.size();  ++k) {
+      auto& node = code.mut(k);
+
+      switch(static_cast<Index>(node.m_stor.index())) {
+        case index_clear_stack:
+        case index_declare_variable:
+        case index_initialize_variable:
+        case index_throw_statement:
+        case index_assert_statement:
+        case index_simple_status:
+        case index_check_argument:
+        case index_push_global_reference:
+        case index_push_local_reference:
+        case index_push_bound_reference:
+        case index_define_function:
+        case index_function_call:
+        case index_push_unnamed_array:
+        case index_push_unnamed_object:
+        case index_apply_operator:
+        case index_unpack_struct_array:
+        case index_unpack_struct_object:
+        case index_define_null_variable:
+        case index_single_step_trap:
+        case index_variadic_call:
+        case index_import_call:
+        case index_declare_reference:
+        case index_initialize_reference:
+        case index_return_statement:
+        case index_push_constant:
+        case index_alt_clear_stack:
+        case index_alt_function_call:
+        case index_member_access:
+        case index_apply_operator_bi32:
+        case index_register_expression:
+          break;
+
+        case index_execute_block:
+          optimize(node.m_stor.mut<S_execute_block>().code_body, level);
+          break;
+
+        case index_if_statement:
+          optimize(node.m_stor.mut<S_if_statement>().code_true, level);
+          optimize(node.m_stor.mut<S_if_statement>().code_false, level);
+          break;
+
+        case index_switch_statement:
+          for(size_t i = 0;  i < node.m_stor.as<S_switch_statement>().clauses.size();  ++i) {
+            auto& clause = node.m_stor.mut<S_switch_statement>().clauses.mut(i);
+            optimize(clause.code_label, level);
+            optimize(clause.code_body, level);
+          }
+          break;
+
+        case index_do_while_statement:
+          optimize(node.m_stor.mut<S_do_while_statement>().code_body, level);
+          optimize(node.m_stor.mut<S_do_while_statement>().code_cond, level);
+          break;
+
+        case index_while_statement:
+          optimize(node.m_stor.mut<S_while_statement>().code_cond, level);
+          optimize(node.m_stor.mut<S_while_statement>().code_body, level);
+          break;
+
+        case index_for_each_statement:
+          optimize(node.m_stor.mut<S_for_each_statement>().code_init, level);
+          optimize(node.m_stor.mut<S_for_each_statement>().code_body, level);
+          break;
+
+        case index_for_statement:
+          optimize(node.m_stor.mut<S_for_statement>().code_init, level);
+          optimize(node.m_stor.mut<S_for_statement>().code_cond, level);
+          optimize(node.m_stor.mut<S_for_statement>().code_step, level);
+          optimize(node.m_stor.mut<S_for_statement>().code_body, level);
+          break;
+
+        case index_try_statement:
+          optimize(node.m_stor.mut<S_try_statement>().code_try, level);
+          optimize(node.m_stor.mut<S_try_statement>().code_catch, level);
+          break;
+
+        case index_branch_expression:
+          optimize(node.m_stor.mut<S_branch_expression>().code_true, level);
+          optimize(node.m_stor.mut<S_branch_expression>().code_false, level);
+          break;
+
+        case index_defer_expression:
+          optimize(node.m_stor.mut<S_defer_expression>().code_body, level);
+          break;
+
+        case index_catch_expression:
+          optimize(node.m_stor.mut<S_catch_expression>().code_body, level);
+          break;
+
+        case index_coalesce_expression:
+          optimize(node.m_stor.mut<S_coalesce_expression>().code_null, level);
+          break;
+
+        default:
+          ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), node.m_stor.index());
+      }
+    }
+
+    // Nodes are taken from the end of `work`. When a branch is selected, its
+    // code is put back into `work`, so it can be folded with preceding nodes.
+    cow_vector<AIR_Node> work;
+    work.reserve(code.size());
+    for(size_t k = code.size();  k != 0;  --k)
+      work.emplace_back(::std::move(code.mut(k - 1)));
+
+    cow_vector<AIR_Node> optimized;
+    optimized.reserve(code.size());
+
+    while(!work.empty()) {
+      AIR_Node node = ::std::move(work.mut_back());
+      work.pop_back();
+
+      // Nodes after a terminator are unreachable.
+      if((level >= 2) && !optimized.empty() && optimized.back().is_terminator())
+        break;
+
+      switch(node.m_stor.index()) {
+        case index_apply_operator: {
+          const auto& altr = node.m_stor.as<S_apply_operator>();
+          if(optimized.empty())
+            break;
+
+          auto qrhs = optimized.back().get_constant_opt();
+          if(!qrhs)
+            break;
+
+          if(!altr.assign && do_is_unary_xop(altr.xop) && do_is_foldable_constant(*qrhs)) {
+            // Fold a unary operator. If an exception is thrown, leave it alone,
+            // so it will be thrown at run time.
+            try {
+              do_apply_unary_operator(altr.xop, *qrhs);
+              S_push_constant xnode = { ::std::move(*qrhs) };
+              optimized.mut_back() = ::std::move(xnode);
+              continue;
+            }
+            catch(Runtime_Error&) { }
+          }
+
+          opt<Value> qlhs;
+          if(optimized.size() >= 2)
+            qlhs = optimized.at(optimized.size() - 2).get_constant_opt();
+
+          if(!altr.assign && qlhs && do_is_foldable_constant(*qlhs) && do_is_foldable_constant(*qrhs)
+             && (do_is_register_xop(altr.xop, false)
+                 || (do_is_register_xop(altr.xop, true) && qrhs->is_integer()))) {
+            // Fold a binary operator. The RHS operand is left alone upon failure,
+            // so it may still be encoded in the operator.
+            try {
+              if(qrhs->is_integer())
+                do_apply_binary_operator_with_integer(altr.xop, *qlhs, qrhs->as_integer());
+              else
+                do_apply_binary_operator(altr.xop, *qlhs, *qrhs);
+
+              S_push_constant xnode = { ::std::move(*qlhs) };
+              optimized.pop_back();
+              optimized.mut_back() = ::std::move(xnode);
+              continue;
+            }
+            catch(Runtime_Error&) { }
+          }
+
+          if(qrhs->is_integer() && ((int32_t) qrhs->as_integer() == qrhs->as_integer())
+             && do_is_bi32_xop(altr.xop)) {
+            // Encode the RHS operand in the operator.
+            S_apply_operator_bi32 xnode = { altr.sloc, altr.xop, altr.assign,
+                                            (int32_t) qrhs->as_integer() };
+            optimized.mut_back() = ::std::move(xnode);
+            continue;
+          }
+
+          break;
+        }
+
+        case index_apply_operator_bi32: {
+          const auto& altr = node.m_stor.as<S_apply_operator_bi32>();
+          if(altr.assign || !do_is_register_xop(altr.xop, true) || optimized.empty())
+            break;
+
+          auto qlhs = optimized.back().get_constant_opt();
+          if(!qlhs || !do_is_foldable_constant(*qlhs))
+            break;
+
+          // Fold a binary operator with an integer RHS operand.
+          try {
+            do_apply_binary_operator_with_integer(altr.xop, *qlhs, altr.irhs);
+            S_push_constant xnode = { ::std::move(*qlhs) };
+            optimized.mut_back() = ::std::move(xnode);
+            continue;
+          }
+          catch(Runtime_Error&) { }
+          break;
+        }
+
+        case index_if_statement: {
+          auto& altr = node.m_stor.mut<S_if_statement>();
+          if((level < 2) || optimized.empty())
+            break;
+
+          auto qcond = optimized.back().get_constant_opt();
+          if(!qcond)
+            break;
+
+          // Execute the selected branch as a plain block. The condition is left
+          // on the stack, just like the original node.
+          auto& code_sel = (qcond->test() != altr.negative) ? altr.code_true : altr.code_false;
+          if(code_sel.empty())
+            continue;
+
+          S_execute_block xnode = { ::std::move(code_sel) };
+          node = ::std::move(xnode);
+          break;
+        }
+
+        case index_branch_expression: {
+          auto& altr = node.m_stor.mut<S_branch_expression>();
+          if((level < 2) || altr.assign || optimized.empty())
+            break;
+
+          auto qcond = optimized.back().get_constant_opt();
+          if(!qcond)
+            break;
+
+          // If the selected branch is empty, the condition is the result.
+          // Otherwise, replace the condition with the selected branch.
+          auto& code_sel = qcond->test() ? altr.code_true : altr.code_false;
+          if(code_sel.empty())
+            continue;
+
+          optimized.pop_back();
+          for(size_t k = code_sel.size();  k != 0;  --k)
+            work.emplace_back(::std::move(code_sel.mut(k - 1)));
+          continue;
+        }
+
+        case index_coalesce_expression: {
+          auto& altr = node.m_stor.mut<S_coalesce_expression>();
+          if((level < 2) || altr.assign || optimized.empty())
+            break;
+
+          auto qcond = optimized.back().get_constant_opt();
+          if(!qcond)
+            break;
+
+          // If the condition is not null or the null branch is empty, the
+          // condition is the result. Otherwise, replace the condition with the
+          // null branch.
+          if(!qcond->is_null() || altr.code_null.empty())
+            continue;
+
+          optimized.pop_back();
+          for(size_t k = altr.code_null.size();  k != 0;  --k)
+            work.emplace_back(::std::move(altr.code_null.mut(k - 1)));
+          continue;
+        }
+
+        default:
+          break;
+      }
+
+      optimized.emplace_back(::std::move(node));
+    }
+
+    code.swap(optimized);
+  }
+
+void
+AIR_Node::
+lower_to_registers(cow_vector<AIR_Node>& code)
+  {
+    // Convert an operand into register code which stores its value into the
+    // register `base`. Register expressions are relocated and merged. Each
+    // instruction keeps the location of the node that it has been converted
+    // from; if there is none, errors are reported at the operator.
+    auto do_lower_operand = [](S_register_expression& rexpr, const AIR_Node& node, uint32_t base)
+      {
+        register_insn insn = { };
+        insn.dst = (uint8_t) base;
+        insn.sloc = rexpr.sloc;
+
+        switch(node.m_stor.index()) {
+          case index_push_constant:
+            insn.opcode = regop_load_constant;
+            insn.val = node.m_stor.as<S_push_constant>().val;
+            break;
+
+          case index_push_local_reference: {
+            const auto& altr = node.m_stor.as<S_push_local_reference>();
+            insn.opcode = regop_load_local;
+            insn.depth = altr.depth;
+            insn.slot = altr.slot;
+            insn.name = altr.name;
+            insn.sloc = altr.sloc;
+            break;
+          }
+
+          case index_push_bound_reference:
+            insn.opcode = regop_load_bound;
+            insn.ref = node.m_stor.as<S_push_bound_reference>().ref;
+            break;
+
+          case index_register_expression: {
+            const auto& altr = node.m_stor.as<S_register_expression>();
+            if(base + altr.nregs > register_count_max)
+              return false;
+
+            for(const auto& other : altr.code) {
+              rexpr.code.emplace_back(other);
+              rexpr.code.mut_back().dst = (uint8_t) (other.dst + base);
+              rexpr.code.mut_back().src = (uint8_t) (other.src + base);
+            }
+            rexpr.nregs = ::rocket::max(rexpr.nregs, base + altr.nregs);
+            return true;
+          }
+
+          default:
+            return false;
+        }
+
+        if(base + 1 > register_count_max)
+          return false;
+
+        rexpr.code.emplace_back(::std::move(insn));
+        rexpr.nregs = ::rocket::max(rexpr.nregs, base + 1);
+        return true;
+      };
+
+    cow_vector<AIR_Node> lowered;
+    lowered.reserve(code.size());
+
+    for(size_t k = 0;  k < code.size();  ++k) {
+      AIR_Node node = ::std::move(code.mut(k));
+
+      switch(static_cast<Index>(node.m_stor.index())) {
+        case index_clear_stack:
+        case index_declare_variable:
+        case index_initialize_variable:
+        case index_throw_statement:
+        case index_assert_statement:
+        case index_simple_status:
+        case index_check_argument:
+        case index_push_global_reference:
+        case index_push_local_reference:
+        case index_push_bound_reference:
+        case index_define_function:
+        case index_function_call:
+        case index_push_unnamed_array:
+        case index_push_unnamed_object:
+        case index_unpack_struct_array:
+        case index_unpack_struct_object:
+        case index_define_null_variable:
+        case index_single_step_trap:
+        case index_variadic_call:
+        case index_import_call:
+        case index_declare_reference:
+        case index_initialize_reference:
+        case index_return_statement:
+        case index_push_constant:
+        case index_alt_clear_stack:
+        case index_alt_function_call:
+        case index_member_access:
+        case index_register_expression:
+          break;
+
+        case index_execute_block:
+          lower_to_registers(node.m_stor.mut<S_execute_block>().code_body);
+          break;
+
+        case index_if_statement:
+          lower_to_registers(node.m_stor.mut<S_if_statement>().code_true);
+          lower_to_registers(node.m_stor.mut<S_if_statement>().code_false);
+          break;
+
+        case index_switch_statement:
+          for(size_t i = 0;  i < node.m_stor.as<S_switch_statement>().clauses.size();  ++i) {
+            auto& clause = node.m_stor.mut<S_switch_statement>().clauses.mut(i);
+            lower_to_registers(clause.code_label);
+            lower_to_registers(clause.code_body);
+          }
+          break;
+
+        case index_do_while_statement:
+          lower_to_registers(node.m_stor.mut<S_do_while_statement>().code_body);
+          lower_to_registers(node.m_stor.mut<S_do_while_statement>().code_cond);
+          break;
+
+        case index_while_statement:
+          lower_to_registers(node.m_stor.mut<S_while_statement>().code_cond);
+          lower_to_registers(node.m_stor.mut<S_while_statement>().code_body);
+          break;
+
+        case index_for_each_statement:
+          lower_to_registers(node.m_stor.mut<S_for_each_statement>().code_init);
+          lower_to_registers(node.m_stor.mut<S_for_each_statement>().code_body);
+          break;
+
+        case index_for_statement:
+          lower_to_registers(node.m_stor.mut<S_for_statement>().code_init);
+          lower_to_registers(node.m_stor.mut<S_for_statement>().code_cond);
+          lower_to_registers(node.m_stor.mut<S_for_statement>().code_step);
+          lower_to_registers(node.m_stor.mut<S_for_statement>().code_body);
+          break;
+
+        case index_try_statement:
+          lower_to_registers(node.m_stor.mut<S_try_statement>().code_try);
+          lower_to_registers(node.m_stor.mut<S_try_statement>().code_catch);
+          break;
+
+        case index_branch_expression:
+          lower_to_registers(node.m_stor.mut<S_branch_expression>().code_true);
+          lower_to_registers(node.m_stor.mut<S_branch_expression>().code_false);
+          break;
+
+        case index_defer_expression:
+          lower_to_registers(node.m_stor.mut<S_defer_expression>().code_body);
+          break;
+
+        case index_catch_expression:
+          lower_to_registers(node.m_stor.mut<S_catch_expression>().code_body);
+          break;
+
+        case index_coalesce_expression:
+          lower_to_registers(node.m_stor.mut<S_coalesce_expression>().code_null);
+          break;
+
+        case index_apply_operator: {
+          const auto& altr = node.m_stor.as<S_apply_operator>();
+          if(altr.assign || !do_is_register_xop(altr.xop, false) || (lowered.size() < 2))
+            break;
+
+          // The operands are the last two values on the stack, which must have
+          // been pushed by the last two nodes.
+          S_register_expression rexpr = { altr.sloc, 0, { } };
+          if(!do_lower_operand(rexpr, lowered.at(lowered.size() - 2), 0)
+             || !do_lower_operand(rexpr, lowered.back(), 1))
+            break;
+
+          register_insn insn = { };
+          insn.opcode = regop_apply;
+          insn.xop = altr.xop;
+          insn.dst = 0;
+          insn.src = 1;
+          insn.sloc = altr.sloc;
+          rexpr.code.emplace_back(::std::move(insn));
+
+          lowered.pop_back();
+          lowered.mut_back() = ::std::move(rexpr);
+          continue;
+        }
+
+        case index_apply_operator_bi32: {
+          const auto& altr = node.m_stor.as<S_apply_operator_bi32>();
+          if(altr.assign || !do_is_register_xop(altr.xop, true) || lowered.empty())
+            break;
+
+          // The operand is the last value on the stack.
+          S_register_expression rexpr = { altr.sloc, 0, { } };
+          if(!do_lower_operand(rexpr, lowered.back(), 0))
+            break;
+
+          register_insn insn = { };
+          insn.opcode = regop_apply_bi32;
+          insn.xop = altr.xop;
+          insn.dst = 0;
+          insn.irhs = altr.irhs;
+          insn.sloc = altr.sloc;
+          rexpr.code.emplace_back(::std::move(insn));
+
+          lowered.mut_back() = ::std::move(rexpr);
+          continue;
+        }
+
+        default:
+          ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), node.m_stor.index());
+      }
+
+      lowered.emplace_back(::std::move(node));
+    }
+
+    code.swap(lowered);
+  }
+
+void
+AIR_Node::
+solidify(AVM_Rod& rod) const
+  {
+    switch(static_cast<Index>(this->m_stor.index())) {
+      case index_clear_stack: {
+        const auto& altr = this->m_stor.as<S_clear_stack>();
+
+        (void) altr;
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* /*head*/) ROCKET_FLATTEN -> AIR_Status
+          {
+            ctx.stack().clear();
+            return air_status_next;
+          }
+
+          // Uparam
+          , Uparam()
+
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
+
+          // Collector
+          , nullptr
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<S_execute_block>();
+
+        struct Sparam
+          {
+            AVM_Rod rod_body;
+          };
+
+        Sparam sp2;
+        do_solidify_nodes(sp2.rod_body, altr.code_body);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // Execute the block on a new context. The block may contain control
+            // statements, so the status shall be forwarded verbatim.
+            return do_execute_block(sp.rod_body, ctx);
+          }
+
+          // Uparam
+          , Uparam()
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_body.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_declare_variable: {
+        const auto& altr = this->m_stor.as<S_declare_variable>();
+
+        Uparam up2;
+        up2.u2345 = altr.slot;
+
+        struct Sparam
+          {
+            phsh_string name;
+          };
+
+        Sparam sp2;
+        sp2.name = altr.name;
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const uint32_t slot = head->uparam.u2345;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            const auto& sloc = head->pv_meta->sloc;
+
+            // Allocate a variable and inject it into the current context.
+            const auto gcoll = ctx.global().garbage_collector();
+            const auto var = gcoll->create_variable();
+            ctx.insert_named_reference(sp.name, slot).set_variable(var);
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_variable_declare, sloc, sp.name);
+
+            // Push a copy of the reference onto the stack, which we will get
+            // back after the initializer finishes execution.
+            ctx.stack().push().set_variable(var);
+            return air_status_next;
+          }
+
+          // Uparam
+          , up2
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , nullptr
+
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
+
+      case index_initialize_variable: {
+        const auto& altr = this->m_stor.as<S_initialize_variable>();
+
+        Uparam up2;
+        up2.b0 = altr.immutable;
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool immutable = head->uparam.b0;
+
+            // Read the value of the initializer. The initializer must not have
+            // been empty for this function.
+            const auto& val = ctx.stack().top().dereference_readonly();
+            ctx.stack().pop();
+
+            // Get the variable back.
+            auto var = ctx.stack().top().unphase_variable_opt();
+            ctx.stack().pop();
+            ROCKET_ASSERT(var && !var->is_initialized());
+
+            // Initialize it with this value.
+            var->initialize(val);
+            var->set_immutable(immutable);
+            return air_status_next;
+          }
+
+          // Uparam
+          , up2
+
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
+
+          // Collector
+          , nullptr
+
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
+
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<S_if_statement>();
+
+        Uparam up2;
+        up2.b0 = altr.negative;
+
+        struct Sparam
+          {
+            AVM_Rod rod_true;
+            AVM_Rod rod_false;
+          };
+
+        Sparam sp2;
+        do_solidify_nodes(sp2.rod_true, altr.code_true);
+        do_solidify_nodes(sp2.rod_false, altr.code_false);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool negative = head->uparam.b0;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // Read the condition and execute the corresponding branch as a block.
+            return (ctx.stack().top().dereference_readonly().test() != negative)
+                      ? do_execute_block(sp.rod_true, ctx)
+                      : do_execute_block(sp.rod_false, ctx);
+          }
+
+          // Uparam
+          , up2
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_true.collect_variables(staged, temp);
+            sp.rod_false.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<S_switch_statement>();
+
+        struct Clause
+          {
+            AVM_Rod rod_label;
+            AVM_Rod rod_body;
+            cow_vector<phsh_string> names_added;
+          };
+
+        struct Sparam
+          {
+            cow_vector<Clause> clauses;
+          };
+
+        Sparam sp2;
+        for(const auto& clause : altr.clauses) {
+          auto& r = sp2.clauses.emplace_back();
+          do_solidify_nodes(r.rod_label, clause.code_label);
+          do_solidify_nodes(r.rod_body, clause.code_body);
+          r.names_added = clause.names_added;
+        }
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // Read the value of the condition and find the target clause for it.
+            auto cond = ctx.stack().top().dereference_readonly();
+            uint32_t target_index = UINT32_MAX;
+
+            // This is different from the `switch` statement in C, where `case` labels must
+            // have constant operands.
+            for(uint32_t i = 0;  i < sp.clauses.size();  ++i) {
+              // This is a `default` clause if the condition is empty, and a `case` clause
+              // otherwise.
+              if(sp.clauses.at(i).rod_label.empty()) {
+                target_index = i;
+                continue;
+              }
+
+              // Evaluate the operand and check whether it equals `cond`.
+              AIR_Status status = sp.clauses.at(i).rod_label.execute(ctx);
+              ROCKET_ASSERT(status == air_status_next);
+              if(ctx.stack().top().dereference_readonly().compare_partial(cond) == compare_equal) {
+                target_index = i;
+                break;
+              }
+            }
+
+            // Skip this statement if no matching clause has been found.
+            if(target_index >= sp.clauses.size())
+              return air_status_next;
+
+            // Jump to the target clause.
+            Executive_Context ctx_body(Executive_Context::M_plain(), ctx);
+            AIR_Status status = air_status_next;
+            try {
+              for(size_t i = 0;  i < sp.clauses.size();  ++i)
+                if(i < target_index) {
+                  // Inject bypassed variables into the scope.
+                  for(const auto& name : sp.clauses.at(i).names_added)
+                    ctx_body.insert_named_reference(name);
+                }
+                else {
+                  // Execute the body of this clause.
+                  status = sp.clauses.at(i).rod_body.execute(ctx_body);
+                  if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_switch })) {
+                    status = air_status_next;
+                    break;
+                  }
+                  else if(status != air_status_next)
+                    break;
+                }
+            }
+            catch(Runtime_Error& except) {
+              ctx_body.on_scope_exit_exceptional(except);
+              throw;
+            }
+            ctx_body.on_scope_exit_normal(status);
+            return status;
+          }
+
+          // Uparam
+          , Uparam()
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            for(const auto& r : sp.clauses) {
+              r.rod_label.collect_variables(staged, temp);
+              r.rod_body.collect_variables(staged, temp);
+            }
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<S_do_while_statement>();
+
+        Uparam up2;
+        up2.b0 = altr.negative;
+
+        struct Sparam
+          {
+            AVM_Rod rods_body;
+            AVM_Rod rods_cond;
+          };
+
+        Sparam sp2;
+        do_solidify_nodes(sp2.rods_body, altr.code_body);
+        do_solidify_nodes(sp2.rods_cond, altr.code_cond);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool negative = head->uparam.b0;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // This is identical to C.
+            AIR_Status status = air_status_next;
+            for(;;) {
+              // Take a sample if the profiling timer has expired.
+              ctx.global().sampling_profiler().check();
+
+              // Execute the body.
+              status = do_execute_block(sp.rods_body, ctx);
+              if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while })) {
+                status = air_status_next;
+                break;
+              }
+              else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                                     air_status_continue_while }))
+                break;
+
+              // Check the condition.
+              status = sp.rods_cond.execute(ctx);
+              ROCKET_ASSERT(status == air_status_next);
+              if(ctx.stack().top().dereference_readonly().test() == negative)
+                break;
+            }
+            return status;
+          }
+
+          // Uparam
+          , up2
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rods_body.collect_variables(staged, temp);
+            sp.rods_cond.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<S_while_statement>();
+
+        Uparam up2;
+        up2.b0 = altr.negative;
+
+        struct Sparam
+          {
+            AVM_Rod rods_cond;
+            AVM_Rod rods_body;
+          };
+
+        Sparam sp2;
+        do_solidify_nodes(sp2.rods_cond, altr.code_cond);
+        do_solidify_nodes(sp2.rods_body, altr.code_body);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool negative = head->uparam.b0;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // This is identical to C.
+            AIR_Status status = air_status_next;
+            for(;;) {
+              // Check the condition.
+              status = sp.rods_cond.execute(ctx);
+              ROCKET_ASSERT(status == air_status_next);
+              if(ctx.stack().top().dereference_readonly().test() == negative)
+                break;
+
+              // Take a sample if the profiling timer has expired.
+              ctx.global().sampling_profiler().check();
+
+              // Execute the body.
+              status = do_execute_block(sp.rods_body, ctx);
+              if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while })) {
+                status = air_status_next;
+                break;
+              }
+              else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                                     air_status_continue_while }))
+                break;
+            }
+            return status;
+          }
+
+          // Uparam
+          , up2
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rods_cond.collect_variables(staged, temp);
+            sp.rods_body.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<S_for_each_statement>();
+
+        struct Sparam
+          {
+            phsh_string name_key;
+            phsh_string name_mapped;
+            Source_Location sloc_init;
+            AVM_Rod rod_init;
+            AVM_Rod rod_body;
+          };
+
+        Sparam sp2;
+        sp2.name_key = altr.name_key;
+        sp2.name_mapped = altr.name_mapped;
+        sp2.sloc_init = altr.sloc_init;
+        do_solidify_nodes(sp2.rod_init, altr.code_init);
+        do_solidify_nodes(sp2.rod_body, altr.code_body);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // We have to create an outer context due to the fact that the key
+            // and mapped references outlast every iteration.
+            Executive_Context ctx_for(Executive_Context::M_plain(), ctx);
+
+            // Create key and mapped references.
+            Reference* qkey_ref = nullptr;
+            if(!sp.name_key.empty())
+              qkey_ref = &(ctx_for.insert_named_reference(sp.name_key));
+            auto& mapped_ref = ctx_for.insert_named_reference(sp.name_mapped);
+
+            // Evaluate the range initializer and set the range up, which isn't
+            // going to change for all loops.
+            AIR_Status status = sp.rod_init.execute(ctx_for);
+            ROCKET_ASSERT(status == air_status_next);
+            mapped_ref = ::std::move(ctx_for.stack().mut_top());
+
+            const auto range = mapped_ref.dereference_readonly();
+            if(range.is_null()) {
+              // Do nothing.
+              return air_status_next;
+            }
+            else if(range.is_array()) {
+              const auto& arr = range.as_array();
+              mapped_ref.push_modifier(Reference_Modifier::S_array_head());  // placeholder
+              for(int64_t i = 0;  i < arr.ssize();  ++i) {
+                // Set the key variable which is the subscript of the mapped
+                // element in the array.
+                if(qkey_ref) {
+                  auto key_var = qkey_ref->unphase_variable_opt();
+                  if(!key_var) {
+                    key_var = ctx.global().garbage_collector()->create_variable();
+                    qkey_ref->set_variable(key_var);
+                  }
+                  key_var->initialize(i);
+                  key_var->set_immutable();
+                }
+
+                // Set the mapped reference.
+                mapped_ref.pop_modifier();
+                Reference_Modifier::S_array_index xmod = { i };
+                do_push_modifier_and_check(mapped_ref, ::std::move(xmod));
+
+                // Take a sample if the profiling timer has expired.
+                ctx.global().sampling_profiler().check();
+
+                // Execute the loop body.
+                status = do_execute_block(sp.rod_body, ctx_for);
+                if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for })) {
+                  status = air_status_next;
+                  break;
+                }
+                else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                                       air_status_continue_for }))
+                  break;
+              }
+              return status;
+            }
+            else if(range.is_object()) {
+              const auto& obj = range.as_object();
+              mapped_ref.push_modifier(Reference_Modifier::S_array_head());  // placeholder
+              for(auto it = obj.begin();  it != obj.end();  ++it) {
+                // Set the key variable which is the name of the mapped element
+                // in the object.
+                if(qkey_ref) {
+                  auto key_var = qkey_ref->unphase_variable_opt();
+                  if(!key_var) {
+                    key_var = ctx.global().garbage_collector()->create_variable();
+                    qkey_ref->set_variable(key_var);
+                  }
+                  key_var->initialize(it->first.rdstr());
+                  key_var->set_immutable();
+                }
+
+                // Set the mapped reference.
+                mapped_ref.pop_modifier();
+                Reference_Modifier::S_object_key xmod = { it->first, 0 };
+                do_push_modifier_and_check(mapped_ref, ::std::move(xmod));
+
+                // Take a sample if the profiling timer has expired.
+                ctx.global().sampling_profiler().check();
+
+                // Execute the loop body.
+                status = do_execute_block(sp.rod_body, ctx_for);
+                if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for })) {
+                  status = air_status_next;
+                  break;
+                }
+                else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                                       air_status_continue_for }))
+                  break;
+              }
+              return status;
+            }
+            else
+              throw Runtime_Error(Runtime_Error::M_assert(), sp.sloc_init,
+                        format_string("Range value not iterable (value `$1`)", range));
+          }
+
+          // Uparam
+          , Uparam()
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_init.collect_variables(staged, temp);
+            sp.rod_body.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<S_for_statement>();
+
+        struct Sparam
+          {
+            AVM_Rod rod_init;
+            AVM_Rod rod_cond;
+            AVM_Rod rod_step;
+            AVM_Rod rod_body;
+          };
+
+        Sparam sp2;
+        do_solidify_nodes(sp2.rod_init, altr.code_init);
+        do_solidify_nodes(sp2.rod_cond, altr.code_cond);
+        do_solidify_nodes(sp2.rod_step, altr.code_step);
+        do_solidify_nodes(sp2.rod_body, altr.code_body);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // This is the same as the `for` statement in C. We have to create
+            // an outer context due to the fact that names declared in the first
+            // segment outlast every iteration.
+            Executive_Context ctx_for(Executive_Context::M_plain(), ctx);
+
+            // Execute the loop initializer, which shall only be a definition or
+            // an expression statement.
+            AIR_Status status = sp.rod_init.execute(ctx_for);
+            ROCKET_ASSERT(status == air_status_next);
+            for(;;) {
+              // Check the condition. There is a special case: If the condition
+              // is empty then the loop is infinite.
+              status = sp.rod_cond.execute(ctx_for);
+              ROCKET_ASSERT(status == air_status_next);
+              if(!ctx_for.stack().empty() && !ctx_for.stack().top().dereference_readonly().test())
+                break;
+
+              // Take a sample if the profiling timer has expired.
+              ctx.global().sampling_profiler().check();
+
+              // Execute the body.
+              status = do_execute_block(sp.rod_body, ctx_for);
+              if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for })) {
+                status = air_status_next;
+                break;
+              }
+              else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
+                                                     air_status_continue_for }))
+                break;
+
+              // Execute the increment.
+              status = sp.rod_step.execute(ctx_for);
+              ROCKET_ASSERT(status == air_status_next);
+            }
+            return status;
+          }
+
+          // Uparam
+          , Uparam()
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_init.collect_variables(staged, temp);
+            sp.rod_cond.collect_variables(staged, temp);
+            sp.rod_step.collect_variables(staged, temp);
+            sp.rod_body.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<S_try_statement>();
+
+        struct Sparam
+          {
+            AVM_Rod rod_try;
+            Source_Location sloc_catch;
+            phsh_string name_except;
+            AVM_Rod rod_catch;
+          };
+
+        Sparam sp2;
+        do_solidify_nodes(sp2.rod_try, altr.code_try);
+        sp2.sloc_catch = altr.sloc_catch;
+        sp2.name_except = altr.name_except;
+        do_solidify_nodes(sp2.rod_catch, altr.code_catch);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // This is almost identical to JavaScript but not to C++. Only one
+            // `catch` clause is allowed.
+            AIR_Status status;
+            try {
+              // Execute the `try` block. If no exception is thrown, this will
+              // have little overhead.
+              status = do_execute_block(sp.rod_try, ctx);
+              if(status == air_status_return_ref)
+                ctx.stack().mut_top().check_function_result(ctx.global());
+              return status;
+            }
+            catch(Runtime_Error& except) {
+              // Append a frame due to exit of the `try` clause.
+              // Reuse the exception object. Don't bother allocating a new one.
+              except.push_frame_try(head->pv_meta->sloc);
+
+              // This branch must be executed inside this `catch` block.
+              // User-provided bindings may obtain the current exception using
+              // `::std::current_exception`.
+              Executive_Context ctx_catch(Executive_Context::M_plain(), ctx);
+              try {
+                // Set the exception reference.
+                auto& except_ref = ctx_catch.insert_named_reference(sp.name_except);
+                except_ref.set_temporary(except.value());
+
+                // Set backtrace frames.
+                V_array backtrace;
+                for(size_t k = 0;  k < except.count_frames();  ++k) {
+                  V_object r;
+                  r.try_emplace(sref("frame"), sref(describe_frame_type(except.frame(k).type)));
+                  r.try_emplace(sref("file"), except.frame(k).sloc.file());
+                  r.try_emplace(sref("line"), except.frame(k).sloc.line());
+                  r.try_emplace(sref("column"), except.frame(k).sloc.column());
+                  r.try_emplace(sref("value"), except.frame(k).value);
+                  backtrace.emplace_back(::std::move(r));
+                }
+                auto& backtrace_ref = ctx_catch.insert_named_reference(sref("__backtrace"));
+                backtrace_ref.set_temporary(::std::move(backtrace));
+
+                // Execute the `catch` clause.
+                status = sp.rod_catch.execute(ctx_catch);
+              }
+              catch(Runtime_Error& nested) {
+                ctx_catch.on_scope_exit_exceptional(nested);
+                nested.push_frame_catch(sp.sloc_catch, except.value());
+                throw;
+              }
+              ctx_catch.on_scope_exit_normal(status);
+              return status;
+            }
+          }
+
+          // Uparam
+          , Uparam()
+
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_try.collect_variables(staged, temp);
+            sp.rod_catch.collect_variables(staged, temp);
+          }
+
+          // Symbols
+          , &(altr.sloc_try)
+        );
+        return;
+      }
+
+      case index_throw_statement: {
+        const auto& altr = this->m_stor.as<S_throw_statement>();
+
+        struct Sparam
+          {
+            Source_Location sloc;
+          };
+
+        Sparam sp2;
+        sp2.sloc = altr.sloc;
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+
+            // Read a value and throw it. The operand expression must not have
+            // been empty for this function.
+            const auto& val = ctx.stack().top().dereference_readonly();
+            ctx.stack().pop();
+            throw Runtime_Error(Runtime_Error::M_throw(), val, sp.sloc);
+          }
+
+          // Uparam
           , Uparam()
 
           // Sparam
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            for(const auto& r : sp.clauses) {
-              r.rod_label.collect_variables(staged, temp);
-              r.rod_body.collect_variables(staged, temp);
-            }
-          }
+          , nullptr
 
           // Symbols
           , nullptr
@@ -1627,63 +3776,40 @@ solidify(AVM_Rod& rod) const
         return;
       }
 
-      case index_do_while_statement: {
-        const auto& altr = this->m_stor.as<S_do_while_statement>();
-
-        Uparam up2;
-        up2.b0 = altr.negative;
+      case index_assert_statement: {
+        const auto& altr = this->m_stor.as<S_assert_statement>();
 
         struct Sparam
           {
-            AVM_Rod rods_body;
-            AVM_Rod rods_cond;
+            Source_Location sloc;
+            cow_string msg;
           };
 
         Sparam sp2;
-        do_solidify_nodes(sp2.rods_body, altr.code_body);
-        do_solidify_nodes(sp2.rods_cond, altr.code_cond);
+        sp2.sloc = altr.sloc;
+        sp2.msg = altr.msg;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
-            const bool negative = head->uparam.b0;
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-            // This is identical to C.
-            AIR_Status status = air_status_next;
-            for(;;) {
-              // Execute the body.
-              status = do_execute_block(sp.rods_body, ctx);
-              if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while })) {
-                status = air_status_next;
-                break;
-              }
-              else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
-                                                     air_status_continue_while }))
-                break;
-
-              // Check the condition.
-              status = sp.rods_cond.execute(ctx);
-              ROCKET_ASSERT(status == air_status_next);
-              if(ctx.stack().top().dereference_readonly().test() == negative)
-                break;
-            }
-            return status;
+            // Throw an exception if the assertion fails. This cannot be disabled.
+            const auto& val = ctx.stack().top().dereference_readonly();
+            ctx.stack().pop();
+            if(!val.test())
+              throw Runtime_Error(Runtime_Error::M_assert(), sp.sloc, sp.msg);
+            return air_status_next;
           }
 
           // Uparam
-          , up2
+          , Uparam()
 
           // Sparam
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rods_body.collect_variables(staged, temp);
-            sp.rods_cond.collect_variables(staged, temp);
-          }
+          , nullptr
 
           // Symbols
           , nullptr
@@ -1691,184 +3817,101 @@ solidify(AVM_Rod& rod) const
         return;
       }
 
-      case index_while_statement: {
-        const auto& altr = this->m_stor.as<S_while_statement>();
+      case index_simple_status: {
+        const auto& altr = this->m_stor.as<S_simple_status>();
 
         Uparam up2;
-        up2.b0 = altr.negative;
+        up2.u0 = altr.status;
 
-        struct Sparam
+        rod.append(
+          +[](Executive_Context& /*ctx*/, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
-            AVM_Rod rods_cond;
-            AVM_Rod rods_body;
-          };
+            return static_cast<AIR_Status>(head->uparam.u0);
+          }
 
-        Sparam sp2;
-        do_solidify_nodes(sp2.rods_cond, altr.code_cond);
-        do_solidify_nodes(sp2.rods_body, altr.code_body);
+          // Uparam
+          , up2
+
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
+
+          // Collector
+          , nullptr
+
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
+
+      case index_check_argument: {
+        const auto& altr = this->m_stor.as<S_check_argument>();
+
+        Uparam up2;
+        up2.b0 = altr.by_ref;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
-            const bool negative = head->uparam.b0;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-
-            // This is identical to C.
-            AIR_Status status = air_status_next;
-            for(;;) {
-              // Check the condition.
-              status = sp.rods_cond.execute(ctx);
-              ROCKET_ASSERT(status == air_status_next);
-              if(ctx.stack().top().dereference_readonly().test() == negative)
-                break;
+            const bool by_ref = head->uparam.b0;
 
-              // Execute the body.
-              status = do_execute_block(sp.rods_body, ctx);
-              if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_while })) {
-                status = air_status_next;
-                break;
-              }
-              else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
-                                                     air_status_continue_while }))
-                break;
+            if(by_ref) {
+              // The argument is passed by reference, so check whether it is
+              // dereferenceable.
+              ctx.stack().top().dereference_readonly();
+              return air_status_next;
+            }
+            else {
+              // The argument is passed by copy, so convert it to a temporary.
+              ctx.stack().mut_top().dereference_copy();
+              return air_status_next;
             }
-            return status;
           }
 
           // Uparam
           , up2
 
           // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+          , 0, nullptr, nullptr, nullptr
 
           // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rods_cond.collect_variables(staged, temp);
-            sp.rods_body.collect_variables(staged, temp);
-          }
+          , nullptr
 
           // Symbols
-          , nullptr
+          , &(altr.sloc)
         );
         return;
       }
 
-      case index_for_each_statement: {
-        const auto& altr = this->m_stor.as<S_for_each_statement>();
+      case index_push_global_reference: {
+        const auto& altr = this->m_stor.as<S_push_global_reference>();
 
         struct Sparam
           {
-            phsh_string name_key;
-            phsh_string name_mapped;
-            Source_Location sloc_init;
-            AVM_Rod rod_init;
-            AVM_Rod rod_body;
+            phsh_string name;
           };
 
         Sparam sp2;
-        sp2.name_key = altr.name_key;
-        sp2.name_mapped = altr.name_mapped;
-        sp2.sloc_init = altr.sloc_init;
-        do_solidify_nodes(sp2.rod_init, altr.code_init);
-        do_solidify_nodes(sp2.rod_body, altr.code_body);
+        sp2.name = altr.name;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-            // We have to create an outer context due to the fact that the key
-            // and mapped references outlast every iteration.
-            Executive_Context ctx_for(Executive_Context::M_plain(), ctx);
-
-            // Create key and mapped references.
-            Reference* qkey_ref = nullptr;
-            if(!sp.name_key.empty())
-              qkey_ref = &(ctx_for.insert_named_reference(sp.name_key));
-            auto& mapped_ref = ctx_for.insert_named_reference(sp.name_mapped);
-
-            // Evaluate the range initializer and set the range up, which isn't
-            // going to change for all loops.
-            AIR_Status status = sp.rod_init.execute(ctx_for);
-            ROCKET_ASSERT(status == air_status_next);
-            mapped_ref = ::std::move(ctx_for.stack().mut_top());
-
-            const auto range = mapped_ref.dereference_readonly();
-            if(range.is_null()) {
-              // Do nothing.
-              return air_status_next;
-            }
-            else if(range.is_array()) {
-              const auto& arr = range.as_array();
-              mapped_ref.push_modifier(Reference_Modifier::S_array_head());  // placeholder
-              for(int64_t i = 0;  i < arr.ssize();  ++i) {
-                // Set the key variable which is the subscript of the mapped
-                // element in the array.
-                if(qkey_ref) {
-                  auto key_var = qkey_ref->unphase_variable_opt();
-                  if(!key_var) {
-                    key_var = ctx.global().garbage_collector()->create_variable();
-                    qkey_ref->set_variable(key_var);
-                  }
-                  key_var->initialize(i);
-                  key_var->set_immutable();
-                }
-
-                // Set the mapped reference.
-                mapped_ref.pop_modifier();
-                Reference_Modifier::S_array_index xmod = { i };
-                do_push_modifier_and_check(mapped_ref, ::std::move(xmod));
-
-                // Execute the loop body.
-                status = do_execute_block(sp.rod_body, ctx_for);
-                if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for })) {
-                  status = air_status_next;
-                  break;
-                }
-                else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
-                                                       air_status_continue_for }))
-                  break;
-              }
-              return status;
-            }
-            else if(range.is_object()) {
-              const auto& obj = range.as_object();
-              mapped_ref.push_modifier(Reference_Modifier::S_array_head());  // placeholder
-              for(auto it = obj.begin();  it != obj.end();  ++it) {
-                // Set the key variable which is the name of the mapped element
-                // in the object.
-                if(qkey_ref) {
-                  auto key_var = qkey_ref->unphase_variable_opt();
-                  if(!key_var) {
-                    key_var = ctx.global().garbage_collector()->create_variable();
-                    qkey_ref->set_variable(key_var);
-                  }
-                  key_var->initialize(it->first.rdstr());
-                  key_var->set_immutable();
-                }
-
-                // Set the mapped reference.
-                mapped_ref.pop_modifier();
-                Reference_Modifier::S_object_key xmod = { it->first };
-                do_push_modifier_and_check(mapped_ref, ::std::move(xmod));
+            // Look for the name in the global context.
+            auto qref = ctx.global().get_named_reference_opt(sp.name);
+            if(!qref)
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Undeclared identifier `$1`", sp.name);
 
-                // Execute the loop body.
-                status = do_execute_block(sp.rod_body, ctx_for);
-                if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for })) {
-                  status = air_status_next;
-                  break;
-                }
-                else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
-                                                       air_status_continue_for }))
-                  break;
-              }
-              return status;
-            }
-            else
-              throw Runtime_Error(Runtime_Error::M_assert(), sp.sloc_init,
-                        format_string("Range value not iterable (value `$1`)", range));
+            if(qref->is_invalid())
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Reference `$1` not initialized", sp.name);
+
+            // Push a copy of the reference onto the stack.
+            ctx.stack().push() = *qref;
+            return air_status_next;
           }
 
           // Uparam
@@ -1878,169 +3921,73 @@ solidify(AVM_Rod& rod) const
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_init.collect_variables(staged, temp);
-            sp.rod_body.collect_variables(staged, temp);
-          }
+          , nullptr
 
           // Symbols
-          , nullptr
+          , &(altr.sloc)
         );
         return;
       }
 
-      case index_for_statement: {
-        const auto& altr = this->m_stor.as<S_for_statement>();
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<S_push_local_reference>();
+
+        Uparam up2;
+        up2.u2345 = altr.depth;
 
         struct Sparam
           {
-            AVM_Rod rod_init;
-            AVM_Rod rod_cond;
-            AVM_Rod rod_step;
-            AVM_Rod rod_body;
+            phsh_string name;
+            uint32_t slot;
           };
 
         Sparam sp2;
-        do_solidify_nodes(sp2.rod_init, altr.code_init);
-        do_solidify_nodes(sp2.rod_cond, altr.code_cond);
-        do_solidify_nodes(sp2.rod_step, altr.code_step);
-        do_solidify_nodes(sp2.rod_body, altr.code_body);
+        sp2.name = altr.name;
+        sp2.slot = altr.slot;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
+            const uint32_t depth = head->uparam.u2345;
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-            // This is the same as the `for` statement in C. We have to create
-            // an outer context due to the fact that names declared in the first
-            // segment outlast every iteration.
-            Executive_Context ctx_for(Executive_Context::M_plain(), ctx);
-
-            // Execute the loop initializer, which shall only be a definition or
-            // an expression statement.
-            AIR_Status status = sp.rod_init.execute(ctx_for);
-            ROCKET_ASSERT(status == air_status_next);
-            for(;;) {
-              // Check the condition. There is a special case: If the condition
-              // is empty then the loop is infinite.
-              status = sp.rod_cond.execute(ctx_for);
-              ROCKET_ASSERT(status == air_status_next);
-              if(!ctx_for.stack().empty() && !ctx_for.stack().top().dereference_readonly().test())
-                break;
-
-              // Execute the body.
-              status = do_execute_block(sp.rod_body, ctx_for);
-              if(::rocket::is_any_of(status, { air_status_break_unspec, air_status_break_for })) {
-                status = air_status_next;
-                break;
-              }
-              else if(::rocket::is_none_of(status, { air_status_next, air_status_continue_unspec,
-                                                     air_status_continue_for }))
-                break;
-
-              // Execute the increment.
-              status = sp.rod_step.execute(ctx_for);
-              ROCKET_ASSERT(status == air_status_next);
-            }
-            return status;
+            // Push a copy of the reference onto the stack.
+            ctx.stack().push() = do_get_local_reference(ctx, depth, sp.name, sp.slot);
+            return air_status_next;
           }
 
           // Uparam
-          , Uparam()
+          , up2
 
           // Sparam
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_init.collect_variables(staged, temp);
-            sp.rod_cond.collect_variables(staged, temp);
-            sp.rod_step.collect_variables(staged, temp);
-            sp.rod_body.collect_variables(staged, temp);
-          }
+          , nullptr
 
           // Symbols
-          , nullptr
+          , &(altr.sloc)
         );
         return;
       }
 
-      case index_try_statement: {
-        const auto& altr = this->m_stor.as<S_try_statement>();
+      case index_push_bound_reference: {
+        const auto& altr = this->m_stor.as<S_push_bound_reference>();
 
         struct Sparam
           {
-            AVM_Rod rod_try;
-            Source_Location sloc_catch;
-            phsh_string name_except;
-            AVM_Rod rod_catch;
+            Reference ref;
           };
 
         Sparam sp2;
-        do_solidify_nodes(sp2.rod_try, altr.code_try);
-        sp2.sloc_catch = altr.sloc_catch;
-        sp2.name_except = altr.name_except;
-        do_solidify_nodes(sp2.rod_catch, altr.code_catch);
+        sp2.ref = altr.ref;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-
-            // This is almost identical to JavaScript but not to C++. Only one
-            // `catch` clause is allowed.
-            AIR_Status status;
-            try {
-              // Execute the `try` block. If no exception is thrown, this will
-              // have little overhead.
-              status = do_execute_block(sp.rod_try, ctx);
-              if(status == air_status_return_ref)
-                ctx.stack().mut_top().check_function_result(ctx.global());
-              return status;
-            }
-            catch(Runtime_Error& except) {
-              // Append a frame due to exit of the `try` clause.
-              // Reuse the exception object. Don't bother allocating a new one.
-              except.push_frame_try(head->pv_meta->sloc);
-
-              // This branch must be executed inside this `catch` block.
-              // User-provided bindings may obtain the current exception using
-              // `::std::current_exception`.
-              Executive_Context ctx_catch(Executive_Context::M_plain(), ctx);
-              try {
-                // Set the exception reference.
-                auto& except_ref = ctx_catch.insert_named_reference(sp.name_except);
-                except_ref.set_temporary(except.value());
-
-                // Set backtrace frames.
-                V_array backtrace;
-                for(size_t k = 0;  k < except.count_frames();  ++k) {
-                  V_object r;
-                  r.try_emplace(sref("frame"), sref(describe_frame_type(except.frame(k).type)));
-                  r.try_emplace(sref("file"), except.frame(k).sloc.file());
-                  r.try_emplace(sref("line"), except.frame(k).sloc.line());
-                  r.try_emplace(sref("column"), except.frame(k).sloc.column());
-                  r.try_emplace(sref("value"), except.frame(k).value);
-                  backtrace.emplace_back(::std::move(r));
-                }
-                auto& backtrace_ref = ctx_catch.insert_named_reference(sref("__backtrace"));
-                backtrace_ref.set_temporary(::std::move(backtrace));
-
-                // Execute the `catch` clause.
-                status = sp.rod_catch.execute(ctx_catch);
-              }
-              catch(Runtime_Error& nested) {
-                ctx_catch.on_scope_exit_exceptional(nested);
-                nested.push_frame_catch(sp.sloc_catch, except.value());
-                throw;
-              }
-              ctx_catch.on_scope_exit_normal(status);
-              return status;
-            }
+            ctx.stack().push() = sp.ref;
+            return air_status_next;
           }
 
           // Uparam
@@ -2050,40 +3997,48 @@ solidify(AVM_Rod& rod) const
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
           {
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_try.collect_variables(staged, temp);
-            sp.rod_catch.collect_variables(staged, temp);
+            sp.ref.collect_variables(staged, temp);
           }
 
           // Symbols
-          , &(altr.sloc_try)
+          , nullptr
         );
         return;
       }
 
-      case index_throw_statement: {
-        const auto& altr = this->m_stor.as<S_throw_statement>();
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<S_define_function>();
 
         struct Sparam
           {
-            Source_Location sloc;
+            Compiler_Options opts;
+            cow_string func;
+            cow_vector<phsh_string> params;
+            cow_vector<AIR_Node> code_body;
           };
 
         Sparam sp2;
-        sp2.sloc = altr.sloc;
+        sp2.opts = altr.opts;
+        sp2.func = altr.func;
+        sp2.params = altr.params;
+        sp2.code_body = altr.code_body;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            const auto& sloc = head->pv_meta->sloc;
 
-            // Read a value and throw it. The operand expression must not have
-            // been empty for this function.
-            const auto& val = ctx.stack().top().dereference_readonly();
-            ctx.stack().pop();
-            throw Runtime_Error(Runtime_Error::M_throw(), val, sp.sloc);
+            // Instantiate the function.
+            AIR_Optimizer optmz(sp.opts);
+            optmz.rebind(&ctx, sp.params, sp.code_body);
+
+            // Push the function as a temporary value.
+            ctx.stack().push().set_temporary(optmz.create_function(sloc, sp.func));
+            return air_status_next;
           }
 
           // Uparam
@@ -2093,65 +4048,84 @@ solidify(AVM_Rod& rod) const
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , nullptr
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            do_collect_variables_for_each(staged, temp, sp.code_body);
+          }
 
           // Symbols
-          , nullptr
+          , &(altr.sloc)
         );
         return;
       }
 
-      case index_assert_statement: {
-        const auto& altr = this->m_stor.as<S_assert_statement>();
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<S_branch_expression>();
+
+        Uparam up2;
+        up2.b0 = altr.assign;
 
         struct Sparam
           {
-            Source_Location sloc;
-            cow_string msg;
+            AVM_Rod rod_true;
+            AVM_Rod rod_false;
           };
 
         Sparam sp2;
-        sp2.sloc = altr.sloc;
-        sp2.msg = altr.msg;
+        do_solidify_nodes(sp2.rod_true, altr.code_true);
+        do_solidify_nodes(sp2.rod_false, altr.code_false);
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
+            const bool assign = head->uparam.b0;
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-            // Throw an exception if the assertion fails. This cannot be disabled.
-            const auto& val = ctx.stack().top().dereference_readonly();
-            ctx.stack().pop();
-            if(!val.test())
-              throw Runtime_Error(Runtime_Error::M_assert(), sp.sloc, sp.msg);
-            return air_status_next;
+            // Read the condition and evaluate the corresponding subexpression.
+            return ctx.stack().top().dereference_readonly().test()
+                     ? do_evaluate_subexpression(ctx, assign, sp.rod_true)
+                     : do_evaluate_subexpression(ctx, assign, sp.rod_false);
           }
 
           // Uparam
-          , Uparam()
+          , up2
 
           // Sparam
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , nullptr
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_true.collect_variables(staged, temp);
+            sp.rod_false.collect_variables(staged, temp);
+          }
 
           // Symbols
-          , nullptr
+          , &(altr.sloc)
         );
         return;
       }
 
-      case index_simple_status: {
-        const auto& altr = this->m_stor.as<S_simple_status>();
+      case index_function_call: {
+        const auto& altr = this->m_stor.as<S_function_call>();
 
         Uparam up2;
-        up2.u0 = altr.status;
+        up2.u0 = altr.ptc;
+        up2.u2345 = altr.nargs;
 
         rod.append(
-          +[](Executive_Context& /*ctx*/, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
-            return static_cast<AIR_Status>(head->uparam.u0);
+            const PTC_Aware ptc = static_cast<PTC_Aware>(head->uparam.u0);
+            const uint32_t nargs = head->uparam.u2345;
+            const auto& sloc = head->pv_meta->sloc;
+            const auto sentry = ctx.global().copy_recursion_sentry();
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
+
+            do_pop_arguments(ctx.alt_stack(), ctx.stack(), nargs);
+            return do_function_call(ctx, ptc, sloc);
           }
 
           // Uparam
@@ -2164,33 +4138,33 @@ solidify(AVM_Rod& rod) const
           , nullptr
 
           // Symbols
-          , nullptr
+          , &(altr.sloc)
         );
         return;
       }
 
-      case index_check_argument: {
-        const auto& altr = this->m_stor.as<S_check_argument>();
+      case index_push_unnamed_array: {
+        const auto& altr = this->m_stor.as<S_push_unnamed_array>();
 
         Uparam up2;
-        up2.b0 = altr.by_ref;
+        up2.u2345 = altr.nelems;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
-            const bool by_ref = head->uparam.b0;
+            const uint32_t nelems = head->uparam.u2345;
 
-            if(by_ref) {
-              // The argument is passed by reference, so check whether it is
-              // dereferenceable.
-              ctx.stack().top().dereference_readonly();
-              return air_status_next;
-            }
-            else {
-              // The argument is passed by copy, so convert it to a temporary.
-              ctx.stack().mut_top().dereference_copy();
-              return air_status_next;
+            // Pop elements from the stack and fill them from right to left.
+            V_array arr;
+            arr.resize(nelems);
+            for(auto it = arr.mut_rbegin();  it != arr.rend();  ++it) {
+              *it = ctx.stack().top().dereference_readonly();
+              ctx.stack().pop();
             }
+
+            // Push the array as a temporary.
+            ctx.stack().push().set_temporary(::std::move(arr));
+            return air_status_next;
           }
 
           // Uparam
@@ -2208,34 +4182,33 @@ solidify(AVM_Rod& rod) const
         return;
       }
 
-      case index_push_global_reference: {
-        const auto& altr = this->m_stor.as<S_push_global_reference>();
+      case index_push_unnamed_object: {
+        const auto& altr = this->m_stor.as<S_push_unnamed_object>();
 
         struct Sparam
           {
-            phsh_string name;
+            cow_vector<phsh_string> keys;
           };
 
         Sparam sp2;
-        sp2.name = altr.name;
+        sp2.keys = altr.keys;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-            // Look for the name in the global context.
-            auto qref = ctx.global().get_named_reference_opt(sp.name);
-            if(!qref)
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Undeclared identifier `$1`", sp.name);
-
-            if(qref->is_invalid())
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Reference `$1` not initialized", sp.name);
+            // Pop elements from the stack and set them from right to left. In case
+            // of duplicate keys, the rightmost value takes precedence.
+            V_object obj;
+            obj.reserve(sp.keys.size());
+            for(auto it = sp.keys.rbegin();  it != sp.keys.rend();  ++it) {
+              obj.try_emplace(*it, ctx.stack().top().dereference_readonly());
+              ctx.stack().pop();
+            }
 
-            // Push a copy of the reference onto the stack.
-            ctx.stack().push() = *qref;
+            // Push the object as a temporary.
+            ctx.stack().push().set_temporary(::std::move(obj));
             return air_status_next;
           }
 
@@ -2254,254 +4227,416 @@ solidify(AVM_Rod& rod) const
         return;
       }
 
-      case index_push_local_reference: {
-        const auto& altr = this->m_stor.as<S_push_local_reference>();
+      case index_apply_operator: {
+        const auto& altr = this->m_stor.as<S_apply_operator>();
 
         Uparam up2;
-        up2.u2345 = altr.depth;
+        up2.b0 = altr.assign;
+        up2.u1 = altr.xop;
 
-        struct Sparam
-          {
-            phsh_string name;
-          };
+        switch(altr.xop) {
+          case xop_inc:
+          case xop_dec:
+          case xop_unset:
+          case xop_head:
+          case xop_tail:
+          case xop_random:
+            // unary
+            rod.append(
+              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+              {
+                const bool assign = head->uparam.b0;
+                const uint8_t uxop = head->uparam.u1;
+                auto& top = ctx.stack().mut_top();
 
-        Sparam sp2;
-        sp2.name = altr.name;
+                switch(uxop) {
+                  case xop_inc: {
+                    // `assign` is `true` for the postfix variant and `false` for
+                    // the prefix variant.
+                    auto& rhs = top.dereference_mutable();
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const uint32_t depth = head->uparam.u2345;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+                    if(rhs.type() == type_integer) {
+                      V_integer& val = rhs.mut_integer();
 
-            // Locate the target context.
-            const Executive_Context* qctx = &ctx;
-            for(uint32_t k = 0;  k != depth;  ++k)
-              qctx = qctx->get_parent_opt();
+                      // Increment the value with overflow checking.
+                      int64_t result;
+                      if(ROCKET_ADD_OVERFLOW(val, 1, &result))
+                        throw Runtime_Error(Runtime_Error::M_format(),
+                                 "Integer increment overflow (operand was `$1`)", val);
 
-            // Look for the name in the target context.
-            auto qref = qctx->get_named_reference_opt(sp.name);
-            if(!qref)
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Undeclared identifier `$1`", sp.name);
+                      if(assign)
+                        top.set_temporary(val);
 
-            if(qref->is_invalid())
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Initialization of `$1` was bypassed", sp.name);
+                      val = result;
+                      return air_status_next;
+                    }
 
-            // Push a copy of the reference onto the stack.
-            ctx.stack().push() = *qref;
-            return air_status_next;
-          }
+                    if(rhs.type() == type_real) {
+                      V_real& val = rhs.mut_real();
 
-          // Uparam
-          , up2
+                      // Overflow will result in an infinity, so this is safe.
+                      double result = val + 1;
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+                      if(assign)
+                        top.set_temporary(val);
 
-          // Collector
-          , nullptr
+                      val = result;
+                      return air_status_next;
+                    }
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
+                    throw Runtime_Error(Runtime_Error::M_format(),
+                             "Increment not applicable (operand was `$1`)", rhs);
+                  }
 
-      case index_push_bound_reference: {
-        const auto& altr = this->m_stor.as<S_push_bound_reference>();
+                  case xop_dec: {
+                    // `assign` is `true` for the postfix variant and `false` for
+                    // the prefix variant.
+                    auto& rhs = top.dereference_mutable();
 
-        struct Sparam
-          {
-            Reference ref;
-          };
+                    if(rhs.type() == type_integer) {
+                      V_integer& val = rhs.mut_integer();
 
-        Sparam sp2;
-        sp2.ref = altr.ref;
+                      // Decrement the value with overflow checking.
+                      int64_t result;
+                      if(ROCKET_SUB_OVERFLOW(val, 1, &result))
+                        throw Runtime_Error(Runtime_Error::M_format(),
+                                 "Integer decrement overflow (operand was `$1`)", val);
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            ctx.stack().push() = sp.ref;
-            return air_status_next;
-          }
+                      if(assign)
+                        top.set_temporary(val);
 
-          // Uparam
-          , Uparam()
+                      val = result;
+                      return air_status_next;
+                    }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+                    if(rhs.type() == type_real) {
+                      V_real& val = rhs.mut_real();
+
+                      // Overflow will result in an infinity, so this is safe.
+                      double result = val - 1;
+
+                      if(assign)
+                        top.set_temporary(val);
+
+                      val = result;
+                      return air_status_next;
+                    }
+
+                    throw Runtime_Error(Runtime_Error::M_format(),
+                             "Decrement not applicable (operand was `$1`)", rhs);
+                  }
+
+                  case xop_unset: {
+                    // Unset the last element and return it as a temporary.
+                    // `assign` is ignored.
+                    auto val = top.dereference_unset();
+                    top.set_temporary(::std::move(val));
+                    return air_status_next;
+                  }
+
+                  case xop_head: {
+                    // Push an array head modifier. `assign` is ignored.
+                    Reference_Modifier::S_array_head xmod = { };
+                    do_push_modifier_and_check(top, ::std::move(xmod));
+                    return air_status_next;
+                  }
+
+                  case xop_tail: {
+                    // Push an array tail modifier. `assign` is ignored.
+                    Reference_Modifier::S_array_tail xmod = { };
+                    do_push_modifier_and_check(top, ::std::move(xmod));
+                    return air_status_next;
+                  }
+
+                  case xop_random: {
+                    // Push a random subscript.
+                    uint32_t seed = ctx.global().random_engine()->bump();
+                    Reference_Modifier::S_array_random xmod = { seed };
+                    do_push_modifier_and_check(top, ::std::move(xmod));
+                    return air_status_next;
+                  }
+
+                  default:
+                    ROCKET_UNREACHABLE();
+                }
+              }
+
+              // Uparam
+              , up2
+
+              // Sparam
+              , 0, nullptr, nullptr, nullptr
+
+              // Collector
+              , nullptr
+
+              // Symbols
+              , &(altr.sloc)
+            );
+            return;
+
+          case xop_assign:
+          case xop_index:
+            // binary
+            rod.append(
+              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+              {
+                const uint8_t uxop = head->uparam.u1;
+                auto& rhs = ctx.stack().mut_top().dereference_copy();
+                ctx.stack().pop();
+                auto& top = ctx.stack().mut_top();
+
+                switch(uxop) {
+                  case xop_assign: {
+                    // `assign` is ignored.
+                    top.dereference_mutable() = ::std::move(rhs);
+                    return air_status_next;
+                  }
+
+                  case xop_index: {
+                    // Push a subscript.
+                    if(rhs.type() == type_integer) {
+                      Reference_Modifier::S_array_index xmod = { rhs.as_integer() };
+                      do_push_modifier_and_check(top, ::std::move(xmod));
+                      return air_status_next;
+                    }
+                    else if(rhs.type() == type_string) {
+                      Reference_Modifier::S_object_key xmod = { rhs.as_string(), 0 };
+                      do_push_modifier_and_check(top, ::std::move(xmod));
+                      return air_status_next;
+                    }
+                    else
+                      throw Runtime_Error(Runtime_Error::M_format(),
+                               "Subscript value not valid (operand was `$1`)", rhs);
+                  }
+
+                  default:
+                    ROCKET_UNREACHABLE();
+                }
+              }
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.ref.collect_variables(staged, temp);
-          }
+              // Uparam
+              , up2
 
-          // Symbols
-          , nullptr
-        );
-        return;
-      }
+              // Sparam
+              , 0, nullptr, nullptr, nullptr
 
-      case index_define_function: {
-        const auto& altr = this->m_stor.as<S_define_function>();
+              // Collector
+              , nullptr
 
-        struct Sparam
-          {
-            Compiler_Options opts;
-            cow_string func;
-            cow_vector<phsh_string> params;
-            cow_vector<AIR_Node> code_body;
-          };
+              // Symbols
+              , &(altr.sloc)
+            );
+            return;
 
-        Sparam sp2;
-        sp2.opts = altr.opts;
-        sp2.func = altr.func;
-        sp2.params = altr.params;
-        sp2.code_body = altr.code_body;
+          case xop_pos:
+          case xop_neg:
+          case xop_notb:
+          case xop_notl:
+          case xop_countof:
+          case xop_typeof:
+          case xop_sqrt:
+          case xop_isnan:
+          case xop_isinf:
+          case xop_abs:
+          case xop_sign:
+          case xop_round:
+          case xop_floor:
+          case xop_ceil:
+          case xop_trunc:
+          case xop_iround:
+          case xop_ifloor:
+          case xop_iceil:
+          case xop_itrunc:
+          case xop_lzcnt:
+          case xop_tzcnt:
+          case xop_popcnt:
+            // unary
+            rod.append(
+              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+              {
+                const bool assign = head->uparam.b0;
+                const uint8_t uxop = head->uparam.u1;
+                auto& top = ctx.stack().mut_top();
+                auto& rhs = assign ? top.dereference_mutable() : top.dereference_copy();
+                return do_apply_unary_operator(uxop, rhs);
+              }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            const auto& sloc = head->pv_meta->sloc;
+              // Uparam
+              , up2
 
-            // Instantiate the function.
-            AIR_Optimizer optmz(sp.opts);
-            optmz.rebind(&ctx, sp.params, sp.code_body);
+              // Sparam
+              , 0, nullptr, nullptr, nullptr
 
-            // Push the function as a temporary value.
-            ctx.stack().push().set_temporary(optmz.create_function(sloc, sp.func));
-            return air_status_next;
-          }
+              // Collector
+              , nullptr
 
-          // Uparam
-          , Uparam()
+              // Symbols
+              , &(altr.sloc)
+            );
+            return;
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+          case xop_cmp_eq:
+          case xop_cmp_ne:
+          case xop_cmp_un:
+          case xop_cmp_lt:
+          case xop_cmp_gt:
+          case xop_cmp_lte:
+          case xop_cmp_gte:
+          case xop_cmp_3way:
+          case xop_add:
+          case xop_sub:
+          case xop_mul:
+          case xop_div:
+          case xop_mod:
+          case xop_andb:
+          case xop_orb:
+          case xop_xorb:
+          case xop_addm:
+          case xop_subm:
+          case xop_mulm:
+          case xop_adds:
+          case xop_subs:
+          case xop_muls:
+            // binary; specialized when operand types are stable
+            rod.append(
+              do_execute_binary_operator
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            do_collect_variables_for_each(staged, temp, sp.code_body);
-          }
+              // Uparam
+              , up2
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
+              // Sparam
+              , sizeof(Binary_Feedback), nullptr, nullptr, nullptr
 
-      case index_branch_expression: {
-        const auto& altr = this->m_stor.as<S_branch_expression>();
+              // Collector
+              , nullptr
 
-        Uparam up2;
-        up2.b0 = altr.assign;
+              // Symbols
+              , &(altr.sloc)
+            );
+            return;
 
-        struct Sparam
-          {
-            AVM_Rod rod_true;
-            AVM_Rod rod_false;
-          };
+          case xop_sll:
+          case xop_srl:
+          case xop_sla:
+          case xop_sra:
+            // shift
+            rod.append(
+              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+              {
+                const bool assign = head->uparam.b0;
+                const uint8_t uxop = head->uparam.u1;
+                const auto& rhs = ctx.stack().top().dereference_readonly();
+                ctx.stack().pop();
+                auto& top = ctx.stack().mut_top();
+                auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
 
-        Sparam sp2;
-        do_solidify_nodes(sp2.rod_true, altr.code_true);
-        do_solidify_nodes(sp2.rod_false, altr.code_false);
+                if(rhs.type() != type_integer)
+                  throw Runtime_Error(Runtime_Error::M_format(),
+                           "Invalid shift count (operands were `$1` and `$2`)",
+                           lhs, rhs);
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const bool assign = head->uparam.b0;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+                return do_apply_binary_operator_with_integer(uxop, lhs, rhs.as_integer());
+              }
 
-            // Read the condition and evaluate the corresponding subexpression.
-            return ctx.stack().top().dereference_readonly().test()
-                     ? do_evaluate_subexpression(ctx, assign, sp.rod_true)
-                     : do_evaluate_subexpression(ctx, assign, sp.rod_false);
-          }
+              // Uparam
+              , up2
 
-          // Uparam
-          , up2
+              // Sparam
+              , 0, nullptr, nullptr, nullptr
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+              // Collector
+              , nullptr
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_true.collect_variables(staged, temp);
-            sp.rod_false.collect_variables(staged, temp);
-          }
+              // Symbols
+              , &(altr.sloc)
+            );
+            return;
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
+          case xop_fma:
+            // fused multiply-add; ternary
+            rod.append(
+              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+              {
+                const bool assign = head->uparam.b0;
+                const auto& rhs = ctx.stack().top().dereference_readonly();
+                ctx.stack().pop();
+                const auto& mid = ctx.stack().top().dereference_readonly();
+                ctx.stack().pop();
+                auto& top = ctx.stack().mut_top();
+                auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
 
-      case index_function_call: {
-        const auto& altr = this->m_stor.as<S_function_call>();
+                // Perform floating-point fused multiply-add.
+                if(lhs.is_real() && mid.is_real() && rhs.is_real()) {
+                  V_real& val = lhs.mut_real();
+                  V_real y_mul = mid.as_real();
+                  V_real z_add = rhs.as_real();
 
-        Uparam up2;
-        up2.u0 = altr.ptc;
-        up2.u2345 = altr.nargs;
+                  val = ::std::fma(val, y_mul, z_add);
+                  return air_status_next;
+                }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const PTC_Aware ptc = static_cast<PTC_Aware>(head->uparam.u0);
-            const uint32_t nargs = head->uparam.u2345;
-            const auto& sloc = head->pv_meta->sloc;
-            const auto sentry = ctx.global().copy_recursion_sentry();
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
+                throw Runtime_Error(Runtime_Error::M_format(),
+                         "`__fma` not applicable (operands were `$1`, `$2` and `$3`)",
+                         lhs, mid, rhs);
+              }
 
-            do_pop_arguments(ctx.alt_stack(), ctx.stack(), nargs);
-            return do_function_call(ctx, ptc, sloc);
-          }
+              // Uparam
+              , up2
 
-          // Uparam
-          , up2
+              // Sparam
+              , 0, nullptr, nullptr, nullptr
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+              // Collector
+              , nullptr
 
-          // Collector
-          , nullptr
+              // Symbols
+              , &(altr.sloc)
+            );
+            return;
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+          default:
+            ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), altr.xop);
+        }
       }
 
-      case index_push_unnamed_array: {
-        const auto& altr = this->m_stor.as<S_push_unnamed_array>();
+      case index_unpack_struct_array: {
+        const auto& altr = this->m_stor.as<S_unpack_struct_array>();
 
         Uparam up2;
+        up2.b0 = altr.immutable;
         up2.u2345 = altr.nelems;
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
+            const bool immutable = head->uparam.b0;
             const uint32_t nelems = head->uparam.u2345;
 
-            // Pop elements from the stack and fill them from right to left.
-            V_array arr;
-            arr.resize(nelems);
-            for(auto it = arr.mut_rbegin();  it != arr.rend();  ++it) {
-              *it = ctx.stack().top().dereference_readonly();
+            // Read the value of the initializer.
+            const auto& init = ctx.stack().top().dereference_readonly();
+            ctx.stack().pop();
+
+            // Make sure it is really an array.
+            if(!init.is_null() && !init.is_array())
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Initializer was not an array (value was `$1`)", init);
+
+            for(uint32_t i = nelems - 1;  i != UINT32_MAX;  --i) {
+              // Pop variables from from right to left.
+              auto var = ctx.stack().top().unphase_variable_opt();
               ctx.stack().pop();
-            }
+              ROCKET_ASSERT(var && !var->is_initialized());
 
-            // Push the array as a temporary.
-            ctx.stack().push().set_temporary(::std::move(arr));
+              if(ROCKET_EXPECT(init.is_array()))
+                if(auto ielem = init.as_array().ptr(i))
+                  var->initialize(*ielem);
+
+              if(ROCKET_UNEXPECT(!var->is_initialized()))
+                var->initialize(nullopt);
+
+              var->set_immutable(immutable);
+            }
             return air_status_next;
           }
 
@@ -2520,8 +4655,11 @@ solidify(AVM_Rod& rod) const
         return;
       }
 
-      case index_push_unnamed_object: {
-        const auto& altr = this->m_stor.as<S_push_unnamed_object>();
+      case index_unpack_struct_object: {
+        const auto& altr = this->m_stor.as<S_unpack_struct_object>();
+
+        Uparam up2;
+        up2.b0 = altr.immutable;
 
         struct Sparam
           {
@@ -2534,24 +4672,38 @@ solidify(AVM_Rod& rod) const
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
+            const bool immutable = head->uparam.b0;
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-            // Pop elements from the stack and set them from right to left. In case
-            // of duplicate keys, the rightmost value takes precedence.
-            V_object obj;
-            obj.reserve(sp.keys.size());
+            // Read the value of the initializer.
+            const auto& init = ctx.stack().top().dereference_readonly();
+            ctx.stack().pop();
+
+            // Make sure it is really an object.
+            if(!init.is_null() && !init.is_object())
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Initializer was not an object (value was `$1`)", init);
+
             for(auto it = sp.keys.rbegin();  it != sp.keys.rend();  ++it) {
-              obj.try_emplace(*it, ctx.stack().top().dereference_readonly());
+              // Pop variables from from right to left.
+              auto var = ctx.stack().top().unphase_variable_opt();
               ctx.stack().pop();
-            }
+              ROCKET_ASSERT(var && !var->is_initialized());
 
-            // Push the object as a temporary.
-            ctx.stack().push().set_temporary(::std::move(obj));
+              if(ROCKET_EXPECT(init.is_object()))
+                if(auto ielem = init.as_object().ptr(*it))
+                  var->initialize(*ielem);
+
+              if(ROCKET_UNEXPECT(!var->is_initialized()))
+                var->initialize(nullopt);
+
+              var->set_immutable(immutable);
+            }
             return air_status_next;
           }
 
           // Uparam
-          , Uparam()
+          , up2
 
           // Sparam
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
@@ -2565,955 +4717,745 @@ solidify(AVM_Rod& rod) const
         return;
       }
 
-      case index_apply_operator: {
-        const auto& altr = this->m_stor.as<S_apply_operator>();
+      case index_define_null_variable: {
+        const auto& altr = this->m_stor.as<S_define_null_variable>();
 
         Uparam up2;
-        up2.b0 = altr.assign;
-        up2.u1 = altr.xop;
-
-        switch(altr.xop) {
-          case xop_inc:
-          case xop_dec:
-          case xop_unset:
-          case xop_head:
-          case xop_tail:
-          case xop_random:
-            // unary
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const bool assign = head->uparam.b0;
-                const uint8_t uxop = head->uparam.u1;
-                auto& top = ctx.stack().mut_top();
-
-                switch(uxop) {
-                  case xop_inc: {
-                    // `assign` is `true` for the postfix variant and `false` for
-                    // the prefix variant.
-                    auto& rhs = top.dereference_mutable();
-
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
-
-                      // Increment the value with overflow checking.
-                      int64_t result;
-                      if(ROCKET_ADD_OVERFLOW(val, 1, &result))
-                        throw Runtime_Error(Runtime_Error::M_format(),
-                                 "Integer increment overflow (operand was `$1`)", val);
-
-                      if(assign)
-                        top.set_temporary(val);
-
-                      val = result;
-                      return air_status_next;
-                    }
-
-                    if(rhs.type() == type_real) {
-                      V_real& val = rhs.mut_real();
-
-                      // Overflow will result in an infinity, so this is safe.
-                      double result = val + 1;
-
-                      if(assign)
-                        top.set_temporary(val);
-
-                      val = result;
-                      return air_status_next;
-                    }
-
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Increment not applicable (operand was `$1`)", rhs);
-                  }
-
-                  case xop_dec: {
-                    // `assign` is `true` for the postfix variant and `false` for
-                    // the prefix variant.
-                    auto& rhs = top.dereference_mutable();
-
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
-
-                      // Decrement the value with overflow checking.
-                      int64_t result;
-                      if(ROCKET_SUB_OVERFLOW(val, 1, &result))
-                        throw Runtime_Error(Runtime_Error::M_format(),
-                                 "Integer decrement overflow (operand was `$1`)", val);
-
-                      if(assign)
-                        top.set_temporary(val);
-
-                      val = result;
-                      return air_status_next;
-                    }
-
-                    if(rhs.type() == type_real) {
-                      V_real& val = rhs.mut_real();
-
-                      // Overflow will result in an infinity, so this is safe.
-                      double result = val - 1;
-
-                      if(assign)
-                        top.set_temporary(val);
-
-                      val = result;
-                      return air_status_next;
-                    }
-
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Decrement not applicable (operand was `$1`)", rhs);
-                  }
+        up2.b0 = altr.immutable;
+        up2.u2345 = altr.slot;
 
-                  case xop_unset: {
-                    // Unset the last element and return it as a temporary.
-                    // `assign` is ignored.
-                    auto val = top.dereference_unset();
-                    top.set_temporary(::std::move(val));
-                    return air_status_next;
-                  }
+        struct Sparam
+          {
+            phsh_string name;
+          };
 
-                  case xop_head: {
-                    // Push an array head modifier. `assign` is ignored.
-                    Reference_Modifier::S_array_head xmod = { };
-                    do_push_modifier_and_check(top, ::std::move(xmod));
-                    return air_status_next;
-                  }
+        Sparam sp2;
+        sp2.name = altr.name;
 
-                  case xop_tail: {
-                    // Push an array tail modifier. `assign` is ignored.
-                    Reference_Modifier::S_array_tail xmod = { };
-                    do_push_modifier_and_check(top, ::std::move(xmod));
-                    return air_status_next;
-                  }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool immutable = head->uparam.b0;
+            const uint32_t slot = head->uparam.u2345;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            const auto& sloc = head->pv_meta->sloc;
 
-                  case xop_random: {
-                    // Push a random subscript.
-                    uint32_t seed = ctx.global().random_engine()->bump();
-                    Reference_Modifier::S_array_random xmod = { seed };
-                    do_push_modifier_and_check(top, ::std::move(xmod));
-                    return air_status_next;
-                  }
+            // Allocate a variable and inject it into the current context.
+            const auto gcoll = ctx.global().garbage_collector();
+            const auto var = gcoll->create_variable();
+            ctx.insert_named_reference(sp.name, slot).set_variable(var);
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_variable_declare, sloc, sp.name);
 
-                  default:
-                    ROCKET_UNREACHABLE();
-                }
-              }
+            // Initialize it to null.
+            var->initialize(nullopt);
+            var->set_immutable(immutable);
+            return air_status_next;
+          }
 
-              // Uparam
-              , up2
+          // Uparam
+          , up2
 
-              // Sparam
-              , 0, nullptr, nullptr, nullptr
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-              // Collector
-              , nullptr
+          // Collector
+          , nullptr
 
-              // Symbols
-              , &(altr.sloc)
-            );
-            return;
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-          case xop_assign:
-          case xop_index:
-            // binary
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const uint8_t uxop = head->uparam.u1;
-                auto& rhs = ctx.stack().mut_top().dereference_copy();
-                ctx.stack().pop();
-                auto& top = ctx.stack().mut_top();
+      case index_single_step_trap: {
+        const auto& altr = this->m_stor.as<S_single_step_trap>();
 
-                switch(uxop) {
-                  case xop_assign: {
-                    // `assign` is ignored.
-                    top.dereference_mutable() = ::std::move(rhs);
-                    return air_status_next;
-                  }
+        (void) altr;
 
-                  case xop_index: {
-                    // Push a subscript.
-                    if(rhs.type() == type_integer) {
-                      Reference_Modifier::S_array_index xmod = { rhs.as_integer() };
-                      do_push_modifier_and_check(top, ::std::move(xmod));
-                      return air_status_next;
-                    }
-                    else if(rhs.type() == type_string) {
-                      Reference_Modifier::S_object_key xmod = { rhs.as_string() };
-                      do_push_modifier_and_check(top, ::std::move(xmod));
-                      return air_status_next;
-                    }
-                    else
-                      throw Runtime_Error(Runtime_Error::M_format(),
-                               "Subscript value not valid (operand was `$1`)", rhs);
-                  }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, head->pv_meta->sloc);
+            return air_status_next;
+          }
 
-                  default:
-                    ROCKET_UNREACHABLE();
-                }
-              }
+          // Uparam
+          , Uparam()
 
-              // Uparam
-              , up2
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
 
-              // Sparam
-              , 0, nullptr, nullptr, nullptr
+          // Collector
+          , nullptr
 
-              // Collector
-              , nullptr
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-              // Symbols
-              , &(altr.sloc)
-            );
-            return;
+      case index_variadic_call: {
+        const auto& altr = this->m_stor.as<S_variadic_call>();
 
-          case xop_pos:
-          case xop_neg:
-          case xop_notb:
-          case xop_notl:
-          case xop_countof:
-          case xop_typeof:
-          case xop_sqrt:
-          case xop_isnan:
-          case xop_isinf:
-          case xop_abs:
-          case xop_sign:
-          case xop_round:
-          case xop_floor:
-          case xop_ceil:
-          case xop_trunc:
-          case xop_iround:
-          case xop_ifloor:
-          case xop_iceil:
-          case xop_itrunc:
-          case xop_lzcnt:
-          case xop_tzcnt:
-          case xop_popcnt:
-            // unary
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const bool assign = head->uparam.b0;
-                const uint8_t uxop = head->uparam.u1;
-                auto& top = ctx.stack().mut_top();
-                auto& rhs = assign ? top.dereference_mutable() : top.dereference_copy();
+        Uparam up2;
+        up2.u0 = altr.ptc;
 
-                switch(uxop) {
-                  case xop_pos: {
-                    // This operator does nothing.
-                    return air_status_next;
-                  }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const PTC_Aware ptc = static_cast<PTC_Aware>(head->uparam.u0);
+            const auto& sloc = head->pv_meta->sloc;
+            const auto sentry = ctx.global().copy_recursion_sentry();
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
 
-                  case xop_neg: {
-                    // Get the additive inverse of the operand.
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
+            ctx.alt_stack().clear();
+            auto va_gen = ctx.stack().top().dereference_readonly();
+            if(va_gen.type() == type_null) {
+              // There is no argument.
+              ctx.stack().pop();
+              return do_function_call(ctx, ptc, sloc);
+            }
+            else if(va_gen.type() == type_array) {
+              // Arguments are temporary values.
+              ctx.stack().pop();
+              for(const auto& val : va_gen.as_array())
+                ctx.alt_stack().push().set_temporary(val);
+              return do_function_call(ctx, ptc, sloc);
+            }
+            else if(va_gen.type() == type_function) {
+              // Invoke the generator with no argument to get the number of
+              // variadic arguments to generate. This destroys its `this`
+              // reference so we have to stash it first.
+              auto va_self = ctx.stack().mut_top().pop_modifier();
+              do_invoke_maybe_tail(ctx.stack().mut_top(), ctx.global(), ptc_aware_none, sloc,
+                                   va_gen.as_function(), ::std::move(ctx.alt_stack()));
+              auto va_num = ctx.stack().top().dereference_readonly();
+              ctx.stack().pop();
 
-                      int64_t result;
-                      if(ROCKET_SUB_OVERFLOW(0, val, &result))
-                        throw Runtime_Error(Runtime_Error::M_format(),
-                                 "Integer negation overflow (operand was `$1`)", val);
+              if(va_num.type() != type_integer)
+                throw Runtime_Error(Runtime_Error::M_format(),
+                         "Variadic argument count was not an integer (value `$1`)", va_num);
 
-                      val = result;
-                      return air_status_next;
-                    }
+              if((va_num.as_integer() < 0) || (va_num.as_integer() > INT_MAX))
+                throw Runtime_Error(Runtime_Error::M_format(),
+                         "Variadic argument count was not valid (value `$1`)", va_num);
 
-                    if(rhs.type() == type_real) {
-                      V_real& val = rhs.mut_real();
+              // Generate arguments into `stack`.
+              for(V_integer va_idx = 0;  va_idx != va_num.as_integer();  ++va_idx) {
+                auto& va_arg_self = ctx.stack().push();
+                va_arg_self = va_self;
+                ctx.alt_stack().clear();
+                ctx.alt_stack().push().set_temporary(va_idx);
+                do_invoke_maybe_tail(va_arg_self, ctx.global(), ptc_aware_none, sloc,
+                                     va_gen.as_function(), ::std::move(ctx.alt_stack()));
+                va_arg_self.dereference_readonly();
+              }
 
-                      int64_t bits;
-                      bcopy(bits, val);
-                      bits ^= INT64_MIN;
+              do_pop_arguments(ctx.alt_stack(), ctx.stack(), static_cast<uint32_t>(va_num.as_integer()));
+              return do_function_call(ctx, ptc, sloc);
+            }
+            else
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Invalid variadic argument generator (value `$1`)", va_gen);
+          }
 
-                      bcopy(val, bits);
-                      return air_status_next;
-                    }
+          // Uparam
+          , up2
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Arithmetic negation not applicable (operand was `$1`)", rhs);
-                  }
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
 
-                  case xop_notb: {
-                    // Flip all bits (of all bytes) in the operand.
-                    if(rhs.type() == type_boolean) {
-                      V_boolean& val = rhs.mut_boolean();
-                      val = !val;
-                      return air_status_next;
-                    }
+          // Collector
+          , nullptr
 
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
-                      val = ~val;
-                      return air_status_next;
-                    }
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                    if(rhs.type() == type_string) {
-                      V_string& val = rhs.mut_string();
-                      for(auto it = val.mut_begin();  it != val.end();  ++it)
-                        *it = static_cast<char>(*it ^ -1);
-                      return air_status_next;
-                    }
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<S_defer_expression>();
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Bitwise NOT not applicable (operand was `$1`)", rhs);
-                  }
+        struct Sparam
+          {
+            cow_vector<AIR_Node> code_body;
+          };
 
-                  case xop_notl: {
-                    // Perform the builtin boolean conversion and negate the result.
-                    rhs = !rhs.test();
-                    return air_status_next;
-                  }
+        Sparam sp2;
+        sp2.code_body = altr.code_body;
 
-                  case xop_countof: {
-                    // Get the number of elements in the operand.
-                    if(rhs.type() == type_null) {
-                      rhs = V_integer(0);
-                      return air_status_next;
-                    }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            const auto& sloc = head->pv_meta->sloc;
 
-                    if(rhs.type() == type_string) {
-                      rhs = V_integer(rhs.as_string().size());
-                      return air_status_next;
-                    }
+            // Capture local references at this time.
+            bool dirty = false;
+            auto bound_body = sp.code_body;
+            do_rebind_nodes(dirty, bound_body, ctx);
 
-                    if(rhs.type() == type_array) {
-                      rhs = V_integer(rhs.as_array().size());
-                      return air_status_next;
-                    }
+            // Instantiate the expression and push it to the current context.
+            AVM_Rod rod_body;
+            do_solidify_nodes(rod_body, bound_body);
+            ctx.mut_defer().emplace_back(sloc, ::std::move(rod_body));
+            return air_status_next;
+          }
 
-                    if(rhs.type() == type_object) {
-                      rhs = V_integer(rhs.as_object().size());
-                      return air_status_next;
-                    }
+          // Uparam
+          , Uparam()
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`countof` not applicable (operand was `$1`)", rhs);
-                  }
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                  case xop_typeof: {
-                    // Ge the type of the operand as a string.
-                    rhs = ::rocket::sref(describe_type(rhs.type()));
-                    return air_status_next;
-                  }
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            do_collect_variables_for_each(staged, temp, sp.code_body);
+          }
 
-                  case xop_sqrt: {
-                    // Get the arithmetic square root of the operand, as a real number.
-                    if(rhs.is_real()) {
-                      rhs = ::std::sqrt(rhs.as_real());
-                      return air_status_next;
-                    }
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__sqrt` not applicable (operand was `$1`)", rhs);
-                  }
+      case index_import_call: {
+        const auto& altr = this->m_stor.as<S_import_call>();
 
-                  case xop_isnan: {
-                    // Checks whether the operand is a NaN. The operand must be of an
-                    // arithmetic type. An integer is never a NaN.
-                    if(rhs.type() == type_integer) {
-                      rhs = false;
-                      return air_status_next;
-                    }
+        Uparam up2;
+        up2.u2345 = altr.nargs;
+
+        struct Sparam
+          {
+            Compiler_Options opts;
+          };
 
-                    if(rhs.type() == type_real) {
-                      rhs = ::std::isnan(rhs.as_real());
-                      return air_status_next;
-                    }
+        Sparam sp2;
+        sp2.opts = altr.opts;
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__isnan` not applicable (operand was `$1`)", rhs);
-                  }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const uint32_t nargs = head->uparam.u2345;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            const auto& sloc = head->pv_meta->sloc;
+            const auto sentry = ctx.global().copy_recursion_sentry();
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
 
-                  case xop_isinf: {
-                    // Checks whether the operand is an infinity. The operand must be of
-                    // an arithmetic type. An integer is never an infinity.
-                    if(rhs.type() == type_integer) {
-                      rhs = false;
-                      return air_status_next;
-                    }
+            ROCKET_ASSERT(nargs != 0);
+            do_pop_arguments(ctx.alt_stack(), ctx.stack(), nargs - 1);
 
-                    if(rhs.type() == type_real) {
-                      rhs = ::std::isinf(rhs.as_real());
-                      return air_status_next;
-                    }
+            // Get the path to import.
+            const auto& path_val = ctx.stack().top().dereference_readonly();
+            if(path_val.type() != type_string)
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Path was not a string (value `$1`)", path_val);
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__isinf` not applicable (operand was `$1`)", rhs);
-                  }
+            if(path_val.as_string() == "")
+              throw Runtime_Error(Runtime_Error::M_format(), "Path was empty");
 
-                  case xop_abs: {
-                    // Get the absolute value of the operand.
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
+            // If the path is relative, resolve it to an absolute one.
+            cow_string abs_path = path_val.as_string();
+            const auto& src_file = sloc.file();
+            if((abs_path[0] != '/') && (src_file[0] == '/'))
+              abs_path.insert(0, src_file, 0, src_file.rfind('/') + 1);
 
-                      V_integer neg_val;
-                      if(ROCKET_SUB_OVERFLOW(0, val, &neg_val))
-                        throw Runtime_Error(Runtime_Error::M_format(),
-                                 "Integer negation overflow (operand was `$1`)", val);
+            unique_ptr<char, void (void*)> realpathp(::free);
+            if(!realpathp.reset(::realpath(abs_path.safe_c_str(), nullptr)))
+              throw Runtime_Error(Runtime_Error::M_format(),
+                       "Could not open script file '$1': ${errno:full}", path_val);
 
-                      val ^= (val ^ neg_val) & (val >> 63);
-                      return air_status_next;
-                    }
+            // Load and parse the file.
+            abs_path.assign(realpathp.get());
+            Source_Location script_sloc(abs_path, 0, 0);
 
-                    if(rhs.type() == type_real) {
-                      V_real& val = rhs.mut_real();
+            const auto loader = ctx.global().module_loader();
+            Module_Loader::Unique_Stream istrm;
+            istrm.reset(loader, realpathp);
 
-                      double result = ::std::fabs(val);
+            // Reuse the compiled module if the file has not been modified since.
+            auto& cached = loader->mut_cached_module(abs_path, sp.opts, istrm);
+            if(!cached) {
+              Token_Stream tstrm(sp.opts);
+              tstrm.reload(abs_path, 1, ::std::move(istrm.get()));
 
-                      val = result;
-                      return air_status_next;
-                    }
+              Statement_Sequence stmtq(sp.opts);
+              stmtq.reload(::std::move(tstrm));
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__abs` not applicable (operand was `$1`)", rhs);
-                  }
+              // Instantiate the script as a variadic function.
+              cow_vector<phsh_string> script_params;
+              script_params.emplace_back(sref("..."));
 
-                  case xop_sign: {
-                    // Get the sign bit of the operand as a boolean value.
-                    if(rhs.type() == type_integer) {
-                      rhs = rhs.as_integer() < 0;
-                      return air_status_next;
-                    }
+              AIR_Optimizer optmz(sp.opts);
+              optmz.reload(nullptr, script_params, ctx.global(), stmtq.get_statements());
 
-                    if(rhs.type() == type_real) {
-                      rhs = ::std::signbit(rhs.as_real());
-                      return air_status_next;
-                    }
+              cached = optmz.create_function(script_sloc, sref("[file scope]"));
+            }
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__sign` not applicable (operand was `$1`)", rhs);
-                  }
+            auto target = cached;
 
-                  case xop_round: {
-                    // Round the operand to the nearest integer of the same type.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+            auto& self = ctx.stack().mut_top().set_temporary(nullopt);
+            ctx.stack().clear_red_zone();
+            return do_invoke_maybe_tail(self, ctx.global(), ptc_aware_none, sloc, target,
+                                        ::std::move(ctx.alt_stack()));
+          }
 
-                    if(rhs.type() == type_real) {
-                      rhs.mut_real() = ::std::round(rhs.as_real());
-                      return air_status_next;
-                    }
+          // Uparam
+          , up2
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__round` not applicable (operand was `$1`)", rhs);
-                  }
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                  case xop_floor: {
-                    // Round the operand to the nearest integer of the same type,
-                    // towards negative infinity.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+          // Collector
+          , nullptr
 
-                    if(rhs.type() == type_real) {
-                      rhs.mut_real() = ::std::floor(rhs.as_real());
-                      return air_status_next;
-                    }
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__floor` not applicable (operand was `$1`)", rhs);
-                  }
+      case index_declare_reference: {
+        const auto& altr = this->m_stor.as<S_declare_reference>();
 
-                  case xop_ceil: {
-                    // Round the operand to the nearest integer of the same type,
-                    // towards positive infinity.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+        Uparam up2;
+        up2.u2345 = altr.slot;
 
-                    if(rhs.type() == type_real) {
-                      rhs.mut_real() = ::std::ceil(rhs.as_real());
-                      return air_status_next;
-                    }
+        struct Sparam
+          {
+            phsh_string name;
+          };
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__ceil` not applicable (operand was `$1`)", rhs);
-                  }
+        Sparam sp2;
+        sp2.name = altr.name;
 
-                  case xop_trunc: {
-                    // Truncate the operand to the nearest integer towards zero.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const uint32_t slot = head->uparam.u2345;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-                    if(rhs.type() == type_real) {
-                      rhs.mut_real() = ::std::trunc(rhs.as_real());
-                      return air_status_next;
-                    }
+            // Declare a void reference.
+            ctx.insert_named_reference(sp.name, slot).clear();
+            return air_status_next;
+          }
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__trunc` not applicable (operand was `$1`)", rhs);
-                  }
+          // Uparam
+          , up2
 
-                  case xop_iround: {
-                    // Round the operand to the nearest integer.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                    if(rhs.type() == type_real) {
-                      rhs = safe_double_to_int64(::std::round(rhs.as_real()));
-                      return air_status_next;
-                    }
+          // Collector
+          , nullptr
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__iround` not applicable (operand was `$1`)", rhs);
-                  }
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
 
-                  case xop_ifloor: {
-                    // Round the operand to the nearest integer towards negative infinity.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+      case index_initialize_reference: {
+        const auto& altr = this->m_stor.as<S_initialize_reference>();
 
-                    if(rhs.type() == type_real) {
-                      rhs = safe_double_to_int64(::std::floor(rhs.as_real()));
-                      return air_status_next;
-                    }
+        Uparam up2;
+        up2.u2345 = altr.slot;
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__ifloor` not applicable (operand was `$1`)", rhs);
-                  }
+        struct Sparam
+          {
+            phsh_string name;
+          };
 
-                  case xop_iceil: {
-                    // Round the operand to the nearest integer towards positive infinity.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+        Sparam sp2;
+        sp2.name = altr.name;
 
-                    if(rhs.type() == type_real) {
-                      rhs = safe_double_to_int64(::std::ceil(rhs.as_real()));
-                      return air_status_next;
-                    }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const uint32_t slot = head->uparam.u2345;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__iceil` not applicable (operand was `$1`)", rhs);
-                  }
+            // Move a reference from the stack into the current context.
+            ctx.insert_named_reference(sp.name, slot) = ::std::move(ctx.stack().mut_top());
+            ctx.stack().pop();
+            return air_status_next;
+          }
 
-                  case xop_itrunc: {
-                    // Truncate the operand to the nearest integer towards zero.
-                    if(rhs.type() == type_integer) {
-                      return air_status_next;
-                    }
+          // Uparam
+          , up2
 
-                    if(rhs.type() == type_real) {
-                      rhs = safe_double_to_int64(::std::trunc(rhs.as_real()));
-                      return air_status_next;
-                    }
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__itrunc` not applicable (operand was `$1`)", rhs);
-                  }
+          // Collector
+          , nullptr
 
-                  case xop_lzcnt: {
-                    // Get the number of leading zeroes in the operand.
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                      val = (int64_t) ROCKET_LZCNT64((uint64_t) val);
-                      return air_status_next;
-                    }
+      case index_catch_expression: {
+        const auto& altr = this->m_stor.as<S_catch_expression>();
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__lzcnt` not applicable (operand was `$1`)", rhs);
-                  }
+        struct Sparam
+          {
+            AVM_Rod rod_body;
+          };
 
-                  case xop_tzcnt: {
-                    // Get the number of trailing zeroes in the operand.
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
+        Sparam sp2;
+        do_solidify_nodes(sp2.rod_body, altr.code_body);
 
-                      val = (int64_t) ROCKET_TZCNT64((uint64_t) val);
-                      return air_status_next;
-                    }
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__tzcnt` not applicable (operand was `$1`)", rhs);
-                  }
+            // Save the stack.
+            Reference_Stack saved_stack;
+            ctx.stack().swap(saved_stack);
+            ctx.stack().swap(ctx.alt_stack());
 
-                  case xop_popcnt: {
-                    // Get the number of ones in the operand.
-                    if(rhs.type() == type_integer) {
-                      V_integer& val = rhs.mut_integer();
+            // Evaluate the expression in a `try` block.
+            Value exval;
+            try {
+              AIR_Status status = sp.rod_body.execute(ctx);
+              ROCKET_ASSERT(status == air_status_next);
+            }
+            catch(Runtime_Error& except) {
+              exval = except.value();
+            }
 
-                      val = (int64_t) ROCKET_POPCNT64((uint64_t) val);
-                      return air_status_next;
-                    }
+            // Restore the stack after the evaluation completes.
+            ctx.stack().swap(ctx.alt_stack());
+            ctx.stack().swap(saved_stack);
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "`__popcnt` not applicable (operand was `$1`)", rhs);
-                  }
+            // Push the exception object.
+            ctx.stack().push().set_temporary(::std::move(exval));
+            return air_status_next;
+          }
 
-                  default:
-                    ROCKET_UNREACHABLE();
-                }
-              }
+          // Uparam
+          , Uparam()
 
-              // Uparam
-              , up2
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-              // Sparam
-              , 0, nullptr, nullptr, nullptr
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_body.collect_variables(staged, temp);
+          }
 
-              // Collector
-              , nullptr
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
 
-              // Symbols
-              , &(altr.sloc)
-            );
-            return;
+      case index_return_statement: {
+        const auto& altr = this->m_stor.as<S_return_statement>();
 
-          case xop_cmp_eq:
-          case xop_cmp_ne:
-          case xop_cmp_un:
-          case xop_cmp_lt:
-          case xop_cmp_gt:
-          case xop_cmp_lte:
-          case xop_cmp_gte:
-          case xop_cmp_3way:
-          case xop_add:
-          case xop_sub:
-          case xop_mul:
-          case xop_div:
-          case xop_mod:
-          case xop_andb:
-          case xop_orb:
-          case xop_xorb:
-          case xop_addm:
-          case xop_subm:
-          case xop_mulm:
-          case xop_adds:
-          case xop_subs:
-          case xop_muls:
-            // binary
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const bool assign = head->uparam.b0;
-                const uint8_t uxop = head->uparam.u1;
-                const auto& rhs = ctx.stack().top().dereference_readonly();
-                ctx.stack().pop();
-                auto& top = ctx.stack().mut_top();
-                auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
+        Uparam up2;
+        up2.b0 = altr.by_ref;
+        up2.b1 = altr.is_void;
 
-                // The fast path should be a proper tail call.
-                if(rhs.type() == type_integer)
-                  return do_apply_binary_operator_with_integer(uxop, lhs, rhs.as_integer());
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool by_ref = head->uparam.b0;
+            const bool is_void = head->uparam.b1;
 
-                switch(uxop) {
-                  case xop_cmp_eq: {
-                    // Check whether the two operands are equal. Unordered values are
-                    // considered to be unequal.
-                    lhs = lhs.compare_partial(rhs) == compare_equal;
-                    return air_status_next;
-                  }
+            if(is_void || ctx.stack().top().is_void()) {
+              // Discard the result.
+              return air_status_return_void;
+            }
+            else if(by_ref) {
+              // The result is passed by reference, so check whether it is
+              // dereferenceable.
+              ctx.stack().top().dereference_readonly();
+              return air_status_return_ref;
+            }
+            else {
+              // The result is passed by copy, so convert it to a temporary.
+              ctx.stack().mut_top().dereference_copy();
+              return air_status_return_ref;
+            }
+          }
 
-                  case xop_cmp_ne: {
-                    // Check whether the two operands are not equal. Unordered values are
-                    // considered to be unequal.
-                    lhs = lhs.compare_partial(rhs) != compare_equal;
-                    return air_status_next;
-                  }
+          // Uparam
+          , up2
 
-                  case xop_cmp_un: {
-                    // Check whether the two operands are unordered.
-                    lhs = lhs.compare_partial(rhs) == compare_unordered;
-                    return air_status_next;
-                  }
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
 
-                  case xop_cmp_lt: {
-                    // Check whether the LHS operand is less than the RHS operand. If
-                    // they are unordered, an exception shall be thrown.
-                    lhs = lhs.compare_total(rhs) == compare_less;
-                    return air_status_next;
-                  }
+          // Collector
+          , nullptr
 
-                  case xop_cmp_gt: {
-                    // Check whether the LHS operand is greater than the RHS operand. If
-                    // they are unordered, an exception shall be thrown.
-                    lhs = lhs.compare_total(rhs) == compare_greater;
-                    return air_status_next;
-                  }
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                  case xop_cmp_lte: {
-                    // Check whether the LHS operand is less than or equal to the RHS
-                    // operand. If they are unordered, an exception shall be thrown.
-                    lhs = lhs.compare_total(rhs) != compare_greater;
-                    return air_status_next;
-                  }
+      case index_push_constant: {
+        const auto& altr = this->m_stor.as<S_push_constant>();
 
-                  case xop_cmp_gte: {
-                    // Check whether the LHS operand is greater than or equal to the RHS
-                    // operand. If they are unordered, an exception shall be thrown.
-                    lhs = lhs.compare_total(rhs) != compare_less;
-                    return air_status_next;
-                  }
+        struct Sparam
+          {
+            Value val;
+          };
 
-                  case xop_cmp_3way: {
-                    // Defines a partial ordering on all values. For unordered operands,
-                    // a string is returned, so `x <=> y` and `(x <=> y) <=> 0` produces
-                    // the same result.
-                    do_set_compare_result(lhs, lhs.compare_partial(rhs));
-                    return air_status_next;
-                  }
+        Sparam sp2;
+        sp2.val = altr.val;
 
-                  case xop_add: {
-                    // Perform logical OR on two boolean values, or get the sum of two
-                    // arithmetic values, or concatenate two strings.
-                    if(lhs.is_real() && rhs.is_real()) {
-                      V_real& val = lhs.mut_real();
-                      V_real other = rhs.as_real();
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            ctx.stack().push().set_temporary(sp.val);
+            return air_status_next;
+          }
 
-                      val += other;
-                      return air_status_next;
-                    }
+          // Uparam
+          , Uparam()
 
-                    if(lhs.is_string() && rhs.is_string()) {
-                      V_string& val = lhs.mut_string();
-                      const V_string& other = rhs.as_string();
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                      val.append(other);
-                      return air_status_next;
-                    }
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.val.collect_variables(staged, temp);
+          }
 
-                    if(lhs.is_boolean() && rhs.is_boolean()) {
-                      V_boolean& val = lhs.mut_boolean();
-                      V_boolean other = rhs.as_boolean();
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
 
-                      val |= other;
-                      return air_status_next;
-                    }
+      case index_alt_clear_stack: {
+        const auto& altr = this->m_stor.as<S_alt_clear_stack>();
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Addition not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+        (void) altr;
 
-                  case xop_sub: {
-                    // Perform logical XOR on two boolean values, or get the difference
-                    // of two arithmetic values.
-                    if(lhs.is_real() && rhs.is_real()) {
-                      V_real& val = lhs.mut_real();
-                      V_real other = rhs.as_real();
+        rod.append(
+          +[](Executive_Context& ctx, const Header* /*head*/) ROCKET_FLATTEN -> AIR_Status
+          {
+            ctx.stack().swap(ctx.alt_stack());
+            ctx.stack().clear();
+            return air_status_next;
+          }
 
-                      // Overflow will result in an infinity, so this is safe.
-                      val -= other;
-                      return air_status_next;
-                    }
+          // Uparam
+          , Uparam()
 
-                    if(lhs.is_boolean() && rhs.is_boolean()) {
-                      V_boolean& val = lhs.mut_boolean();
-                      V_boolean other = rhs.as_boolean();
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
 
-                      // Perform logical XOR of the operands.
-                      val ^= other;
-                      return air_status_next;
-                    }
+          // Collector
+          , nullptr
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Subtraction not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+          // Symbols
+          , nullptr
+        );
+        return;
+      }
 
-                  case xop_mul: {
-                     // Perform logical AND on two boolean values, or get the product of
-                     // two arithmetic values, or duplicate a string or array by a given
-                     // times.
-                    if(lhs.is_real() && rhs.is_real()) {
-                      V_real& val = lhs.mut_real();
-                      V_real other = rhs.as_real();
+      case index_alt_function_call: {
+        const auto& altr = this->m_stor.as<S_alt_function_call>();
 
-                      val *= other;
-                      return air_status_next;
-                    }
+        Uparam up2;
+        up2.u0 = altr.ptc;
 
-                    if(lhs.is_integer() && rhs.is_string()) {
-                      V_integer count = lhs.as_integer();
-                      lhs = rhs.as_string();
-                      V_string& val = lhs.mut_string();
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const PTC_Aware ptc = static_cast<PTC_Aware>(head->uparam.u0);
+            const auto& sloc = head->pv_meta->sloc;
+            const auto sentry = ctx.global().copy_recursion_sentry();
+            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
 
-                      do_duplicate_sequence(val, count);
-                      return air_status_next;
-                    }
+            ctx.stack().swap(ctx.alt_stack());
+            return do_function_call(ctx, ptc, sloc);
+          }
 
-                    if(lhs.is_integer() && rhs.is_array()) {
-                      V_integer count = lhs.as_integer();
-                      lhs = rhs.as_array();
-                      V_array& val = lhs.mut_array();
+          // Uparam
+          , up2
 
-                      do_duplicate_sequence(val, count);
-                      return air_status_next;
-                    }
+          // Sparam
+          , 0, nullptr, nullptr, nullptr
 
-                    if(lhs.is_boolean() && rhs.is_boolean()) {
-                      V_boolean& val = lhs.mut_boolean();
-                      V_boolean other = rhs.as_boolean();
+          // Collector
+          , nullptr
 
-                      val &= other;
-                      return air_status_next;
-                    }
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Multiplication not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+      case index_coalesce_expression: {
+        const auto& altr = this->m_stor.as<S_coalesce_expression>();
 
-                  case xop_div: {
-                    // Get the quotient of two arithmetic values. If both operands are
-                    // integers, the result is also an integer, truncated towards zero.
-                    if(lhs.is_real() && rhs.is_real()) {
-                      V_real& val = lhs.mut_real();
-                      V_real other = rhs.as_real();
+        Uparam up2;
+        up2.b0 = altr.assign;
 
-                      val /= other;
-                      return air_status_next;
-                    }
+        struct Sparam
+          {
+            AVM_Rod rod_null;
+          };
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Division not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+        Sparam sp2;
+        do_solidify_nodes(sp2.rod_null, altr.code_null);
+
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const bool assign = head->uparam.b0;
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
 
-                  case xop_mod: {
-                    // Get the remainder of two arithmetic values. The quotient is
-                    // truncated towards zero. If both operands are integers, the result
-                    // is also an integer.
-                    if(lhs.is_real() && rhs.is_real()) {
-                      V_real& val = lhs.mut_real();
-                      V_real other = rhs.as_real();
+            // Read the condition and evaluate the corresponding subexpression.
+            return ctx.stack().top().dereference_readonly().is_null()
+                     ? do_evaluate_subexpression(ctx, assign, sp.rod_null)
+                     : air_status_next;
+          }
 
-                      val = ::std::fmod(val, other);
-                      return air_status_next;
-                    }
+          // Uparam
+          , up2
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Modulo not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                  case xop_andb: {
-                    // Perform the bitwise AND operation on all bits of the operands. If
-                    // the two operands have different lengths, the result is truncated
-                    // to the same length as the shorter one.
-                    if(lhs.is_string() && rhs.is_string()) {
-                      V_string& val = lhs.mut_string();
-                      const V_string& mask = rhs.as_string();
-
-                      if(val.size() > mask.size())
-                        val.erase(mask.size());
-                      auto maskp = mask.begin();
-                      for(auto it = val.mut_begin();  it != val.end();  ++it, ++maskp)
-                        *it = static_cast<char>(*it & *maskp);
-                      return air_status_next;
-                    }
+          // Collector
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            sp.rod_null.collect_variables(staged, temp);
+          }
 
-                    if(lhs.is_boolean() && rhs.is_boolean()) {
-                      V_boolean& val = lhs.mut_boolean();
-                      V_boolean other = rhs.as_boolean();
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                      val &= other;
-                      return air_status_next;
-                    }
+      case index_member_access: {
+        const auto& altr = this->m_stor.as<S_member_access>();
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Bitwise AND not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+        struct Sparam
+          {
+            phsh_string key;
+            Member_Cache cache;
+          };
 
-                  case xop_orb: {
-                    // Perform the bitwise OR operation on all bits of the operands. If
-                    // the two operands have different lengths, the result is padded to
-                    // the same length as the longer one, with zeroes.
-                    if(lhs.is_string() && rhs.is_string()) {
-                      V_string& val = lhs.mut_string();
-                      const V_string& mask = rhs.as_string();
-
-                      if(val.size() < mask.size())
-                        val.append(mask.size() - val.size(), 0);
-                      auto valp = val.mut_begin();
-                      for(auto it = mask.begin();  it != mask.end();  ++it, ++valp)
-                        *valp = static_cast<char>(*valp | *it);
-                      return air_status_next;
-                    }
+        Sparam sp2 = { altr.key, { } };
 
-                    if(lhs.is_boolean() && rhs.is_boolean()) {
-                      V_boolean& val = lhs.mut_boolean();
-                      V_boolean other = rhs.as_boolean();
+        rod.append(
+          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            auto& top = ctx.stack().mut_top();
+            Reference_Modifier::S_object_key xmod = { sp.key, 0 };
 
-                      val |= other;
-                      return air_status_next;
-                    }
+            const auto& parent = top.dereference_readonly();
+            if(!parent.is_object()) {
+              // Push a modifier and let it report errors.
+              do_push_modifier_and_check(top, ::std::move(xmod));
+              return air_status_next;
+            }
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Bitwise OR not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+            // Push a modifier. The parent is an object, so it can't fail.
+            do_find_member_cached(xmod.hint, parent.as_object(), sp.key, sp.cache);
+            top.push_modifier(::std::move(xmod));
+            return air_status_next;
+          }
 
-                  case xop_xorb: {
-                    // Perform the bitwise XOR operation on all bits of the operands. If
-                    // the two operands have different lengths, the result is padded to
-                    // the same length as the longer one, with zeroes.
-                    if(lhs.is_string() && rhs.is_string()) {
-                      V_string& val = lhs.mut_string();
-                      const V_string& mask = rhs.as_string();
-
-                      if(val.size() < mask.size())
-                        val.append(mask.size() - val.size(), 0);
-                      auto valp = val.mut_begin();
-                      for(auto it = mask.begin();  it != mask.end();  ++it, ++valp)
-                        *valp = static_cast<char>(*valp ^ *it);
-                      return air_status_next;
-                    }
+          // Uparam
+          , Uparam()
 
-                    if(lhs.is_boolean() && rhs.is_boolean()) {
-                      V_boolean& val = lhs.mut_boolean();
-                      V_boolean other = rhs.as_boolean();
+          // Sparam
+          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
-                      val ^= other;
-                      return air_status_next;
-                    }
+          // Collector
+          , nullptr
 
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Bitwise XOR not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
-                  }
+          // Symbols
+          , &(altr.sloc)
+        );
+        return;
+      }
 
-                  case xop_addm:
-                    // This should have been redirected to the fast path.
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Modular addition not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
+      case index_apply_operator_bi32: {
+        const auto& altr = this->m_stor.as<S_apply_operator_bi32>();
 
-                  case xop_subm:
-                    // This should have been redirected to the fast path.
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Modular subtraction not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
+        Uparam up2;
+        up2.b0 = altr.assign;
+        up2.u1 = altr.xop;
+        up2.i2345 = altr.irhs;
 
-                  case xop_mulm:
-                    // This should have been redirected to the fast path.
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Modular multiplication not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
+        switch(altr.xop) {
+          case xop_inc:
+          case xop_dec:
+          case xop_unset:
+          case xop_head:
+          case xop_tail:
+          case xop_random:
+          case xop_pos:
+          case xop_neg:
+          case xop_notb:
+          case xop_notl:
+          case xop_countof:
+          case xop_typeof:
+          case xop_sqrt:
+          case xop_isnan:
+          case xop_isinf:
+          case xop_abs:
+          case xop_sign:
+          case xop_round:
+          case xop_floor:
+          case xop_ceil:
+          case xop_trunc:
+          case xop_iround:
+          case xop_ifloor:
+          case xop_iceil:
+          case xop_itrunc:
+          case xop_lzcnt:
+          case xop_tzcnt:
+          case xop_popcnt:
+          case xop_fma:
+            ASTERIA_TERMINATE(("Constant folding not implemented for `$1`"), altr.xop);
 
-                  case xop_adds:
-                    // This should have been redirected to the fast path.
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Saturating addition not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
+          case xop_assign:
+          case xop_index:
+            // binary
+            rod.append(
+              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+              {
+                const uint8_t uxop = head->uparam.u1;
+                const V_integer irhs = head->uparam.i2345;
+                auto& top = ctx.stack().mut_top();
 
-                  case xop_subs:
-                    // This should have been redirected to the fast path.
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Saturating subtraction not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
+                switch(uxop) {
+                  case xop_assign: {
+                    // `assign` is ignored.
+                    top.dereference_mutable() = irhs;
+                    return air_status_next;
+                  }
 
-                  case xop_muls:
-                    // This should have been redirected to the fast path.
-                    throw Runtime_Error(Runtime_Error::M_format(),
-                             "Saturating multiplication not applicable (operands were `$1` and `$2`)",
-                             lhs, rhs);
+                  case xop_index: {
+                    // Push a subscript.
+                    Reference_Modifier::S_array_index xmod = { irhs };
+                    do_push_modifier_and_check(top, ::std::move(xmod));
+                    return air_status_next;
+                  }
 
                   default:
                     ROCKET_UNREACHABLE();
@@ -3534,69 +5476,43 @@ solidify(AVM_Rod& rod) const
             );
             return;
 
+          case xop_cmp_eq:
+          case xop_cmp_ne:
+          case xop_cmp_un:
+          case xop_cmp_lt:
+          case xop_cmp_gt:
+          case xop_cmp_lte:
+          case xop_cmp_gte:
+          case xop_cmp_3way:
+          case xop_add:
+          case xop_sub:
+          case xop_mul:
+          case xop_div:
+          case xop_mod:
+          case xop_andb:
+          case xop_orb:
+          case xop_xorb:
+          case xop_addm:
+          case xop_subm:
+          case xop_mulm:
+          case xop_adds:
+          case xop_subs:
+          case xop_muls:
           case xop_sll:
           case xop_srl:
           case xop_sla:
           case xop_sra:
-            // shift
+            // binary, shift
             rod.append(
               +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
               {
                 const bool assign = head->uparam.b0;
                 const uint8_t uxop = head->uparam.u1;
-                const auto& rhs = ctx.stack().top().dereference_readonly();
-                ctx.stack().pop();
-                auto& top = ctx.stack().mut_top();
-                auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
-
-                if(rhs.type() != type_integer)
-                  throw Runtime_Error(Runtime_Error::M_format(),
-                           "Invalid shift count (operands were `$1` and `$2`)",
-                           lhs, rhs);
-
-                return do_apply_binary_operator_with_integer(uxop, lhs, rhs.as_integer());
-              }
-
-              // Uparam
-              , up2
-
-              // Sparam
-              , 0, nullptr, nullptr, nullptr
-
-              // Collector
-              , nullptr
-
-              // Symbols
-              , &(altr.sloc)
-            );
-            return;
-
-          case xop_fma:
-            // fused multiply-add; ternary
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const bool assign = head->uparam.b0;
-                const auto& rhs = ctx.stack().top().dereference_readonly();
-                ctx.stack().pop();
-                const auto& mid = ctx.stack().top().dereference_readonly();
-                ctx.stack().pop();
+                const V_integer irhs = head->uparam.i2345;
                 auto& top = ctx.stack().mut_top();
                 auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
 
-                // Perform floating-point fused multiply-add.
-                if(lhs.is_real() && mid.is_real() && rhs.is_real()) {
-                  V_real& val = lhs.mut_real();
-                  V_real y_mul = mid.as_real();
-                  V_real z_add = rhs.as_real();
-
-                  val = ::std::fma(val, y_mul, z_add);
-                  return air_status_next;
-                }
-
-                throw Runtime_Error(Runtime_Error::M_format(),
-                         "`__fma` not applicable (operands were `$1`, `$2` and `$3`)",
-                         lhs, mid, rhs);
+                return do_apply_binary_operator_with_integer(uxop, lhs, irhs);
               }
 
               // Uparam
@@ -3614,110 +5530,96 @@ solidify(AVM_Rod& rod) const
             return;
 
           default:
-            ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), altr.xop);
+            ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
         }
       }
 
-      case index_unpack_struct_array: {
-        const auto& altr = this->m_stor.as<S_unpack_struct_array>();
-
-        Uparam up2;
-        up2.b0 = altr.immutable;
-        up2.u2345 = altr.nelems;
-
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const bool immutable = head->uparam.b0;
-            const uint32_t nelems = head->uparam.u2345;
-
-            // Read the value of the initializer.
-            const auto& init = ctx.stack().top().dereference_readonly();
-            ctx.stack().pop();
-
-            // Make sure it is really an array.
-            if(!init.is_null() && !init.is_array())
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Initializer was not an array (value was `$1`)", init);
-
-            for(uint32_t i = nelems - 1;  i != UINT32_MAX;  --i) {
-              // Pop variables from from right to left.
-              auto var = ctx.stack().top().unphase_variable_opt();
-              ctx.stack().pop();
-              ROCKET_ASSERT(var && !var->is_initialized());
-
-              if(ROCKET_EXPECT(init.is_array()))
-                if(auto ielem = init.as_array().ptr(i))
-                  var->initialize(*ielem);
-
-              if(ROCKET_UNEXPECT(!var->is_initialized()))
-                var->initialize(nullopt);
-
-              var->set_immutable(immutable);
-            }
-            return air_status_next;
-          }
-
-          // Uparam
-          , up2
-
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
-
-          // Collector
-          , nullptr
-
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
-
-      case index_unpack_struct_object: {
-        const auto& altr = this->m_stor.as<S_unpack_struct_object>();
-
-        Uparam up2;
-        up2.b0 = altr.immutable;
+      case index_register_expression: {
+        const auto& altr = this->m_stor.as<S_register_expression>();
 
         struct Sparam
           {
-            cow_vector<phsh_string> keys;
+            cow_vector<register_insn> code;
           };
 
+        Uparam up2;
+        up2.u0 = (uint8_t) altr.nregs;
+
         Sparam sp2;
-        sp2.keys = altr.keys;
+        sp2.code = altr.code;
+        register_insn insn_ret = { };
+        insn_ret.opcode = regop_return;
+        sp2.code.emplace_back(::std::move(insn_ret));
 
         rod.append(
           +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
           {
-            const bool immutable = head->uparam.b0;
+            const uint8_t nregs = head->uparam.u0;
             const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            // The first register is allocated on the stack, where the result
+            // will be returned. The others are allocated on the C stack.
+            auto& r0 = ctx.stack().push().set_temporary(nullopt).dereference_copy();
+            static_vector<Value, register_count_max - 1> rs(nregs - 1U);
+            auto reg = [&](uint8_t index) -> Value& { return index ? rs.mut(index - 1U) : r0;  };
+
+            // Instructions are dispatched with computed gotos, in the order of
+            // `Register_Opcode`. The last instruction is always `return`.
+            static void* const s_targets[] =
+              {
+                &&do_load_constant_,
+                &&do_load_local_,
+                &&do_load_bound_,
+                &&do_apply_,
+                &&do_apply_bi32_,
+                &&do_return_,
+              };
+
+            // Register expressions have no symbols, so errors are reported
+            // here at the instruction that has failed, like
+            // `AVM_Rod::execute()` does for other nodes.
+            const register_insn* pc = sp.code.data();
+            try {
+              goto *s_targets[pc->opcode];
 
-            // Read the value of the initializer.
-            const auto& init = ctx.stack().top().dereference_readonly();
-            ctx.stack().pop();
+            do_load_constant_:
+              reg(pc->dst) = pc->val;
+              goto *s_targets[(++pc)->opcode];
 
-            // Make sure it is really an object.
-            if(!init.is_null() && !init.is_object())
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Initializer was not an object (value was `$1`)", init);
+            do_load_local_:
+              {
+                const auto& ref = do_get_local_reference(ctx, pc->depth, pc->name, pc->slot);
+                reg(pc->dst) = ref.dereference_readonly();
+              }
+              goto *s_targets[(++pc)->opcode];
 
-            for(auto it = sp.keys.rbegin();  it != sp.keys.rend();  ++it) {
-              // Pop variables from from right to left.
-              auto var = ctx.stack().top().unphase_variable_opt();
-              ctx.stack().pop();
-              ROCKET_ASSERT(var && !var->is_initialized());
+            do_load_bound_:
+              reg(pc->dst) = pc->ref.dereference_readonly();
+              goto *s_targets[(++pc)->opcode];
 
-              if(ROCKET_EXPECT(init.is_object()))
-                if(auto ielem = init.as_object().ptr(*it))
-                  var->initialize(*ielem);
+            do_apply_:
+              if(reg(pc->src).type() == type_integer)
+                do_apply_binary_operator_with_integer(pc->xop, reg(pc->dst), reg(pc->src).as_integer());
+              else
+                do_apply_binary_operator(pc->xop, reg(pc->dst), reg(pc->src));
+              goto *s_targets[(++pc)->opcode];
 
-              if(ROCKET_UNEXPECT(!var->is_initialized()))
-                var->initialize(nullopt);
+            do_apply_bi32_:
+              do_apply_binary_operator_with_integer(pc->xop, reg(pc->dst), pc->irhs);
+              goto *s_targets[(++pc)->opcode];
 
-              var->set_immutable(immutable);
+            do_return_:
+              // The result is in the first register, so there is nothing to do.
+              return air_status_next;
+            }
+            catch(Runtime_Error& except) {
+              except.push_frame_plain(pc->sloc);
+              throw;
+            }
+            catch(exception& stdex) {
+              Runtime_Error except(Runtime_Error::M_format(), "$1", stdex);
+              except.push_frame_plain(pc->sloc);
+              throw except;
             }
-            return air_status_next;
           }
 
           // Uparam
@@ -3727,803 +5629,1442 @@ solidify(AVM_Rod& rod) const
           , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
 
           // Collector
-          , nullptr
+          , +[](Variable_HashMap& staged, Variable_Worklist& temp, const Header* head)
+          {
+            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+            for(const auto& insn : sp.code)
+              if(insn.opcode == regop_load_constant)
+                insn.val.collect_variables(staged, temp);
+              else if(insn.opcode == regop_load_bound)
+                insn.ref.collect_variables(staged, temp);
+          }
 
           // Symbols
-          , &(altr.sloc)
+          , nullptr
         );
         return;
       }
+    }
+  }
 
-      case index_define_null_variable: {
-        const auto& altr = this->m_stor.as<S_define_null_variable>();
+#ifdef ASTERIA_NGRAM_STATS
 
-        Uparam up2;
-        up2.b0 = altr.immutable;
+namespace {
 
-        struct Sparam
-          {
-            phsh_string name;
-          };
+// This is the index of a node which doesn't exist, past the end of a sequence.
+constexpr uint8_t ngram_none = 63;
 
-        Sparam sp2;
-        sp2.name = altr.name;
+const char* const s_ngram_node_names[] =
+  {
+    "clear_stack", "execute_block", "declare_variable", "initialize_variable",
+    "if_statement", "switch_statement", "do_while_statement", "while_statement",
+    "for_each_statement", "for_statement", "try_statement", "throw_statement",
+    "assert_statement", "simple_status", "check_argument", "push_global_reference",
+    "push_local_reference", "push_bound_reference", "define_function",
+    "branch_expression", "function_call", "push_unnamed_array",
+    "push_unnamed_object", "apply_operator", "unpack_struct_array",
+    "unpack_struct_object", "define_null_variable", "single_step_trap",
+    "variadic_call", "defer_expression", "import_call", "declare_reference",
+    "initialize_reference", "catch_expression", "return_statement", "push_constant",
+    "alt_clear_stack", "alt_function_call", "coalesce_expression", "member_access",
+    "apply_operator_bi32", "register_expression",
+  };
+
+struct NGram_Stats
+  {
+    // These are numbers of times that sequences of three nodes have been
+    // executed. Shorter sequences are obtained by summing them up.
+    uint64_t counts[64][64][64];
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
+    ~NGram_Stats()
+      {
+        struct Entry
           {
-            const bool immutable = head->uparam.b0;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            const auto& sloc = head->pv_meta->sloc;
+            uint64_t count;
+            uint8_t nodes[3];
+          };
 
-            // Allocate a variable and inject it into the current context.
-            const auto gcoll = ctx.global().garbage_collector();
-            const auto var = gcoll->create_variable();
-            ctx.insert_named_reference(sp.name).set_variable(var);
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_variable_declare, sloc, sp.name);
+        cow_vector<Entry> entries[3];
+        uint64_t sums2[64][64] = { };
+        uint64_t sums1[64] = { };
+
+        for(uint8_t a = 0;  a != ngram_none;  ++a)
+          for(uint8_t b = 0;  b != 64;  ++b)
+            for(uint8_t c = 0;  c != 64;  ++c)
+              if(this->counts[a][b][c] != 0) {
+                if((b != ngram_none) && (c != ngram_none))
+                  entries[2].push_back({ this->counts[a][b][c], { a, b, c } });
+                sums2[a][b] += this->counts[a][b][c];
+                sums1[a] += this->counts[a][b][c];
+              }
 
-            // Initialize it to null.
-            var->initialize(nullopt);
-            var->set_immutable(immutable);
-            return air_status_next;
+        for(uint8_t a = 0;  a != ngram_none;  ++a) {
+          for(uint8_t b = 0;  b != ngram_none;  ++b)
+            if(sums2[a][b] != 0)
+              entries[1].push_back({ sums2[a][b], { a, b, ngram_none } });
+          if(sums1[a] != 0)
+            entries[0].push_back({ sums1[a], { a, ngram_none, ngram_none } });
+        }
+
+        // Print the most frequent sequences of each length.
+        for(size_t n = 0;  n != 3;  ++n) {
+          ::std::sort(entries[n].mut_begin(), entries[n].mut_end(),
+              [](const Entry& x, const Entry& y) { return x.count > y.count;  });
+
+          ::fprintf(stderr, "ngram: most frequent %zu-node sequences\n", n + 1);
+          for(size_t i = 0;  i < ::rocket::min(entries[n].size(), (size_t) 40);  ++i) {
+            const auto& e = entries[n].at(i);
+            ::fprintf(stderr, "ngram: %14llu ", (unsigned long long) e.count);
+            for(size_t k = 0;  k <= n;  ++k)
+              ::fprintf(stderr, " %s", s_ngram_node_names[e.nodes[k]]);
+            ::fprintf(stderr, "\n");
           }
+        }
+      }
+  };
 
-          // Uparam
-          , up2
+NGram_Stats s_ngram_stats;
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+AIR_Status
+do_count_ngram(Executive_Context& /*ctx*/, const Header* head)
+  {
+    s_ngram_stats.counts[head->uparam.u0][head->uparam.u1][head->uparam.u2] ++;
+    return air_status_next;
+  }
 
-          // Collector
-          , nullptr
+}  // namespace
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+#else  // ASTERIA_NGRAM_STATS
+
+namespace {
+
+// A local reference may be fused with the node before it and the one after it.
+// These were chosen as the most frequent sequences in our workloads.
+enum Fused_Prefix : uint8_t
+  {
+    fused_prefix_none             = 0,
+    fused_prefix_clear_stack      = 1,
+    fused_prefix_alt_clear_stack  = 2,
+  };
+
+enum Fused_Suffix : uint8_t
+  {
+    fused_suffix_none             = 0,
+    fused_suffix_push_local       = 1,
+    fused_suffix_apply_bi32       = 2,
+  };
+
+struct Fused_Local
+  {
+    phsh_string name;
+    uint32_t depth;
+    uint32_t slot;
+    Source_Location sloc;
+
+    // These are used by `fused_suffix_push_local`.
+    phsh_string name2;
+    uint32_t depth2;
+    uint32_t slot2;
+
+    // This is used by `fused_suffix_apply_bi32`.
+    int32_t irhs;
+
+    // This is used by both suffixes.
+    Source_Location sloc2;
+  };
+
+template<uint8_t prefixT, uint8_t suffixT>
+ROCKET_FLATTEN
+AIR_Status
+do_execute_fused_local(Executive_Context& ctx, const Header* head)
+  {
+    const auto& sp = *reinterpret_cast<const Fused_Local*>(head->sparam);
+
+    switch(prefixT) {
+      case fused_prefix_clear_stack:
+        ctx.stack().clear();
+        break;
+
+      case fused_prefix_alt_clear_stack:
+        ctx.stack().swap(ctx.alt_stack());
+        ctx.stack().clear();
+        break;
+    }
+
+    // Fused nodes have no symbols, so errors are reported here at the node
+    // that has failed, like `AVM_Rod::execute()` does for others.
+    const Source_Location* sloc = &(sp.sloc);
+    try {
+      ctx.stack().push() = do_get_local_reference(ctx, sp.depth, sp.name, sp.slot);
+      sloc = &(sp.sloc2);
+
+      switch(suffixT) {
+        case fused_suffix_push_local:
+          ctx.stack().push() = do_get_local_reference(ctx, sp.depth2, sp.name2, sp.slot2);
+          break;
+
+        case fused_suffix_apply_bi32: {
+          const bool assign = head->uparam.b3;
+          const uint8_t uxop = head->uparam.u2;
+          auto& top = ctx.stack().mut_top();
+          auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
+          return do_apply_binary_operator_with_integer(uxop, lhs, sp.irhs);
+        }
       }
+    }
+    catch(Runtime_Error& except) {
+      except.push_frame_plain(*sloc);
+      throw;
+    }
+    catch(exception& stdex) {
+      Runtime_Error except(Runtime_Error::M_format(), "$1", stdex);
+      except.push_frame_plain(*sloc);
+      throw except;
+    }
 
-      case index_single_step_trap: {
-        const auto& altr = this->m_stor.as<S_single_step_trap>();
+    return air_status_next;
+  }
 
-        (void) altr;
+AVM_Rod::Executor*
+do_get_fused_local_executor(uint8_t prefix, uint8_t suffix) noexcept
+  {
+    static AVM_Rod::Executor* const s_table[3][3] =
+      {
+        { do_execute_fused_local<0, 0>, do_execute_fused_local<0, 1>,
+          do_execute_fused_local<0, 2> },
+        { do_execute_fused_local<1, 0>, do_execute_fused_local<1, 1>,
+          do_execute_fused_local<1, 2> },
+        { do_execute_fused_local<2, 0>, do_execute_fused_local<2, 1>,
+          do_execute_fused_local<2, 2> },
+      };
+
+    ROCKET_ASSERT((prefix < 3) && (suffix < 3));
+    return s_table[prefix][suffix];
+  }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, head->pv_meta->sloc);
-            return air_status_next;
-          }
+// A chain of member accesses such as `a.b.c.d` is fused into a single node, so
+// the parent is dereferenced only once.
+struct Fused_Member
+  {
+    phsh_string key;
+    Source_Location sloc;
+    Member_Cache cache;
+  };
 
-          // Uparam
-          , Uparam()
+struct Fused_Member_Chain
+  {
+    cow_vector<Fused_Member> members;
+  };
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+ROCKET_FLATTEN
+AIR_Status
+do_execute_fused_member_chain(Executive_Context& ctx, const Header* head)
+  {
+    const auto& sp = *reinterpret_cast<const Fused_Member_Chain*>(head->sparam);
+    auto& top = ctx.stack().mut_top();
 
-          // Collector
-          , nullptr
+    // Each member is looked up in the value that has been found for the one
+    // before it. Modifiers don't alter the root value, so it stays valid.
+    const Source_Location* sloc = &(sp.members.front().sloc);
+    try {
+      const Value* valp = &(top.dereference_readonly());
+      for(const auto& memb : sp.members) {
+        sloc = &(memb.sloc);
+        Reference_Modifier::S_object_key xmod = { memb.key, 0 };
+
+        if(valp->is_null()) {
+          // Members of null values are also null values.
+          top.push_modifier(::std::move(xmod));
+          continue;
+        }
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+        if(!valp->is_object()) {
+          // Push a modifier and let it report errors.
+          do_push_modifier_and_check(top, ::std::move(xmod));
+          ROCKET_UNREACHABLE();
+        }
+
+        valp = do_find_member_cached(xmod.hint, valp->as_object(), memb.key, memb.cache);
+        top.push_modifier(::std::move(xmod));
+        if(!valp)
+          valp = &null_value;
       }
+    }
+    catch(Runtime_Error& except) {
+      except.push_frame_plain(*sloc);
+      throw;
+    }
+    catch(exception& stdex) {
+      Runtime_Error except(Runtime_Error::M_format(), "$1", stdex);
+      except.push_frame_plain(*sloc);
+      throw except;
+    }
 
-      case index_variadic_call: {
-        const auto& altr = this->m_stor.as<S_variadic_call>();
+    return air_status_next;
+  }
 
-        Uparam up2;
-        up2.u0 = altr.ptc;
+}  // namespace
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const PTC_Aware ptc = static_cast<PTC_Aware>(head->uparam.u0);
-            const auto& sloc = head->pv_meta->sloc;
-            const auto sentry = ctx.global().copy_recursion_sentry();
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
+#endif  // ASTERIA_NGRAM_STATS
 
-            ctx.alt_stack().clear();
-            auto va_gen = ctx.stack().top().dereference_readonly();
-            if(va_gen.type() == type_null) {
-              // There is no argument.
-              ctx.stack().pop();
-              return do_function_call(ctx, ptc, sloc);
-            }
-            else if(va_gen.type() == type_array) {
-              // Arguments are temporary values.
-              ctx.stack().pop();
-              for(const auto& val : va_gen.as_array())
-                ctx.alt_stack().push().set_temporary(val);
-              return do_function_call(ctx, ptc, sloc);
-            }
-            else if(va_gen.type() == type_function) {
-              // Invoke the generator with no argument to get the number of
-              // variadic arguments to generate. This destroys its `this`
-              // reference so we have to stash it first.
-              auto va_self = ctx.stack().mut_top().pop_modifier();
-              do_invoke_maybe_tail(ctx.stack().mut_top(), ctx.global(), ptc_aware_none, sloc,
-                                   va_gen.as_function(), ::std::move(ctx.alt_stack()));
-              auto va_num = ctx.stack().top().dereference_readonly();
-              ctx.stack().pop();
+void
+AIR_Node::
+solidify_sequence(AVM_Rod& rod, const cow_vector<AIR_Node>& code)
+  {
+#ifdef ASTERIA_NGRAM_STATS
+    for(size_t i = 0;  i < code.size();  ++i) {
+      // Count the sequence that starts with this node each time it's executed.
+      static_assert(sizeof(s_ngram_node_names) / sizeof(*s_ngram_node_names)
+                    == index_register_expression + 1, "");
 
-              if(va_num.type() != type_integer)
-                throw Runtime_Error(Runtime_Error::M_format(),
-                         "Variadic argument count was not an integer (value `$1`)", va_num);
+      Uparam up2;
+      up2.u0 = static_cast<uint8_t>(code.at(i).m_stor.index());
+      up2.u1 = ngram_none;
+      up2.u2 = ngram_none;
 
-              if((va_num.as_integer() < 0) || (va_num.as_integer() > INT_MAX))
-                throw Runtime_Error(Runtime_Error::M_format(),
-                         "Variadic argument count was not valid (value `$1`)", va_num);
+      if(i + 1 < code.size())
+        up2.u1 = static_cast<uint8_t>(code.at(i + 1).m_stor.index());
 
-              // Generate arguments into `stack`.
-              for(V_integer va_idx = 0;  va_idx != va_num.as_integer();  ++va_idx) {
-                auto& va_arg_self = ctx.stack().push();
-                va_arg_self = va_self;
-                ctx.alt_stack().clear();
-                ctx.alt_stack().push().set_temporary(va_idx);
-                do_invoke_maybe_tail(va_arg_self, ctx.global(), ptc_aware_none, sloc,
-                                     va_gen.as_function(), ::std::move(ctx.alt_stack()));
-                va_arg_self.dereference_readonly();
-              }
+      if(i + 2 < code.size())
+        up2.u2 = static_cast<uint8_t>(code.at(i + 2).m_stor.index());
 
-              do_pop_arguments(ctx.alt_stack(), ctx.stack(), static_cast<uint32_t>(va_num.as_integer()));
-              return do_function_call(ctx, ptc, sloc);
-            }
-            else
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Invalid variadic argument generator (value `$1`)", va_gen);
+      rod.append(do_count_ngram, up2, 0, nullptr, nullptr, nullptr, nullptr, nullptr);
+      code.at(i).solidify(rod);
+    }
+#else
+    for(size_t i = 0;  i < code.size();  ++i) {
+      // Look for a chain of member accesses.
+      if(code.at(i).m_stor.index() == index_member_access) {
+        size_t k = i + 1;
+        while((k < code.size()) && (code.at(k).m_stor.index() == index_member_access))
+          k ++;
+
+        if(k - i >= 2) {
+          Fused_Member_Chain sp2;
+          for(size_t j = i;  j != k;  ++j) {
+            const auto& altr = code.at(j).m_stor.as<S_member_access>();
+            sp2.members.push_back({ altr.key, altr.sloc, { } });
           }
 
-          // Uparam
-          , up2
+          rod.append(
+            do_execute_fused_member_chain
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+            // Uparam
+            , Uparam()
 
-          // Collector
-          , nullptr
+            // Sparam
+            , sizeof(sp2), do_sparam_ctor<Fused_Member_Chain>, &sp2,
+              do_sparam_dtor<Fused_Member_Chain>
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+            // Collector
+            , nullptr
+
+            // Symbols
+            , nullptr
+          );
+          i = k - 1;
+          continue;
+        }
       }
 
-      case index_defer_expression: {
-        const auto& altr = this->m_stor.as<S_defer_expression>();
+      // Look for a local reference, which may follow a stack clear.
+      Uparam up2;
+      up2.u0 = fused_prefix_none;
+      up2.u1 = fused_suffix_none;
+      size_t k = i;
+
+      if((k + 1 < code.size())
+          && (code.at(k + 1).m_stor.index() == index_push_local_reference)) {
+        if(code.at(k).m_stor.index() == index_clear_stack) {
+          up2.u0 = fused_prefix_clear_stack;
+          k ++;
+        }
+        else if(code.at(k).m_stor.index() == index_alt_clear_stack) {
+          up2.u0 = fused_prefix_alt_clear_stack;
+          k ++;
+        }
+      }
+
+      if(code.at(k).m_stor.index() == index_push_local_reference) {
+        const auto& altr = code.at(k).m_stor.as<S_push_local_reference>();
+        Fused_Local sp2 = { altr.name, altr.depth, altr.slot, altr.sloc, { }, 0, 0, 0, { } };
+
+        // The location of each node is kept, so errors are reported at the
+        // node that has failed.
+        if(k + 1 < code.size()) {
+          const auto& next = code.at(k + 1).m_stor;
+          if(next.index() == index_push_local_reference) {
+            const auto& altr2 = next.as<S_push_local_reference>();
+            up2.u1 = fused_suffix_push_local;
+            sp2.name2 = altr2.name;
+            sp2.depth2 = altr2.depth;
+            sp2.slot2 = altr2.slot;
+            sp2.sloc2 = altr2.sloc;
+            k ++;
+          }
+          else if((next.index() == index_apply_operator_bi32)
+                  && do_is_register_xop(next.as<S_apply_operator_bi32>().xop, true)) {
+            const auto& altr2 = next.as<S_apply_operator_bi32>();
+            up2.u1 = fused_suffix_apply_bi32;
+            up2.u2 = altr2.xop;
+            up2.b3 = altr2.assign;
+            sp2.irhs = altr2.irhs;
+            sp2.sloc2 = altr2.sloc;
+            k ++;
+          }
+        }
+
+        if((up2.u0 != fused_prefix_none) || (up2.u1 != fused_suffix_none)) {
+          rod.append(
+            do_get_fused_local_executor(up2.u0, up2.u1)
+
+            // Uparam
+            , up2
+
+            // Sparam
+            , sizeof(sp2), do_sparam_ctor<Fused_Local>, &sp2, do_sparam_dtor<Fused_Local>
+
+            // Collector
+            , nullptr
+
+            // Symbols
+            , nullptr
+          );
+          i = k;
+          continue;
+        }
+      }
+
+      // This node is not fused. There is only one call to `solidify()` here,
+      // as executors which solidify nodes shall not inline it many times.
+      code.at(i).solidify(rod);
+    }
+#endif
+  }
+
+namespace {
+
+// Precompiled code uses the following encoding: Unsigned integers are encoded
+// in LEB128, signed integers are zigzag-encoded first. Strings and sequences
+// are prefixed with their lengths. File names of source locations are not
+// stored, as all nodes of a script come from the same file.
+void
+do_put_byte(cow_string& buf, uint8_t value)
+  {
+    buf.push_back(static_cast<char>(value));
+  }
+
+void
+do_put_uint(cow_string& buf, uint64_t value)
+  {
+    while(value >= 0x80) {
+      do_put_byte(buf, static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    do_put_byte(buf, static_cast<uint8_t>(value));
+  }
+
+void
+do_put_sint(cow_string& buf, int64_t value)
+  {
+    do_put_uint(buf, static_cast<uint64_t>(value) << 1 ^ static_cast<uint64_t>(value >> 63));
+  }
+
+void
+do_put_string(cow_string& buf, stringR str)
+  {
+    do_put_uint(buf, str.size());
+    buf.append(str.data(), str.size());
+  }
+
+void
+do_put_sloc(cow_string& buf, const Source_Location& sloc)
+  {
+    do_put_sint(buf, sloc.line());
+    do_put_sint(buf, sloc.column());
+  }
+
+void
+do_put_options(cow_string& buf, const Compiler_Options& opts)
+  {
+    do_put_byte(buf, opts.version);
+    do_put_byte(buf, opts.escapable_single_quotes);
+    do_put_byte(buf, opts.keywords_as_identifiers);
+    do_put_byte(buf, opts.integers_as_reals);
+    do_put_byte(buf, opts.proper_tail_calls);
+    do_put_byte(buf, opts.verbose_single_step_traps);
+    do_put_byte(buf, opts.implicit_global_names);
+    do_put_byte(buf, opts.optimization_level);
+  }
+
+void
+do_put_names(cow_string& buf, const cow_vector<phsh_string>& names)
+  {
+    do_put_uint(buf, names.size());
+    for(const auto& name : names)
+      do_put_string(buf, name.rdstr());
+  }
 
-        struct Sparam
-          {
-            cow_vector<AIR_Node> code_body;
-          };
+void
+do_put_code(cow_string& buf, const cow_vector<AIR_Node>& code)
+  {
+    do_put_uint(buf, code.size());
+    for(const auto& node : code)
+      node.serialize(buf);
+  }
 
-        Sparam sp2;
-        sp2.code_body = altr.code_body;
+void
+do_put_value(cow_string& buf, const Value& val)
+  {
+    do_put_byte(buf, val.type());
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            const auto& sloc = head->pv_meta->sloc;
+    switch(val.type()) {
+      case type_null:
+        return;
 
-            // Capture local references at this time.
-            bool dirty = false;
-            auto bound_body = sp.code_body;
-            do_rebind_nodes(dirty, bound_body, ctx);
+      case type_boolean:
+        do_put_byte(buf, val.as_boolean());
+        return;
 
-            // Instantiate the expression and push it to the current context.
-            AVM_Rod rod_body;
-            do_solidify_nodes(rod_body, bound_body);
-            ctx.mut_defer().emplace_back(sloc, ::std::move(rod_body));
-            return air_status_next;
-          }
+      case type_integer:
+        do_put_sint(buf, val.as_integer());
+        return;
 
-          // Uparam
-          , Uparam()
+      case type_real: {
+        uint64_t bits;
+        bcopy(bits, val.as_real());
+        do_put_uint(buf, bits);
+        return;
+      }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case type_string:
+        do_put_string(buf, val.as_string());
+        return;
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            do_collect_variables_for_each(staged, temp, sp.code_body);
-          }
+      case type_array:
+        do_put_uint(buf, val.as_array().size());
+        for(const auto& elem : val.as_array())
+          do_put_value(buf, elem);
+        return;
 
-          // Symbols
-          , &(altr.sloc)
-        );
+      case type_object:
+        do_put_uint(buf, val.as_object().size());
+        for(const auto& pair : val.as_object()) {
+          do_put_string(buf, pair.first.rdstr());
+          do_put_value(buf, pair.second);
+        }
         return;
-      }
 
-      case index_import_call: {
-        const auto& altr = this->m_stor.as<S_import_call>();
+      case type_opaque:
+      case type_function:
+        ASTERIA_THROW(("Constant of type `$1` cannot be serialized"), describe_type(val.type()));
 
-        Uparam up2;
-        up2.u2345 = altr.nargs;
+      default:
+        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), val.type());
+    }
+  }
 
-        struct Sparam
-          {
-            Compiler_Options opts;
-          };
+struct AIR_Input
+  {
+    const char*& bptr;
+    const char* eptr;
+    const cow_string& file;
+  };
 
-        Sparam sp2;
-        sp2.opts = altr.opts;
+[[noreturn]]
+void
+do_throw_corrupted()
+  {
+    ASTERIA_THROW(("Precompiled code corrupted"));
+  }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const uint32_t nargs = head->uparam.u2345;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            const auto& sloc = head->pv_meta->sloc;
-            const auto sentry = ctx.global().copy_recursion_sentry();
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
+uint8_t
+do_get_byte(AIR_Input& in)
+  {
+    if(in.bptr == in.eptr)
+      do_throw_corrupted();
 
-            ROCKET_ASSERT(nargs != 0);
-            do_pop_arguments(ctx.alt_stack(), ctx.stack(), nargs - 1);
+    return static_cast<uint8_t>(*(in.bptr ++));
+  }
 
-            // Get the path to import.
-            const auto& path_val = ctx.stack().top().dereference_readonly();
-            if(path_val.type() != type_string)
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Path was not a string (value `$1`)", path_val);
+uint64_t
+do_get_uint(AIR_Input& in)
+  {
+    uint64_t value = 0;
+    for(uint32_t shift = 0;  shift < 64;  shift += 7) {
+      uint8_t byte = do_get_byte(in);
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if(byte < 0x80)
+        return value;
+    }
+    do_throw_corrupted();
+  }
 
-            if(path_val.as_string() == "")
-              throw Runtime_Error(Runtime_Error::M_format(), "Path was empty");
+uint32_t
+do_get_u32(AIR_Input& in)
+  {
+    uint64_t value = do_get_uint(in);
+    if(value > UINT32_MAX)
+      do_throw_corrupted();
 
-            // If the path is relative, resolve it to an absolute one.
-            cow_string abs_path = path_val.as_string();
-            const auto& src_file = sloc.file();
-            if((abs_path[0] != '/') && (src_file[0] == '/'))
-              abs_path.insert(0, src_file, 0, src_file.rfind('/') + 1);
+    return static_cast<uint32_t>(value);
+  }
 
-            unique_ptr<char, void (void*)> realpathp(::free);
-            if(!realpathp.reset(::realpath(abs_path.safe_c_str(), nullptr)))
-              throw Runtime_Error(Runtime_Error::M_format(),
-                       "Could not open script file '$1': ${errno:full}", path_val);
+int64_t
+do_get_sint(AIR_Input& in)
+  {
+    uint64_t value = do_get_uint(in);
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
 
-            // Load and parse the file.
-            abs_path.assign(realpathp.get());
-            Source_Location script_sloc(abs_path, 0, 0);
+int32_t
+do_get_s32(AIR_Input& in)
+  {
+    int64_t value = do_get_sint(in);
+    if((value < INT32_MIN) || (value > INT32_MAX))
+      do_throw_corrupted();
 
-            Module_Loader::Unique_Stream istrm;
-            istrm.reset(ctx.global().module_loader(), realpathp);
+    return static_cast<int32_t>(value);
+  }
 
-            Token_Stream tstrm(sp.opts);
-            tstrm.reload(abs_path, 1, ::std::move(istrm.get()));
+// Enumerations are checked, as their values are used as indices of jump
+// tables, or to dispatch operators.
+Xop
+do_get_xop(AIR_Input& in)
+  {
+    uint8_t value = do_get_byte(in);
+    if(value > xop_random)
+      do_throw_corrupted();
 
-            Statement_Sequence stmtq(sp.opts);
-            stmtq.reload(::std::move(tstrm));
+    return static_cast<Xop>(value);
+  }
 
-            // Instantiate the script as a variadic function.
-            cow_vector<phsh_string> script_params;
-            script_params.emplace_back(sref("..."));
+PTC_Aware
+do_get_ptc(AIR_Input& in)
+  {
+    uint8_t value = do_get_byte(in);
+    if(value > ptc_aware_void)
+      do_throw_corrupted();
 
-            AIR_Optimizer optmz(sp.opts);
-            optmz.reload(nullptr, script_params, ctx.global(), stmtq.get_statements());
+    return static_cast<PTC_Aware>(value);
+  }
 
-            auto target = optmz.create_function(script_sloc, sref("[file scope]"));
-            auto& self = ctx.stack().mut_top().set_temporary(nullopt);
-            ctx.stack().clear_red_zone();
-            return do_invoke_maybe_tail(self, ctx.global(), ptc_aware_none, sloc, target,
-                                        ::std::move(ctx.alt_stack()));
-          }
+AIR_Status
+do_get_status(AIR_Input& in)
+  {
+    uint8_t value = do_get_byte(in);
+    if(value > air_status_continue_for)
+      do_throw_corrupted();
 
-          // Uparam
-          , up2
+    return static_cast<AIR_Status>(value);
+  }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+uint32_t
+do_get_count(AIR_Input& in)
+  {
+    // Every element takes at least one byte, so a count that exceeds the
+    // number of remaining bytes is invalid.
+    uint64_t count = do_get_uint(in);
+    if(count > static_cast<size_t>(in.eptr - in.bptr))
+      do_throw_corrupted();
 
-          // Collector
-          , nullptr
+    return static_cast<uint32_t>(count);
+  }
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
-      }
+cow_string
+do_get_string(AIR_Input& in)
+  {
+    uint64_t len = do_get_uint(in);
+    if(len > static_cast<size_t>(in.eptr - in.bptr))
+      do_throw_corrupted();
 
-      case index_declare_reference: {
-        const auto& altr = this->m_stor.as<S_declare_reference>();
+    cow_string str(in.bptr, static_cast<size_t>(len));
+    in.bptr += len;
+    return str;
+  }
 
-        struct Sparam
-          {
-            phsh_string name;
-          };
+Source_Location
+do_get_sloc(AIR_Input& in)
+  {
+    int line = do_get_s32(in);
+    int column = do_get_s32(in);
+    return Source_Location(in.file, line, column);
+  }
 
-        Sparam sp2;
-        sp2.name = altr.name;
+Compiler_Options
+do_get_options(AIR_Input& in)
+  {
+    Compiler_Options opts;
+    opts.version = do_get_byte(in);
+    opts.escapable_single_quotes = do_get_byte(in);
+    opts.keywords_as_identifiers = do_get_byte(in);
+    opts.integers_as_reals = do_get_byte(in);
+    opts.proper_tail_calls = do_get_byte(in);
+    opts.verbose_single_step_traps = do_get_byte(in);
+    opts.implicit_global_names = do_get_byte(in);
+    opts.optimization_level = do_get_byte(in);
+    return opts;
+  }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+cow_vector<phsh_string>
+do_get_names(AIR_Input& in)
+  {
+    cow_vector<phsh_string> names;
+    names.append(do_get_count(in));
+    for(auto it = names.mut_begin();  it != names.end();  ++it)
+      *it = do_get_string(in);
+    return names;
+  }
 
-            // Declare a void reference.
-            ctx.insert_named_reference(sp.name).clear();
-            return air_status_next;
-          }
+cow_vector<AIR_Node>
+do_get_code(AIR_Input& in)
+  {
+    cow_vector<AIR_Node> code;
+    uint32_t count = do_get_count(in);
+    code.reserve(count);
+    while(code.size() != count)
+      code.emplace_back(AIR_Node::deserialize(in.bptr, in.eptr, in.file));
+    return code;
+  }
 
-          // Uparam
-          , Uparam()
+Value
+do_get_value(AIR_Input& in)
+  {
+    switch(do_get_byte(in)) {
+      case type_null:
+        return nullopt;
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case type_boolean:
+        return do_get_byte(in) != 0;
 
-          // Collector
-          , nullptr
+      case type_integer:
+        return do_get_sint(in);
 
-          // Symbols
-          , nullptr
-        );
-        return;
+      case type_real: {
+        V_real real;
+        bcopy(real, do_get_uint(in));
+        return real;
       }
 
-      case index_initialize_reference: {
-        const auto& altr = this->m_stor.as<S_initialize_reference>();
-
-        struct Sparam
-          {
-            phsh_string name;
-          };
+      case type_string:
+        return do_get_string(in);
 
-        Sparam sp2;
-        sp2.name = altr.name;
+      case type_array: {
+        V_array arr;
+        uint32_t count = do_get_count(in);
+        while(arr.size() != count)
+          arr.emplace_back(do_get_value(in));
+        return ::std::move(arr);
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+      case type_object: {
+        V_object obj;
+        uint32_t count = do_get_count(in);
+        while(count -- != 0) {
+          phsh_string key = do_get_string(in);
+          obj.insert_or_assign(::std::move(key), do_get_value(in));
+        }
+        return ::std::move(obj);
+      }
 
-            // Move a reference from the stack into the current context.
-            ctx.insert_named_reference(sp.name) = ::std::move(ctx.stack().mut_top());
-            ctx.stack().pop();
-            return air_status_next;
-          }
+      default:
+        do_throw_corrupted();
+    }
+  }
 
-          // Uparam
-          , Uparam()
+}  // namespace
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+void
+AIR_Node::
+serialize(cow_string& buf) const
+  {
+    do_put_byte(buf, static_cast<uint8_t>(this->m_stor.index()));
 
-          // Collector
-          , nullptr
+    switch(static_cast<Index>(this->m_stor.index())) {
+      case index_clear_stack:
+      case index_alt_clear_stack:
+        return;
 
-          // Symbols
-          , &(altr.sloc)
-        );
+      case index_execute_block: {
+        const auto& altr = this->m_stor.as<S_execute_block>();
+        do_put_code(buf, altr.code_body);
         return;
       }
 
-      case index_catch_expression: {
-        const auto& altr = this->m_stor.as<S_catch_expression>();
-
-        struct Sparam
-          {
-            AVM_Rod rod_body;
-          };
+      case index_declare_variable: {
+        const auto& altr = this->m_stor.as<S_declare_variable>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.slot);
+        do_put_string(buf, altr.name.rdstr());
+        return;
+      }
 
-        Sparam sp2;
-        do_solidify_nodes(sp2.rod_body, altr.code_body);
+      case index_initialize_variable: {
+        const auto& altr = this->m_stor.as<S_initialize_variable>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.immutable);
+        return;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+      case index_if_statement: {
+        const auto& altr = this->m_stor.as<S_if_statement>();
+        do_put_byte(buf, altr.negative);
+        do_put_code(buf, altr.code_true);
+        do_put_code(buf, altr.code_false);
+        return;
+      }
 
-            // Save the stack.
-            Reference_Stack saved_stack;
-            ctx.stack().swap(saved_stack);
-            ctx.stack().swap(ctx.alt_stack());
+      case index_switch_statement: {
+        const auto& altr = this->m_stor.as<S_switch_statement>();
+        do_put_uint(buf, altr.clauses.size());
+        for(const auto& clause : altr.clauses) {
+          do_put_code(buf, clause.code_label);
+          do_put_code(buf, clause.code_body);
+          do_put_names(buf, clause.names_added);
+        }
+        return;
+      }
 
-            // Evaluate the expression in a `try` block.
-            Value exval;
-            try {
-              AIR_Status status = sp.rod_body.execute(ctx);
-              ROCKET_ASSERT(status == air_status_next);
-            }
-            catch(Runtime_Error& except) {
-              exval = except.value();
-            }
+      case index_do_while_statement: {
+        const auto& altr = this->m_stor.as<S_do_while_statement>();
+        do_put_code(buf, altr.code_body);
+        do_put_byte(buf, altr.negative);
+        do_put_code(buf, altr.code_cond);
+        return;
+      }
 
-            // Restore the stack after the evaluation completes.
-            ctx.stack().swap(ctx.alt_stack());
-            ctx.stack().swap(saved_stack);
+      case index_while_statement: {
+        const auto& altr = this->m_stor.as<S_while_statement>();
+        do_put_byte(buf, altr.negative);
+        do_put_code(buf, altr.code_cond);
+        do_put_code(buf, altr.code_body);
+        return;
+      }
 
-            // Push the exception object.
-            ctx.stack().push().set_temporary(::std::move(exval));
-            return air_status_next;
-          }
+      case index_for_each_statement: {
+        const auto& altr = this->m_stor.as<S_for_each_statement>();
+        do_put_string(buf, altr.name_key.rdstr());
+        do_put_string(buf, altr.name_mapped.rdstr());
+        do_put_sloc(buf, altr.sloc_init);
+        do_put_code(buf, altr.code_init);
+        do_put_code(buf, altr.code_body);
+        return;
+      }
 
-          // Uparam
-          , Uparam()
+      case index_for_statement: {
+        const auto& altr = this->m_stor.as<S_for_statement>();
+        do_put_code(buf, altr.code_init);
+        do_put_code(buf, altr.code_cond);
+        do_put_code(buf, altr.code_step);
+        do_put_code(buf, altr.code_body);
+        return;
+      }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case index_try_statement: {
+        const auto& altr = this->m_stor.as<S_try_statement>();
+        do_put_sloc(buf, altr.sloc_try);
+        do_put_code(buf, altr.code_try);
+        do_put_sloc(buf, altr.sloc_catch);
+        do_put_string(buf, altr.name_except.rdstr());
+        do_put_code(buf, altr.code_catch);
+        return;
+      }
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_body.collect_variables(staged, temp);
-          }
+      case index_throw_statement: {
+        const auto& altr = this->m_stor.as<S_throw_statement>();
+        do_put_sloc(buf, altr.sloc);
+        return;
+      }
 
-          // Symbols
-          , nullptr
-        );
+      case index_assert_statement: {
+        const auto& altr = this->m_stor.as<S_assert_statement>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_string(buf, altr.msg);
         return;
       }
 
-      case index_return_statement: {
-        const auto& altr = this->m_stor.as<S_return_statement>();
+      case index_simple_status: {
+        const auto& altr = this->m_stor.as<S_simple_status>();
+        do_put_byte(buf, altr.status);
+        return;
+      }
 
-        Uparam up2;
-        up2.b0 = altr.by_ref;
-        up2.b1 = altr.is_void;
+      case index_check_argument: {
+        const auto& altr = this->m_stor.as<S_check_argument>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.by_ref);
+        return;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const bool by_ref = head->uparam.b0;
-            const bool is_void = head->uparam.b1;
+      case index_push_global_reference: {
+        const auto& altr = this->m_stor.as<S_push_global_reference>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_string(buf, altr.name.rdstr());
+        return;
+      }
 
-            if(is_void || ctx.stack().top().is_void()) {
-              // Discard the result.
-              return air_status_return_void;
-            }
-            else if(by_ref) {
-              // The result is passed by reference, so check whether it is
-              // dereferenceable.
-              ctx.stack().top().dereference_readonly();
-              return air_status_return_ref;
-            }
-            else {
-              // The result is passed by copy, so convert it to a temporary.
-              ctx.stack().mut_top().dereference_copy();
-              return air_status_return_ref;
-            }
-          }
+      case index_push_local_reference: {
+        const auto& altr = this->m_stor.as<S_push_local_reference>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.depth);
+        do_put_uint(buf, altr.slot);
+        do_put_string(buf, altr.name.rdstr());
+        return;
+      }
 
-          // Uparam
-          , up2
+      case index_push_bound_reference:
+        // Bound references only exist in code that has been rebound to an
+        // executive context, which is never serialized.
+        ASTERIA_THROW(("Bound references cannot be serialized"));
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+      case index_define_function: {
+        const auto& altr = this->m_stor.as<S_define_function>();
+        do_put_options(buf, altr.opts);
+        do_put_sloc(buf, altr.sloc);
+        do_put_string(buf, altr.func);
+        do_put_names(buf, altr.params);
+        do_put_code(buf, altr.code_body);
+        return;
+      }
 
-          // Collector
-          , nullptr
+      case index_branch_expression: {
+        const auto& altr = this->m_stor.as<S_branch_expression>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_code(buf, altr.code_true);
+        do_put_code(buf, altr.code_false);
+        do_put_byte(buf, altr.assign);
+        return;
+      }
 
-          // Symbols
-          , &(altr.sloc)
-        );
+      case index_function_call: {
+        const auto& altr = this->m_stor.as<S_function_call>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.nargs);
+        do_put_byte(buf, altr.ptc);
         return;
       }
 
-      case index_push_constant: {
-        const auto& altr = this->m_stor.as<S_push_constant>();
+      case index_push_unnamed_array: {
+        const auto& altr = this->m_stor.as<S_push_unnamed_array>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.nelems);
+        return;
+      }
 
-        struct Sparam
-          {
-            Value val;
-          };
+      case index_push_unnamed_object: {
+        const auto& altr = this->m_stor.as<S_push_unnamed_object>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_names(buf, altr.keys);
+        return;
+      }
 
-        Sparam sp2;
-        sp2.val = altr.val;
+      case index_apply_operator: {
+        const auto& altr = this->m_stor.as<S_apply_operator>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.xop);
+        do_put_byte(buf, altr.assign);
+        return;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            ctx.stack().push().set_temporary(sp.val);
-            return air_status_next;
-          }
+      case index_unpack_struct_array: {
+        const auto& altr = this->m_stor.as<S_unpack_struct_array>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.immutable);
+        do_put_uint(buf, altr.nelems);
+        return;
+      }
 
-          // Uparam
-          , Uparam()
+      case index_unpack_struct_object: {
+        const auto& altr = this->m_stor.as<S_unpack_struct_object>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.immutable);
+        do_put_names(buf, altr.keys);
+        return;
+      }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case index_define_null_variable: {
+        const auto& altr = this->m_stor.as<S_define_null_variable>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.immutable);
+        do_put_uint(buf, altr.slot);
+        do_put_string(buf, altr.name.rdstr());
+        return;
+      }
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.val.collect_variables(staged, temp);
-          }
+      case index_single_step_trap: {
+        const auto& altr = this->m_stor.as<S_single_step_trap>();
+        do_put_sloc(buf, altr.sloc);
+        return;
+      }
 
-          // Symbols
-          , nullptr
-        );
+      case index_variadic_call: {
+        const auto& altr = this->m_stor.as<S_variadic_call>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.ptc);
         return;
       }
 
-      case index_alt_clear_stack: {
-        const auto& altr = this->m_stor.as<S_alt_clear_stack>();
+      case index_defer_expression: {
+        const auto& altr = this->m_stor.as<S_defer_expression>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_code(buf, altr.code_body);
+        return;
+      }
 
-        (void) altr;
+      case index_import_call: {
+        const auto& altr = this->m_stor.as<S_import_call>();
+        do_put_options(buf, altr.opts);
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.nargs);
+        return;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* /*head*/) ROCKET_FLATTEN -> AIR_Status
-          {
-            ctx.stack().swap(ctx.alt_stack());
-            ctx.stack().clear();
-            return air_status_next;
-          }
+      case index_declare_reference: {
+        const auto& altr = this->m_stor.as<S_declare_reference>();
+        do_put_uint(buf, altr.slot);
+        do_put_string(buf, altr.name.rdstr());
+        return;
+      }
 
-          // Uparam
-          , Uparam()
+      case index_initialize_reference: {
+        const auto& altr = this->m_stor.as<S_initialize_reference>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.slot);
+        do_put_string(buf, altr.name.rdstr());
+        return;
+      }
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+      case index_catch_expression: {
+        const auto& altr = this->m_stor.as<S_catch_expression>();
+        do_put_code(buf, altr.code_body);
+        return;
+      }
 
-          // Collector
-          , nullptr
+      case index_return_statement: {
+        const auto& altr = this->m_stor.as<S_return_statement>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.by_ref);
+        do_put_byte(buf, altr.is_void);
+        return;
+      }
 
-          // Symbols
-          , nullptr
-        );
+      case index_push_constant: {
+        const auto& altr = this->m_stor.as<S_push_constant>();
+        do_put_value(buf, altr.val);
         return;
       }
 
       case index_alt_function_call: {
         const auto& altr = this->m_stor.as<S_alt_function_call>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.ptc);
+        return;
+      }
 
-        Uparam up2;
-        up2.u0 = altr.ptc;
+      case index_coalesce_expression: {
+        const auto& altr = this->m_stor.as<S_coalesce_expression>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_code(buf, altr.code_null);
+        do_put_byte(buf, altr.assign);
+        return;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const PTC_Aware ptc = static_cast<PTC_Aware>(head->uparam.u0);
-            const auto& sloc = head->pv_meta->sloc;
-            const auto sentry = ctx.global().copy_recursion_sentry();
-            ASTERIA_CALL_GLOBAL_HOOK(ctx.global(), on_single_step_trap, ctx, sloc);
+      case index_member_access: {
+        const auto& altr = this->m_stor.as<S_member_access>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_string(buf, altr.key.rdstr());
+        return;
+      }
 
-            ctx.stack().swap(ctx.alt_stack());
-            return do_function_call(ctx, ptc, sloc);
-          }
+      case index_apply_operator_bi32: {
+        const auto& altr = this->m_stor.as<S_apply_operator_bi32>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_byte(buf, altr.xop);
+        do_put_byte(buf, altr.assign);
+        do_put_sint(buf, altr.irhs);
+        return;
+      }
 
-          // Uparam
-          , up2
+      case index_register_expression: {
+        const auto& altr = this->m_stor.as<S_register_expression>();
+        do_put_sloc(buf, altr.sloc);
+        do_put_uint(buf, altr.nregs);
+        do_put_uint(buf, altr.code.size());
+        for(const auto& insn : altr.code) {
+          if(insn.opcode == regop_load_bound)
+            ASTERIA_THROW(("Bound references cannot be serialized"));
+
+          do_put_byte(buf, insn.opcode);
+          do_put_byte(buf, insn.xop);
+          do_put_byte(buf, insn.dst);
+          do_put_byte(buf, insn.src);
+          do_put_sint(buf, insn.irhs);
+          do_put_uint(buf, insn.depth);
+          do_put_uint(buf, insn.slot);
+          do_put_string(buf, insn.name.rdstr());
+          do_put_sloc(buf, insn.sloc);
+          if(insn.opcode == regop_load_constant)
+            do_put_value(buf, insn.val);
+        }
+        return;
+      }
 
-          // Sparam
-          , 0, nullptr, nullptr, nullptr
+      default:
+        ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
+    }
+  }
 
-          // Collector
-          , nullptr
+AIR_Node
+AIR_Node::
+deserialize(const char*& bptr, const char* eptr, stringR file)
+  {
+    AIR_Input in = { bptr, eptr, file };
+
+    switch(do_get_byte(in)) {
+      case index_clear_stack:
+        return S_clear_stack();
+
+      case index_alt_clear_stack:
+        return S_alt_clear_stack();
+
+      case index_execute_block: {
+        S_execute_block xnode;
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+      case index_declare_variable: {
+        S_declare_variable xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.slot = do_get_u32(in);
+        xnode.name = do_get_string(in);
+        return xnode;
       }
 
-      case index_coalesce_expression: {
-        const auto& altr = this->m_stor.as<S_coalesce_expression>();
+      case index_initialize_variable: {
+        S_initialize_variable xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.immutable = do_get_byte(in);
+        return xnode;
+      }
 
-        Uparam up2;
-        up2.b0 = altr.assign;
+      case index_if_statement: {
+        S_if_statement xnode;
+        xnode.negative = do_get_byte(in);
+        xnode.code_true = do_get_code(in);
+        xnode.code_false = do_get_code(in);
+        return xnode;
+      }
 
-        struct Sparam
-          {
-            AVM_Rod rod_null;
-          };
+      case index_switch_statement: {
+        S_switch_statement xnode;
+        uint32_t count = do_get_count(in);
+        while(xnode.clauses.size() != count) {
+          auto& clause = xnode.clauses.emplace_back();
+          clause.code_label = do_get_code(in);
+          clause.code_body = do_get_code(in);
+          clause.names_added = do_get_names(in);
+        }
+        return xnode;
+      }
 
-        Sparam sp2;
-        do_solidify_nodes(sp2.rod_null, altr.code_null);
+      case index_do_while_statement: {
+        S_do_while_statement xnode;
+        xnode.code_body = do_get_code(in);
+        xnode.negative = do_get_byte(in);
+        xnode.code_cond = do_get_code(in);
+        return xnode;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const bool assign = head->uparam.b0;
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+      case index_while_statement: {
+        S_while_statement xnode;
+        xnode.negative = do_get_byte(in);
+        xnode.code_cond = do_get_code(in);
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-            // Read the condition and evaluate the corresponding subexpression.
-            return ctx.stack().top().dereference_readonly().is_null()
-                     ? do_evaluate_subexpression(ctx, assign, sp.rod_null)
-                     : air_status_next;
-          }
+      case index_for_each_statement: {
+        S_for_each_statement xnode;
+        xnode.name_key = do_get_string(in);
+        xnode.name_mapped = do_get_string(in);
+        xnode.sloc_init = do_get_sloc(in);
+        xnode.code_init = do_get_code(in);
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-          // Uparam
-          , up2
+      case index_for_statement: {
+        S_for_statement xnode;
+        xnode.code_init = do_get_code(in);
+        xnode.code_cond = do_get_code(in);
+        xnode.code_step = do_get_code(in);
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case index_try_statement: {
+        S_try_statement xnode;
+        xnode.sloc_try = do_get_sloc(in);
+        xnode.code_try = do_get_code(in);
+        xnode.sloc_catch = do_get_sloc(in);
+        xnode.name_except = do_get_string(in);
+        xnode.code_catch = do_get_code(in);
+        return xnode;
+      }
 
-          // Collector
-          , +[](Variable_HashMap& staged, Variable_HashMap& temp, const Header* head)
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
-            sp.rod_null.collect_variables(staged, temp);
-          }
+      case index_throw_statement: {
+        S_throw_statement xnode;
+        xnode.sloc = do_get_sloc(in);
+        return xnode;
+      }
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+      case index_assert_statement: {
+        S_assert_statement xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.msg = do_get_string(in);
+        return xnode;
       }
 
-      case index_member_access: {
-        const auto& altr = this->m_stor.as<S_member_access>();
+      case index_simple_status: {
+        S_simple_status xnode;
+        xnode.status = do_get_status(in);
+        return xnode;
+      }
 
-        struct Sparam
-          {
-            phsh_string key;
-          };
+      case index_check_argument: {
+        S_check_argument xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.by_ref = do_get_byte(in);
+        return xnode;
+      }
 
-        Sparam sp2;
-        sp2.key = altr.key;
+      case index_push_global_reference: {
+        S_push_global_reference xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.name = do_get_string(in);
+        return xnode;
+      }
 
-        rod.append(
-          +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-          {
-            const auto& sp = *reinterpret_cast<const Sparam*>(head->sparam);
+      case index_push_local_reference: {
+        S_push_local_reference xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.depth = do_get_u32(in);
+        xnode.slot = do_get_u32(in);
+        xnode.name = do_get_string(in);
+        return xnode;
+      }
 
-            // Push a modifier.
-            Reference_Modifier::S_object_key xmod = { sp.key };
-            do_push_modifier_and_check(ctx.stack().mut_top(), ::std::move(xmod));
-            return air_status_next;
-          }
+      case index_define_function: {
+        S_define_function xnode;
+        xnode.opts = do_get_options(in);
+        xnode.sloc = do_get_sloc(in);
+        xnode.func = do_get_string(in);
+        xnode.params = do_get_names(in);
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-          // Uparam
-          , Uparam()
+      case index_branch_expression: {
+        S_branch_expression xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.code_true = do_get_code(in);
+        xnode.code_false = do_get_code(in);
+        xnode.assign = do_get_byte(in);
+        return xnode;
+      }
 
-          // Sparam
-          , sizeof(sp2), do_sparam_ctor<Sparam>, &sp2, do_sparam_dtor<Sparam>
+      case index_function_call: {
+        S_function_call xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.nargs = do_get_u32(in);
+        xnode.ptc = do_get_ptc(in);
+        return xnode;
+      }
 
-          // Collector
-          , nullptr
+      case index_push_unnamed_array: {
+        S_push_unnamed_array xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.nelems = do_get_u32(in);
+        return xnode;
+      }
 
-          // Symbols
-          , &(altr.sloc)
-        );
-        return;
+      case index_push_unnamed_object: {
+        S_push_unnamed_object xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.keys = do_get_names(in);
+        return xnode;
       }
 
-      case index_apply_operator_bi32: {
-        const auto& altr = this->m_stor.as<S_apply_operator_bi32>();
+      case index_apply_operator: {
+        S_apply_operator xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.xop = do_get_xop(in);
+        xnode.assign = do_get_byte(in);
+        return xnode;
+      }
 
-        Uparam up2;
-        up2.b0 = altr.assign;
-        up2.u1 = altr.xop;
-        up2.i2345 = altr.irhs;
+      case index_unpack_struct_array: {
+        S_unpack_struct_array xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.immutable = do_get_byte(in);
+        xnode.nelems = do_get_u32(in);
+        return xnode;
+      }
 
-        switch(altr.xop) {
-          case xop_inc:
-          case xop_dec:
-          case xop_unset:
-          case xop_head:
-          case xop_tail:
-          case xop_random:
-          case xop_pos:
-          case xop_neg:
-          case xop_notb:
-          case xop_notl:
-          case xop_countof:
-          case xop_typeof:
-          case xop_sqrt:
-          case xop_isnan:
-          case xop_isinf:
-          case xop_abs:
-          case xop_sign:
-          case xop_round:
-          case xop_floor:
-          case xop_ceil:
-          case xop_trunc:
-          case xop_iround:
-          case xop_ifloor:
-          case xop_iceil:
-          case xop_itrunc:
-          case xop_lzcnt:
-          case xop_tzcnt:
-          case xop_popcnt:
-          case xop_fma:
-            ASTERIA_TERMINATE(("Constant folding not implemented for `$1`"), altr.xop);
+      case index_unpack_struct_object: {
+        S_unpack_struct_object xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.immutable = do_get_byte(in);
+        xnode.keys = do_get_names(in);
+        return xnode;
+      }
 
-          case xop_assign:
-          case xop_index:
-            // binary
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const uint8_t uxop = head->uparam.u1;
-                const V_integer irhs = head->uparam.i2345;
-                auto& top = ctx.stack().mut_top();
+      case index_define_null_variable: {
+        S_define_null_variable xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.immutable = do_get_byte(in);
+        xnode.slot = do_get_u32(in);
+        xnode.name = do_get_string(in);
+        return xnode;
+      }
 
-                switch(uxop) {
-                  case xop_assign: {
-                    // `assign` is ignored.
-                    top.dereference_mutable() = irhs;
-                    return air_status_next;
-                  }
+      case index_single_step_trap: {
+        S_single_step_trap xnode;
+        xnode.sloc = do_get_sloc(in);
+        return xnode;
+      }
 
-                  case xop_index: {
-                    // Push a subscript.
-                    Reference_Modifier::S_array_index xmod = { irhs };
-                    do_push_modifier_and_check(top, ::std::move(xmod));
-                    return air_status_next;
-                  }
+      case index_variadic_call: {
+        S_variadic_call xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.ptc = do_get_ptc(in);
+        return xnode;
+      }
 
-                  default:
-                    ROCKET_UNREACHABLE();
-                }
-              }
+      case index_defer_expression: {
+        S_defer_expression xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-              // Uparam
-              , up2
+      case index_import_call: {
+        S_import_call xnode;
+        xnode.opts = do_get_options(in);
+        xnode.sloc = do_get_sloc(in);
+        xnode.nargs = do_get_u32(in);
+        return xnode;
+      }
 
-              // Sparam
-              , 0, nullptr, nullptr, nullptr
+      case index_declare_reference: {
+        S_declare_reference xnode;
+        xnode.slot = do_get_u32(in);
+        xnode.name = do_get_string(in);
+        return xnode;
+      }
 
-              // Collector
-              , nullptr
+      case index_initialize_reference: {
+        S_initialize_reference xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.slot = do_get_u32(in);
+        xnode.name = do_get_string(in);
+        return xnode;
+      }
 
-              // Symbols
-              , &(altr.sloc)
-            );
-            return;
+      case index_catch_expression: {
+        S_catch_expression xnode;
+        xnode.code_body = do_get_code(in);
+        return xnode;
+      }
 
-          case xop_cmp_eq:
-          case xop_cmp_ne:
-          case xop_cmp_un:
-          case xop_cmp_lt:
-          case xop_cmp_gt:
-          case xop_cmp_lte:
-          case xop_cmp_gte:
-          case xop_cmp_3way:
-          case xop_add:
-          case xop_sub:
-          case xop_mul:
-          case xop_div:
-          case xop_mod:
-          case xop_andb:
-          case xop_orb:
-          case xop_xorb:
-          case xop_addm:
-          case xop_subm:
-          case xop_mulm:
-          case xop_adds:
-          case xop_subs:
-          case xop_muls:
-          case xop_sll:
-          case xop_srl:
-          case xop_sla:
-          case xop_sra:
-            // binary, shift
-            rod.append(
-              +[](Executive_Context& ctx, const Header* head) ROCKET_FLATTEN -> AIR_Status
-              {
-                const bool assign = head->uparam.b0;
-                const uint8_t uxop = head->uparam.u1;
-                const V_integer irhs = head->uparam.i2345;
-                auto& top = ctx.stack().mut_top();
-                auto& lhs = assign ? top.dereference_mutable() : top.dereference_copy();
+      case index_return_statement: {
+        S_return_statement xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.by_ref = do_get_byte(in);
+        xnode.is_void = do_get_byte(in);
+        return xnode;
+      }
 
-                return do_apply_binary_operator_with_integer(uxop, lhs, irhs);
-              }
+      case index_push_constant: {
+        S_push_constant xnode;
+        xnode.val = do_get_value(in);
+        return xnode;
+      }
 
-              // Uparam
-              , up2
+      case index_alt_function_call: {
+        S_alt_function_call xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.ptc = do_get_ptc(in);
+        return xnode;
+      }
 
-              // Sparam
-              , 0, nullptr, nullptr, nullptr
+      case index_coalesce_expression: {
+        S_coalesce_expression xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.code_null = do_get_code(in);
+        xnode.assign = do_get_byte(in);
+        return xnode;
+      }
 
-              // Collector
-              , nullptr
+      case index_member_access: {
+        S_member_access xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.key = do_get_string(in);
+        return xnode;
+      }
 
-              // Symbols
-              , &(altr.sloc)
-            );
-            return;
+      case index_apply_operator_bi32: {
+        S_apply_operator_bi32 xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.xop = do_get_xop(in);
+        xnode.assign = do_get_byte(in);
+        xnode.irhs = do_get_s32(in);
+        if(!do_is_register_xop(xnode.xop, true))
+          do_throw_corrupted();
+        return xnode;
+      }
 
-          default:
-            ASTERIA_TERMINATE(("Corrupted enumeration `$1`"), this->m_stor.index());
+      case index_register_expression: {
+        S_register_expression xnode;
+        xnode.sloc = do_get_sloc(in);
+        xnode.nregs = do_get_u32(in);
+        if((xnode.nregs == 0) || (xnode.nregs > register_count_max))
+          do_throw_corrupted();
+
+        // The `return` instruction is appended when the node is solidified,
+        // and bound references cannot be serialized.
+        uint32_t count = do_get_count(in);
+        while(xnode.code.size() != count) {
+          auto& insn = xnode.code.emplace_back();
+          uint8_t opcode = do_get_byte(in);
+          if((opcode >= regop_return) || (opcode == regop_load_bound))
+            do_throw_corrupted();
+
+          insn.opcode = static_cast<Register_Opcode>(opcode);
+          insn.xop = do_get_xop(in);
+          insn.dst = do_get_byte(in);
+          insn.src = do_get_byte(in);
+          if((insn.dst >= xnode.nregs) || (insn.src >= xnode.nregs))
+            do_throw_corrupted();
+
+          if(((insn.opcode == regop_apply) && !do_is_register_xop(insn.xop, false))
+             || ((insn.opcode == regop_apply_bi32) && !do_is_register_xop(insn.xop, true)))
+            do_throw_corrupted();
+
+          insn.irhs = do_get_s32(in);
+          insn.depth = do_get_u32(in);
+          insn.slot = do_get_u32(in);
+          insn.name = do_get_string(in);
+          insn.sloc = do_get_sloc(in);
+          if(insn.opcode == regop_load_constant)
+            insn.val = do_get_value(in);
         }
+        return xnode;
       }
+
+      default:
+        do_throw_corrupted();
     }
   }
 
@@ -25,6 +25,7 @@ class AIR_Node
     struct S_declare_variable
       {
         Source_Location sloc;
+        uint32_t slot;
         phsh_string name;
       };
 
@@ -125,6 +126,7 @@ class AIR_Node
       {
         Source_Location sloc;
         uint32_t depth;
+        uint32_t slot;
         phsh_string name;
       };
 
@@ -194,6 +196,7 @@ class AIR_Node
       {
         Source_Location sloc;
         bool immutable;
+        uint32_t slot;
         phsh_string name;
       };
 
@@ -223,12 +226,14 @@ class AIR_Node
 
     struct S_declare_reference
       {
+        uint32_t slot;
         phsh_string name;
       };
 
     struct S_initialize_reference
       {
         Source_Location sloc;
+        uint32_t slot;
         phsh_string name;
       };
 
@@ -280,6 +285,38 @@ class AIR_Node
         int32_t irhs;
       };
 
+    enum Register_Opcode : uint8_t
+      {
+        regop_load_constant  = 0,
+        regop_load_local     = 1,
+        regop_load_bound     = 2,
+        regop_apply          = 3,
+        regop_apply_bi32     = 4,
+        regop_return         = 5,
+      };
+
+    struct register_insn
+      {
+        Register_Opcode opcode;
+        Xop xop;
+        uint8_t dst;  // register for the result, which is also the LHS operand
+        uint8_t src;  // register for the RHS operand
+        int32_t irhs;
+        uint32_t depth;
+        uint32_t slot;
+        phsh_string name;
+        Value val;
+        Reference ref;
+        Source_Location sloc;  // where errors are reported
+      };
+
+    struct S_register_expression
+      {
+        Source_Location sloc;
+        uint32_t nregs;
+        cow_vector<register_insn> code;
+      };
+
     enum Index : uint8_t
       {
         index_clear_stack            =  0,
@@ -323,6 +360,7 @@ class AIR_Node
         index_coalesce_expression    = 38,
         index_member_access          = 39,
         index_apply_operator_bi32    = 40,
+        index_register_expression    = 41,
       };
 
   private:
@@ -369,6 +407,7 @@ class AIR_Node
         , S_coalesce_expression    // 38,
         , S_member_access          // 39,
         , S_apply_operator_bi32    // 40,
+        , S_register_expression    // 41,
       );
 
   public:
@@ -417,11 +456,46 @@ class AIR_Node
     // This is necessary because the body of a closure shall not have been
     // solidified.
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const;
+
+    // Fold operators whose operands are constants, and encode small integer
+    // operands into operators. At level 2, branches with constant conditions
+    // are pruned, and nodes after terminators are removed. Nested code is
+    // processed recursively, except bodies of closures.
+    static void
+    optimize(cow_vector<AIR_Node>& code, uint8_t level);
+
+    // Lower operators whose operands are constants or variables into register
+    // code, so intermediate results are not pushed onto the stack. Nested code
+    // is processed recursively, except bodies of closures, which have been
+    // processed by their own optimizers.
+    static void
+    lower_to_registers(cow_vector<AIR_Node>& code);
 
     // Compress this IR node into `rod` for execution.
     void
     solidify(AVM_Rod& rod) const;
+
+    // Compress a sequence of IR nodes into `rod` for execution. Common short
+    // sequences are fused into single nodes. If `ASTERIA_NGRAM_STATS` is
+    // defined, nodes are not fused; instead, sequences that are executed are
+    // counted, and the most frequent ones are printed to standard error when
+    // the program exits.
+    static void
+    solidify_sequence(AVM_Rod& rod, const cow_vector<AIR_Node>& code);
+
+    // Serialize this IR node into `buf`, so it can be stored as precompiled
+    // code. File names of source locations are not stored. An exception is
+    // thrown if this node contains a bound reference or a non-serializable
+    // constant.
+    void
+    serialize(cow_string& buf) const;
+
+    // Deserialize an IR node from `[bptr,eptr)`, which shall have been stored
+    // by `serialize()`, and advance `bptr` past it. Source locations are set
+    // to `file`. An exception is thrown if the data are corrupted.
+    static AIR_Node
+    deserialize(const char*& bptr, const char* eptr, stringR file);
   };
 
 inline
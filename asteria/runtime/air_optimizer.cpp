@@ -46,7 +46,10 @@ reload(const Abstract_Context* ctx_opt, const cow_vector<phsh_string>& params,
     if(this->m_opts.optimization_level <= 0)
       return;
 
-    // TODO: Insert optimization passes
+    AIR_Node::optimize(this->m_code, this->m_opts.optimization_level);
+
+    if(this->m_opts.optimization_level >= 3)
+      AIR_Node::lower_to_registers(this->m_code);
   }
 
 void
@@ -12,7 +12,8 @@ Analytic_Context(M_function, const Abstract_Context* parent_opt,
   :
     m_parent_opt(parent_opt)
   {
-    // Set parameters, which are local references.
+    // Set parameters, which are local references. They take the first slots,
+    // followed by `__this`, which the executive context relies on.
     for(const auto& name : params)
       if(name != sref("..."))
         this->do_mut_named_reference(nullptr, name);
@@ -36,7 +36,7 @@ operator->*(target_R_gsa& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -80,7 +80,7 @@ operator->*(target_R_ga& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -124,7 +124,7 @@ operator->*(target_R_sa& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -168,7 +168,7 @@ operator->*(target_R_a& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -212,7 +212,7 @@ operator->*(target_V_gsa& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -256,7 +256,7 @@ operator->*(target_V_ga& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -300,7 +300,7 @@ operator->*(target_V_sa& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -344,7 +344,7 @@ operator->*(target_V_a& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -388,7 +388,7 @@ operator->*(target_Z_gsa& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -432,7 +432,7 @@ operator->*(target_Z_ga& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -476,7 +476,7 @@ operator->*(target_Z_sa& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -520,7 +520,7 @@ operator->*(target_Z_a& target) const
           }
 
         void
-        collect_variables(Variable_HashMap&, Variable_HashMap&) const final
+        collect_variables(Variable_HashMap&, Variable_Worklist&) const final
           {
           }
 
@@ -21,21 +21,17 @@ Executive_Context(M_function, Global_Context& global, Reference_Stack& stack,
     m_parent_opt(nullptr), m_global(&global), m_stack(&stack),
     m_alt_stack(&alt_stack), m_zvarg(zvarg)
   {
-    // Set the `this` reference, but only if it is a variable or non-null. When
-    // `this` is null, it is likely that it is never referenced in the function,
-    // so lazy initialization is performed to avoid the overhead here.
-    if(!self.is_invalid())
-      this->do_mut_named_reference(nullptr, sref("__this")) = ::std::move(self);
-
     // Set arguments. Because arguments are evaluated from left to right, the
-    // reference at the top is the last argument.
+    // reference at the top is the last argument. Parameters occupy the first
+    // slots, in the same order as they are declared in the analytic context.
     uint32_t nargs = stack.size();
+    uint32_t slot = 0;
     bool has_ellipsis = false;
 
     for(const auto& name : params)
       if(name != sref("...")) {
         // Try popping an argument and assign it.
-        auto& param = this->do_mut_named_reference(nullptr, name);
+        auto& param = this->do_mut_named_reference(name, slot ++);
         if(nargs == 0)
           param.set_temporary(nullopt);
         else
@@ -44,6 +40,12 @@ Executive_Context(M_function, Global_Context& global, Reference_Stack& stack,
       else
         has_ellipsis = true;
 
+    // Set the `this` reference, but only if it is a variable or non-null. When
+    // `this` is null, it is likely that it is never referenced in the function,
+    // so lazy initialization is performed to avoid the overhead here.
+    if(!self.is_invalid())
+      this->do_mut_named_reference(sref("__this"), slot) = ::std::move(self);
+
     if(!has_ellipsis && (nargs != 0))
       throw Runtime_Error(Runtime_Error::M_format(),
                "Too many arguments passed to `$1`", zvarg->func());
@@ -5,138 +5,393 @@
 #include "garbage_collector.hpp"
 #include "variable.hpp"
 #include "../utils.hpp"
+#include <time.h>  // ::clock_gettime()
 namespace asteria {
+namespace {
+
+void
+do_warn_exception(const exception& stdex) noexcept
+  {
+    ::fprintf(stderr,
+        "WARNING: An unusual exception that was thrown during garbage "
+        "collection has been caught and ignored. If this issue persists, "
+        "please file a bug report.\n"
+        "\n"
+        "  exception class: %s\n"
+        "  what(): %s\n",
+        typeid(stdex).name(), stdex.what());
+  }
+
+int64_t
+do_monotonic_us() noexcept
+  {
+    ::timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+  }
+
+// Cycles of all collectors are numbered uniquely, so a foreign variable can't
+// be mistaken as visited.
+atomic_relaxed<uint32_t> s_cycle_counter;
+
+}  // namespace
 
 Garbage_Collector::
 ~Garbage_Collector()
   {
+    this->do_abort_cycle();
   }
 
-size_t
+inline
+void
 Garbage_Collector::
-do_collect_generation(uint32_t gen)
+do_visit(Variable* var)
   {
-    // Ignore recursive requests.
-    if(this->m_recur > 0)
-      return 0;
+    // Each variable that is visited here shall have a direct reference from
+    // either `tracked` or an owner, so its `gc_ref` counter shall be initialized
+    // to one. If the variable is held, that reference is also counted.
+    var->set_gc_cycle(this->m_cycle);
+    var->set_gc_ref(1 + this->m_incr_cycle);
+    this->m_visited.push_back(var);
+
+    if(this->m_incr_cycle) {
+      this->m_held.emplace_back();
+      var->add_reference();
+      this->m_held.mut_back().reset(var);
+    }
+  }
 
-    this->m_recur ++;
-    const ::rocket::unique_ptr<int, void (int*)> rguard(&(this->m_recur), *[](int* ptr) { -- *ptr;  });
+void
+Garbage_Collector::
+do_start_cycle(uint32_t gen, bool incr)
+  {
+    ROCKET_ASSERT(this->m_phase == phase_idle);
 
+    this->m_staged.clear();
+    this->m_found.clear();
+    this->m_visited.clear();
+    this->m_marking.clear();
+    this->m_forced.clear();
+    this->m_held.clear();
+
+    do
+      this->m_cycle = s_cycle_counter.xadd(1U) + 1U;
+    while(this->m_cycle == 0);
+
+    this->m_incr_cycle = incr;
+    this->m_gen = gen;
+    this->m_cursor = 0;
+    this->m_ncands = 0;
+    this->m_phase = phase_scan;
+
+    // Take a snapshot of the generation. Variables that are created later are
+    // not in it.
+    this->m_tracked.at(gMax - gen).for_each_variable(
+        [&](const refcnt_ptr<Variable>& var) { this->do_visit(var.get());  });
+
+    this->m_ntracked = this->m_visited.size();
+  }
+
+size_t
+Garbage_Collector::
+do_run_cycle(size_t quantum, int64_t deadline)
+  {
     // This algorithm is described at
     //   https://pythoninternal.wordpress.com/2014/08/04/the-garbage-collector/
     size_t nvars = 0;
-    refcnt_ptr<Variable> var;
-    auto& tracked = this->m_tracked.at(gMax - gen);
-    const auto next_opt = (gen >= gMax) ? nullptr : &(this->m_tracked.at(gMax - gen - 1));
-    const auto count_opt = (gen >= gMax) ? nullptr : &(this->m_counts.at(gMax - gen - 1));
+    size_t nwork = 0;
+    auto& tracked = this->m_tracked.at(gMax - this->m_gen);
+    const auto next_opt = (this->m_gen >= gMax) ? nullptr : &(this->m_tracked.at(gMax - this->m_gen - 1));
+    const auto count_opt = (this->m_gen >= gMax) ? nullptr : &(this->m_counts.at(gMax - this->m_gen - 1));
+
+    while(this->m_phase != phase_idle) {
+      // Yield if enough work has been done. Reading the clock is not cheap,
+      // so the deadline is checked every 16 variables.
+      if(nwork >= quantum)
+        break;
+
+      if(deadline && (nwork % 16 == 15) && (do_monotonic_us() >= deadline))
+        break;
+
+      if(this->m_phase == phase_scan) {
+        if(this->m_cursor == this->m_visited.size()) {
+          this->m_staged.clear();
+          this->m_cursor = 0;
+          this->m_phase = phase_classify;
+          continue;
+        }
 
-    this->m_staged.clear();
-    this->m_temp_1.clear();
-    this->m_temp_2.clear();
-    this->m_unreach.clear();
-    tracked.merge_into(this->m_temp_1);
-
-    while(this->m_temp_1.extract_variable(var)) {
-      // Each variable that is encountered here shall have a direct reference
-      // from either `tracked` or `m_staged`, so its `gc_ref` counter shall be
-      // initialized to one.
-      var->set_gc_ref(1);
-      ROCKET_ASSERT(var->get_gc_ref() <= var->use_count() - 1);
-      var->get_value().collect_variables(this->m_staged, this->m_temp_1);
-    }
+        nwork ++;
+        const auto var = this->m_visited[this->m_cursor++];
 
-    this->m_temp_1.clear();
+        if(this->m_incr_cycle) {
+          // A variable that has a write barrier from another collector can't
+          // be scanned, so it is reachable.
+          if(var->get_gc_barrier() && (var->get_gc_barrier() != this)) {
+            this->m_forced.push_back(var);
+            continue;
+          }
 
-    while(this->m_staged.extract_variable(var)) {
-      // Each key in `m_staged` denotes an internal reference, so its `gc_ref`
-      // counter shall be incremented.
-      var->set_gc_ref(var->get_gc_ref() + 1);
-      ROCKET_ASSERT(var->get_gc_ref() <= var->use_count() - 1);
-      this->m_temp_1.insert(var.get(), var);
-    }
+          var->set_gc_barrier(this);
+        }
 
-    this->m_staged.clear();
-    tracked.merge_into(this->m_temp_1);
-
-    while(this->m_temp_1.extract_variable(var)) {
-      // Each variable whose `gc_ref` counter equals its reference count is
-      // marked as possibly unreachable. Note `var` here owns a reference
-      // which must be excluded.
-      if(var->get_gc_ref() == var->use_count() - 1)
-        this->m_unreach.insert(var.get(), var);
-      else
-        this->m_temp_2.insert(var.get(), var);
-    }
+        // Each variable that is found here denotes an internal reference, so
+        // its `gc_ref` counter shall be incremented.
+        this->m_found.clear();
+        var->get_value().collect_variables(this->m_staged, this->m_found);
 
-    this->m_temp_1.clear();
+        for(auto qvar : this->m_found) {
+          if(qvar->get_gc_cycle() != this->m_cycle)
+            this->do_visit(qvar);
 
-    while(this->m_temp_2.extract_variable(var)) {
-      // Mark this indirectly reachable variable, too.
-      var->set_gc_ref(0);
-      this->m_temp_1.erase(var.get());
-      this->m_unreach.erase(var.get());
+          qvar->set_gc_ref(qvar->get_gc_ref() + 1);
+          ROCKET_ASSERT(qvar->get_gc_ref() <= qvar->use_count());
+        }
+      }
+      else if(this->m_phase == phase_classify) {
+        if(this->m_cursor == this->m_visited.size()) {
+          // Only tracked variables are kept for collection.
+          this->m_visited.erase(this->m_ncands);
+          this->m_cursor = 0;
+          this->m_phase = phase_mark;
+          continue;
+        }
 
-      var->get_value().collect_variables(this->m_staged, this->m_temp_2);
+        // Each variable whose `gc_ref` counter equals its reference count is
+        // marked as possibly unreachable. Others are roots for marking.
+        nwork ++;
+        const size_t index = this->m_cursor++;
+        const auto var = this->m_visited[index];
 
-      if(next_opt && tracked.erase(var.get()))
-        try {
-          // Move the variable to the next generation.
-          next_opt->insert(var.get(), var);
-          *count_opt += 1;
+        if(var->get_gc_ref() != var->use_count())
+          this->m_marking.push_back(var);
+        else if(index < this->m_ntracked)
+          this->m_visited.mut(this->m_ncands++) = var;
+      }
+      else if(this->m_phase == phase_mark) {
+        if(!this->m_forced.empty()) {
+          this->m_marking.append(this->m_forced.begin(), this->m_forced.end());
+          this->m_forced.clear();
         }
-        catch(...) {
-          tracked.insert(var.get(), var);
+
+        if(this->m_marking.empty()) {
+          this->m_staged.clear();
+          this->m_phase = phase_sweep;
+          continue;
         }
-    }
 
-    this->m_temp_2.clear();
+        nwork ++;
+        const auto var = this->m_marking.back();
+        this->m_marking.pop_back();
+        if(var->get_gc_ref() == 0)
+          continue;
+
+        // Mark this indirectly reachable variable, too.
+        var->set_gc_ref(0);
+
+        this->m_found.clear();
+        var->get_value().collect_variables(this->m_staged, this->m_found);
+
+        for(auto qvar : this->m_found)
+          if((qvar->get_gc_cycle() == this->m_cycle) && (qvar->get_gc_ref() != 0))
+            this->m_marking.push_back(qvar);
+
+        refcnt_ptr<Variable> rvar;
+        if(next_opt && tracked.erase(var, &rvar))
+          try {
+            // Move the variable to the next generation.
+            next_opt->insert(var, rvar);
+            *count_opt += 1;
+          }
+          catch(...) {
+            tracked.insert(var, rvar);
+          }
+      }
+      else if(this->m_phase == phase_sweep) {
+        // If a write barrier has been triggered since marking, mark again.
+        if(!this->m_forced.empty()) {
+          this->m_phase = phase_mark;
+          continue;
+        }
 
-    while(this->m_unreach.extract_variable(var)) {
-      // This variable is unreachable now, so collect it.
-      if(!tracked.erase(var.get()))
-        continue;
+        if(this->m_cursor == this->m_visited.size()) {
+          this->m_cursor = 0;
+          this->m_phase = phase_release;
+          continue;
+        }
 
-      ROCKET_ASSERT(var->get_gc_ref() != 0);
-      nvars += 1;
+        // All variables here are tracked, so they are alive. Those that have
+        // not been marked are unreachable now, so collect them.
+        nwork ++;
+        const auto var = this->m_visited[this->m_cursor++];
+        if(var->get_gc_ref() == 0)
+          continue;
 
-      try {
-        // Cache the variable for later use.
-        // If an exception is thrown during uninitialization, the variable
-        // shall be collected immediately.
-        var->uninitialize();
-        this->m_pool.insert(var.get(), var);
+        refcnt_ptr<Variable> rvar;
+        if(!tracked.erase(var, &rvar))
+          continue;
+
+        nvars += 1;
+
+        try {
+          // Cache the variable for later use.
+          // If an exception is thrown during uninitialization, the variable
+          // shall be collected immediately.
+          rvar->uninitialize();
+          this->m_pool.insert(var, rvar);
+        }
+        catch(exception& stdex) {
+          do_warn_exception(stdex);
+        }
       }
-      catch(exception& stdex) {
-        ::fprintf(stderr,
-            "WARNING: An unusual exception that was thrown during garbage "
-            "collection has been caught and ignored. If this issue persists, "
-            "please file a bug report.\n"
-            "\n"
-            "  exception class: %s\n"
-            "  what(): %s\n",
-            typeid(stdex).name(), stdex.what());
+      else {
+        ROCKET_ASSERT(this->m_phase == phase_release);
+        if(this->m_cursor == this->m_held.size()) {
+          // The cycle is complete. Reset the GC counter to zero only if the
+          // operation completes normally.
+          this->m_visited.clear();
+          this->m_forced.clear();
+          this->m_held.clear();
+          this->m_counts[gMax-this->m_gen] = 0;
+          this->m_phase = phase_idle;
+          continue;
+        }
+
+        // Remove write barriers.
+        nwork ++;
+        const auto& var = this->m_held[this->m_cursor++];
+        if(var->get_gc_barrier() == this)
+          var->set_gc_barrier(nullptr);
       }
     }
 
-    this->m_unreach.clear();
-
-    // Reset the GC counter to zero only if the operation completes
-    // normally i.e. don't reset it if an exception is thrown.
-    this->m_counts[gMax-gen] = 0;
+    // Owners that have been recorded in `m_staged` may be freed before the
+    // next step, and their addresses may be reused by new owners, which must
+    // not be skipped when marking. While scanning, each owner shall only be
+    // counted once, so the map is kept; a stale address can only cause fewer
+    // internal references to be counted, which keeps variables alive.
+    if((this->m_phase != phase_idle) && (this->m_phase != phase_scan))
+      this->m_staged.clear();
 
     // Return the number of variables that have been collected.
     return nvars;
   }
 
+void
+Garbage_Collector::
+do_abort_cycle() noexcept
+  {
+    for(const auto& var : this->m_held)
+      if(var->get_gc_barrier() == this)
+        var->set_gc_barrier(nullptr);
+
+    this->m_staged.clear();
+    this->m_found.clear();
+    this->m_visited.clear();
+    this->m_marking.clear();
+    this->m_forced.clear();
+    this->m_held.clear();
+    this->m_phase = phase_idle;
+  }
+
+size_t
+Garbage_Collector::
+do_collect_generation(uint32_t gen)
+  {
+    // Ignore recursive requests.
+    if(this->m_recur > 0)
+      return 0;
+
+    this->m_recur ++;
+    const ::rocket::unique_ptr<int, void (int*)> rguard(&(this->m_recur), *[](int* ptr) { -- *ptr;  });
+
+    // Perform a whole cycle. If an exception is thrown, discard it.
+    try {
+      this->do_start_cycle(gen, false);
+      return this->do_run_cycle(SIZE_MAX, 0);
+    }
+    catch(...) {
+      this->do_abort_cycle();
+      throw;
+    }
+  }
+
+size_t
+Garbage_Collector::
+do_incremental_step()
+  {
+    // Ignore recursive requests.
+    if(this->m_recur > 0)
+      return 0;
+
+    this->m_recur ++;
+    const ::rocket::unique_ptr<int, void (int*)> rguard(&(this->m_recur), *[](int* ptr) { -- *ptr;  });
+
+    const int64_t deadline = (this->m_budget_us == 0) ? 0 : (do_monotonic_us() + this->m_budget_us);
+    return this->do_run_cycle(this->m_quantum, deadline);
+  }
+
+void
+Garbage_Collector::
+start_incremental_cycle(GC_Generation gen)
+  {
+    if(this->m_phase != phase_idle)
+      return;
+
+    try {
+      this->do_start_cycle(gen, true);
+    }
+    catch(...) {
+      this->do_abort_cycle();
+      throw;
+    }
+  }
+
+size_t
+Garbage_Collector::
+step_incremental_cycle()
+  {
+    if(this->m_phase == phase_idle)
+      return 0;
+
+    return this->do_incremental_step();
+  }
+
+void
+Garbage_Collector::
+write_barrier(const Variable& var)
+  {
+    // The old value of `var` is about to be overwritten. Everything that it
+    // references has been counted as an internal reference, so it must be
+    // kept alive in this cycle.
+    this->m_bstaged.clear();
+    this->m_found.clear();
+    var.get_value().collect_variables(this->m_bstaged, this->m_found);
+
+    for(auto qvar : this->m_found)
+      if(qvar->get_gc_cycle() == this->m_cycle)
+        this->m_forced.push_back(qvar);
+  }
+
 refcnt_ptr<Variable>
 Garbage_Collector::
 create_variable(GC_Generation gen_hint)
   {
-    // Perform automatic garbage collection.
-    for(uint32_t gen = 0;  gen <= gMax;  ++gen)
-      if(this->m_counts[gMax-gen] >= this->m_thres[gMax-gen])
-        this->do_collect_generation(gen);
+    // Perform automatic garbage collection. In incremental mode, the oldest
+    // generation is collected in steps, and nothing else is collected while
+    // a cycle is active.
+    if(this->m_phase != phase_idle)
+      this->do_incremental_step();
+    else
+      for(uint32_t gen = 0;  gen <= gMax;  ++gen)
+        if(this->m_counts[gMax-gen] >= this->m_thres[gMax-gen]) {
+          if(this->m_incr && (gen == gMax)) {
+            this->start_incremental_cycle(gc_generation_oldest);
+            this->do_incremental_step();
+          }
+          else
+            this->do_collect_generation(gen);
+        }
 
     // Get a cached variable.
     refcnt_ptr<Variable> var;
@@ -155,7 +410,10 @@ size_t
 Garbage_Collector::
 collect_variables(GC_Generation gen_limit)
   {
-    // Collect all variables up to generation `gen_limit`.
+    // Collect all variables up to generation `gen_limit`. An active cycle of
+    // incremental collection is discarded.
+    if(this->m_recur == 0)
+      this->do_abort_cycle();
     size_t nvars = 0;
     for(uint32_t gen = 0;  (gen <= gMax) && (gen <= gen_limit);  ++gen)
       nvars += this->do_collect_generation(gen);
@@ -174,14 +432,10 @@ finalize() noexcept
     if(this->m_recur > 0)
       ASTERIA_TERMINATE(("Garbage collector not finalizable while in use"));
 
+    this->do_abort_cycle();
     size_t nvars = 0;
     refcnt_ptr<Variable> var;
 
-    this->m_staged.clear();
-    this->m_temp_1.clear();
-    this->m_temp_2.clear();
-    this->m_unreach.clear();
-
     for(size_t gen = 0;  gen <= gMax;  ++gen)
       nvars += this->m_tracked.at(gMax-gen).size();
 
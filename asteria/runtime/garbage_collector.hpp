@@ -21,10 +21,44 @@ class Garbage_Collector final
     ::std::array<size_t, gMax+1> m_thres = { 10, 70, 500 };
     ::std::array<Variable_HashMap, gMax+1> m_tracked;
 
+    // A cycle visits all variables that are reachable from a generation. Each
+    // visited variable is stamped with the number of the cycle, and its `gc_ref`
+    // counter is valid in this cycle only. Working sets are flat lists of raw
+    // pointers whose storage is reused, so no variable is copied or hashed.
+    //
+    // Incremental collection performs a cycle in steps. As the mutator may run
+    // between steps, visited variables are kept alive in `m_held`, and each
+    // scanned variable has a write barrier, which keeps everything it referenced
+    // before its first modification alive in the current cycle.
+    enum Phase : uint8_t
+      {
+        phase_idle      = 0,
+        phase_scan      = 1,
+        phase_classify  = 2,
+        phase_mark      = 3,
+        phase_sweep     = 4,
+        phase_release   = 5,
+      };
+
+    Phase m_phase = phase_idle;
+    bool m_incr_cycle = false;
+    uint32_t m_gen = 0;
+    uint32_t m_cycle = 0;
+    size_t m_ntracked = 0;  // number of variables from the generation
+    size_t m_ncands = 0;  // number of possibly unreachable variables
+    size_t m_cursor = 0;
+
     Variable_HashMap m_staged;  // key is address of the owner of a `Variable`
-    Variable_HashMap m_temp_1;  // key is address to a `Variable`
-    Variable_HashMap m_temp_2;
-    Variable_HashMap m_unreach;
+    Variable_Worklist m_found;  // variables from `collect_variables()`
+    Variable_Worklist m_visited;  // tracked variables go first
+    Variable_Worklist m_marking;
+    Variable_Worklist m_forced;  // variables that are kept by write barriers
+    cow_vector<refcnt_ptr<Variable>> m_held;
+    Variable_HashMap m_bstaged;  // scratch for write barriers
+
+    bool m_incr = false;
+    size_t m_quantum = 256;
+    int64_t m_budget_us = 0;
 
   public:
     explicit
@@ -33,9 +67,24 @@ class Garbage_Collector final
 
   private:
     inline
+    void
+    do_visit(Variable* var);
+
+    void
+    do_start_cycle(uint32_t gen, bool incr);
+
+    size_t
+    do_run_cycle(size_t quantum, int64_t deadline);
+
+    void
+    do_abort_cycle() noexcept;
+
     size_t
     do_collect_generation(uint32_t gen);
 
+    size_t
+    do_incremental_step();
+
   public:
     ASTERIA_NONCOPYABLE_DESTRUCTOR(Garbage_Collector);
 
@@ -69,6 +118,67 @@ class Garbage_Collector final
 
     size_t
     finalize() noexcept;
+
+    // Incremental collection
+    // If incremental collection is enabled, the oldest generation is collected
+    // in steps, each of which processes at most `get_step_quantum()` variables
+    // and should not take longer than `get_pause_budget_us()` microseconds
+    // (zero means unlimited). Steps are performed by `create_variable()`, and
+    // may also be performed by the host with `step_incremental_cycle()`.
+    bool
+    is_incremental() const noexcept
+      { return this->m_incr;  }
+
+    void
+    set_incremental(bool incr) noexcept
+      {
+        if(!incr && this->m_incr_cycle)
+          this->do_abort_cycle();
+        this->m_incr = incr;
+      }
+
+    size_t
+    get_step_quantum() const noexcept
+      { return this->m_quantum;  }
+
+    void
+    set_step_quantum(size_t quantum) noexcept
+      { this->m_quantum = ::rocket::max(quantum, (size_t) 1);  }
+
+    int64_t
+    get_pause_budget_us() const noexcept
+      { return this->m_budget_us;  }
+
+    void
+    set_pause_budget_us(int64_t budget_us) noexcept
+      { this->m_budget_us = ::rocket::max(budget_us, (int64_t) 0);  }
+
+    bool
+    is_incremental_cycle_active() const noexcept
+      { return this->m_incr_cycle && (this->m_phase != phase_idle);  }
+
+    // Starts a new cycle for `gen` if none is active. Variables that are created
+    // after this call are not collected in this cycle.
+    void
+    start_incremental_cycle(GC_Generation gen = gc_generation_oldest);
+
+    // Performs a step of the active cycle, and returns the number of variables
+    // that have been collected by it.
+    size_t
+    step_incremental_cycle();
+
+    // Discards the active cycle. Nothing is collected.
+    void
+    abort_incremental_cycle() noexcept
+      {
+        if(this->m_incr_cycle)
+          this->do_abort_cycle();
+      }
+
+    // This is called by `Variable` before the first modification of a variable
+    // that has been scanned in the active cycle.
+    void
+    write_barrier(const Variable& var);
   };
 
 }  // namespace asteria
@@ -6,6 +6,8 @@
 #include "garbage_collector.hpp"
 #include "random_engine.hpp"
 #include "module_loader.hpp"
+#include "pattern_cache.hpp"
+#include "sampling_profiler.hpp"
 #include "abstract_hooks.hpp"
 #include "../library/version.hpp"
 #include "../library/gc.hpp"
@@ -76,7 +78,9 @@ Global_Context(API_Version api_version_req)
   :
     m_gcoll(::rocket::make_refcnt<Garbage_Collector>()),
     m_prng(::rocket::make_refcnt<Random_Engine>()),
-    m_ldrlk(::rocket::make_refcnt<Module_Loader>())
+    m_ldrlk(::rocket::make_refcnt<Module_Loader>()),
+    m_pcache(::rocket::make_refcnt<Pattern_Cache>()),
+    m_sprof(::rocket::make_refcnt<Sampling_Profiler>())
   {
     // Get the range of modules to initialize.
     // This also determines the maximum version number of the library, which
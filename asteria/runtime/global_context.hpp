@@ -19,6 +19,8 @@ class Global_Context
     rcfwd_ptr<Garbage_Collector> m_gcoll;
     rcfwd_ptr<Random_Engine> m_prng;
     rcfwd_ptr<Module_Loader> m_ldrlk;
+    rcfwd_ptr<Pattern_Cache> m_pcache;
+    rcfwd_ptr<Sampling_Profiler> m_sprof;
 
   public:
     // A global context has no parent.
@@ -86,6 +88,18 @@ class Global_Context
     refcnt_ptr<Module_Loader>
     module_loader() const noexcept
       { return unerase_pointer_cast<Module_Loader>(this->m_ldrlk);  }
+
+    ASTERIA_INCOMPLET(Pattern_Cache)
+    refcnt_ptr<Pattern_Cache>
+    pattern_cache() const noexcept
+      { return unerase_pointer_cast<Pattern_Cache>(this->m_pcache);  }
+
+    // The profiler is accessed at safe points, so no reference count is
+    // incremented.
+    ASTERIA_INCOMPLET(Sampling_Profiler)
+    Sampling_Profiler&
+    sampling_profiler() const noexcept
+      { return *(unerase_cast<Sampling_Profiler*>(this->m_sprof.get()));  }
   };
 
 #define ASTERIA_CALL_GLOBAL_HOOK(global, target, ...)  \
@@ -7,6 +7,7 @@
 #include "executive_context.hpp"
 #include "global_context.hpp"
 #include "abstract_hooks.hpp"
+#include "sampling_profiler.hpp"
 #include "runtime_error.hpp"
 #include "ptc_arguments.hpp"
 #include "enums.hpp"
@@ -20,7 +21,7 @@ Instantiated_Function(const cow_vector<phsh_string>& params, refcnt_ptr<Variadic
   :
     m_params(params), m_zvarg(::std::move(zvarg))
   {
-    ::rocket::for_each(code, [&](const AIR_Node& node) { node.solidify(this->m_rod);  });
+    AIR_Node::solidify_sequence(this->m_rod, code);
     this->m_rod.finalize();
   }
 
@@ -38,7 +39,7 @@ describe(tinyfmt& fmt) const
 
 void
 Instantiated_Function::
-collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
   {
     this->m_rod.collect_variables(staged, temp);
   }
@@ -54,6 +55,12 @@ invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stac
 
     ASTERIA_CALL_GLOBAL_HOOK(global, on_function_enter, ctx_func, *this, this->m_zvarg->sloc());
 
+    // Make this function visible to the sampling profiler. The frame is
+    // popped when this function returns or throws an exception.
+    auto& prof = global.sampling_profiler();
+    Sampling_Profiler::Frame prof_frame(prof, *(this->m_zvarg));
+    prof.check();
+
     // Execute the function body, using `stack` for evaluation.
     AIR_Status status;
     try {
@@ -59,4 +59,42 @@ do_unlock_stream(locked_stream_pair* qstrm) noexcept
     ROCKET_ASSERT(count == 1);
   }
 
+void
+Module_Loader::
+do_stat_stream(Cached_Module& entry, const Unique_Stream& strm)
+  {
+    struct ::stat info;
+    if(::fstat(::fileno(strm.get().get_handle()), &info))
+      throw Runtime_Error(Runtime_Error::M_format(),
+               "Could not get properties of script file: ${errno:full}");
+
+    entry.dev = (uint64_t) info.st_dev;
+    entry.ino = (uint64_t) info.st_ino;
+    entry.size = (int64_t) info.st_size;
+    entry.mtime_ns = (int64_t) info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+  }
+
+cow_function&
+Module_Loader::
+mut_cached_module(stringR path, const Compiler_Options& opts, const Unique_Stream& strm)
+  {
+    Cached_Module cur;
+    cur.opts = opts;
+    do_stat_stream(cur, strm);
+
+    auto result = this->m_modules.try_emplace(path, cur);
+    auto& entry = result.first->second;
+    if(!result.second && entry.target && (::memcmp(&(entry.opts), &opts, sizeof(opts)) == 0)
+       && (entry.dev == cur.dev) && (entry.ino == cur.ino) && (entry.size == cur.size)
+       && (entry.mtime_ns == cur.mtime_ns)) {
+      this->m_hits ++;
+      return entry.target;
+    }
+
+    // The module has to be compiled again.
+    entry = ::std::move(cur);
+    this->m_misses ++;
+    return entry.target;
+  }
+
 }  // namespace asteria
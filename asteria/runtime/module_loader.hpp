@@ -19,6 +19,23 @@ class Module_Loader final
     cow_dictionary<::rocket::tinybuf_file> m_strms;
     using locked_stream_pair = decltype(m_strms)::value_type;
 
+    // Compiled modules are keyed by their real paths. An entry is valid if
+    // the file has not been modified since it was compiled, and if it was
+    // compiled with the same options.
+    struct Cached_Module
+      {
+        Compiler_Options opts;
+        uint64_t dev;
+        uint64_t ino;
+        int64_t size;
+        int64_t mtime_ns;
+        cow_function target;
+      };
+
+    cow_dictionary<Cached_Module> m_modules;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
   public:
     explicit
     Module_Loader() noexcept
@@ -31,8 +48,37 @@ class Module_Loader final
     void
     do_unlock_stream(locked_stream_pair* qstrm) noexcept;
 
+    static
+    void
+    do_stat_stream(Cached_Module& entry, const Unique_Stream& strm);
+
   public:
     ASTERIA_NONCOPYABLE_DESTRUCTOR(Module_Loader);
+
+    size_t
+    count_cached_modules() const noexcept
+      { return this->m_modules.size();  }
+
+    uint64_t
+    count_hits() const noexcept
+      { return this->m_hits;  }
+
+    uint64_t
+    count_misses() const noexcept
+      { return this->m_misses;  }
+
+    // Removes all compiled modules. Counters are not reset.
+    void
+    clear_cached_modules() noexcept
+      { this->m_modules.clear();  }
+
+    // Gets the slot of a compiled module. `strm` shall be a locked stream of
+    // the file denoted by `path`, whose status is used to check whether the
+    // file has been modified. If the module has not been compiled with `opts`
+    // since then, the slot is reset to null, and the caller shall compile the
+    // module and store it into the slot. Hits and misses are counted.
+    cow_function&
+    mut_cached_module(stringR path, const Compiler_Options& opts, const Unique_Stream& strm);
   };
 
 class Module_Loader::Unique_Stream
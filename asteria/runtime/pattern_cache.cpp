@@ -0,0 +1,86 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.ipp"
+#include "pattern_cache.hpp"
+#include "../utils.hpp"
+namespace asteria {
+
+Pattern_Cache::
+~Pattern_Cache()
+  {
+  }
+
+void
+Pattern_Cache::
+set_capacity(size_t cap)
+  {
+    // Evict least recently used patterns until there are at most `cap` ones.
+    while(this->m_entries.size() > cap) {
+      size_t victim = 0;
+      for(size_t k = 1;  k != this->m_entries.size();  ++k)
+        if(this->m_entries[k].stamp < this->m_entries[victim].stamp)
+          victim = k;
+
+      this->m_entries.erase(victim, 1);
+    }
+    this->m_capacity = cap;
+  }
+
+refcnt_ptr<Abstract_Opaque>
+Pattern_Cache::
+find_opt(const phsh_string& patt, uint32_t opts)
+  {
+    for(size_t k = 0;  k != this->m_entries.size();  ++k) {
+      if((this->m_entries[k].opts != opts) || (this->m_entries[k].patt != patt))
+        continue;
+
+      // Mark this pattern the most recently used one.
+      auto& entry = this->m_entries.mut(k);
+      entry.stamp = ++ this->m_clock;
+      this->m_hits ++;
+      return entry.comp;
+    }
+
+    this->m_misses ++;
+    return nullptr;
+  }
+
+void
+Pattern_Cache::
+insert(const phsh_string& patt, uint32_t opts, const refcnt_ptr<Abstract_Opaque>& comp)
+  {
+    if(this->m_capacity == 0)
+      return;
+
+    // Overwrite an existent entry with the same key.
+    for(size_t k = 0;  k != this->m_entries.size();  ++k) {
+      auto& entry = this->m_entries.mut(k);
+      if((entry.opts != opts) || (entry.patt != patt))
+        continue;
+
+      entry.stamp = ++ this->m_clock;
+      entry.comp = comp;
+      return;
+    }
+
+    if(this->m_entries.size() < this->m_capacity) {
+      // Append a new entry.
+      this->m_entries.push_back({ patt, opts, ++ this->m_clock, comp });
+      return;
+    }
+
+    // Replace the least recently used one.
+    size_t victim = 0;
+    for(size_t k = 1;  k != this->m_entries.size();  ++k)
+      if(this->m_entries[k].stamp < this->m_entries[victim].stamp)
+        victim = k;
+
+    auto& entry = this->m_entries.mut(victim);
+    entry.patt = patt;
+    entry.opts = opts;
+    entry.stamp = ++ this->m_clock;
+    entry.comp = comp;
+  }
+
+}  // namespace asteria
@@ -0,0 +1,76 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_PATTERN_CACHE_
+#define ASTERIA_RUNTIME_PATTERN_CACHE_
+
+#include "../fwd.hpp"
+namespace asteria {
+
+class Pattern_Cache final
+  :
+    public rcfwd<Pattern_Cache>
+  {
+  private:
+    // Compiled patterns are opaque to this class. They are keyed by their
+    // source strings and option bits, and are evicted in LRU order.
+    struct Entry
+      {
+        phsh_string patt;
+        uint32_t opts;
+        uint64_t stamp;
+        refcnt_ptr<Abstract_Opaque> comp;
+      };
+
+    cow_vector<Entry> m_entries;
+    size_t m_capacity = 64;
+    uint64_t m_clock = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+  public:
+    explicit
+    Pattern_Cache() noexcept
+      { }
+
+  public:
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(Pattern_Cache);
+
+    size_t
+    size() const noexcept
+      { return this->m_entries.size();  }
+
+    size_t
+    capacity() const noexcept
+      { return this->m_capacity;  }
+
+    uint64_t
+    count_hits() const noexcept
+      { return this->m_hits;  }
+
+    uint64_t
+    count_misses() const noexcept
+      { return this->m_misses;  }
+
+    // Sets the maximum number of patterns. Excess patterns are evicted.
+    void
+    set_capacity(size_t cap);
+
+    // Removes all patterns. Counters are not reset.
+    void
+    clear() noexcept
+      { this->m_entries.clear();  }
+
+    // Searches for a compiled pattern. If one is found, it becomes the most
+    // recently used one. Hits and misses are counted.
+    refcnt_ptr<Abstract_Opaque>
+    find_opt(const phsh_string& patt, uint32_t opts);
+
+    // Inserts a compiled pattern, replacing the least recently used one if
+    // the cache is full. If `patt` exists already, it is overwritten.
+    void
+    insert(const phsh_string& patt, uint32_t opts, const refcnt_ptr<Abstract_Opaque>& comp);
+  };
+
+}  // namespace asteria
+#endif
@@ -27,13 +27,14 @@ do_throw_not_dereferenceable() const
 
 void
 Reference::
-collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
   {
     this->m_value.collect_variables(staged, temp);
 
-    if(auto var = unerase_pointer_cast<Variable>(this->m_var))
-      if(staged.insert(&(this->m_var), var))
-        temp.insert(var.get(), var);
+    // `staged` only records owners, so no reference is taken.
+    if(auto var = unerase_cast<Variable*>(this->m_var.get()))
+      if(staged.insert(&(this->m_var), nullptr))
+        temp.push_back(var);
   }
 
 const Value&
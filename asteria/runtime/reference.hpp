@@ -234,7 +234,7 @@ class Reference
       }
 
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const;
 
     // Get the target value.
     const Value&
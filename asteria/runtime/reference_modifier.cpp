@@ -46,7 +46,8 @@ apply_read_opt(const Value& parent) const
                    describe_type(parent.type()));
 
         const auto& obj = parent.as_object();
-        return obj.ptr(altr.key);
+        size_t hint = altr.hint;
+        return obj.ptr_hint(hint, altr.key);
       }
 
       case index_array_head: {
@@ -148,7 +149,8 @@ apply_write_opt(Value& parent) const
                    describe_type(parent.type()));
 
         auto& obj = parent.mut_object();
-        return obj.mut_ptr(altr.key);
+        size_t hint = altr.hint;
+        return obj.mut_ptr_hint(hint, altr.key);
       }
 
       case index_array_head: {
@@ -18,6 +18,7 @@ class Reference_Modifier
     struct S_object_key
       {
         phsh_string key;
+        uint32_t hint;  // bucket index where `key` is expected; may be stale
       };
 
     struct S_array_head
@@ -0,0 +1,162 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "../precompiled.ipp"
+#include "sampling_profiler.hpp"
+#include "variadic_arguer.hpp"
+#include "../../rocket/mutex.hpp"
+#include "../../rocket/tinyfmt_file.hpp"
+#include "../utils.hpp"
+#include <signal.h>  // ::sigaction()
+#include <sys/time.h>  // ::setitimer()
+namespace asteria {
+namespace {
+
+::rocket::mutex s_timer_mutex;
+uint32_t s_timer_users;
+struct ::sigaction s_old_sigprof;
+
+}  // namespace
+
+atomic_relaxed<uint32_t> Sampling_Profiler::s_ticks;
+
+Sampling_Profiler::
+~Sampling_Profiler()
+  {
+    this->stop();
+  }
+
+void
+Sampling_Profiler::
+do_take_sample()
+  {
+    uint32_t ticks = s_ticks.load();
+    uint32_t count = ticks - this->m_ticks;
+    this->m_ticks = ticks;
+
+    // The timer is shared, so ticks have to be ignored if this profiler is
+    // not active.
+    if(!this->m_interval || !this->m_top)
+      return;
+
+    // Compose the call stack, outermost frame first.
+    cow_vector<const Frame*> frames;
+    for(auto qframe = this->m_top;  qframe;  qframe = qframe->prev_opt())
+      frames.emplace_back(qframe);
+
+    ::rocket::ascii_numput nump;
+    auto& str = this->m_stack;
+    str.clear();
+
+    for(size_t k = frames.size() - 1;  k != SIZE_MAX;  --k) {
+      const auto& zvarg = frames[k]->zvarg();
+      size_t pos = str.size();
+      str.append(zvarg.func());
+      str.append(" at ");
+      str.append(zvarg.sloc().file());
+      str.push_back(':');
+      nump.put_DI(zvarg.sloc().line());
+      str.append(nump.data(), nump.size());
+
+      // Semicolons are frame separators, so they have to be replaced.
+      while((pos = str.find(pos, ';')) != str.npos)
+        str.mut(pos) = ':';
+
+      if(k != 0)
+        str.push_back(';');
+    }
+
+    this->m_samples.try_emplace(phsh_string(str), 0U).first->second += count;
+    this->m_nsamples += count;
+  }
+
+void
+Sampling_Profiler::
+start(uint32_t interval)
+  {
+    if(interval == 0)
+      ASTERIA_THROW(("Sampling interval must be positive"));
+
+    ::rocket::mutex::unique_lock lock(s_timer_mutex);
+
+    // Install the signal handler for the first profiler. The handler only
+    // counts ticks; samples are taken by `check()` at safe points.
+    if(!this->m_interval && (s_timer_users == 0)) {
+      struct ::sigaction sigact = { };
+      sigact.sa_handler = +[](int) { s_ticks.xadd(1U);  };
+      sigact.sa_flags = SA_RESTART;
+      if(::sigaction(SIGPROF, &sigact, &s_old_sigprof) != 0)
+        ASTERIA_THROW((
+            "Could not install signal handler for profiling",
+            "[`sigaction()` failed: ${errno:full}]"));
+    }
+
+    // If the timer is running already, its interval is updated.
+    struct ::itimerval itv = { };
+    itv.it_interval.tv_sec = static_cast<::time_t>(interval / 1000000);
+    itv.it_interval.tv_usec = static_cast<::suseconds_t>(interval % 1000000);
+    itv.it_value = itv.it_interval;
+    if(::setitimer(ITIMER_PROF, &itv, nullptr) != 0) {
+      if(!this->m_interval && (s_timer_users == 0))
+        ::sigaction(SIGPROF, &s_old_sigprof, nullptr);
+
+      ASTERIA_THROW((
+          "Could not start profiling timer",
+          "[`setitimer()` failed: ${errno:full}]"));
+    }
+
+    if(!this->m_interval)
+      s_timer_users ++;
+
+    this->m_ticks = s_ticks.load();
+    this->m_interval = interval;
+  }
+
+void
+Sampling_Profiler::
+stop() noexcept
+  {
+    if(!this->m_interval)
+      return;
+
+    ::rocket::mutex::unique_lock lock(s_timer_mutex);
+
+    this->m_interval = 0;
+    if(-- s_timer_users != 0)
+      return;
+
+    // Stop the timer and restore the old signal handler.
+    struct ::itimerval itv = { };
+    ::setitimer(ITIMER_PROF, &itv, nullptr);
+    ::sigaction(SIGPROF, &s_old_sigprof, nullptr);
+  }
+
+tinyfmt&
+Sampling_Profiler::
+print_folded(tinyfmt& fmt) const
+  {
+    // Sort call stacks, so the output is stable.
+    cow_vector<const pair<const phsh_string, uint64_t>*> stacks;
+    for(const auto& r : this->m_samples)
+      stacks.emplace_back(&r);
+
+    ::std::sort(stacks.mut_begin(), stacks.mut_end(),
+        [](const auto* x, const auto* y) { return x->first.rdstr() < y->first.rdstr();  });
+
+    for(const auto* qr : stacks)
+      fmt << qr->first << ' ' << qr->second << '\n';
+
+    return fmt;
+  }
+
+void
+Sampling_Profiler::
+write_folded_file(const char* path) const
+  {
+    ::rocket::tinyfmt_file fmt;
+    fmt.open(path, tinybuf::open_write | tinybuf::open_create | tinybuf::open_truncate);
+    this->print_folded(fmt);
+    fmt.flush();
+  }
+
+}  // namespace asteria
@@ -0,0 +1,130 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#ifndef ASTERIA_RUNTIME_SAMPLING_PROFILER_
+#define ASTERIA_RUNTIME_SAMPLING_PROFILER_
+
+#include "../fwd.hpp"
+namespace asteria {
+
+class Sampling_Profiler final
+  :
+    public rcfwd<Sampling_Profiler>
+  {
+  public:
+    // A frame denotes a script function that is being executed. Frames are
+    // allocated on the machine stack, and form a list of callers.
+    class Frame
+      {
+      private:
+        Sampling_Profiler* m_prof;
+        const Frame* m_prev;
+        const Variadic_Arguer* m_zvarg;
+
+      public:
+        explicit
+        Frame(Sampling_Profiler& prof, const Variadic_Arguer& zvarg) noexcept
+          :
+            m_prof(&prof), m_prev(prof.m_top), m_zvarg(&zvarg)
+          { prof.m_top = this;  }
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        ~Frame()
+          { this->m_prof->m_top = this->m_prev;  }
+
+        const Frame*
+        prev_opt() const noexcept
+          { return this->m_prev;  }
+
+        const Variadic_Arguer&
+        zvarg() const noexcept
+          { return *(this->m_zvarg);  }
+      };
+
+  private:
+    // This is incremented by the timer signal handler, which is shared by
+    // all profilers in this process.
+    static atomic_relaxed<uint32_t> s_ticks;
+
+    const Frame* m_top = nullptr;
+    uint32_t m_ticks = 0;
+    uint32_t m_interval = 0;
+    cow_dictionary<uint64_t> m_samples;
+    uint64_t m_nsamples = 0;
+    cow_string m_stack;  // reusable storage
+
+  public:
+    explicit
+    Sampling_Profiler() noexcept
+      { }
+
+  private:
+    void
+    do_take_sample();
+
+  public:
+    ASTERIA_NONCOPYABLE_DESTRUCTOR(Sampling_Profiler);
+
+    bool
+    active() const noexcept
+      { return this->m_interval != 0;  }
+
+    uint32_t
+    interval() const noexcept
+      { return this->m_interval;  }
+
+    const Frame*
+    top_frame_opt() const noexcept
+      { return this->m_top;  }
+
+    size_t
+    count_stacks() const noexcept
+      { return this->m_samples.size();  }
+
+    uint64_t
+    count_samples() const noexcept
+      { return this->m_nsamples;  }
+
+    // Starts sampling every `interval` microseconds of CPU time. The timer
+    // is shared by all profilers in this process. It is started when the
+    // first profiler becomes active, and is stopped when the last one becomes
+    // inactive. If the timer is running already, its interval is updated.
+    void
+    start(uint32_t interval = 1000);
+
+    // Stops sampling. Samples are preserved.
+    void
+    stop() noexcept;
+
+    // Removes all samples.
+    void
+    clear() noexcept
+      { this->m_samples.clear();
+        this->m_nsamples = 0;  }
+
+    // This is called at safe points, such as function entries and loop
+    // iterations. If the timer has expired since the last call, the current
+    // call stack is recorded. Samples are weighted by the number of timer
+    // ticks that they cover.
+    void
+    check()
+      {
+        if(ROCKET_UNEXPECT(this->m_ticks != s_ticks.load()))
+          this->do_take_sample();
+      }
+
+    // Writes samples in the folded-stack format, which can be consumed by
+    // flame graph tools. Each line contains a call stack, outermost frame
+    // first, separated by semicolons, followed by a space and its count.
+    tinyfmt&
+    print_folded(tinyfmt& fmt) const;
+
+    // Writes samples into a file. Existent contents are truncated.
+    void
+    write_folded_file(const char* path) const;
+  };
+
+}  // namespace asteria
+#endif
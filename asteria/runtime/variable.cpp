@@ -3,6 +3,7 @@
 
 #include "../precompiled.ipp"
 #include "variable.hpp"
+#include "garbage_collector.hpp"
 #include "../utils.hpp"
 namespace asteria {
 
@@ -11,4 +12,13 @@ Variable::
   {
   }
 
+void
+Variable::
+do_write_barrier()
+  {
+    // Clear the barrier only if the old value has been recorded successfully.
+    this->m_gc_barrier->write_barrier(*this);
+    this->m_gc_barrier = nullptr;
+  }
+
 }  // namespace asteria
@@ -17,12 +17,18 @@ class Variable final
     bool m_init = false;
     bool m_immut = false;
     int m_gc_ref;  // uninitialized by default
+    uint32_t m_gc_cycle = 0;
+    Garbage_Collector* m_gc_barrier = nullptr;
 
   public:
     explicit
     Variable() noexcept
       { }
 
+  private:
+    void
+    do_write_barrier();
+
   public:
     ASTERIA_NONCOPYABLE_DESTRUCTOR(Variable);
 
@@ -37,13 +43,19 @@ class Variable final
 
     Value&
     mut_value()
-      { return this->m_value;  }
+      {
+        if(ROCKET_UNEXPECT(this->m_gc_barrier))
+          this->do_write_barrier();
+        return this->m_value;
+      }
 
     template<typename XValT,
     ROCKET_ENABLE_IF(::std::is_assignable<Value&, XValT&&>::value)>
     void
     initialize(XValT&& xval)
       {
+        if(ROCKET_UNEXPECT(this->m_gc_barrier))
+          this->do_write_barrier();
         this->m_value = ::std::forward<XValT>(xval);
         this->m_init = true;
       }
@@ -71,6 +83,22 @@ class Variable final
     void
     set_gc_ref(int ref) noexcept
       { this->m_gc_ref = ref;  }
+
+    uint32_t
+    get_gc_cycle() const noexcept
+      { return this->m_gc_cycle;  }
+
+    void
+    set_gc_cycle(uint32_t cycle) noexcept
+      { this->m_gc_cycle = cycle;  }
+
+    Garbage_Collector*
+    get_gc_barrier() const noexcept
+      { return this->m_gc_barrier;  }
+
+    void
+    set_gc_barrier(Garbage_Collector* gcoll) noexcept
+      { this->m_gc_barrier = gcoll;  }
   };
 
 }  // namespace asteria
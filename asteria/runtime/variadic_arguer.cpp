@@ -16,7 +16,7 @@ describe(tinyfmt& fmt) const
 
 void
 Variadic_Arguer::
-collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
   {
     for(const auto& arg : this->m_vargs)
       arg.collect_variables(staged, temp);
@@ -69,7 +69,7 @@ class Variadic_Arguer final
     describe(tinyfmt& fmt) const override;
 
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const override;
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const override;
 
     Reference&
     invoke_ptc_aware(Reference& self, Global_Context& global, Reference_Stack&& stack) const override;
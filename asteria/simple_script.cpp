@@ -7,11 +7,149 @@
 #include "compiler/statement_sequence.hpp"
 #include "compiler/expression_unit.hpp"
 #include "runtime/air_optimizer.hpp"
+#include "runtime/air_node.hpp"
 #include "runtime/variable.hpp"
 #include "runtime/garbage_collector.hpp"
+#include "runtime/sampling_profiler.hpp"
 #include "llds/reference_stack.hpp"
+#include "library/checksum.hpp"
 #include "utils.hpp"
+#include <sys/stat.h>  // ::fstat()
+#include <fcntl.h>  // ::open()
+#include <unistd.h>  // ::read(), ::getpid(), ::unlink()
 namespace asteria {
+namespace {
+
+cow_vector<phsh_string>
+do_script_params()
+  {
+    cow_vector<phsh_string> params;
+    params.emplace_back(sref("..."));
+    return params;
+  }
+
+cow_function
+do_create_script_function(AIR_Optimizer& optmz, stringR name)
+  {
+    Source_Location script_sloc(name, 0, 0);
+    return optmz.create_function(script_sloc, sref("[file scope]"));
+  }
+
+cow_string
+do_get_real_path(const char* path)
+  {
+    unique_ptr<char, void (void*)> abspath(::free);
+    if(!abspath.reset(::realpath(path, nullptr)))
+      ASTERIA_THROW((
+          "Could not open script file '$1'",
+          "[`realpath()` failed: ${errno:full}]"),
+          path);
+
+    return cow_string(abspath);
+  }
+
+bool
+do_read_file_opt(cow_string& data, const char* path)
+  {
+    // Files are read in whole, so allocate storage according to their sizes.
+    ::rocket::unique_posix_fd fd(::open(path, O_RDONLY));
+    struct ::stat info;
+    if(!fd || (::fstat(fd, &info) != 0))
+      return false;
+
+    data.clear();
+    data.reserve(static_cast<size_t>(info.st_size) + 1);
+    for(;;) {
+      size_t off = data.size();
+      size_t nbatch = data.capacity() - off;
+      data.append(nbatch ? nbatch : 0x10000, '\0');
+      ::ssize_t nread = ::read(fd, data.mut_data() + off, data.size() - off);
+      if(nread < 0)
+        return false;
+
+      data.erase(off + static_cast<size_t>(nread));
+      if(nread == 0)
+        return true;
+    }
+  }
+
+cow_string
+do_read_script(stringR path)
+  {
+    cow_string code;
+    if(!do_read_file_opt(code, path.c_str()))
+      ASTERIA_THROW((
+          "Could not read script file '$1'",
+          "[`open()` or `read()` failed: ${errno:full}]"),
+          path);
+
+    return code;
+  }
+
+cow_string
+do_make_cache_key(const Compiler_Options& opts, stringR code)
+  {
+    // The first line of a cache file identifies the format, the library that
+    // has created it, the options, and the script that it has been compiled
+    // from. A cache file that does not begin with the same line is ignored.
+    static_assert(::std::is_trivially_copyable<Compiler_Options>::value, "");
+    static constexpr char xdigits[] = "0123456789ABCDEF";
+
+    cow_string key = sref("ASTERIA-AIR/3 " ASTERIA_ABI_VERSION_STRING " ");
+    for(size_t k = 0;  k != sizeof(opts);  ++k) {
+      uint8_t byte = reinterpret_cast<const uint8_t*>(&opts)[k];
+      key.push_back(xdigits[byte / 16]);
+      key.push_back(xdigits[byte % 16]);
+    }
+    key << " " << std_checksum_sha256(code) << "\n";
+    return key;
+  }
+
+cow_string
+do_make_payload_checksum(stringR payload)
+  {
+    // The second line of a cache file is the CRC-32 checksum of the code that
+    // follows it, so a truncated or corrupted file is rejected before it is
+    // deserialized.
+    static constexpr char xdigits[] = "0123456789ABCDEF";
+    uint32_t crc = static_cast<uint32_t>(std_checksum_crc32(payload));
+
+    cow_string line;
+    for(int k = 28;  k >= 0;  k -= 4)
+      line.push_back(xdigits[crc >> k & 15]);
+    line.push_back('\n');
+    return line;
+  }
+
+bool
+do_load_cached_code_opt(cow_vector<AIR_Node>& code, const char* cache_path, stringR key,
+                        stringR file)
+  try {
+    cow_string cache;
+    if(!do_read_file_opt(cache, cache_path) || !cache.starts_with(key))
+      return false;
+
+    size_t offset = cache.find(key.size(), '\n');
+    if(offset == cow_string::npos)
+      return false;
+
+    offset ++;
+    cow_string payload = cache.substr(offset);
+    if(cache.substr_compare(key.size(), offset - key.size(), do_make_payload_checksum(payload)) != 0)
+      return false;
+
+    const char* bptr = payload.data();
+    const char* eptr = payload.data() + payload.size();
+    while(bptr != eptr)
+      code.emplace_back(AIR_Node::deserialize(bptr, eptr, file));
+    return true;
+  }
+  catch(exception&) {
+    // A corrupted cache file is not fatal, as the script can be parsed again.
+    return false;
+  }
+
+}  // namespace
 
 refcnt_ptr<Variable>
 Simple_Script::
@@ -52,14 +190,9 @@ Simple_Script::
 reload(stringR name, Statement_Sequence&& stmtq)
   {
     // Instantiate the function.
-    cow_vector<phsh_string> script_params;
-    script_params.emplace_back(sref("..."));
-
     AIR_Optimizer optmz(this->m_opts);
-    optmz.reload(nullptr, script_params, this->m_global, stmtq.get_statements());
-
-    Source_Location script_sloc(name, 0, 0);
-    this->m_func = optmz.create_function(script_sloc, sref("[file scope]"));
+    optmz.reload(nullptr, do_script_params(), this->m_global, stmtq.get_statements());
+    this->m_func = do_create_script_function(optmz, name);
   }
 
 void
@@ -116,16 +249,10 @@ void
 Simple_Script::
 reload_file(const char* path)
   {
-    unique_ptr<char, void (void*)> abspath(::free);
-    if(!abspath.reset(::realpath(path, nullptr)))
-      ASTERIA_THROW((
-          "Could not open script file '$1'",
-          "[`realpath()` failed: ${errno:full}]"),
-          path);
-
+    cow_string abspath = do_get_real_path(path);
     ::rocket::tinybuf_file cbuf;
-    cbuf.open(abspath, tinybuf::open_read);
-    this->reload(cow_string(abspath), 1, ::std::move(cbuf));
+    cbuf.open(abspath.c_str(), tinybuf::open_read);
+    this->reload(abspath, 1, ::std::move(cbuf));
   }
 
 void
@@ -135,6 +262,91 @@ reload_file(stringR path)
     this->reload_file(path.safe_c_str());
   }
 
+bool
+Simple_Script::
+reload_file_cached(const char* path, const char* cache_path)
+  {
+    cow_string abspath = do_get_real_path(path);
+    cow_string code = do_read_script(abspath);
+
+    cow_vector<AIR_Node> air;
+    AIR_Optimizer optmz(this->m_opts);
+    bool cached = do_load_cached_code_opt(air, cache_path, do_make_cache_key(this->m_opts, code),
+                                          abspath);
+    if(cached)
+      try {
+        // Instantiate the function without parsing anything.
+        optmz.rebind(nullptr, do_script_params(), air);
+      }
+      catch(exception&) {
+        // The cached code does not match this script, so ignore it.
+        cached = false;
+      }
+
+    if(!cached) {
+      // Parse the script as usual.
+      ::rocket::tinybuf_str cbuf;
+      cbuf.set_string(code, tinybuf::open_read);
+      this->reload(abspath, 1, ::std::move(cbuf));
+      return false;
+    }
+
+    this->m_func = do_create_script_function(optmz, abspath);
+    return true;
+  }
+
+void
+Simple_Script::
+precompile_file(const char* path, const char* cache_path)
+  {
+    cow_string abspath = do_get_real_path(path);
+    cow_string code = do_read_script(abspath);
+
+    ::rocket::tinybuf_str cbuf;
+    cbuf.set_string(code, tinybuf::open_read);
+    Token_Stream tstrm(this->m_opts);
+    tstrm.reload(abspath, 1, ::std::move(cbuf));
+    Statement_Sequence stmtq(this->m_opts);
+    stmtq.reload(::std::move(tstrm));
+
+    AIR_Optimizer optmz(this->m_opts);
+    optmz.reload(nullptr, do_script_params(), this->m_global, stmtq.get_statements());
+
+    cow_string payload;
+    for(const auto& node : optmz.get_code())
+      node.serialize(payload);
+
+    cow_string cache = do_make_cache_key(this->m_opts, code);
+    cache += do_make_payload_checksum(payload);
+    cache += payload;
+
+    // Write a temporary file and then rename it, so other processes never see
+    // incomplete data.
+    cow_string temp_path = format_string("$1.$2~", cache_path, ::getpid());
+    try {
+      ::rocket::tinybuf_file file;
+      file.open(temp_path.c_str(), tinybuf::open_write | tinybuf::open_create
+                                     | tinybuf::open_truncate | tinybuf::open_binary);
+      file.putn(cache.data(), cache.size());
+      file.flush();
+      file.close();
+    }
+    catch(...) {
+      ::unlink(temp_path.c_str());
+      throw;
+    }
+
+    if(::rename(temp_path.c_str(), cache_path) != 0) {
+      ::unlink(temp_path.c_str());
+      ASTERIA_THROW((
+          "Could not write precompiled code to '$1'",
+          "[`rename()` failed: ${errno:full}]"),
+          cache_path);
+    }
+
+    this->m_func = do_create_script_function(optmz, abspath);
+  }
+
 Reference
 Simple_Script::
 execute(Reference_Stack&& stack)
@@ -165,4 +377,25 @@ execute()
     return this->execute(::std::move(stack));
   }
 
+void
+Simple_Script::
+start_profiling(uint32_t interval)
+  {
+    this->m_global.sampling_profiler().start(interval);
+  }
+
+void
+Simple_Script::
+stop_profiling() noexcept
+  {
+    this->m_global.sampling_profiler().stop();
+  }
+
+void
+Simple_Script::
+write_profile(const char* path) const
+  {
+    this->m_global.sampling_profiler().write_folded_file(path);
+  }
+
 }  // namespace asteria
@@ -92,6 +92,19 @@ class Simple_Script
     void
     reload_file(stringR path);
 
+    // Load a script from a file, with precompiled code in `cache_path`. If
+    // the cache file exists and matches both the script and options, the
+    // script is loaded from it without being parsed; otherwise, or if the
+    // cache file is corrupted, the script is compiled as usual. Returns
+    // whether the cache file has been used.
+    bool
+    reload_file_cached(const char* path, const char* cache_path);
+
+    // Load a script from a file, and write its precompiled code into
+    // `cache_path`, which can then be used by `reload_file_cached()`.
+    void
+    precompile_file(const char* path, const char* cache_path);
+
     // Execute the script that has been loaded.
     Reference
     execute(Reference_Stack&& stack);
@@ -101,6 +114,18 @@ class Simple_Script
 
     Reference
     execute();
+
+    // Profile the script with the sampling profiler of the bundled context.
+    // Samples are taken every `interval` microseconds of CPU time, and can be
+    // written in the folded-stack format for flame graph tools.
+    void
+    start_profiling(uint32_t interval = 1000);
+
+    void
+    stop_profiling() noexcept;
+
+    void
+    write_profile(const char* path) const;
   };
 
 }  // namespace asteria
@@ -286,7 +286,7 @@ utf8_decode(char32_t& cp, const char*& pos, size_t avail) noexcept
 
     // Accumulate trailing code units.
     for(size_t i = 1;  i < u8len;  ++i)
-      if(((uint8_t) *pos >= 0x80U) || ((uint8_t) *pos < 0xC0U))
+      if(((uint8_t) *pos >= 0x80U) && ((uint8_t) *pos < 0xC0U))
         cp = (cp << 6) | ((uint8_t) *(pos++) & 0x3FU);
       else
         return false;
@@ -389,6 +389,427 @@ utf16_decode(char32_t& cp, const cow_u16string& text, size_t& offset)
     return true;
   }
 
+namespace {
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define ASTERIA_UTF8_SIMD  1
+#endif
+
+// Decodes a code point from a sequence that has been validated.
+inline
+char32_t
+do_utf8_decode_unchecked(const char*& pos) noexcept
+  {
+    char32_t cp = (uint8_t) *(pos++);
+    if(cp < 0x80U)
+      return cp;
+
+    if(cp < 0xE0U) {
+      cp = (cp & 0x1FU) << 6 | ((uint8_t) pos[0] & 0x3FU);
+      pos += 1;
+    }
+    else if(cp < 0xF0U) {
+      cp = (cp & 0x0FU) << 12 | ((uint8_t) pos[0] & 0x3FU) << 6 | ((uint8_t) pos[1] & 0x3FU);
+      pos += 2;
+    }
+    else {
+      cp = (cp & 0x07U) << 18 | ((uint8_t) pos[0] & 0x3FU) << 12 | ((uint8_t) pos[1] & 0x3FU) << 6
+           | ((uint8_t) pos[2] & 0x3FU);
+      pos += 3;
+    }
+    return cp;
+  }
+
+// This is the scalar fallback. ASCII characters are skipped eight at a time.
+// The return value points to the first invalid sequence, or `eptr` if none.
+const char*
+do_utf8_validate_scalar(const char* bptr, const char* eptr) noexcept
+  {
+    while(bptr != eptr) {
+      if(eptr - bptr >= 8) {
+        uint64_t word;
+        ::memcpy(&word, bptr, 8);
+        if(!(word & 0x8080808080808080ULL)) {
+          bptr += 8;
+          continue;
+        }
+      }
+
+      char32_t cp;
+      const char* tptr = bptr;
+      if(!utf8_decode(cp, tptr, (size_t) (eptr - bptr)))
+        return bptr;
+
+      bptr = tptr;
+    }
+    return eptr;
+  }
+
+// Moves `bptr` back to the beginning of the character that it is in. If a
+// block of bytes has been validated as a whole, this is where validation of
+// the next block shall start, as a character may span both.
+const char*
+do_utf8_back_to_boundary(const char* sptr, const char* bptr) noexcept
+  {
+    const char* tptr = bptr;
+    while((tptr != sptr) && (bptr - tptr < 3) && ((tptr[-1] & 0xC0) == 0x80))
+      tptr --;
+
+    if((tptr != sptr) && ((uint8_t) tptr[-1] >= 0xC0U))
+      tptr --;
+
+    return tptr;
+  }
+
+#ifdef ASTERIA_UTF8_SIMD
+// This is the lookup algorithm from 'Validating UTF-8 In Less Than One
+// Instruction Per Byte' by John Keiser and Daniel Lemire. Each pair of
+// adjacent bytes is classified by the high and low nibbles of the first byte
+// and the high nibble of the second byte. Each lookup yields a set of errors
+// that the pair may have, and the pair is invalid if all three sets have an
+// error in common. Third and fourth bytes of characters are then checked
+// with saturating subtraction.
+constexpr char utf8e_too_short    = 0x01;  // 11______ 0_______
+constexpr char utf8e_too_long     = 0x02;  // 0_______ 10______
+constexpr char utf8e_overlong_3   = 0x04;  // 11100000 100_____
+constexpr char utf8e_too_large    = 0x08;  // 11110100 1001____
+constexpr char utf8e_surrogate    = 0x10;  // 11101101 101_____
+constexpr char utf8e_overlong_2   = 0x20;  // 1100000_ 10______
+constexpr char utf8e_too_large_x  = 0x40;  // 11110101 1000____
+constexpr char utf8e_overlong_4   = 0x40;  // 11110000 1000____
+constexpr char utf8e_two_conts    = (char) 0x80;  // 10______ 10______
+constexpr char utf8e_carry        = utf8e_too_short | utf8e_too_long | utf8e_two_conts;
+
+#define do_utf8_lookup_tables_(SETR)  \
+    const auto tb1h = SETR(  \
+        utf8e_too_long, utf8e_too_long, utf8e_too_long, utf8e_too_long,  \
+        utf8e_too_long, utf8e_too_long, utf8e_too_long, utf8e_too_long,  \
+        utf8e_two_conts, utf8e_two_conts, utf8e_two_conts, utf8e_two_conts,  \
+        utf8e_too_short | utf8e_overlong_2,  \
+        utf8e_too_short,  \
+        utf8e_too_short | utf8e_overlong_3 | utf8e_surrogate,  \
+        utf8e_too_short | utf8e_too_large | utf8e_too_large_x | utf8e_overlong_4);  \
+    const auto tb1l = SETR(  \
+        utf8e_carry | utf8e_overlong_3 | utf8e_overlong_2 | utf8e_overlong_4,  \
+        utf8e_carry | utf8e_overlong_2,  \
+        utf8e_carry,  \
+        utf8e_carry,  \
+        utf8e_carry | utf8e_too_large,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x | utf8e_surrogate,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x,  \
+        utf8e_carry | utf8e_too_large | utf8e_too_large_x);  \
+    const auto tb2h = SETR(  \
+        utf8e_too_short, utf8e_too_short, utf8e_too_short, utf8e_too_short,  \
+        utf8e_too_short, utf8e_too_short, utf8e_too_short, utf8e_too_short,  \
+        utf8e_too_long | utf8e_overlong_2 | utf8e_two_conts | utf8e_overlong_3  \
+          | utf8e_too_large_x | utf8e_overlong_4,  \
+        utf8e_too_long | utf8e_overlong_2 | utf8e_two_conts | utf8e_overlong_3  \
+          | utf8e_too_large,  \
+        utf8e_too_long | utf8e_overlong_2 | utf8e_two_conts | utf8e_surrogate  \
+          | utf8e_too_large,  \
+        utf8e_too_long | utf8e_overlong_2 | utf8e_two_conts | utf8e_surrogate  \
+          | utf8e_too_large,  \
+        utf8e_too_short, utf8e_too_short, utf8e_too_short, utf8e_too_short)  // no semicolon
+
+__attribute__((__target__("avx2")))
+__m256i
+do_utf8_setr_avx2(char c0, char c1, char c2, char c3, char c4, char c5, char c6, char c7,
+                  char c8, char c9, char ca, char cb, char cc, char cd, char ce, char cf) noexcept
+  {
+    return _mm256_broadcastsi128_si256(
+             _mm_setr_epi8(c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, ca, cb, cc, cd, ce, cf));
+  }
+
+__attribute__((__target__("avx2")))
+const char*
+do_utf8_validate_avx2(const char* sptr, const char* eptr) noexcept
+  {
+    do_utf8_lookup_tables_(do_utf8_setr_avx2);
+    const __m256i nib = _mm256_set1_epi8(0x0F);
+    const __m256i byte3 = _mm256_set1_epi8((char) (0xE0 - 0x80));
+    const __m256i byte4 = _mm256_set1_epi8((char) (0xF0 - 0x80));
+    const __m256i bit7 = _mm256_set1_epi8((char) 0x80);
+    const __m256i incmax = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            -1, -1, -1, -1, -1, -1, -1,
+                                            (char) 0xEF, (char) 0xDF, (char) 0xBF);
+    const char* bptr = sptr;
+    __m256i prev = _mm256_setzero_si256();
+
+    while(eptr - bptr >= 32) {
+      __m256i input = _mm256_loadu_si256((const __m256i*) bptr);
+      __m256i err;
+
+      if(_mm256_movemask_epi8(input) == 0) {
+        // If all bytes are ASCII, the previous block must not end with an
+        // incomplete character.
+        err = _mm256_subs_epu8(prev, incmax);
+      }
+      else {
+        // Get the previous three bytes of each byte.
+        __m256i carry = _mm256_permute2x128_si256(prev, input, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(input, carry, 15);
+        __m256i prev2 = _mm256_alignr_epi8(input, carry, 14);
+        __m256i prev3 = _mm256_alignr_epi8(input, carry, 13);
+
+        // Check each pair of adjacent bytes.
+        __m256i sc = _mm256_shuffle_epi8(tb1h, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nib));
+        sc = _mm256_and_si256(sc, _mm256_shuffle_epi8(tb1l, _mm256_and_si256(prev1, nib)));
+        sc = _mm256_and_si256(sc, _mm256_shuffle_epi8(tb2h, _mm256_and_si256(_mm256_srli_epi16(input, 4), nib)));
+
+        // Third and fourth bytes must be continuations. The lookups above
+        // yield `two_conts` for them, which cancels out here.
+        __m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, byte3), _mm256_subs_epu8(prev3, byte4));
+        err = _mm256_xor_si256(_mm256_and_si256(must23, bit7), sc);
+      }
+
+      if(!_mm256_testz_si256(err, err))
+        break;
+
+      prev = input;
+      bptr += 32;
+    }
+
+    // Locate the error, or validate remaining bytes.
+    return do_utf8_validate_scalar(do_utf8_back_to_boundary(sptr, bptr), eptr);
+  }
+
+__attribute__((__target__("sse4.1")))
+const char*
+do_utf8_validate_sse41(const char* sptr, const char* eptr) noexcept
+  {
+    do_utf8_lookup_tables_(_mm_setr_epi8);
+    const __m128i nib = _mm_set1_epi8(0x0F);
+    const __m128i byte3 = _mm_set1_epi8((char) (0xE0 - 0x80));
+    const __m128i byte4 = _mm_set1_epi8((char) (0xF0 - 0x80));
+    const __m128i bit7 = _mm_set1_epi8((char) 0x80);
+    const __m128i incmax = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                         (char) 0xEF, (char) 0xDF, (char) 0xBF);
+    const char* bptr = sptr;
+    __m128i prev = _mm_setzero_si128();
+
+    while(eptr - bptr >= 16) {
+      __m128i input = _mm_loadu_si128((const __m128i*) bptr);
+      __m128i err;
+
+      if(_mm_movemask_epi8(input) == 0) {
+        // If all bytes are ASCII, the previous block must not end with an
+        // incomplete character.
+        err = _mm_subs_epu8(prev, incmax);
+      }
+      else {
+        // Get the previous three bytes of each byte.
+        __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+        __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+
+        // Check each pair of adjacent bytes.
+        __m128i sc = _mm_shuffle_epi8(tb1h, _mm_and_si128(_mm_srli_epi16(prev1, 4), nib));
+        sc = _mm_and_si128(sc, _mm_shuffle_epi8(tb1l, _mm_and_si128(prev1, nib)));
+        sc = _mm_and_si128(sc, _mm_shuffle_epi8(tb2h, _mm_and_si128(_mm_srli_epi16(input, 4), nib)));
+
+        // Third and fourth bytes must be continuations.
+        __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, byte3), _mm_subs_epu8(prev3, byte4));
+        err = _mm_xor_si128(_mm_and_si128(must23, bit7), sc);
+      }
+
+      if(!_mm_testz_si128(err, err))
+        break;
+
+      prev = input;
+      bptr += 16;
+    }
+
+    // Locate the error, or validate remaining bytes.
+    return do_utf8_validate_scalar(do_utf8_back_to_boundary(sptr, bptr), eptr);
+  }
+#endif  // ASTERIA_UTF8_SIMD
+
+}  // namespace
+
+bool
+utf8_validate(const char*& pos, size_t avail) noexcept
+  {
+    const char* eptr = pos + avail;
+
+#ifdef ASTERIA_UTF8_SIMD
+    // Check for CPU features only once.
+    static const bool s_avx2 = __builtin_cpu_supports("avx2");
+    static const bool s_sse41 = __builtin_cpu_supports("sse4.1");
+
+    if(s_avx2)
+      pos = do_utf8_validate_avx2(pos, eptr);
+    else if(s_sse41)
+      pos = do_utf8_validate_sse41(pos, eptr);
+    else
+#endif
+      pos = do_utf8_validate_scalar(pos, eptr);
+
+    return pos == eptr;
+  }
+
+bool
+utf8_to_utf16(cow_u16string& text, const char*& pos, size_t avail)
+  {
+    // Validate characters in bulk, so they can be decoded without checks.
+    const char* bptr = pos;
+    bool valid = utf8_validate(pos, avail);
+    const char* eptr = pos;
+
+    // Each byte yields at most one code unit.
+    size_t off = text.size();
+    text.append((size_t) (eptr - bptr), u'\0');
+    char16_t* out = text.mut_data() + off;
+
+    while(bptr != eptr) {
+#ifdef __SSE2__
+      // Widen ASCII characters, sixteen at a time.
+      if(eptr - bptr >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*) bptr);
+        if(_mm_movemask_epi8(x) == 0) {
+          _mm_storeu_si128((__m128i*) out, _mm_unpacklo_epi8(x, _mm_setzero_si128()));
+          _mm_storeu_si128((__m128i*) (out + 8), _mm_unpackhi_epi8(x, _mm_setzero_si128()));
+          bptr += 16;
+          out += 16;
+          continue;
+        }
+      }
+#endif
+
+      char32_t cp = do_utf8_decode_unchecked(bptr);
+      utf16_encode(out, cp);
+    }
+
+    text.erase((size_t) (out - text.data()));
+    return valid;
+  }
+
+bool
+utf8_to_utf32(cow_u32string& text, const char*& pos, size_t avail)
+  {
+    // Validate characters in bulk, so they can be decoded without checks.
+    const char* bptr = pos;
+    bool valid = utf8_validate(pos, avail);
+    const char* eptr = pos;
+
+    // Each byte yields at most one code point.
+    size_t off = text.size();
+    text.append((size_t) (eptr - bptr), U'\0');
+    char32_t* out = text.mut_data() + off;
+
+    while(bptr != eptr) {
+#ifdef __SSE2__
+      // Widen ASCII characters, sixteen at a time.
+      if(eptr - bptr >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*) bptr);
+        if(_mm_movemask_epi8(x) == 0) {
+          __m128i lo = _mm_unpacklo_epi8(x, _mm_setzero_si128());
+          __m128i hi = _mm_unpackhi_epi8(x, _mm_setzero_si128());
+          _mm_storeu_si128((__m128i*) out, _mm_unpacklo_epi16(lo, _mm_setzero_si128()));
+          _mm_storeu_si128((__m128i*) (out + 4), _mm_unpackhi_epi16(lo, _mm_setzero_si128()));
+          _mm_storeu_si128((__m128i*) (out + 8), _mm_unpacklo_epi16(hi, _mm_setzero_si128()));
+          _mm_storeu_si128((__m128i*) (out + 12), _mm_unpackhi_epi16(hi, _mm_setzero_si128()));
+          bptr += 16;
+          out += 16;
+          continue;
+        }
+      }
+#endif
+
+      *(out++) = do_utf8_decode_unchecked(bptr);
+    }
+
+    text.erase((size_t) (out - text.data()));
+    return valid;
+  }
+
+bool
+utf16_to_utf8(cow_string& text, const char16_t*& pos, size_t avail)
+  {
+    const char16_t* bptr = pos;
+    const char16_t* eptr = pos + avail;
+
+    // Each code unit yields at most three bytes.
+    size_t off = text.size();
+    text.append(avail * 3, '\0');
+    char* out = text.mut_data() + off;
+
+    while(bptr != eptr) {
+#ifdef __SSE2__
+      // Narrow ASCII characters, eight at a time.
+      if(eptr - bptr >= 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*) bptr);
+        __m128i t = _mm_and_si128(x, _mm_set1_epi16((short) 0xFF80));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(t, _mm_setzero_si128())) == 0xFFFF) {
+          _mm_storel_epi64((__m128i*) out, _mm_packus_epi16(x, x));
+          bptr += 8;
+          out += 8;
+          continue;
+        }
+      }
+#endif
+
+      char32_t cp;
+      const char16_t* tptr = bptr;
+      if(!utf16_decode(cp, tptr, (size_t) (eptr - bptr)))
+        break;
+
+      bptr = tptr;
+      utf8_encode(out, cp);
+    }
+
+    pos = bptr;
+    text.erase((size_t) (out - text.data()));
+    return bptr == eptr;
+  }
+
+bool
+utf32_to_utf8(cow_string& text, const char32_t*& pos, size_t avail)
+  {
+    const char32_t* bptr = pos;
+    const char32_t* eptr = pos + avail;
+
+    // Each code point yields at most four bytes.
+    size_t off = text.size();
+    text.append(avail * 4, '\0');
+    char* out = text.mut_data() + off;
+
+    while(bptr != eptr) {
+#ifdef __SSE2__
+      // Narrow ASCII characters, four at a time.
+      if(eptr - bptr >= 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*) bptr);
+        __m128i t = _mm_and_si128(x, _mm_set1_epi32((int) 0xFFFFFF80));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(t, _mm_setzero_si128())) == 0xFFFF) {
+          x = _mm_packs_epi32(x, x);
+          int word = _mm_cvtsi128_si32(_mm_packus_epi16(x, x));
+          ::memcpy(out, &word, 4);
+          bptr += 4;
+          out += 4;
+          continue;
+        }
+      }
+#endif
+
+      if(!utf8_encode(out, *bptr))
+        break;
+
+      bptr ++;
+    }
+
+    pos = bptr;
+    text.erase((size_t) (out - text.data()));
+    return bptr == eptr;
+  }
+
 tinyfmt&
 c_quote(tinyfmt& fmt, const char* data, size_t size)
   {
@@ -235,6 +235,25 @@ utf16_decode(char32_t& cp, const char16_t*& pos, size_t avail) noexcept;
 bool
 utf16_decode(char32_t& cp, const cow_u16string& text, size_t& offset);
 
+// Bulk UTF conversion functions. These functions process as many characters
+// as possible, and advance `pos` past them. If an invalid sequence is
+// encountered, `pos` is left at its beginning and `false` is returned;
+// characters before it have been converted.
+bool
+utf8_validate(const char*& pos, size_t avail) noexcept;
+
+bool
+utf8_to_utf16(cow_u16string& text, const char*& pos, size_t avail);
+
+bool
+utf8_to_utf32(cow_u32string& text, const char*& pos, size_t avail);
+
+bool
+utf16_to_utf8(cow_string& text, const char16_t*& pos, size_t avail);
+
+bool
+utf32_to_utf8(cow_string& text, const char32_t*& pos, size_t avail);
+
 // C-style quoting
 tinyfmt&
 c_quote(tinyfmt& fmt, const char* data, size_t size);
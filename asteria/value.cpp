@@ -137,7 +137,7 @@ do_destroy_variant_slow() noexcept
 
 void
 Value::
-do_collect_variables_slow(Variable_HashMap& staged, Variable_HashMap& temp) const
+do_collect_variables_slow(Variable_HashMap& staged, Variable_Worklist& temp) const
   {
     // Expand recursion by hand with a stack.
     auto qval = this;
@@ -99,7 +99,7 @@ class Value
     do_destroy_variant_slow() noexcept;
 
     void
-    do_collect_variables_slow(Variable_HashMap& staged, Variable_HashMap& temp) const;
+    do_collect_variables_slow(Variable_HashMap& staged, Variable_Worklist& temp) const;
 
     [[noreturn]]
     void
@@ -310,7 +310,7 @@ class Value
 
     // This is used by garbage collection.
     void
-    collect_variables(Variable_HashMap& staged, Variable_HashMap& temp) const
+    collect_variables(Variable_HashMap& staged, Variable_Worklist& temp) const
       {
         if(this->type() >= type_opaque)
           this->do_collect_variables_slow(staged, temp);
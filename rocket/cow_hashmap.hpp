@@ -27,7 +27,8 @@ namespace rocket {
 //    Multimap cannot be implemented.
 // 7. The key and mapped types may be incomplete. The mapped type need be neither
 //    copy-assignable nor move-assignable.
-// 8. `erase()` may move elements around and invalidate iterators.
+// 8. Elements are stored in place. Insertion may move elements around and
+//    invalidate iterators, but `erase()` doesn't move other elements.
 template<typename keyT, typename mappedT, typename hashT = hash<keyT>,
          typename eqT = equal_to<void>, typename allocT = allocator<pair<const keyT, mappedT>>>
 class cow_hashmap;
@@ -401,7 +402,7 @@ class cow_hashmap
         if(!this->m_sth.unique())
           return this->do_deallocate();
 
-        this->m_sth.erase_range_unchecked(0, this->size());
+        this->m_sth.erase_range_unchecked(0, this->bucket_count());
         return *this;
       }
 
@@ -429,7 +430,7 @@ class cow_hashmap
     // N.B. The return type differs from `std::unordered_map`.
     double
     max_load_factor() const noexcept
-      { return 1.0 / storage_handle::max_load_factor_reciprocal;  }
+      { return storage_handle::max_load_factor;  }
 
     // N.B. The return type is a non-standard extension.
     cow_hashmap&
@@ -503,7 +504,7 @@ class cow_hashmap
         }
         else {
           // The length is not known.
-          bkts = sth.reallocate_reserve(this->m_sth, false, 17 | cap / 2);
+          bkts = sth.reallocate_reserve(this->m_sth, false, 7 | cap / 2);
           cap = sth.capacity();
           for(auto it = ::std::move(first);  it != last;  ++it) {
             if(ROCKET_UNEXPECT(sth.size() >= cap)) {
@@ -557,10 +558,12 @@ class cow_hashmap
         if(this->m_sth.find(tpos, ykey))
           return { iterator(this->do_mut_buckets(), tpos, this->bucket_count()), false };
 
-        // Allocate new storage.
+        // Allocate new storage. Tables with less than a group of buckets are
+        // doubled, as moving elements is cheaper than carrying empty buckets.
         storage_handle sth(this->m_sth.as_allocator(), this->m_sth.as_hasher(),
                            this->m_sth.as_key_equal());
-        bkts = sth.reallocate_reserve(this->m_sth, false, 17 | cap / 2);
+        bkts = sth.reallocate_reserve(this->m_sth, false,
+                    (cap < hash_group_size) ? noadl::max(cap, size_type(8)) : (cap / 2));
 
         sth.keyed_try_emplace(tpos, ykey,
                  ::std::piecewise_construct,
@@ -735,6 +738,28 @@ class cow_hashmap
         return ::std::addressof(this->do_mut_buckets()[tpos]->second);
       }
 
+    // These functions take a bucket index which is checked before hashing. If
+    // the element is found, its bucket index is stored into `hint`, which can
+    // be passed again for later lookups of the same key.
+    // N.B. These are non-standard extensions.
+    template<typename ykeyT>
+    const mapped_type*
+    ptr_hint(size_type& hint, const ykeyT& ykey) const
+      {
+        if(!this->m_sth.find_hint(hint, ykey))
+          return nullptr;
+        return ::std::addressof(this->do_buckets()[hint]->second);
+      }
+
+    template<typename ykeyT>
+    mapped_type*
+    mut_ptr_hint(size_type& hint, const ykeyT& ykey)
+      {
+        if(!this->m_sth.find_hint(hint, ykey))
+          return nullptr;
+        return ::std::addressof(this->do_mut_buckets()[hint]->second);
+      }
+
     // N.B. This function is a non-standard extension.
     template<typename inputT,
     ROCKET_ENABLE_IF(is_input_iterator<inputT>::value)>
@@ -26,6 +26,10 @@ namespace rocket {
 //    null-terminated character arrays allocated externally.
 // 7. `data()` returns a null pointer if the string is empty.
 // 8. `erase()` and `substr()` cannot be called without arguments.
+// 9. Short strings of single-byte characters are stored in place, so moving
+//    or swapping a string invalidates pointers and iterators into it, as it
+//    does with `std::basic_string`. Copies, which share storage, are not
+//    affected.
 template<typename charT>
 class basic_shallow_string;
 
@@ -220,6 +224,17 @@ class basic_cow_string
         basic_cow_string(alloc)
       { this->append(::std::move(first), ::std::move(last));  }
 
+#ifdef __cpp_constexpr_dynamic_alloc
+    constexpr
+#endif
+    ~basic_cow_string()
+      {
+        // Characters stored in place may have been modified bytewise, so
+        // avoid reading them back as a word, which would be slow.
+        if(!this->m_ref.m_ptr)
+          this->m_sth.release_sso();
+      }
+
     basic_cow_string&
     operator=(shallow_type sh) & noexcept
       {
@@ -275,11 +290,69 @@ class basic_cow_string
     void
     do_set_data_and_size(value_type* ptr, size_type n) noexcept
       {
+        // If characters are stored in place, they can't be referenced by
+        // pointer, as strings are relocated bitwise. A null pointer denotes
+        // such a string. The storage handle is not read here, as it may have
+        // been modified bytewise.
+        bool sso = (storage_handle::sso_capacity != 0) && (ptr == this->m_sth.sso_data());
         ptr[n] = value_type();
-        this->m_ref.m_ptr = ptr;
+        this->m_ref.m_ptr = sso ? nullptr : ptr;
         this->m_ref.m_len = n;
       }
 
+    value_type*
+    do_exchange_storage(storage_handle& sth, value_type* ptr, size_type n) noexcept
+      {
+        // Take ownership of the new storage from `sth`, and pass the old one
+        // to `sth`, which shall be released by the caller.
+        this->m_sth.exchange_with(sth);
+        if(this->m_sth.sso())
+          ptr = this->m_sth.sso_mut_data();
+        this->do_set_data_and_size(ptr, n);
+        return ptr;
+      }
+
+    value_type*
+    do_mut_data_opt() noexcept
+      {
+        // Characters stored in place are always unique.
+        if(!this->m_ref.m_ptr) {
+          ROCKET_ASSERT(this->m_ref.m_len <= storage_handle::sso_capacity);
+          return this->m_sth.sso_mut_data();
+        }
+
+        // Storage is only reusable if it is unique and this string starts at
+        // its beginning. It isn't if this string is a suffix of a string that
+        // has been destroyed, or it has been assigned a shallow string.
+        auto ptr = this->m_sth.mut_data_opt();
+        if(ptr && (ptr != this->m_ref.m_ptr) && (this->m_ref.m_len != 0))
+          return nullptr;
+        return ptr;
+      }
+
+    value_type*
+    do_mut_data_for_append_opt(size_type n) noexcept
+      {
+        // This is `do_mut_data_opt()` with a check for space. The in-place
+        // buffer is checked against its constant capacity in its own branch,
+        // so the compiler can tell it from dynamic storage when it sees a
+        // write of `n` characters through the result.
+        size_type len = this->m_ref.m_len;
+        if(!this->m_ref.m_ptr) {
+          ROCKET_ASSERT(len <= storage_handle::sso_capacity);
+          if(n > storage_handle::sso_capacity - len)
+            return nullptr;
+          return this->m_sth.sso_mut_data();
+        }
+
+        auto ptr = this->m_sth.mut_data_opt();
+        if(!ptr || ((ptr != this->m_ref.m_ptr) && (len != 0)))
+          return nullptr;
+        if(n > this->m_sth.capacity() - len)
+          return nullptr;
+        return ptr;
+      }
+
     [[noreturn]] ROCKET_NEVER_INLINE
     void
     do_throw_subscript_out_of_range(size_type pos, unsigned char rel) const
@@ -425,7 +498,10 @@ class basic_cow_string
     constexpr
     size_type
     capacity() const noexcept
-      { return this->m_sth.capacity();  }
+      {
+        return ROCKET_EXPECT(this->m_ref.m_ptr) ? this->m_sth.capacity()
+                                                : storage_handle::sso_capacity;
+      }
 
     // N.B. The return type is a non-standard extension.
     basic_cow_string&
@@ -444,8 +520,7 @@ class basic_cow_string
         // Allocate new storage.
         storage_handle sth(this->m_sth.as_allocator());
         auto ptr = sth.reallocate_more(this->data(), this->size(), rcap - this->size());
-        this->m_sth.exchange_with(sth);
-        this->m_ref.m_ptr = ptr;
+        this->do_exchange_storage(sth, ptr, this->size());
         return *this;
       }
 
@@ -466,8 +541,7 @@ class basic_cow_string
         // Allocate new storage.
         storage_handle sth(this->m_sth.as_allocator());
         auto ptr = sth.reallocate_more(this->data(), this->size(), 0);
-        this->m_sth.exchange_with(sth);
-        this->m_ref.m_ptr = ptr;
+        this->do_exchange_storage(sth, ptr, this->size());
         return *this;
       }
 
@@ -597,11 +671,11 @@ class basic_cow_string
           return *this;
 
         // Check whether the storage is unique and there is enough space.
-        auto ptr = this->m_sth.mut_data_opt();
+        auto ptr = this->do_mut_data_for_append_opt(n);
         size_type cap = this->capacity();
         size_type len = this->size();
 
-        if(ROCKET_EXPECT(ptr && (n <= cap - len))) {
+        if(ROCKET_EXPECT(ptr)) {
           ::memmove(ptr + len, s, n * sizeof(value_type));
           len += n;
           this->do_set_data_and_size(ptr, len);
@@ -610,11 +684,10 @@ class basic_cow_string
 
         // Allocate new storage.
         storage_handle sth(this->m_sth.as_allocator());
-        ptr = sth.reallocate_more(this->m_ref.m_ptr, len, n | cap / 2);
+        ptr = sth.reallocate_more(this->data(), len, n | cap / 2);
         ::memcpy(ptr + len, s, n * sizeof(value_type));
         len += n;
-        this->m_sth.exchange_with(sth);
-        this->do_set_data_and_size(ptr, len);
+        this->do_exchange_storage(sth, ptr, len);
         return *this;
       }
 
@@ -625,11 +698,11 @@ class basic_cow_string
           return *this;
 
         // Check whether the storage is unique and there is enough space.
-        auto ptr = this->m_sth.mut_data_opt();
+        auto ptr = this->do_mut_data_for_append_opt(n);
         size_type cap = this->capacity();
         size_type len = this->size();
 
-        if(ROCKET_EXPECT(ptr && (n <= cap - len))) {
+        if(ROCKET_EXPECT(ptr)) {
           noadl::xmempset(ptr + len, c, n);
           len += n;
           this->do_set_data_and_size(ptr, len);
@@ -638,11 +711,10 @@ class basic_cow_string
 
         // Allocate new storage.
         storage_handle sth(this->m_sth.as_allocator());
-        ptr = sth.reallocate_more(this->m_ref.m_ptr, len, n | cap / 2);
+        ptr = sth.reallocate_more(this->data(), len, n | cap / 2);
         noadl::xmempset(ptr + len, c, n);
         len += n;
-        this->m_sth.exchange_with(sth);
-        this->do_set_data_and_size(ptr, len);
+        this->do_exchange_storage(sth, ptr, len);
         return *this;
       }
 
@@ -658,11 +730,11 @@ class basic_cow_string
         size_type n = static_cast<size_type>(dist);
 
         // Check whether the storage is unique and there is enough space.
-        auto ptr = this->m_sth.mut_data_opt();
+        auto ptr = (dist && (dist == n)) ? this->do_mut_data_for_append_opt(n) : nullptr;
         size_type cap = this->capacity();
         size_type len = this->size();
 
-        if(ROCKET_EXPECT(dist && (dist == n) && ptr && (n <= cap - len))) {
+        if(ROCKET_EXPECT(ptr)) {
           for(auto it = ::std::move(first);  it != last;  ++it)
             ptr[len++] = *it;
           this->do_set_data_and_size(ptr, len);
@@ -673,13 +745,13 @@ class basic_cow_string
         storage_handle sth(this->m_sth.as_allocator());
         if(ROCKET_EXPECT(dist && (dist == n))) {
           // The length is known.
-          ptr = sth.reallocate_more(this->m_ref.m_ptr, len, n | cap / 2);
+          ptr = sth.reallocate_more(this->data(), len, n | cap / 2);
           for(auto it = ::std::move(first);  it != last;  ++it)
             ptr[len++] = *it;
         }
         else {
           // The length is not known.
-          ptr = sth.reallocate_more(this->m_ref.m_ptr, len, 17 | cap / 2);
+          ptr = sth.reallocate_more(this->data(), len, 17 | cap / 2);
           cap = sth.capacity();
           for(auto it = ::std::move(first);  it != last;  ++it) {
             if(ROCKET_UNEXPECT(len >= cap)) {
@@ -689,8 +761,7 @@ class basic_cow_string
             ptr[len++] = *it;
           }
         }
-        this->m_sth.exchange_with(sth);
-        this->do_set_data_and_size(ptr, len);
+        this->do_exchange_storage(sth, ptr, len);
         return *this;
       }
 
@@ -1083,7 +1154,7 @@ class basic_cow_string
           return *this;
 
         // If the storage is unique, modify it in place.
-        auto ptr = this->m_sth.mut_data_opt();
+        auto ptr = this->do_mut_data_opt();
         if(ROCKET_EXPECT(ptr)) {
           this->do_set_data_and_size(ptr, this->size() - n);
           return *this;
@@ -1102,7 +1173,7 @@ class basic_cow_string
         size_type tlen = this->do_clamp_substr(tpos, tn);
         basic_cow_string res(this->m_sth.as_allocator());
 
-        if(tpos + tlen == this->m_ref.m_len) {
+        if((tpos + tlen == this->m_ref.m_len) && this->m_ref.m_ptr) {
           // Reuse the last part of existing dynamic storage.
           res.m_sth.share_with(this->m_sth);
           res.m_ref.m_ptr = this->m_ref.m_ptr + tpos;
@@ -1111,7 +1182,7 @@ class basic_cow_string
         }
 
         // Duplicate the subrange.
-        auto ptr = res.m_sth.reallocate_more(this->m_ref.m_ptr, 0, tlen);
+        auto ptr = res.m_sth.reallocate_more(this->data(), 0, tlen);
         ::memcpy(ptr, this->data() + tpos, tlen * sizeof(value_type));
         res.do_set_data_and_size(ptr, tlen);
         return res;
@@ -1184,15 +1255,20 @@ class basic_cow_string
       }
 
     // 24.3.2.7, string operations
+    // N.B. If this string is stored in place, the result points into this
+    // object, and becomes dangling when this string is moved.
     constexpr
     const value_type*
     data() const noexcept
-      { return this->m_ref.m_ptr;  }
+      {
+        return ROCKET_EXPECT(this->m_ref.m_ptr) ? this->m_ref.m_ptr
+                                                : this->m_sth.sso_data();
+      }
 
     constexpr
     const value_type*
     c_str() const noexcept
-      { return this->m_ref.m_ptr;  }
+      { return this->data();  }
 
     // N.B. This is a non-standard extension.
     const value_type*
@@ -1213,8 +1289,8 @@ class basic_cow_string
     value_type*
     mut_data()
       {
-        auto ptr = this->m_sth.mut_data_opt();
-        if(ROCKET_EXPECT(ptr))
+        auto ptr = this->do_mut_data_opt();
+        if(ROCKET_EXPECT(ptr && (ptr == this->data())))
           return ptr;
 
         // If the string is empty, return a pointer to constant storage. The
@@ -1224,7 +1300,7 @@ class basic_cow_string
 
         // Reallocate the storage. The length is left intact.
         ptr = this->m_sth.reallocate_more(this->data(), this->size(), 0);
-        this->m_ref.m_ptr = ptr;
+        this->do_set_data_and_size(ptr, this->size());
         return ptr;
       }
 
@@ -2329,24 +2405,9 @@ struct basic_cow_string<charT, allocT>::hash
     using result_type    = uint32_t;
     using argument_type  = basic_cow_string;
 
-    constexpr
     result_type
     operator()(const argument_type& str) const noexcept
-      {
-        // Implement the FNV-1a hashing algorithm.
-        uint32_t reg = 2166136261U;
-        for(charT c : str) {
-          int ch = noadl::int_from(c);
-
-          // Accumulate bytes in little-endian byte order.
-          for(uint32_t k = 0;  k != sizeof(c);  ++k) {
-            reg ^= static_cast<uint8_t>(ch);
-            reg *= 16777619U;
-            ch >>= 8;
-          }
-        }
-        return reg;
-      }
+      { return noadl::xmemhash(str.data(), str.size());  }
   };
 
 template<typename charT, typename allocT>
@@ -51,64 +51,62 @@ struct ebo_select_aux<baseT, indexT, firstT, restT...>
 template<typename baseT, typename... othersT>
 using ebo_select  = typename ebo_select_aux<baseT, sizeof...(othersT), othersT...>::type;
 
-// This is a pointer wrapper that preserves const-ness.
+// This is a bucket which stores a value in place. Whether it is in use is
+// indicated by its control byte, which is stored separately.
 template<typename allocT>
 class basic_bucket
   {
   public:
     using allocator_type   = allocT;
     using value_type       = typename allocator_type::value_type;
-    using const_pointer    = typename allocator_traits<allocator_type>::const_pointer;
-    using pointer          = typename allocator_traits<allocator_type>::pointer;
 
   private:
-    pointer m_qval = nullptr;
+    union { value_type m_val;  };
 
   public:
-    constexpr basic_bucket() noexcept = default;
+    basic_bucket() noexcept
+      { }
+
+    ~basic_bucket()
+      { }
 
     basic_bucket(const basic_bucket&) = delete;
     basic_bucket& operator=(const basic_bucket&) = delete;
 
   public:
-    constexpr
-    const_pointer
-    get() const noexcept
-      { return this->m_qval;  }
-
-    pointer
-    get() noexcept
-      { return this->m_qval;  }
-
-    pointer
-    exchange(pointer qval) noexcept
-      { return ::std::exchange(this->m_qval, qval);  }
-
-    explicit constexpr operator
-    bool() const noexcept
-      { return static_cast<bool>(this->m_qval);  }
-
     constexpr
     const value_type&
-    operator*() const
-      { return *(this->m_qval);  }
+    operator*() const noexcept
+      { return this->m_val;  }
 
     value_type&
-    operator*()
-      { return *(this->m_qval);  }
+    operator*() noexcept
+      { return this->m_val;  }
 
     constexpr
     const value_type*
     operator->() const noexcept
-      { return noadl::unfancy(this->m_qval);  }
+      { return ::std::addressof(this->m_val);  }
 
     value_type*
     operator->() noexcept
-      { return noadl::unfancy(this->m_qval);  }
+      { return ::std::addressof(this->m_val);  }
   };
 
+template<typename bucketT>
+constexpr
+size_t
+ctrl_size_for_nbkt(size_t nbkt) noexcept
+  {
+    // There are at least as many control bytes as a group, and buckets after
+    // them have to be aligned.
+    static_assert(alignof(bucketT) <= hash_group_size, "invalid bucket alignment");
+    return (noadl::max(nbkt, hash_group_size) + alignof(bucketT) - 1) / alignof(bucketT)
+           * alignof(bucketT);
+  }
+
 template<typename allocT, typename hashT>
-struct basic_storage
+struct alignas(size_t) alignas(basic_bucket<allocT>) basic_storage
   :
     public storage_header,
     public allocator_wrapper_base_for<allocT>::type,
@@ -117,42 +115,44 @@ struct basic_storage
     using allocator_type   = allocT;
     using hasher           = hashT;
     using bucket_type      = basic_bucket<allocator_type>;
-    using pointer          = typename allocator_traits<allocator_type>::pointer;
     using size_type        = typename allocator_traits<allocator_type>::size_type;
 
+    // Control bytes follow this struct, and buckets follow control bytes.
     size_type nblk;
-    union { bucket_type bkts[1];  };
+    size_type nbkt;
+    size_type ndel;
 
     basic_storage(unknown_function* xdtor, const allocator_type& xalloc,
                   const hasher& hf, size_type xnblk) noexcept
       :
         allocator_wrapper_base_for<allocT>::type(xalloc),
         ebo_select<hashT, allocT>(hf),
-        nblk(xnblk)
+        nblk(xnblk), nbkt(max_nbkt_for_nblk(xnblk)), ndel(0)
       {
         this->dtor = xdtor;
         this->nelem = 0;
 
         // Initialize an empty table.
-        size_t nbkts = this->bucket_count();
-        for(size_t k = 0;  k != nbkts;  ++k)
-          noadl::construct(this->bkts + k);
+        ::std::memset(this->ctrl(), hash_ctrl_empty, ctrl_size_for_nbkt<bucket_type>(this->nbkt));
+
+        for(size_t k = 0;  k != this->nbkt;  ++k)
+          noadl::construct(this->bkts() + k);
       }
 
     ~basic_storage()
       {
         // Destroy all buckets.
-        size_t nbkts = this->bucket_count();
-        for(size_t k = 0;  k != nbkts;  ++k)
-          if(auto qval = this->bkts[k].exchange(nullptr))
-            this->free_value(qval);
+        for(size_t k = 0;  k != this->nbkt;  ++k)
+          if(this->ctrl()[k] < hash_ctrl_empty)
+            allocator_traits<allocator_type>::destroy(*this, this->bkts()[k].operator->());
 
-        for(size_t k = 0;  k != nbkts;  ++k)
-          noadl::destroy(this->bkts + k);
+        for(size_t k = 0;  k != this->nbkt;  ++k)
+          noadl::destroy(this->bkts() + k);
 
 #ifdef ROCKET_DEBUG
         this->nelem = static_cast<size_type>(0xBAD1BEEF);
-        ::std::memset(static_cast<void*>(this->bkts), '~', sizeof(bucket_type) + (this->nblk - 1) * sizeof(basic_storage));
+        ::std::memset(static_cast<void*>(this->ctrl()), '~',
+                      (this->nblk - 1) * sizeof(basic_storage));
 #endif
       }
 
@@ -163,47 +163,58 @@ struct basic_storage
     size_type
     min_nblk_for_nbkt(size_t nbkt) noexcept
       {
-        // Note this is correct even when `nbkt` is zero, as long as
-        // `basic_storage` is larger than `bucket_type`.
-        return ((nbkt - 1) * sizeof(bucket_type) + sizeof(basic_storage) - 1)
-                / sizeof(basic_storage) + 1;
+        return (ctrl_size_for_nbkt<bucket_type>(nbkt) + nbkt * sizeof(bucket_type)
+                + sizeof(basic_storage) - 1) / sizeof(basic_storage) + 1;
       }
 
     static constexpr
     size_t
     max_nbkt_for_nblk(size_type nblk) noexcept
-      { return (nblk - 1) * sizeof(basic_storage) / sizeof(bucket_type) + 1;  }
+      {
+        // A table with at least a group of buckets has a multiple of groups of
+        // buckets, so each control byte takes up one byte. A smaller table has
+        // as many control bytes as a group.
+        size_t nbytes = (nblk - 1) * sizeof(basic_storage);
+        size_t nbkt = nbytes / (sizeof(bucket_type) + 1) / hash_group_size * hash_group_size;
+        if(nbkt == 0)
+          nbkt = (nbytes - noadl::min(nbytes, ctrl_size_for_nbkt<bucket_type>(0)))
+                 / sizeof(bucket_type);
+        return nbkt;
+      }
 
     constexpr
     bool
     compatible(const basic_storage& other) const noexcept
       { return static_cast<const allocator_type&>(*this) == static_cast<const allocator_type&>(other);  }
 
-    size_t
-    bucket_count() const noexcept
-      { return this->max_nbkt_for_nblk(this->nblk);  }
+    const uint8_t*
+    ctrl() const noexcept
+      { return reinterpret_cast<const uint8_t*>(this + 1);  }
 
-    template<typename... paramsT>
-    pointer
-    allocate_value(paramsT&&... params)
+    uint8_t*
+    ctrl() noexcept
+      { return reinterpret_cast<uint8_t*>(this + 1);  }
+
+    const bucket_type*
+    bkts() const noexcept
       {
-        auto qval = allocator_traits<allocator_type>::allocate(*this, size_type(1));
-        try {
-          allocator_traits<allocator_type>::construct(*this, noadl::unfancy(qval), ::std::forward<paramsT>(params)...);
-        }
-        catch(...) {
-          allocator_traits<allocator_type>::deallocate(*this, qval, size_type(1));
-          throw;
-        }
-        return qval;
+        return reinterpret_cast<const bucket_type*>(
+                  this->ctrl() + ctrl_size_for_nbkt<bucket_type>(this->nbkt));
       }
 
-    void
-    free_value(pointer qval) noexcept
+    bucket_type*
+    bkts() noexcept
       {
-        ROCKET_ASSERT(qval);
-        allocator_traits<allocator_type>::destroy(*this, noadl::unfancy(qval)),
-        allocator_traits<allocator_type>::deallocate(*this, qval, size_type(1));
+        return reinterpret_cast<bucket_type*>(
+                  this->ctrl() + ctrl_size_for_nbkt<bucket_type>(this->nbkt));
+      }
+
+    uint32_t
+    group_mask() const noexcept
+      {
+        // A table with less than a group of buckets has some trailing control
+        // bytes that are always empty, which must not be reported as free.
+        return (this->nbkt >= hash_group_size) ? UINT32_MAX : (1U << this->nbkt) - 1U;
       }
 
     template<typename ykeyT>
@@ -212,48 +223,83 @@ struct basic_storage
     hash(const ykeyT& ykey) const noexcept
       { return static_cast<const hasher&>(*this)(ykey);  }
 
-    // This function does not check for duplicate keys.
-    bucket_type*
-    adopt_value_unchecked(pointer qval) noexcept
+    // This function returns the first bucket that is not in use, in the probe
+    // sequence of `hval`. It does not check for duplicate keys.
+    size_t
+    probe_free(size_t hval) const noexcept
       {
-        ROCKET_ASSERT(qval);
-        ROCKET_ASSERT_MSG(this->nref.unique(), "shared storage shall not be modified");
+        // A table with at most a group of buckets is probed as a whole.
+        if(this->nbkt <= hash_group_size) {
+          uint32_t mask = noadl::hash_group_match_free(this->ctrl()) & this->group_mask();
+          ROCKET_ASSERT(mask != 0);
+          return (uint32_t) ROCKET_TZCNT32(mask);
+        }
 
-        // Find a spare bucket.
-        size_t orig = noadl::probe_origin(this->bucket_count(), this->hash(qval->first));
-        auto qbkt = noadl::linear_probe(this->bkts, orig, orig, this->bucket_count(),
-              [&](const bucket_type&) { return false;  });
+        size_t ngrp = (this->nbkt + hash_group_size - 1) / hash_group_size;
+        size_t g = noadl::probe_origin(ngrp, hval);
+        for(;;) {
+          uint32_t mask = noadl::hash_group_match_free(this->ctrl() + g * hash_group_size);
+          mask &= this->group_mask();
+          if(mask != 0)
+            return g * hash_group_size + (uint32_t) ROCKET_TZCNT32(mask);
 
-        // Insert it into the spare bucket.
-        ROCKET_ASSERT(qbkt);
-        return this->adopt_value_unchecked(static_cast<size_type>(qbkt - this->bkts), qval);
+          if(++g == ngrp)
+            g = 0;
+        }
       }
 
     // This function does not check for duplicate keys.
-    // The bucket must be empty prior to this call.
-    bucket_type*
-    adopt_value_unchecked(size_t k, pointer qval) noexcept
+    // The bucket must not be in use prior to this call.
+    template<typename... paramsT>
+    void
+    construct_value(size_t k, uint8_t h2, paramsT&&... params)
       {
-        ROCKET_ASSERT(!this->bkts[k]);
-        ROCKET_ASSERT(qval);
+        ROCKET_ASSERT(this->ctrl()[k] >= hash_ctrl_empty);
+        ROCKET_ASSERT(h2 < hash_ctrl_empty);
         ROCKET_ASSERT_MSG(this->nref.unique(), "shared storage shall not be modified");
 
-        // Insert the value into this bucket.
-        this->bkts[k].exchange(qval);
+        // Construct the value in place, then mark this bucket in use.
+        allocator_traits<allocator_type>::construct(*this, this->bkts()[k].operator->(),
+                                                    ::std::forward<paramsT>(params)...);
+        this->ndel -= this->ctrl()[k] == hash_ctrl_deleted;
+        this->ctrl()[k] = h2;
         this->nelem += 1;
-        return this->bkts + k;
       }
 
-    // This function does not relocate elements and may corrupt the table.
-    pointer
-    extract_value_opt(size_t k) noexcept
+    void
+    destroy_value(size_t k) noexcept
       {
+        ROCKET_ASSERT(this->ctrl()[k] < hash_ctrl_empty);
         ROCKET_ASSERT_MSG(this->nref.unique(), "shared storage shall not be modified");
 
-        // Try extracting an element.
-        auto qval = this->bkts[k].exchange(nullptr);
-        this->nelem -= bool(qval);
-        return qval;
+        allocator_traits<allocator_type>::destroy(*this, this->bkts()[k].operator->());
+        this->nelem -= 1;
+
+        // Probing never goes past a group with an empty bucket, so if there is
+        // one, this bucket may become empty, too. Otherwise, it has to be marked
+        // deleted, so probing for keys in subsequent groups may continue. A
+        // table with at most a group of buckets never needs deleted buckets.
+        if((this->nbkt <= hash_group_size)
+           || (noadl::hash_group_match(this->ctrl() + k / hash_group_size * hash_group_size,
+                                       hash_ctrl_empty) != 0))
+          this->ctrl()[k] = hash_ctrl_empty;
+        else {
+          this->ctrl()[k] = hash_ctrl_deleted;
+          this->ndel += 1;
+        }
+      }
+
+    // This function destroys a value which has been moved into another table,
+    // and leaves its bucket empty. It shall only be used when this table is
+    // about to be freed, as probing may stop there.
+    void
+    destroy_moved_value(size_t k) noexcept
+      {
+        ROCKET_ASSERT(this->ctrl()[k] < hash_ctrl_empty);
+
+        allocator_traits<allocator_type>::destroy(*this, this->bkts()[k].operator->());
+        this->ctrl()[k] = hash_ctrl_empty;
+        this->nelem -= 1;
       }
   };
 
@@ -263,6 +309,7 @@ struct storage_traits
     using allocator_type   = allocT;
     using storage_type     = storageT;
     using value_type       = typename allocator_type::value_type;
+    using mutable_key_type = typename remove_const<typename value_type::first_type>::type;
 
     static
     void
@@ -281,10 +328,11 @@ struct storage_traits
                    false_type,     // 2. cloning?
                    storage_type& st_new, const storage_type& st_old)
       {
-        size_t nbkts = st_old.bucket_count();
-        for(size_t k = 0;  k != nbkts;  ++k)
-          if(auto qval = st_old.bkts[k].get())
-            st_new.adopt_value_unchecked(st_new.allocate_value(*qval));
+        for(size_t k = 0;  k != st_old.nbkt;  ++k)
+          if(st_old.ctrl()[k] < hash_ctrl_empty) {
+            size_t hval = st_new.hash(st_old.bkts()[k]->first);
+            st_new.construct_value(st_new.probe_free(hval), st_old.ctrl()[k], *(st_old.bkts()[k]));
+          }
       }
 
     static
@@ -293,10 +341,14 @@ struct storage_traits
                    true_type,      // 2. cloning?
                    storage_type& st_new, const storage_type& st_old)
       {
-        size_t nbkts = st_old.bucket_count();
-        for(size_t k = 0;  k != nbkts;  ++k)
-          if(auto qval = st_old.bkts[k].get())
-            st_new.adopt_value_unchecked(k, st_new.allocate_value(*qval));
+        // Copy values and deleted buckets to the same locations.
+        for(size_t k = 0;  k != st_old.nbkt;  ++k)
+          if(st_old.ctrl()[k] < hash_ctrl_empty)
+            st_new.construct_value(k, st_old.ctrl()[k], *(st_old.bkts()[k]));
+          else if(st_old.ctrl()[k] == hash_ctrl_deleted) {
+            st_new.ctrl()[k] = hash_ctrl_deleted;
+            st_new.ndel += 1;
+          }
       }
 
     static
@@ -306,10 +358,17 @@ struct storage_traits
         if(st_new.compatible(st_old) && st_old.nref.unique()) {
           // Values may be moved if allocators compare equal and the old
           // storage is exclusively owned.
-          size_t nbkts = st_old.bucket_count();
-          for(size_t k = 0;  k != nbkts;  ++k)
-            if(auto qval = st_old.extract_value_opt(k))
-              st_new.adopt_value_unchecked(qval);
+          for(size_t k = 0;  k != st_old.nbkt;  ++k)
+            if(st_old.ctrl()[k] < hash_ctrl_empty) {
+              // The key is destroyed immediately, so it can be moved, too.
+              auto& oval = *(st_old.bkts()[k]);
+              size_t hval = st_new.hash(oval.first);
+              st_new.construct_value(st_new.probe_free(hval), st_old.ctrl()[k],
+                        ::std::piecewise_construct,
+                        ::std::forward_as_tuple(::std::move(const_cast<mutable_key_type&>(oval.first))),
+                        ::std::forward_as_tuple(::std::move(oval.second)));
+              st_old.destroy_moved_value(k);
+            }
 
           // After moving all values, `st_old` shall be empty.
           ROCKET_ASSERT(st_old.nelem == 0);
@@ -349,7 +408,9 @@ class storage_handle
     using key_equal        = eqT;
     using bucket_type      = basic_bucket<allocator_type>;
 
-    static constexpr size_type max_load_factor_reciprocal = 2;
+    // Buckets that are in use or deleted may take up to 7/8 of a table, so
+    // there is always an empty bucket to stop probing.
+    static constexpr double max_load_factor = 0.875;
 
   private:
     using allocator_base    = typename allocator_wrapper_base_for<allocator_type>::type;
@@ -431,6 +492,83 @@ class storage_handle
         allocator_traits<storage_allocator>::deallocate(st_alloc, qstor, nblk);
       }
 
+    static constexpr
+    size_type
+    do_capacity_for_nbkt(size_t nbkt) noexcept
+      {
+        // A table with at most a group of buckets is probed as a whole, which
+        // does not stop at empty buckets, so it can be full.
+        return static_cast<size_type>((nbkt <= hash_group_size) ? nbkt : nbkt - nbkt / 8);
+      }
+
+    static
+    size_t
+    do_nbkt_for_capacity(size_type cap) noexcept
+      {
+        // Get the minimum number of buckets that can hold `cap` elements.
+        if(cap <= hash_group_size)
+          return noadl::max(cap, size_type(1));
+
+        size_t nbkt = (cap + cap / 7 + hash_group_size - 1) / hash_group_size * hash_group_size;
+        if(do_capacity_for_nbkt(nbkt) < cap)
+          nbkt += hash_group_size;
+        return nbkt;
+      }
+
+    template<typename ykeyT>
+    const bucket_type*
+    do_find(size_type& tpos, size_t hval, const ykeyT& ykey) const noexcept
+      {
+        auto qstor = this->m_qstor;
+        ROCKET_ASSERT(qstor);
+
+        // Find an equivalent key, probing a group of buckets at a time. Keys are
+        // only compared if their control bytes match. Probing stops at a group
+        // with an empty bucket, and there is always one.
+        const uint8_t* ctrl = qstor->ctrl();
+        const bucket_type* bkts = qstor->bkts();
+        uint8_t h2 = noadl::hash_ctrl_h2(hval);
+
+        if(qstor->nbkt <= hash_group_size) {
+          // A table with at most a group of buckets is probed as a whole. Its
+          // trailing control bytes are empty, so they never match.
+          uint32_t mask = noadl::hash_group_match(ctrl, h2);
+          while(mask != 0) {
+            size_t k = (uint32_t) ROCKET_TZCNT32(mask);
+            if(this->as_key_equal()(bkts[k]->first, ykey)) {
+              tpos = static_cast<size_type>(k);
+              return bkts + k;
+            }
+            mask &= mask - 1;
+          }
+          return nullptr;
+        }
+
+        size_t ngrp = (qstor->nbkt + hash_group_size - 1) / hash_group_size;
+        size_t g = noadl::probe_origin(ngrp, hval);
+
+        for(;;) {
+          const uint8_t* gctrl = ctrl + g * hash_group_size;
+          uint32_t mask = noadl::hash_group_match(gctrl, h2);
+          while(mask != 0) {
+            size_t k = g * hash_group_size + (uint32_t) ROCKET_TZCNT32(mask);
+            if(this->as_key_equal()(bkts[k]->first, ykey)) {
+              // Report that an element has been found. The bucket index is
+              // returned via `tpos`.
+              tpos = static_cast<size_type>(k);
+              return bkts + k;
+            }
+            mask &= mask - 1;
+          }
+
+          if(noadl::hash_group_match(gctrl, hash_ctrl_empty) != 0)
+            return nullptr;
+
+          if(++g == ngrp)
+            g = 0;
+        }
+      }
+
   public:
     constexpr
     const hasher&
@@ -485,20 +623,27 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor)
           return 0;
-        return qstor->bucket_count();
+        return qstor->nbkt;
       }
 
     ROCKET_PURE
     size_type
     capacity() const noexcept
-      { return this->bucket_count() / max_load_factor_reciprocal;  }
+      {
+        // Deleted buckets can't be used for new keys without probing, so they
+        // are not counted.
+        auto qstor = this->m_qstor;
+        if(!qstor)
+          return 0;
+        return do_capacity_for_nbkt(qstor->nbkt) - qstor->ndel;
+      }
 
     size_type
     max_size() const noexcept
       {
         storage_allocator st_alloc(this->as_allocator());
         auto max_nblk = allocator_traits<storage_allocator>::max_size(st_alloc);
-        return storage::max_nbkt_for_nblk(max_nblk / 2) / max_load_factor_reciprocal;
+        return do_capacity_for_nbkt(storage::max_nbkt_for_nblk(max_nblk / 2));
       }
 
     size_type
@@ -524,8 +669,8 @@ class storage_handle
     round_up_capacity(size_type res_arg) const
       {
         size_type cap = this->check_size_add(0, res_arg);
-        auto nblk = storage::min_nblk_for_nbkt(cap * max_load_factor_reciprocal);
-        return storage::max_nbkt_for_nblk(nblk) / max_load_factor_reciprocal;
+        auto nblk = storage::min_nblk_for_nbkt(do_nbkt_for_capacity(cap));
+        return do_capacity_for_nbkt(storage::max_nbkt_for_nblk(nblk));
       }
 
     ROCKET_PURE
@@ -535,7 +680,7 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor)
           return reinterpret_cast<bucket_type*>(-1);
-        return qstor->bkts;
+        return qstor->bkts();
       }
 
     bucket_type*
@@ -544,7 +689,7 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor || !qstor->nref.unique())
           return nullptr;
-        return qstor->bkts;
+        return qstor->bkts();
       }
 
     ROCKET_PURE
@@ -565,22 +710,24 @@ class storage_handle
         if(!qstor)
           return nullptr;
 
-        // Find an equivalent key using linear probing.
-        // The load factor is kept below 0.5 so there is always at least one bucket available.
-        size_t orig = noadl::probe_origin(qstor->bucket_count(), qstor->hash(ykey));
-        auto qbkt = noadl::linear_probe(qstor->bkts, orig, orig, qstor->bucket_count(),
-              [&](const bucket_type& r) { return this->as_key_equal()(r->first, ykey);  });
-
-        static_assert(max_load_factor_reciprocal > 1);
-        ROCKET_ASSERT(qbkt);
-        tpos = static_cast<size_type>(qbkt - qstor->bkts);
+        return this->do_find(tpos, qstor->hash(ykey), ykey);
+      }
 
-        // If probing stopped due to an empty bucket, there is no equivalent key.
-        if(!*qbkt)
+    template<typename ykeyT>
+    const bucket_type*
+    find_hint(size_type& tpos, const ykeyT& ykey) const noexcept
+      {
+        auto qstor = this->m_qstor;
+        if(!qstor)
           return nullptr;
 
-        // Report that an element has been found. The bucket index is returned via `tpos`.
-        return qbkt;
+        // Try the bucket which was reported by a previous search first. If it
+        // holds an equivalent key, hashing and probing are skipped.
+        if((tpos < qstor->nbkt) && (qstor->ctrl()[tpos] < hash_ctrl_empty)
+           && this->as_key_equal()(qstor->bkts()[tpos]->first, ykey))
+          return qstor->bkts() + tpos;
+
+        return this->find(tpos, ykey);
       }
 
     template<typename ykeyT, typename... paramsT>
@@ -593,12 +740,13 @@ class storage_handle
         ROCKET_ASSERT_MSG(qstor->nelem < this->capacity(), "no space for new elements");
 
         // Check whether the key exists already.
-        if(this->find(tpos, ykey))
+        size_t hval = qstor->hash(ykey);
+        if(this->do_find(tpos, hval, ykey))
           return false;
 
         // Insert a new element otherwise.
-        // Note that `tpos` shall have been set by `find()`.
-        qstor->adopt_value_unchecked(tpos, qstor->allocate_value(::std::forward<paramsT>(params)...));
+        tpos = static_cast<size_type>(qstor->probe_free(hval));
+        qstor->construct_value(tpos, noadl::hash_ctrl_h2(hval), ::std::forward<paramsT>(params)...);
         return true;
       }
 
@@ -612,24 +760,17 @@ class storage_handle
         if(tlen == 0)
           return;
 
-        // Clear all buckets in the interval [tpos,tpos+tlen).
+        // Destroy all elements in the interval [tpos,tpos+tlen). Other elements
+        // are not moved.
         for(size_t k = tpos;  k != tpos + tlen;  ++k)
-          if(auto qval = qstor->extract_value_opt(k))
-            qstor->free_value(qval);
-
-        // Relocate elements that are not placed in their immediate locations.
-        noadl::linear_probe(
-          qstor->bkts, tpos, tpos + tlen, qstor->bucket_count(),
-          [&](bucket_type& r) {
-            // Clear this bucket temporarily.
-            auto qval = r.exchange(nullptr);
-            ROCKET_ASSERT(qval);
-            qstor->nelem -= 1;
+          if(qstor->ctrl()[k] < hash_ctrl_empty)
+            qstor->destroy_value(k);
 
-            // Insert it back.
-            qstor->adopt_value_unchecked(qval);
-            return false;
-          });
+        // If the table has become empty, remove all deleted buckets.
+        if((qstor->nelem == 0) && (qstor->ndel != 0)) {
+          ::std::memset(qstor->ctrl(), hash_ctrl_empty, qstor->nbkt);
+          qstor->ndel = 0;
+        }
       }
 
     ROCKET_NEVER_INLINE
@@ -641,7 +782,7 @@ class storage_handle
         ROCKET_ASSERT(sth.m_qstor);
         auto len = sth.size();
 
-        // Allocate an array of `storage` large enough for a header + `cap` instances of `bucket_type`.
+        // Allocate a table of the same size.
         auto nblk = sth.m_qstor->nblk;
         storage_allocator st_alloc(this->as_allocator());
         auto qstor = allocator_traits<storage_allocator>::allocate(st_alloc, nblk);
@@ -661,7 +802,7 @@ class storage_handle
 
         // Set up the new storage.
         this->do_reset(qstor);
-        return qstor->bkts;
+        return qstor->bkts();
       }
 
     ROCKET_NEVER_INLINE
@@ -673,8 +814,8 @@ class storage_handle
         auto len = sth.size();
         size_type cap = this->check_size_add(len, add);
 
-        // Allocate an array of `storage` large enough for a header + `cap` instances of `bucket_type`.
-        auto nblk = storage::min_nblk_for_nbkt(cap * max_load_factor_reciprocal);
+        // Allocate a table large enough for `cap` elements.
+        auto nblk = storage::min_nblk_for_nbkt(do_nbkt_for_capacity(cap));
         storage_allocator st_alloc(this->as_allocator());
         auto qstor = allocator_traits<storage_allocator>::allocate(st_alloc, nblk);
         noadl::construct(noadl::unfancy(qstor),
@@ -694,7 +835,7 @@ class storage_handle
 
         // Set up the new storage.
         this->do_reset(qstor);
-        return qstor->bkts;
+        return qstor->bkts();
       }
 
     void
@@ -706,9 +847,9 @@ class storage_handle
 #ifdef ROCKET_DEBUG
         // Ensure there are no duplicate keys.
         size_type tpos;
-        for(size_t k = 0;  k != qstor->bucket_count();  ++k)
-          if(auto qval = qstor->bkts[k].get())
-            ROCKET_ASSERT(!sth.find(tpos, qval->first));
+        for(size_t k = 0;  k != qstor->nbkt;  ++k)
+          if(qstor->ctrl()[k] < hash_ctrl_empty)
+            ROCKET_ASSERT(!sth.find(tpos, qstor->bkts()[k]->first));
 #endif
 
         // Copy/move old elements from `sth`.
@@ -826,7 +967,7 @@ class iterator
         m_begin(begin), m_cur(begin + ncur), m_end(begin + nend)
       {
         // Go to the first following non-empty bucket if any.
-        while((this->m_cur != this->m_end) && !*(this->m_cur))
+        while((this->m_cur != this->m_end) && !this->do_in_use(this->m_cur))
           this->m_cur++;
       }
 
@@ -859,13 +1000,22 @@ class iterator
       }
 
   private:
+    bool
+    do_in_use(const bucketT* cur) const noexcept
+      {
+        // Control bytes precede the first bucket.
+        auto ctrl = reinterpret_cast<const uint8_t*>(this->m_begin)
+                    - ctrl_size_for_nbkt<bucketT>(static_cast<size_t>(this->m_end - this->m_begin));
+        return ctrl[cur - this->m_begin] < hash_ctrl_empty;
+      }
+
     bucketT*
     do_validate(bucketT* cur, bool deref) const noexcept
       {
         ROCKET_ASSERT_MSG(this->m_begin, "iterator not initialized");
         ROCKET_ASSERT_MSG((this->m_begin <= cur) && (cur <= this->m_end), "iterator out of range");
         ROCKET_ASSERT_MSG(!deref || (cur < this->m_end), "past-the-end iterator not dereferenceable");
-        ROCKET_ASSERT_MSG(!deref || *cur, "iterator invalidated");
+        ROCKET_ASSERT_MSG(!deref || this->do_in_use(cur), "iterator invalidated");
         return cur;
       }
 
@@ -895,7 +1045,7 @@ class iterator
           ROCKET_ASSERT_MSG(res.m_cur != this->m_end, "past-the-end iterator not incrementable");
           res.m_cur++;
         }
-        while((res.m_cur != this->m_end) && !*(res.m_cur));
+        while((res.m_cur != this->m_end) && !this->do_in_use(res.m_cur));
         return res;
       }
 
@@ -908,7 +1058,7 @@ class iterator
           ROCKET_ASSERT_MSG(res.m_cur != this->m_begin, "beginning iterator not decrementable");
           res.m_cur--;
         }
-        while(!*(res.m_cur));
+        while(!this->do_in_use(res.m_cur));
         return res;
       }
 
@@ -79,6 +79,15 @@ class storage_handle
     using storage_allocator = typename allocator_traits<allocator_type>::template rebind_alloc<storage>;
     using storage_pointer   = typename allocator_traits<storage_allocator>::pointer;
 
+  public:
+    // A string of at most `sso_capacity` single-byte characters may be stored
+    // in place of the storage pointer, with its least significant bit set as
+    // a tag, which is always clear in a pointer to dynamic storage. As strings
+    // are relocated bitwise, characters have to be accessed through the handle.
+    static constexpr size_type sso_capacity =
+        (is_pointer<storage_pointer>::value && (sizeof(value_type) == 1))
+            ? static_cast<size_type>(sizeof(storage_pointer) - 2) : 0;
+
   private:
     storage_pointer m_qstor = nullptr;
 
@@ -123,6 +132,9 @@ class storage_handle
         if(ROCKET_EXPECT(!qstor))
           return;
 
+        if(this->do_is_sso(qstor))
+          return;
+
         if(ROCKET_EXPECT(qstor->nref.decrement() != 0))
           return;
 
@@ -131,6 +143,34 @@ class storage_handle
         this->do_destroy_storage(qstor);
       }
 
+    static
+    bool
+    do_is_sso(const storage_pointer& qstor) noexcept
+      {
+        return (sso_capacity != 0)
+               && (reinterpret_cast<uintptr_t>(noadl::unfancy(qstor)) & 1);
+      }
+
+    static
+    size_t
+    do_sso_tag_offset() noexcept
+      {
+        // This is the byte containing the least significant bit, which is
+        // a constant after optimization.
+        uintptr_t bits = 1;
+        unsigned char first;
+        ::std::memcpy(&first, &bits, 1);
+        return first ? 0 : sizeof(storage_pointer) - 1;
+      }
+
+    unsigned char*
+    do_sso_bytes() noexcept
+      { return reinterpret_cast<unsigned char*>(&(this->m_qstor));  }
+
+    const unsigned char*
+    do_sso_bytes() const noexcept
+      { return reinterpret_cast<const unsigned char*>(&(this->m_qstor));  }
+
     ROCKET_NEVER_INLINE static
     void
     do_destroy_storage(storage_pointer qstor) noexcept
@@ -151,6 +191,25 @@ class storage_handle
     as_allocator() noexcept
       { return static_cast<allocator_base&>(*this);  }
 
+    ROCKET_PURE
+    bool
+    sso() const noexcept
+      { return this->do_is_sso(this->m_qstor);  }
+
+    const value_type*
+    sso_data() const noexcept
+      {
+        size_t off = (this->do_sso_tag_offset() == 0) ? 1 : 0;
+        return reinterpret_cast<const value_type*>(this->do_sso_bytes() + off);
+      }
+
+    value_type*
+    sso_mut_data() noexcept
+      {
+        size_t off = (this->do_sso_tag_offset() == 0) ? 1 : 0;
+        return reinterpret_cast<value_type*>(this->do_sso_bytes() + off);
+      }
+
     ROCKET_PURE
     bool
     unique() const noexcept
@@ -158,6 +217,8 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor)
           return false;
+        if(this->do_is_sso(qstor))
+          return true;
         return qstor->nref.unique();
       }
 
@@ -167,6 +228,8 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor)
           return 0;
+        if(this->do_is_sso(qstor))
+          return 1;
         return qstor->nref.get();
       }
 
@@ -177,6 +240,8 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor)
           return 0;
+        if(this->do_is_sso(qstor))
+          return sso_capacity;
         return storage::max_nchar_for_nblk(qstor->nblk);
       }
 
@@ -211,6 +276,9 @@ class storage_handle
     round_up_capacity(size_type res_arg) const
       {
         size_type cap = this->check_size_add(0, res_arg);
+        if(cap <= sso_capacity)
+          return sso_capacity;
+
         auto nblk = storage::min_nblk_for_nchar(cap);
         return storage::max_nchar_for_nblk(nblk);
       }
@@ -222,14 +290,17 @@ class storage_handle
         auto qstor = this->m_qstor;
         if(!qstor)
           return nullptr;
+        if(this->do_is_sso(qstor))
+          return this->sso_data();
         return qstor->data;
       }
 
     value_type*
     mut_data_opt() noexcept
       {
+        // Characters stored in place shall be accessed with `sso_mut_data()`.
         auto qstor = this->m_qstor;
-        if(!qstor || !qstor->nref.unique())
+        if(!qstor || this->do_is_sso(qstor) || !qstor->nref.unique())
           return nullptr;
         return qstor->data;
       }
@@ -242,6 +313,23 @@ class storage_handle
         // is copied from `src`. The second part is left uninitialized.
         size_type cap = this->check_size_add(len, add);
 
+        if(cap <= sso_capacity) {
+          // Store characters in place. `src` may point into the current
+          // storage, so they have to be copied before it is released. The
+          // tag bit is the least significant bit, regardless of byte order.
+          // Characters are combined arithmetically, as reading bytes that
+          // have just been written as a word would stall the pipeline.
+          uintptr_t bits = 1;
+          bool le = this->do_sso_tag_offset() == 0;
+          for(size_t k = 0;  k != len;  ++k)
+            bits |= static_cast<uintptr_t>(static_cast<unsigned char>(src[k]))
+                      << (le ? (k * 8 + 8) : (sizeof(bits) * 8 - 8 - k * 8));
+
+          this->do_reset(nullptr);
+          ::std::memcpy(&(this->m_qstor), &bits, sizeof(bits));
+          return this->sso_mut_data();
+        }
+
         // Allocate an array of `storage` large enough for a header + `cap`
         // instances of `value_type`.
         auto nblk = storage::min_nblk_for_nchar(cap);
@@ -266,11 +354,19 @@ class storage_handle
     deallocate() noexcept
       { this->do_reset(nullptr);  }
 
+    void
+    release_sso() noexcept
+      {
+        // Forget characters stored in place without reading them.
+        ROCKET_ASSERT(this->sso());
+        this->m_qstor = nullptr;
+      }
+
     void
     share_with(const storage_handle& other) noexcept
       {
         auto qstor = other.m_qstor;
-        if(qstor)
+        if(qstor && !this->do_is_sso(qstor))
           qstor->nref.increment();
         this->do_reset(qstor);
       }
@@ -0,0 +1,78 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#ifndef ROCKET_REFERENCE_COUNTER_
+#  error Please include <rocket/reference_counter.hpp> instead.
+#endif
+namespace details_reference_counter {
+
+// If `ROCKET_NONATOMIC_REFCOUNT` is defined, reference counters are plain
+// integers, and all reference-counted objects (strings, vectors, hashmaps and
+// `refcnt_ptr`s, and thus all values of a script) shall only be copied and
+// destroyed by the thread that has created them. This is checked in debug
+// builds.
+template<typename valueT>
+class nonatomic_counter
+  {
+  private:
+    valueT m_value;
+#ifdef ROCKET_DEBUG
+    ::pthread_t m_owner = ::pthread_self();
+#endif
+
+  public:
+    constexpr
+    nonatomic_counter(valueT value) noexcept
+      :
+        m_value(value)
+      { }
+
+  private:
+    void
+    do_check_thread() const noexcept
+      {
+#ifdef ROCKET_DEBUG
+        ROCKET_ASSERT_MSG(::pthread_equal(this->m_owner, ::pthread_self()),
+            "reference counter accessed from a foreign thread");
+#endif
+      }
+
+  public:
+    valueT
+    load(memory_order) const noexcept
+      {
+        this->do_check_thread();
+        return this->m_value;
+      }
+
+    bool
+    compare_exchange_weak(valueT& cmp, valueT xchg, memory_order) noexcept
+      {
+        this->do_check_thread();
+        if(this->m_value != cmp)
+          return cmp = this->m_value, false;
+
+        this->m_value = xchg;
+        return true;
+      }
+
+    valueT
+    fetch_add(valueT add, memory_order) noexcept
+      {
+        this->do_check_thread();
+        valueT old = this->m_value;
+        this->m_value = old + add;
+        return old;
+      }
+
+    valueT
+    fetch_sub(valueT sub, memory_order) noexcept
+      {
+        this->do_check_thread();
+        valueT old = this->m_value;
+        this->m_value = old - sub;
+        return old;
+      }
+  };
+
+}  // namespace details_reference_counter
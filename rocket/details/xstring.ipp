@@ -310,4 +310,106 @@ ymempcpy(wchar_t* out, const wchar_t* str, size_t len) noexcept
     return (wchar_t*) ::memcpy(out, str, len * sizeof(wchar_t)) + len;
   }
 
+inline
+uint32_t
+ymemhash_fnv1a(const unsigned char* bptr, size_t size) noexcept
+  {
+    // Implement the FNV-1a hashing algorithm.
+    uint32_t reg = 2166136261U;
+    for(size_t k = 0;  k != size;  ++k)
+      reg = (reg ^ bptr[k]) * 16777619U;
+    return reg;
+  }
+
+inline
+uint64_t
+ymemhash_r32(const unsigned char* bptr) noexcept
+  {
+    uint32_t word;
+    ::memcpy(&word, bptr, 4);
+    return ROCKET_LETOH32(word);
+  }
+
+inline
+uint64_t
+ymemhash_r64(const unsigned char* bptr) noexcept
+  {
+    uint64_t word;
+    ::memcpy(&word, bptr, 8);
+    return ROCKET_LETOH64(word);
+  }
+
+inline
+uint64_t
+ymemhash_mix(uint64_t x, uint64_t y) noexcept
+  {
+    uint64_t lo;
+    uint64_t hi = noadl::mulh128(x, y, &lo);
+    return lo ^ hi;
+  }
+
+inline
+uint32_t
+ymemhash_wyhash(const unsigned char* bptr, size_t size) noexcept
+  {
+    // Implement the wyhash algorithm (final version 4) with a zero seed. Long
+    // strings are consumed 48 bytes at a time in three independent lanes. See
+    // https://github.com/wangyi-fudan/wyhash.
+    constexpr uint64_t s0 = 0xA0761D6478BD642FULL;
+    constexpr uint64_t s1 = 0xE7037ED1A0B428DBULL;
+    constexpr uint64_t s2 = 0x8EBC6AF09C88C6E3ULL;
+    constexpr uint64_t s3 = 0x589965CC75374CC3ULL;
+
+    uint64_t seed = ymemhash_mix(s0, s1);
+    uint64_t a, b;
+
+    if(size <= 16) {
+      if(size >= 4) {
+        // Read two overlapping pairs of 32-bit words.
+        size_t off = size / 8 * 4;
+        a = ymemhash_r32(bptr) << 32 | ymemhash_r32(bptr + off);
+        b = ymemhash_r32(bptr + size - 4) << 32 | ymemhash_r32(bptr + size - 4 - off);
+      }
+      else if(size != 0) {
+        a = (uint64_t) bptr[0] << 16 | (uint64_t) bptr[size / 2] << 8 | bptr[size - 1];
+        b = 0;
+      }
+      else
+        a = b = 0;
+    }
+    else {
+      const unsigned char* p = bptr;
+      size_t n = size;
+
+      if(n > 48) {
+        uint64_t see1 = seed, see2 = seed;
+        do {
+          seed = ymemhash_mix(ymemhash_r64(p) ^ s1, ymemhash_r64(p + 8) ^ seed);
+          see1 = ymemhash_mix(ymemhash_r64(p + 16) ^ s2, ymemhash_r64(p + 24) ^ see1);
+          see2 = ymemhash_mix(ymemhash_r64(p + 32) ^ s3, ymemhash_r64(p + 40) ^ see2);
+          p += 48;
+          n -= 48;
+        }
+        while(n > 48);
+        seed ^= see1 ^ see2;
+      }
+
+      while(n > 16) {
+        seed = ymemhash_mix(ymemhash_r64(p) ^ s1, ymemhash_r64(p + 8) ^ seed);
+        p += 16;
+        n -= 16;
+      }
+
+      // Read the last 16 bytes, which may overlap with previous ones.
+      a = ymemhash_r64(p + n - 16);
+      b = ymemhash_r64(p + n - 8);
+    }
+
+    a ^= s1;
+    b ^= seed;
+    b = noadl::mulh128(a, b, &a);
+    uint64_t h = ymemhash_mix(a ^ s0 ^ size, b ^ s1);
+    return (uint32_t) (h ^ h >> 32);
+  }
+
 }  // namespace details_xstring
@@ -8,8 +8,15 @@
 #include "xassert.hpp"
 #include <atomic>  // std::atomic<>
 #include <exception>  // std::terminate()
+#if defined(ROCKET_NONATOMIC_REFCOUNT) && defined(ROCKET_DEBUG)
+#  include <pthread.h>  // ::pthread_self()
+#endif
 namespace rocket {
 
+#ifdef ROCKET_NONATOMIC_REFCOUNT
+#  include "details/reference_counter.ipp"
+#endif
+
 template<typename valueT = int>
 class reference_counter
   {
@@ -20,7 +27,12 @@ class reference_counter
     using value_type  = valueT;
 
   private:
+#ifdef ROCKET_NONATOMIC_REFCOUNT
+    // See 'details/reference_counter.ipp' for the threading contract.
+    details_reference_counter::nonatomic_counter<value_type> m_nref;
+#else
     ::std::atomic<value_type> m_nref;
+#endif
 
   public:
     constexpr
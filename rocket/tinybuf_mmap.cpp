@@ -0,0 +1,159 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "tinybuf_mmap.hpp"
+#include "unique_posix_fd.hpp"
+#include <sys/mman.h>  // ::mmap(), ::munmap(), ::madvise()
+#include <sys/stat.h>  // ::fstat()
+#include <fcntl.h>  // ::open()
+#include <errno.h>  // errno
+namespace rocket {
+
+tinybuf_mmap::
+~tinybuf_mmap()
+  {
+    this->close();
+  }
+
+tinybuf_mmap&
+tinybuf_mmap::
+open(const char* path)
+  {
+    unique_posix_fd fd(::open(path, O_RDONLY), ::close);
+    if(!fd)
+      noadl::sprintf_and_throw<runtime_error>(
+          "tinybuf_mmap: `open()` failed (path `%s`, errno `%d`)",
+          path, errno);
+
+    return this->open(fd.get());
+  }
+
+tinybuf_mmap&
+tinybuf_mmap::
+open(int fd)
+  {
+    struct ::stat st;
+    if(::fstat(fd, &st) != 0)
+      noadl::sprintf_and_throw<runtime_error>(
+          "tinybuf_mmap: `fstat()` failed (fd `%d`, errno `%d`)",
+          fd, errno);
+
+    // Only regular files can be mapped. Empty files are not mapped, as
+    // mappings shall not be empty, and some pseudo files report zero sizes
+    // despite having contents.
+    if(S_ISREG(st.st_mode) && (st.st_size > 0)) {
+      if(static_cast<uint64_t>(st.st_size) > PTRDIFF_MAX)
+        noadl::sprintf_and_throw<out_of_range>(
+            "tinybuf_mmap: file too large (fd `%d`, size `%lld`)",
+            fd, static_cast<long long>(st.st_size));
+
+      size_t size = static_cast<size_t>(st.st_size);
+      void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(addr == MAP_FAILED)
+        noadl::sprintf_and_throw<runtime_error>(
+            "tinybuf_mmap: `mmap()` failed (fd `%d`, size `%zu`, errno `%d`)",
+            fd, size, errno);
+
+      // This is only a hint, so errors are ignored.
+      ::madvise(addr, size, MADV_SEQUENTIAL);
+
+      this->close();
+      this->m_data = static_cast<const char*>(addr);
+      this->m_size = size;
+      this->m_mapped = size;
+      return *this;
+    }
+
+    return this->load(fd);
+  }
+
+tinybuf_mmap&
+tinybuf_mmap::
+load(int fd)
+  {
+    // Read all contents into memory. The size of a regular file is only a
+    // hint, as it may change while it is being read.
+    cow_string str;
+    struct ::stat st;
+    if((::fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)
+       && (static_cast<uint64_t>(st.st_size) < PTRDIFF_MAX / 2))
+      str.reserve(static_cast<size_t>(st.st_size) + 0x10000);
+
+    for(;;) {
+      size_t off = str.size();
+      size_t nbatch = noadl::max(str.capacity() - off, static_cast<size_t>(0x10000));
+      str.append(nbatch, '\0');
+      ::ssize_t nread = ::read(fd, str.mut_data() + off, nbatch);
+      if((nread < 0) && (errno != EINTR))
+        noadl::sprintf_and_throw<runtime_error>(
+            "tinybuf_mmap: `read()` failed (fd `%d`, errno `%d`)",
+            fd, errno);
+
+      str.erase(off + ((nread > 0) ? static_cast<size_t>(nread) : 0));
+      if(nread == 0)
+        break;
+    }
+
+    this->close();
+    this->m_str = ::std::move(str);
+    this->m_data = this->m_str.data();
+    this->m_size = this->m_str.size();
+    return *this;
+  }
+
+tinybuf_mmap&
+tinybuf_mmap::
+close() noexcept
+  {
+    if(this->m_mapped)
+      ::munmap(const_cast<char*>(this->m_data), this->m_mapped);
+
+    this->m_data = nullptr;
+    this->m_size = 0;
+    this->m_off = 0;
+    this->m_mapped = 0;
+    this->m_str.clear();
+    return *this;
+  }
+
+tinybuf_mmap&
+tinybuf_mmap::
+seek(int64_t off, seek_dir dir)
+  {
+    int64_t orig, targ;
+
+    // Get the origin offset.
+    switch(dir) {
+      case tinybuf_base::seek_set:
+        orig = 0;
+        break;
+
+      case tinybuf_base::seek_cur:
+        orig = static_cast<int64_t>(this->m_off);
+        break;
+
+      case tinybuf_base::seek_end:
+        orig = static_cast<int64_t>(this->m_size);
+        break;
+
+      default:
+        noadl::sprintf_and_throw<invalid_argument>(
+            "tinybuf_mmap: seek direction `%d` not valid",
+            static_cast<int>(dir));
+    }
+
+    // Calculate the target offset.
+    if(ROCKET_ADD_OVERFLOW(orig, off, ::std::addressof(targ)))
+      noadl::sprintf_and_throw<out_of_range>(
+          "tinybuf_mmap: stream offset overflow (operands were `%lld` and `%lld`)",
+          static_cast<long long>(orig), static_cast<long long>(off));
+
+    if(targ < 0)
+      noadl::sprintf_and_throw<out_of_range>(
+          "tinybuf_mmap: seeking to negative offsets not allowed");
+
+    this->m_off = static_cast<size_t>(targ);
+    return *this;
+  }
+
+}  // namespace rocket
@@ -0,0 +1,145 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#ifndef ROCKET_TINYBUF_MMAP_
+#define ROCKET_TINYBUF_MMAP_
+
+#include "tinybuf.hpp"
+#include "cow_string.hpp"
+namespace rocket {
+
+// This is a read-only stream of a memory-mapped file. Characters can be read
+// through the `tinybuf` interface, but it is more efficient to access them
+// in place via `data()` and `size()`, or `gptr()` and `gavail()` for those
+// that have not been read. Only narrow characters are supported, as files
+// are mapped verbatim.
+class tinybuf_mmap
+  :
+    public tinybuf
+  {
+  private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_off = 0;
+    size_t m_mapped = 0;  // number of bytes to unmap
+    cow_string m_str;  // contents of files that cannot be mapped
+
+  public:
+    constexpr
+    tinybuf_mmap() noexcept
+      { }
+
+    explicit
+    tinybuf_mmap(const char* path)
+      {
+        this->open(path);
+      }
+
+    tinybuf_mmap(const tinybuf_mmap&) = delete;
+    tinybuf_mmap& operator=(const tinybuf_mmap&) & = delete;
+
+  public:
+    virtual
+    ~tinybuf_mmap() override;
+
+    // Checks whether the file has been mapped. If a file is not a regular
+    // file, such as a pipe or a terminal, it cannot be mapped, so its
+    // contents are read into memory instead.
+    bool
+    mapped() const noexcept
+      { return this->m_mapped != 0;  }
+
+    // Gets all characters of the file.
+    const char*
+    data() const noexcept
+      { return this->m_data;  }
+
+    size_t
+    size() const noexcept
+      { return this->m_size;  }
+
+    // Gets characters that have not been read.
+    const char*
+    gptr() const noexcept
+      { return this->m_data + noadl::min(this->m_off, this->m_size);  }
+
+    size_t
+    gavail() const noexcept
+      { return this->m_size - noadl::min(this->m_off, this->m_size);  }
+
+    // Marks some characters as read. `n` shall not be greater than
+    // `gavail()`.
+    tinybuf_mmap&
+    gbump(size_t n) noexcept
+      {
+        ROCKET_ASSERT(n <= this->gavail());
+        this->m_off += n;
+        return *this;
+      }
+
+    // Opens and maps a file for reading. Access to mapped pages is advised to
+    // be sequential.
+    tinybuf_mmap&
+    open(const char* path);
+
+    // Maps a file that has been opened for reading. The file descriptor is
+    // not closed, and may be closed as soon as this function returns. If the
+    // file is truncated by someone else while it is mapped, accessing pages
+    // past its new end raises `SIGBUS`.
+    tinybuf_mmap&
+    open(int fd);
+
+    // Reads all contents of a file that has been opened for reading into
+    // memory, without mapping it. This is safe even if the file is truncated
+    // while it is being read. The file descriptor is not closed.
+    tinybuf_mmap&
+    load(int fd);
+
+    // Closes the current file, if any.
+    tinybuf_mmap&
+    close() noexcept;
+
+    // Gets the current stream pointer.
+    virtual
+    int64_t
+    tell() const override
+      {
+        return static_cast<int64_t>(this->m_off);
+      }
+
+    // Adjusts the current stream pointer. It is valid to seek past the end,
+    // where nothing can be read.
+    virtual
+    tinybuf_mmap&
+    seek(int64_t off, seek_dir dir) override;
+
+    // Reads some characters from the stream. If the end of stream has been
+    // reached, zero is returned.
+    virtual
+    size_t
+    getn(char* s, size_t n) override
+      {
+        if(this->m_off >= this->m_size)
+          return 0;
+
+        size_t r = noadl::min(n, this->m_size - this->m_off);
+        noadl::xmempcpy(s, this->m_data + this->m_off, r);
+        this->m_off += r;
+        return r;
+      }
+
+    // Reads a single character from the stream. If the end of stream has been
+    // reached, `-1` is returned.
+    virtual
+    int
+    getc() override
+      {
+        if(this->m_off >= this->m_size)
+          return -1;
+
+        return noadl::int_from(this->m_data[this->m_off++]);
+      }
+  };
+
+}  // namespace rocket
+#endif
@@ -6,6 +6,9 @@
 
 #include "fwd.hpp"
 #include "xassert.hpp"
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
 namespace rocket {
 
 constexpr
@@ -35,5 +38,54 @@ linear_probe(bucketT* data, size_t to, size_t from, size_t size, predictorT&& pr
     return nullptr;
   }
 
+// Open-addressing hash tables may keep a control byte for each bucket, which
+// are probed in groups of `hash_group_size`. A bucket in use has the seven
+// bits from `hash_ctrl_h2()` of its key, so most keys that don't match can be
+// rejected without comparison.
+constexpr uint8_t hash_ctrl_empty = 0x80;
+constexpr uint8_t hash_ctrl_deleted = 0xFE;
+constexpr size_t hash_group_size = 16;
+
+constexpr
+uint8_t
+hash_ctrl_h2(size_t hval) noexcept
+  {
+    // These bits are independent of the ones that `probe_origin()` uses.
+    return (uint8_t) ((uint64_t) hval * 0x9E3779B97F4A7C15ULL >> 57);
+  }
+
+inline
+uint32_t
+hash_group_match(const uint8_t* ctrl, uint8_t byte) noexcept
+  {
+    // Get a mask of control bytes in this group which equal `byte`.
+#ifdef __SSE2__
+    __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(t, _mm_set1_epi8((char) byte)));
+#else
+    uint32_t mask = 0;
+    for(uint32_t k = 0;  k != hash_group_size;  ++k)
+      mask |= (uint32_t) (ctrl[k] == byte) << k;
+    return mask;
+#endif
+  }
+
+inline
+uint32_t
+hash_group_match_free(const uint8_t* ctrl) noexcept
+  {
+    // Get a mask of buckets in this group which are not in use, whose control
+    // bytes have their most significant bits set.
+#ifdef __SSE2__
+    __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return (uint32_t) _mm_movemask_epi8(t);
+#else
+    uint32_t mask = 0;
+    for(uint32_t k = 0;  k != hash_group_size;  ++k)
+      mask |= (uint32_t) (ctrl[k] >> 7) << k;
+    return mask;
+#endif
+  }
+
 }  // namespace rocket
 #endif
@@ -3,6 +3,7 @@
 
 #include "xmemory.hpp"
 #include "atomic.hpp"
+#include <pthread.h>
 namespace rocket {
 namespace {
 
@@ -19,16 +20,158 @@ struct alignas(64) pool
 
 pool s_pools[64];
 
+// Each thread has a magazine for each size class in front of the global pool,
+// which is accessed without atomic operations. A magazine is refilled from or
+// flushed to the global pool in batches.
+constexpr uint32_t magazine_capacity = 32;
+constexpr size_t magazine_max_block_size = 65536;
+constexpr size_t thread_cache_budget = 1048576;
+
+struct magazine
+  {
+    free_block* head;
+    uint32_t count;
+    uint64_t hits;
+    uint64_t misses;
+  };
+
+struct thread_cache
+  {
+    magazine mags[64];
+    size_t bytes;
+    bool registered;
+    bool exiting;
+  };
+
+// This is zero-initialized, so no guard is required for access.
+thread_local thread_cache s_tcache;
+
 inline
-pool&
-do_get_pool_for_size(size_t& rsize)
+uint32_t
+do_get_class_for_size(size_t& rsize)
   {
     uint64_t si64 = ::std::max(rsize, sizeof(free_block));
     uint32_t i = 64U - (uint32_t) ROCKET_LZCNT64(si64 - 1ULL);
     si64 = 1ULL << i;
     ROCKET_ASSERT(si64 >= rsize);
     rsize = (size_t) si64;
-    return s_pools[i];
+    return i;
+  }
+
+inline
+void
+do_push_chain(pool& p, free_block* head, free_block* tail) noexcept
+  {
+    tail->next = p.head.load();
+    while(!p.head.cmpxchg_weak(tail->next, head));
+  }
+
+void
+do_flush_magazine(uint32_t i, uint32_t keep) noexcept
+  {
+    auto& m = s_tcache.mags[i];
+    if(m.count <= keep)
+      return;
+
+    // Detach all blocks but the first `keep` ones, and return them to the
+    // global pool with a single operation.
+    free_block* head = m.head;
+    free_block* last_kept = nullptr;
+    for(uint32_t k = 0;  k != keep;  ++k)
+      last_kept = exchange(head, head->next);
+
+    free_block* tail = head;
+    while(tail->next != nullptr)
+      tail = tail->next;
+
+    if(last_kept)
+      last_kept->next = nullptr;
+    else
+      m.head = nullptr;
+
+    s_tcache.bytes -= (size_t) (m.count - keep) << i;
+    m.count = keep;
+    do_push_chain(s_pools[i], head, tail);
+  }
+
+void
+do_flush_thread_cache() noexcept
+  {
+    for(uint32_t i = 0;  i != 64;  ++i)
+      do_flush_magazine(i, 0);
+  }
+
+// Cached blocks are returned to the global pools upon thread exit. A thread-
+// specific key is used, because registering a destructor for a `thread_local`
+// object may allocate memory. Destructors of other keys may still free memory
+// after this one, so the thread cache is disabled when it has been flushed.
+::pthread_once_t s_tkey_once = PTHREAD_ONCE_INIT;
+::pthread_key_t s_tkey;
+
+void
+do_exit_thread_cache(void*) noexcept
+  {
+    s_tcache.exiting = true;
+    do_flush_thread_cache();
+  }
+
+void
+do_create_thread_key() noexcept
+  {
+    ::pthread_key_create(&s_tkey, do_exit_thread_cache);
+  }
+
+ROCKET_NEVER_INLINE
+void
+do_register_thread_cache() noexcept
+  {
+    ::pthread_once(&s_tkey_once, do_create_thread_key);
+    ::pthread_setspecific(s_tkey, &s_tcache);
+    s_tcache.registered = true;
+  }
+
+ROCKET_NEVER_INLINE
+free_block*
+do_refill_magazine(uint32_t i, size_t rsize) noexcept
+  {
+    // A thread that only allocates memory shall also return its magazines
+    // upon exit.
+    if(ROCKET_UNEXPECT(!s_tcache.registered))
+      do_register_thread_cache();
+
+    // Take the entire chain from the global pool, so other threads can't
+    // interfere. The first block is returned to the caller.
+    auto& p = s_pools[i];
+    free_block* b = p.head.xchg(nullptr);
+    if(b == nullptr)
+      return nullptr;
+
+    // Keep as many blocks as allowed in the magazine.
+    auto& m = s_tcache.mags[i];
+    free_block* rest = b->next;
+    b->next = nullptr;
+    while((rest != nullptr) && !s_tcache.exiting && (m.count < magazine_capacity / 2)
+          && (s_tcache.bytes + rsize <= thread_cache_budget)) {
+      m.head = exchange(rest, exchange(rest->next, m.head));
+      m.count ++;
+      s_tcache.bytes += rsize;
+    }
+
+    // Put the remaining blocks back without walking them, as the chain may be
+    // very long. Blocks that have been pushed in the meantime are returned,
+    // and are pushed again. This chain is short, as it has been built while
+    // the global pool was detached.
+    if(rest != nullptr) {
+      free_block* other = p.head.xchg(rest);
+      if(other != nullptr) {
+        free_block* tail = other;
+        while(tail->next != nullptr)
+          tail = tail->next;
+
+        do_push_chain(p, other, tail);
+      }
+    }
+    return b;
   }
 
 }  // namespace
@@ -41,9 +184,26 @@ xmemalloc(xmeminfo& info, xmemopt opt)
       throw ::std::bad_alloc();
 
     free_block* b = nullptr;
-    auto& p = do_get_pool_for_size(rsize);
+    uint32_t i = do_get_class_for_size(rsize);
+    auto& p = s_pools[i];
 
-    if(opt == xmemopt_use_cache) {
+    if((opt == xmemopt_use_cache) && (rsize <= magazine_max_block_size)) {
+      // Get a block from the magazine of this thread.
+      auto& m = s_tcache.mags[i];
+      b = m.head;
+      if(ROCKET_EXPECT(b != nullptr)) {
+        m.head = b->next;
+        m.count --;
+        m.hits ++;
+        s_tcache.bytes -= rsize;
+        b->next = nullptr;
+      }
+      else {
+        m.misses ++;
+        b = do_refill_magazine(i, rsize);
+      }
+    }
+    else if(opt == xmemopt_use_cache) {
       // Get a block from the cache.
       b = p.head.xchg(nullptr);
       if(ROCKET_EXPECT(b != nullptr) && (b->next != nullptr))
@@ -51,6 +211,7 @@ xmemalloc(xmeminfo& info, xmemopt opt)
     }
     else if(opt == xmemopt_clear_cache) {
       // Extract all blocks.
+      do_flush_magazine(i, 0);
       b = p.head.xchg(nullptr);
     }
 
@@ -76,7 +237,8 @@ xmemfree(xmeminfo& info, xmemopt opt) noexcept
       return;
 
     size_t rsize = info.element_size * info.count;
-    auto& p = do_get_pool_for_size(rsize);
+    uint32_t i = do_get_class_for_size(rsize);
+    auto& p = s_pools[i];
 
 #ifdef ROCKET_DEBUG
     ::memset(b, 0xCB, rsize);
@@ -84,14 +246,37 @@ xmemfree(xmeminfo& info, xmemopt opt) noexcept
     b->size = rsize;
     b->next = nullptr;
 
-    if(opt == xmemopt_use_cache) {
+    if((opt == xmemopt_use_cache) && (rsize <= magazine_max_block_size)
+       && ROCKET_EXPECT(!s_tcache.exiting)) {
+      // If the magazine of this thread is full, or the budget is exceeded,
+      // return half of it to the global pool.
+      if(ROCKET_UNEXPECT(!s_tcache.registered))
+        do_register_thread_cache();
+
+      auto& m = s_tcache.mags[i];
+      if((m.count >= magazine_capacity) || (s_tcache.bytes + rsize > thread_cache_budget))
+        do_flush_magazine(i, m.count / 2);
+
+      if(s_tcache.bytes + rsize <= thread_cache_budget) {
+        // Put the block into the magazine.
+        b->next = m.head;
+        m.head = b;
+        m.count ++;
+        s_tcache.bytes += rsize;
+      }
+      else
+        do_push_chain(p, b, b);
+
+      b = nullptr;
+    }
+    else if(opt == xmemopt_use_cache) {
       // Put the block into the cache.
-      b->next = p.head.load();
-      while(!p.head.cmpxchg_weak(b->next, b));
+      do_push_chain(p, b, b);
       b = nullptr;
     }
     else if(opt == xmemopt_clear_cache) {
       // Append all blocks from the cache to `b`.
+      do_flush_magazine(i, 0);
       b->next = p.head.xchg(nullptr);
     }
 
@@ -103,6 +288,8 @@ xmemfree(xmeminfo& info, xmemopt opt) noexcept
 void
 xmemclean() noexcept
   {
+    do_flush_thread_cache();
+
     for(auto& p : s_pools) {
       // Extract all blocks.
       free_block* b = p.head.xchg(nullptr);
@@ -113,4 +300,14 @@ xmemclean() noexcept
     }
   }
 
+void
+xmemstat(xmemstats& stats, uint32_t index) noexcept
+  {
+    const auto& m = s_tcache.mags[index % 64];
+    stats.block_size = (size_t) 1 << (index % 64);
+    stats.hits = m.hits;
+    stats.misses = m.misses;
+    stats.bytes_cached = (size_t) m.count << (index % 64);
+  }
+
 }  // namespace rocket
@@ -36,10 +36,26 @@ xmemalloc(xmeminfo& info, xmemopt opt = xmemopt_use_cache);
 void
 xmemfree(xmeminfo& info, xmemopt opt = xmemopt_use_cache) noexcept;
 
-// Clears the global cache.
+// Clears the global cache, as well as the cache of the calling thread.
+// Caches of other threads are not affected.
 void
 xmemclean() noexcept;
 
+struct xmemstats
+  {
+    size_t block_size;
+    uint64_t hits;
+    uint64_t misses;
+    size_t bytes_cached;
+  };
+
+// Gets statistics about the cache of the calling thread. `index` is the base-2
+// logarithm of the block size, and shall be less than 64. Large blocks, and
+// blocks which are allocated or freed with `xmemopt_bypass_cache`, are not
+// counted.
+void
+xmemstat(xmemstats& stats, uint32_t index) noexcept;
+
 // Copies a block into another, with some checking.
 inline
 void
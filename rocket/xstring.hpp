@@ -151,5 +151,20 @@ xmemrpcpy(charT*& out, const typename identity<charT>::type* str, size_t len) no
     return out = noadl::xmempcpy(out, str, len);
   }
 
+template<typename charT>
+ROCKET_PURE inline
+uint32_t
+xmemhash(const charT* str, size_t len) noexcept
+  {
+    // Hash values are only stable within the same process. FNV-1a, which is
+    // slower but portable, may be selected by defining `ROCKET_FNV1A_HASH`.
+    auto bptr = reinterpret_cast<const unsigned char*>(str);
+#ifdef ROCKET_FNV1A_HASH
+    return details_xstring::ymemhash_fnv1a(bptr, len * sizeof(charT));
+#else
+    return details_xstring::ymemhash_wyhash(bptr, len * sizeof(charT));
+#endif
+  }
+
 }  // namespace rocket
 #endif
@@ -0,0 +1,46 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/library/checksum.hpp"
+#include "../asteria/library/filesystem.hpp"
+#include <zlib.h>
+using namespace ::asteria;
+
+int main()
+  {
+    // Repeat the contents of 'checksum.txt' to make 16 MiB of data.
+    cow_string path = sref(__FILE__);
+    path.erase(path.rfind('/') + 1);
+    path += "checksum.txt";
+    cow_string text = std_filesystem_read(path, nullopt, nullopt);
+    ASTERIA_TEST_CHECK(text.size() != 0);
+
+    cow_string data;
+    while(data.size() < 16777216)
+      data += text;
+
+    // Results must match zlib for any length and alignment.
+    size_t nmismatches = 0;
+    for(size_t off = 0;  off != 16;  ++off)
+      for(size_t len = 0;  len != 300;  ++len) {
+        auto ref = ::crc32_z(0, (const ::Byte*) data.data() + off, len);
+        if(std_checksum_crc32(data.substr(off, len)) != (int64_t) ref)
+          nmismatches ++;
+      }
+    ASTERIA_TEST_CHECK(nmismatches == 0);
+
+    double zlib = asteria_test_mib_per_sec(data.size(), 8,
+        [&] { (void) ::crc32_z(0, (const ::Byte*) data.data(), data.size());  });
+    double crc32 = asteria_test_mib_per_sec(data.size(), 8,
+        [&] { (void) std_checksum_crc32(data);  });
+    double md5 = asteria_test_mib_per_sec(data.size(), 2,
+        [&] { (void) std_checksum_md5(data);  });
+    double sha1 = asteria_test_mib_per_sec(data.size(), 2,
+        [&] { (void) std_checksum_sha1(data);  });
+    double sha256 = asteria_test_mib_per_sec(data.size(), 2,
+        [&] { (void) std_checksum_sha256(data);  });
+
+    ::printf("checksum: MiB/s: crc32_z = %.1f, crc32 = %.1f, md5 = %.1f, sha1 = %.1f, sha256 = %.1f\n",
+             zlib, crc32, md5, sha1, sha256);
+  }
@@ -0,0 +1,226 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/value.hpp"
+#include <unordered_map>
+#include <vector>
+#include <stdexcept>
+using namespace ::asteria;
+
+// This is a model of the previous layout of `cow_hashmap`, whose buckets
+// were pointers to elements which were allocated one by one. Keys were found
+// by linear probing, and tables were kept at most half full.
+class old_layout_map
+  {
+  private:
+    using element = pair<phsh_string, Value>;
+
+    element** m_bkts = nullptr;
+    size_t m_nbkt = 0;
+    size_t m_nelem = 0;
+
+  public:
+    old_layout_map() noexcept = default;
+
+    old_layout_map(old_layout_map&& other) noexcept
+      :
+        m_bkts(::std::exchange(other.m_bkts, nullptr)),
+        m_nbkt(::std::exchange(other.m_nbkt, 0U)),
+        m_nelem(::std::exchange(other.m_nelem, 0U))
+      { }
+
+    old_layout_map&
+    operator=(old_layout_map&& other) & noexcept
+      {
+        ::std::swap(this->m_bkts, other.m_bkts);
+        ::std::swap(this->m_nbkt, other.m_nbkt);
+        ::std::swap(this->m_nelem, other.m_nelem);
+        return *this;
+      }
+
+    ~old_layout_map()
+      {
+        for(size_t k = 0;  k != this->m_nbkt;  ++k)
+          delete this->m_bkts[k];
+        delete[] this->m_bkts;
+      }
+
+  private:
+    element**
+    do_probe(element** bkts, size_t nbkt, const phsh_string& key) const noexcept
+      {
+        size_t k = ::rocket::probe_origin(nbkt, key.rdhash());
+        while(bkts[k] && (bkts[k]->first != key))
+          k = (k + 1) % nbkt;
+        return bkts + k;
+      }
+
+  public:
+    bool
+    try_emplace(const phsh_string& key, const Value& value)
+      {
+        if(this->m_nelem >= this->m_nbkt / 2) {
+          // Move pointers to a larger table, like `17 | cap / 2` did.
+          size_t nbkt = (this->m_nelem + (17 | this->m_nbkt / 4)) * 2;
+          auto bkts = new element*[nbkt]();
+          for(size_t k = 0;  k != this->m_nbkt;  ++k)
+            if(this->m_bkts[k])
+              *(this->do_probe(bkts, nbkt, this->m_bkts[k]->first)) = this->m_bkts[k];
+          delete[] ::std::exchange(this->m_bkts, bkts);
+          this->m_nbkt = nbkt;
+        }
+
+        auto qbkt = this->do_probe(this->m_bkts, this->m_nbkt, key);
+        if(*qbkt)
+          return false;
+
+        *qbkt = new element(key, value);
+        this->m_nelem ++;
+        return true;
+      }
+
+    const Value&
+    at(const phsh_string& key) const
+      {
+        auto qbkt = this->do_probe(this->m_bkts, this->m_nbkt, key);
+        if(!*qbkt)
+          throw ::std::out_of_range("old_layout_map: key not found");
+        return (*qbkt)->second;
+      }
+  };
+
+template<typename FuncT>
+static
+double
+measure_ns_per_op(size_t nops, FuncT&& func)
+  {
+    return asteria_test_measure(1, func) * 1.0e9 / (double) nops;
+  }
+
+int main()
+  {
+    // Elements survive erasure of others, copies and clearing.
+    V_object obj;
+    for(int64_t k = 0;  k != 1000;  ++k)
+      obj.try_emplace(phsh_string(format_string("key$1", k)), k);
+    ASTERIA_TEST_CHECK(obj.size() == 1000);
+    ASTERIA_TEST_CHECK(obj.size() <= obj.capacity());
+
+    V_object copy = obj;
+    for(int64_t k = 0;  k != 1000;  k += 2)
+      ASTERIA_TEST_CHECK(obj.erase(phsh_string(format_string("key$1", k))));
+    ASTERIA_TEST_CHECK(obj.size() == 500);
+    ASTERIA_TEST_CHECK(copy.size() == 1000);
+
+    size_t nbad = 0;
+    for(int64_t k = 0;  k != 1000;  ++k) {
+      auto qval = obj.ptr(phsh_string(format_string("key$1", k)));
+      nbad += (k % 2 == 0) ? (qval != nullptr) : (!qval || (qval->as_integer() != k));
+      nbad += copy.at(phsh_string(format_string("key$1", k))).as_integer() != k;
+    }
+    ASTERIA_TEST_CHECK(nbad == 0);
+
+    int64_t sum = 0;
+    for(auto it = obj.begin();  it != obj.end();  ++it)
+      sum += it->second.as_integer();
+    ASTERIA_TEST_CHECK(sum == 250000);
+
+    // Erasing elements while iterating doesn't skip any.
+    for(auto it = copy.mut_begin();  it != copy.end();  )
+      if(it->second.as_integer() % 3 == 0)
+        it = copy.erase(it);
+      else
+        ++it;
+    ASTERIA_TEST_CHECK(copy.size() == 666);
+
+    // Deleted buckets are reused.
+    for(int r = 0;  r != 100;  ++r)
+      for(int64_t k = 0;  k != 1000;  k += 2) {
+        obj.try_emplace(phsh_string(format_string("key$1", k)), k);
+        obj.erase(phsh_string(format_string("key$1", k)));
+      }
+    ASTERIA_TEST_CHECK(obj.size() == 500);
+
+    obj.clear();
+    ASTERIA_TEST_CHECK(obj.empty());
+    ASTERIA_TEST_CHECK(obj.begin() == obj.end());
+    ASTERIA_TEST_CHECK(copy.size() == 666);
+
+    // Compare objects with the previous layout, and with node-based maps,
+    // which allocate every element.
+    using node_map = ::std::unordered_map<phsh_string, Value, phsh_string::hash>;
+    constexpr size_t nobjs = 100000;
+    constexpr size_t nlookups = 4000000;
+
+    cow_vector<phsh_string> keys;
+    for(size_t k = 0;  k != 16;  ++k)
+      keys.emplace_back(format_string("field_$1", k));
+
+    for(size_t nfields : { 4U, 8U, 16U }) {
+      cow_vector<V_object> objs;
+      double ctor_flat = measure_ns_per_op(nobjs,
+          [&] {
+            for(size_t i = 0;  i != nobjs;  ++i) {
+              V_object o;
+              for(size_t k = 0;  k != nfields;  ++k)
+                o.try_emplace(keys[k], (int64_t) k);
+              objs.emplace_back(::std::move(o));
+            }
+          });
+
+      ::std::vector<old_layout_map> olds;
+      double ctor_old = measure_ns_per_op(nobjs,
+          [&] {
+            for(size_t i = 0;  i != nobjs;  ++i) {
+              old_layout_map m;
+              for(size_t k = 0;  k != nfields;  ++k)
+                m.try_emplace(keys[k], (int64_t) k);
+              olds.emplace_back(::std::move(m));
+            }
+          });
+
+      ::std::vector<node_map> maps;
+      double ctor_node = measure_ns_per_op(nobjs,
+          [&] {
+            for(size_t i = 0;  i != nobjs;  ++i) {
+              node_map m;
+              for(size_t k = 0;  k != nfields;  ++k)
+                m.emplace(keys[k], (int64_t) k);
+              maps.emplace_back(::std::move(m));
+            }
+          });
+
+      // Look up fields via const references, so nothing is copied.
+      const auto& cobjs = objs;
+      const auto& colds = olds;
+      const auto& cmaps = maps;
+      int64_t sum_flat = 0;
+      double find_flat = measure_ns_per_op(nlookups,
+          [&] {
+            for(size_t i = 0;  i != nlookups;  ++i)
+              sum_flat += cobjs[i % nobjs].at(keys[i % nfields]).as_integer();
+          });
+
+      int64_t sum_old = 0;
+      double find_old = measure_ns_per_op(nlookups,
+          [&] {
+            for(size_t i = 0;  i != nlookups;  ++i)
+              sum_old += colds[i % nobjs].at(keys[i % nfields]).as_integer();
+          });
+
+      int64_t sum_node = 0;
+      double find_node = measure_ns_per_op(nlookups,
+          [&] {
+            for(size_t i = 0;  i != nlookups;  ++i)
+              sum_node += cmaps[i % nobjs].at(keys[i % nfields]).as_integer();
+          });
+
+      ASTERIA_TEST_CHECK(sum_flat == sum_old);
+      ASTERIA_TEST_CHECK(sum_flat == sum_node);
+
+      ::printf("cow_hashmap: ns per object (%zu fields): flat = %.1f, old = %.1f, node = %.1f\n"
+               "cow_hashmap: ns per lookup (%zu fields): flat = %.1f, old = %.1f, node = %.1f\n",
+               nfields, ctor_flat, ctor_old, ctor_node, nfields, find_flat, find_old, find_node);
+    }
+  }
@@ -0,0 +1,145 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include <new>
+using namespace ::asteria;
+
+// Count all allocations in this process.
+static size_t s_nallocs;
+
+void*
+operator new(size_t size)
+  {
+    s_nallocs ++;
+    void* ptr = ::malloc(size ? size : 1);
+    if(!ptr)
+      throw ::std::bad_alloc();
+    return ptr;
+  }
+
+void
+operator delete(void* ptr) noexcept
+  {
+    ::free(ptr);
+  }
+
+void
+operator delete(void* ptr, size_t) noexcept
+  {
+    ::free(ptr);
+  }
+
+template<typename FuncT>
+static
+size_t
+count_allocations(FuncT&& func)
+  {
+    size_t old = s_nallocs;
+    func();
+    return s_nallocs - old;
+  }
+
+int main()
+  {
+    ASTERIA_TEST_CHECK(sizeof(cow_string) == sizeof(void*) * 3);
+
+    // Short strings are stored in place.
+    cow_string s1(sref("hello"));
+    ASTERIA_TEST_CHECK(count_allocations([&] { s1 = cow_string("hello", 5);  }) == 0);
+    ASTERIA_TEST_CHECK(s1 == "hello");
+    ASTERIA_TEST_CHECK(s1.c_str()[5] == 0);
+    ASTERIA_TEST_CHECK(s1.unique());
+
+    cow_string s2 = s1;
+    s2.mut(0) = 'j';
+    ASTERIA_TEST_CHECK(s1 == "hello");
+    ASTERIA_TEST_CHECK(s2 == "jello");
+
+    cow_string s3 = ::std::move(s2);
+    s3.swap(s1);
+    ASTERIA_TEST_CHECK(s1 == "jello");
+    ASTERIA_TEST_CHECK(s3 == "hello");
+    ASTERIA_TEST_CHECK(s1.substr(1, 3) == "ell");
+    ASTERIA_TEST_CHECK(s1.substr(2) == "llo");
+
+    // They move to dynamic storage when they grow.
+    s1.append(" world!");
+    ASTERIA_TEST_CHECK(s1 == "jello world!");
+    s1.pop_back(7);
+    ASTERIA_TEST_CHECK(s1 == "jello");
+    s1.shrink_to_fit();
+    ASTERIA_TEST_CHECK(s1 == "jello");
+    ASTERIA_TEST_CHECK(s1.capacity() < 8);
+    s1.append(s1.data() + 1, 4);
+    ASTERIA_TEST_CHECK(s1 == "jelloello");
+
+    // A suffix of a destroyed string shall not overwrite its preceding
+    // characters.
+    cow_string s4 = cow_string(sref("hello world")).substr(6);
+    s4.append("!");
+    ASTERIA_TEST_CHECK(s4 == "world!");
+
+    // A string that has been assigned a shallow string shall not modify its
+    // old storage.
+    cow_string s5(sref("xyzw"));
+    s5.append("0123456789");
+    s5 = sref("abc");
+    s5.append("d");
+    ASTERIA_TEST_CHECK(s5 == "abcd");
+    s5 = sref("abc");
+    s5.mut(0) = 'k';
+    ASTERIA_TEST_CHECK(s5 == "kbc");
+
+    // Characters are appended in place as long as they fit, and a moved
+    // short string has to be accessed through its new object.
+    cow_string s6;
+    ASTERIA_TEST_CHECK(count_allocations([&] { s6.insert(s6.begin(), 4, '-');  }) == 0);
+    s6.append(2, '+');
+    ASTERIA_TEST_CHECK(s6 == "----++");
+    cow_string s7 = ::std::move(s6);
+    ASTERIA_TEST_CHECK(s7 == "----++");
+    ASTERIA_TEST_CHECK(s7.data() == &*(s7.begin()));
+    s7.insert(s7.begin() + 4, 40, '=');
+    ASTERIA_TEST_CHECK(s7.size() == 46);
+    ASTERIA_TEST_CHECK(s7.substr(42) == "==++");
+
+    // Count allocations in some string operations from 'string.cpp'.
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var text = "";
+        for(var i = 0;  i < 2000;  ++i)
+          text += std.string.format("$1,", i % 97);
+
+        var n = 0;
+        for(var r = 0;  r < 5;  ++r) {
+          var words = std.string.explode(text, ",");
+          for(each k, w -> words) {
+            var t = std.string.to_upper(w) + "x";
+            n += countof std.string.slice(t, 1);
+            n += countof std.string.padl(w, 4, "0");
+            n += countof std.string.trim("  " + w);
+          }
+          for(var i = 0;  i < countof text;  i += 7)
+            n += countof std.string.slice(text, i, 1);
+        }
+        return n;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+
+    Value result;
+    size_t nallocs = 0;
+    double secs = asteria_test_measure(1,
+        [&] {
+          nallocs = count_allocations([&] { result = code.execute().dereference_readonly();  });
+        });
+    ASTERIA_TEST_CHECK(result.as_integer() == 82060);
+
+    ::printf("cow_string: allocations in string workload = %zu, time = %.1f ms\n",
+             nallocs, secs * 1000);
+  }
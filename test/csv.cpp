@@ -3,6 +3,9 @@
 
 #include "utils.hpp"
 #include "../asteria/simple_script.hpp"
+#include <thread>
+#include <sys/stat.h>  // ::mkfifo()
+#include <fcntl.h>  // ::open()
 using namespace ::asteria;
 
 int main()
@@ -23,7 +26,79 @@ int main()
         assert rows[3] == [ 'a', 'nested', "line\nbreak", 'is', 'acceptable' ];
         assert rows[4] == [ 'a bc"d e"', '4' ];
 
+        var srows = [ ];
+        assert std.csv.stream_file(path, func(i, r) { assert i == countof srows;  srows[$] = r;  }) == 5;
+        assert srows == rows;
+
+        srows = [ ];
+        assert std.csv.stream_file(path, func(i, r) { srows[$] = r;  }, [ 3, 0, 9 ]) == 5;
+        assert srows[0] == [ null, '1', null ];
+        assert srows[1] == [ 'quote', 'value', null ];
+        assert srows[3] == [ 'is', 'a', null ];
+        assert srows[4] == [ null, 'a bc"d e"', null ];
+        assert catch( std.csv.stream_file(path, func(i, r) { }, [ -1 ]) ) != null;
+
+        const tmp_path = path + ".unmatched";
+        std.filesystem.write(tmp_path, "a,b\nc,\"d\n");
+        assert catch( std.csv.stream_file(tmp_path, func(i, r) { }) ) != null;
+        std.filesystem.remove_file(tmp_path);
+
+        // strings
+        assert std.csv.parse("") == [ ];
+        assert std.csv.parse("\xEF\xBB\xBFa,b\r\n\r\nc") == [ [ 'a', 'b' ], [ ], [ 'c' ] ];
+        assert std.csv.parse("\"x\r\n\r\ny\",z\n\"w\"") == [ [ "x\n\ny", 'z' ], [ 'w' ] ];
+        assert std.csv.parse("1,,\"\",\n") == [ [ '1', '', '', '' ] ];
+        assert catch( std.csv.parse("a,\"b\nc") ) != null;
+        assert catch( std.csv.parse("a,\"b\n") ) != null;
+
 ///////////////////////////////////////////////////////////////////////////////
       )__"));
     code.execute();
+
+    // Stream rows through a FIFO, which is read in chunks. A quoted cell with
+    // line breaks and a long line cross chunk boundaries.
+    cow_string text = sref("a,b\n\"");
+    for(int k = 0;  k != 3;  ++k)
+      text.append(70000, 'x').append("\r\n");
+    text += sref("y\"\"\",z\nc,");
+    text.append(150000, 'w');
+    text += sref("\n\"q\"\"r\",s\r\n");
+
+    char fifo[64];
+    ::snprintf(fifo, sizeof(fifo), "/tmp/asteria_csv_test_%d", (int) ::getpid());
+    ::unlink(fifo);
+    ASTERIA_TEST_CHECK(::mkfifo(fifo, 0600) == 0);
+
+    ::std::thread writer(
+        [&] {
+          int fd = ::open(fifo, O_WRONLY);
+          for(size_t off = 0;  off < text.size();  off += 4099)
+            if(::write(fd, text.data() + off, ::rocket::min(text.size() - off, (size_t) 4099)) < 0)
+              break;
+          ::close(fd);
+        });
+
+    Simple_Script fifo_code;
+    fifo_code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        const path = __varg(0);
+        const rows = std.csv.parse(__varg(1));
+        assert countof rows == 4;
+        assert countof rows[1][0] == 210005;
+
+        var srows = [ ];
+        assert std.csv.stream_file(path, func(i, r) { srows[$] = r;  }) == 4;
+        assert srows == rows;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+
+    cow_vector<Value> args;
+    args.emplace_back(cow_string(fifo));
+    args.emplace_back(text);
+    fifo_code.execute(::std::move(args));
+    writer.join();
+    ::unlink(fifo);
   }
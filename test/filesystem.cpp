@@ -90,6 +90,38 @@ int main()
         assert std.filesystem.stream(fname, appender, 2, 3) == 3;
         assert data == "lHE";
 
+        var offs = [ ];
+        var chunker = func(off, str) { offs[$] = off;  data += str;  };
+        data = "";
+        assert std.filesystem.stream(fname, chunker, null, null, { chunk_size: 3 }) == 10;
+        assert data == "helHE#??!!";
+        assert offs == [ 0, 3, 6, 9 ];
+        data = "";
+        offs = [ ];
+        assert std.filesystem.stream(fname, chunker, 1, null, { chunk_size: 4, mmap: true }) == 9;
+        assert data == "elHE#??!!";
+        assert offs == [ 1, 5, 9 ];
+        data = "";
+        assert std.filesystem.stream(fname, appender, 2, 3, { mmap: true }) == 3;
+        assert data == "lHE";
+        data = "";
+        assert std.filesystem.stream(fname, appender, 1000, null, { mmap: true }) == 0;
+        assert data == "";
+        assert catch( std.filesystem.stream(fname, appender, null, null, { chunk_size: 0 }) ) != null;
+
+        // If the file is truncated while it is mapped, streaming stops at its
+        // new end.
+        std.filesystem.write(fname + ".3", "0123456789abcdef" * 1536);
+        var truncator = func(off, str) { std.filesystem.write(fname + ".3", "");  };
+        assert std.filesystem.stream(fname + ".3", truncator, null, null, { chunk_size: 8192, mmap: true }) == 8192;
+        assert std.filesystem.remove_file(fname + ".3") == 1;
+
+        // Files in procfs report a size of zero, but they are not empty.
+        var nread = 0;
+        var counter = func(off, str) { nread += countof str;  };
+        assert std.filesystem.stream("/proc/self/status", counter, null, null, { mmap: true }) > 0;
+        assert nread > 0;
+
         assert catch( std.filesystem.create_directory(fname) ) != null;
         assert std.filesystem.remove_file(fname) == 1;
         assert std.filesystem.remove_file(fname) == 0;
@@ -0,0 +1,60 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include "../rocket/unique_posix_fd.hpp"
+#include <stdlib.h>  // ::mkstemp()
+using namespace ::asteria;
+
+int main()
+  {
+    // Create a temporary file of 64 MiB.
+    char path[] = "/tmp/.asteria-filesystem_benchmark-XXXXXX";
+    ::rocket::unique_posix_fd fd(::mkstemp(path));
+    ASTERIA_TEST_CHECK(fd);
+
+    cow_string chunk;
+    chunk.append(0x100000, 'x');
+    for(int k = 0;  k != 64;  ++k)
+      ASTERIA_TEST_CHECK(::write(fd, chunk.data(), chunk.size()) == (::ssize_t) chunk.size());
+
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        const path = __varg(0);
+        const size = __varg(1);
+
+        func measure(opts) {
+          var n = 0;
+          var t = std.chrono.hires_now();
+          for(var r = 0;  r < 4;  ++r)
+            n += std.filesystem.stream(path, func(off, data) { assert countof data != 0;  }, null, null, opts);
+          assert n == size * 4;
+          return n / 1048576.0 / (std.chrono.hires_now() - t) * 1000;
+        }
+
+        return [
+          measure(null),
+          measure({ chunk_size: 65536 }),
+          measure({ chunk_size: 1048576 }),
+          measure({ chunk_size: 65536, mmap: true }),
+          measure({ chunk_size: 1048576, mmap: true }),
+        ];
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+
+    cow_vector<Value> args;
+    args.emplace_back(cow_string(path));
+    args.emplace_back((int64_t) 0x4000000);
+    auto result = code.execute(::std::move(args)).dereference_readonly();
+    ::unlink(path);
+
+    const auto& r = result.as_array();
+    ::printf("filesystem.stream: MiB/s: default = %.1f, read 64KiB = %.1f, read 1MiB = %.1f, "
+             "mmap 64KiB = %.1f, mmap 1MiB = %.1f\n",
+             r[0].as_real(), r[1].as_real(), r[2].as_real(), r[3].as_real(), r[4].as_real());
+  }
@@ -0,0 +1,100 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // clear stack, push local, apply operator
+        var n = 0;
+        for(var i = 0;  i < 100;  ++i)
+          n += 3;
+        assert n == 300;
+        n <<= 2;
+        assert n == 1200;
+
+        // push local, apply operator
+        func sum(k) {
+          return (k <= 0) ? 0 : k + sum(k - 1);
+        }
+        assert sum(100) == 5050;
+
+        // push local, push local
+        var a = 5;
+        var b = 7;
+        assert a < b;
+        assert [ a, b ] == [ 5, 7 ];
+        var c = a;
+        c = b;
+        assert c == 7;
+
+        // errors
+        var m = 0x7FFFFFFFFFFFFFFF;
+        try {
+          m += 1;
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "overflow") != null;
+        assert m == 0x7FFFFFFFFFFFFFFF;
+
+        var s = "str";
+        assert catch( s - 1 ) != null;
+
+        func disp(x) {
+          switch(x) {
+          case 1:
+            var sth = 1;
+          case 2:
+            sth += 1;
+          }
+        }
+        assert catch( disp(2) ) != null;
+
+        // errors are reported at the node that has failed
+        func disp2(x) {
+          switch(x) {
+          case 1:
+            var p = 1;
+          case 2:
+            return [ p, x ];
+          case 3:
+            return [ x, p ];
+          }
+        }
+        var cols = [ ];
+        try { disp2(2);  }
+          catch(e) cols[$] = __backtrace[1].column;
+        try { disp2(3);  }
+          catch(e) cols[$] = __backtrace[1].column;
+        assert cols == [ 22, 25 ];
+
+        // member access chains
+        var o = { a: { b: { c: 1, d: null } }, e: 2 };
+        assert o.a.b.c == 1;
+        assert o.a.b.d.x.y == null;
+        assert o.a.x.y.z == null;
+        o.a.b.c += 5;
+        assert o.a.b.c == 6;
+        ref r -> o.a.b;
+        o.a.b = { c: 7 };
+        assert r.c == 7;
+
+        cols = [ ];
+        try { o.e.f.g;  }
+          catch(e) cols[$] = __backtrace[1].column;
+        try { o.a.b.c.d;  }
+          catch(e) cols[$] = __backtrace[1].column;
+        assert cols == [ 18, 22 ];
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+  }
@@ -0,0 +1,53 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(""
+      "const nkeep = 20000;"
+      "const nround = 50;"
+      R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Create variables that survive all collections.
+        var keep = [];
+        for(var i = 0;  i < nkeep;  ++i) {
+          var x = i;
+          keep[i] = func() { return x;  };
+        }
+        std.gc.collect();
+
+        // Create some garbage, then measure full collections.
+        var total = 0;
+        var nvars = 0;
+        for(var r = 0;  r < nround;  ++r) {
+          for(var i = 0;  i < 100;  ++i) {
+            var a, b;
+            a = func() { return b;  };
+            b = func() { return a;  };
+          }
+
+          var t = std.chrono.hires_now();
+          nvars += std.gc.collect();
+          total += std.chrono.hires_now() - t;
+        }
+
+        for(var i = 0;  i < nkeep;  ++i)
+          assert keep[i]() == i;
+
+        std.io.putf("gc: $1 tracked variables, $2 collected, $3 ms per collection\n",
+                    std.gc.count_variables(2), nvars, total / nround);
+        return nvars;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+
+    auto nvars = code.execute().dereference_readonly().as_integer();
+    ASTERIA_TEST_CHECK(nvars > 0);
+  }
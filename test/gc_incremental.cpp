@@ -0,0 +1,142 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include "../asteria/runtime/global_context.hpp"
+#include "../asteria/runtime/garbage_collector.hpp"
+#include "../asteria/runtime/variable.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    const auto gcoll = code.global().garbage_collector();
+    gcoll->set_incremental(true);
+    gcoll->set_step_quantum(3);
+    gcoll->set_threshold(gc_generation_newest, 20);
+    gcoll->set_threshold(gc_generation_middle, 20);
+    gcoll->set_threshold(gc_generation_oldest, 20);
+
+    // Variables are moved around while cycles are active.
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var keep = [];
+        var last;
+        for(var i = 0;  i < 2000;  ++i) {
+          var a, b;
+          a = func() { return b;  };
+          b = func() { return a;  };
+
+          var c = i;
+          keep[i % 10] = func() { return c;  };
+          last = keep[(i + 5) % 10];
+          assert keep[i % 10]() == i;
+        }
+
+        for(var i = 0;  i < 10;  ++i)
+          assert keep[i]() == 1990 + i;
+        assert last() == 1994;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+
+    // Containers that own variables are freed and allocated again between
+    // steps, so their addresses are likely to be reused.
+    gcoll->set_step_quantum(1);
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func make(n) {
+          var c = n;
+          return func() { return c;  };
+        }
+
+        var keep = [ make(-1) ];
+        for(var i = 0;  i < 3000;  ++i) {
+          var next = [ make(i), { f: keep[0], g: [ keep[0] ] } ];
+          for(var k = 0;  k < 6;  ++k)
+            next[$] = make(k);
+
+          // Don't let `next` share its array with `keep` when it dies.
+          keep = next;
+          next = null;
+
+          var a, b;
+          a = func() { return b;  };
+          b = func() { return a;  };
+          assert keep[0]() == i;
+          assert keep[1].g[0]() == (i == 0 ? -1 : i - 1);
+        }
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+
+    // Drive a cycle from the host.
+    gcoll->collect_variables();
+    gcoll->set_step_quantum(1);
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var x, y;
+        func fx() { return y;  }
+        func fy() { return x;  }
+        x = fy;
+        y = fx;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+
+    ASTERIA_TEST_CHECK(gcoll->is_incremental_cycle_active() == false);
+    gcoll->start_incremental_cycle(gc_generation_newest);
+    ASTERIA_TEST_CHECK(gcoll->is_incremental_cycle_active() == true);
+
+    size_t nvars = 0;
+    size_t nsteps = 0;
+    while(gcoll->is_incremental_cycle_active()) {
+      nvars += gcoll->step_incremental_cycle();
+      nsteps ++;
+    }
+    ASTERIA_TEST_CHECK(nvars == 4);  // x,y,fx,fy
+    ASTERIA_TEST_CHECK(nsteps > 4);
+
+    // Move the only reference to a closure out of a scanned variable. The
+    // captured variable must survive because of the write barrier.
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var c = 42;
+        return func() { return c;  };
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    auto holder = gcoll->create_variable();
+    holder->initialize(code.execute().dereference_readonly());
+    Value temp;
+
+    gcoll->start_incremental_cycle(gc_generation_newest);
+    while(holder->get_gc_barrier() == nullptr)
+      gcoll->step_incremental_cycle();
+
+    temp = holder->get_value();
+    holder->mut_value() = nullopt;
+    ASTERIA_TEST_CHECK(holder->get_gc_barrier() == nullptr);
+
+    nvars = 0;
+    while(gcoll->is_incremental_cycle_active())
+      nvars += gcoll->step_incremental_cycle();
+    ASTERIA_TEST_CHECK(nvars == 0);
+
+    temp = nullopt;
+    holder = nullptr;
+    gcoll->set_incremental(false);
+    ASTERIA_TEST_CHECK(gcoll->collect_variables() == 2);  // holder,c
+  }
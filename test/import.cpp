@@ -21,6 +21,26 @@ int main()
 
         assert catch( import("nonexistent file") ) != null;
 
+        // Compiled modules are reused until files are modified.
+        var s = std.system.module_cache_stats();
+        for(var i = 0;  i < 100;  ++i)
+          assert import("import_sub.txt", i, 1) == i - 1;
+        var t = std.system.module_cache_stats();
+        assert t.hits - s.hits == 100;
+        assert t.misses == s.misses;
+
+        const path = __file + ".tmp";
+        std.filesystem.write(path, "return 1;");
+        assert import(path) == 1;
+        assert import(path) == 1;
+        std.filesystem.write(path, "return 42;");
+        assert import(path) == 42;
+        std.filesystem.remove_file(path);
+        s = std.system.module_cache_stats();
+        assert s.hits - t.hits == 1;
+        assert s.misses - t.misses == 2;
+        assert s.size == t.size + 1;
+
         try {
           import("import_recursive.txt");
           assert false;
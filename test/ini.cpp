@@ -21,6 +21,16 @@ int main()
         assert obj.section1."some crazy" == "spaces";
         assert obj.section2."key without a value" == "";
 
+        // strings
+        const str = std.ini.parse("\xEF\xBB\xBFa = 1 ; c\r\n\r\n[ s ]\r\n  b\t=\t x y #z\r\nc\r\n");
+        assert str.a == "1";
+        assert str." s ".b == "x y";
+        assert str." s ".c == "";
+        assert countof str == 2;
+        assert catch( std.ini.parse("[s") ) != null;
+        assert catch( std.ini.parse("[ ]") ) != null;
+        assert catch( std.ini.parse(" = 1") ) != null;
+
 ///////////////////////////////////////////////////////////////////////////////
       )__"));
     code.execute();
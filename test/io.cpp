@@ -0,0 +1,47 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include <stdio.h>
+using namespace ::asteria;
+
+int main()
+  {
+    // Redirect standard input from a temporary file.
+    ::FILE* fp = ::tmpfile();
+    ASTERIA_TEST_CHECK(fp);
+    static constexpr char text[] = "hello\nworld\n\n\xE4\xBD\xA0\xE5\xA5\xBD\n\xC3" "A\nx\ny\nlast line";
+    ASTERIA_TEST_CHECK(::fwrite(text, 1, sizeof(text) - 1, fp) == sizeof(text) - 1);
+    ::rewind(fp);
+    ASTERIA_TEST_CHECK(::dup2(::fileno(fp), STDIN_FILENO) == STDIN_FILENO);
+
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        assert std.io.getln() == "hello";
+        assert std.io.getc() == 0x77;
+        assert std.io.getln() == "orld";
+        assert std.io.getln() == "";
+        assert std.io.getc() == 0x4F60;
+        assert std.io.getln() == "好";
+
+        // An incomplete sequence doesn't consume the next character.
+        assert catch( std.io.getc() ) != null;
+        assert std.io.getc() == 0x41;
+        assert std.io.getln() == "";
+
+        var lines = [ ];
+        assert std.io.lines(func(i, s) { assert i == countof lines;  lines[$] = s;  }) == 3;
+        assert lines == [ "x", "y", "last line" ];
+
+        assert std.io.getln() == null;
+        assert std.io.getc() == null;
+        assert std.io.lines(func(i, s) { assert false;  }) == 0;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+  }
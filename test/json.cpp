@@ -96,6 +96,25 @@ int main()
         assert std.json.parse("{c:1,d:2,}").c == 1;
         assert std.json.parse("{c:1,d:2,}").d == 2;
 
+        assert std.json.parse("  -0x1.8p1 ") == -3;
+        assert std.json.parse("0b1`0`1") == 5;
+        assert std.json.parse("+1e3") == 1000;
+        assert std.json.parse("-Infinity") == -infinity;
+        assert std.json.parse("'a\\x41\\U01F600\\'b'") == "aA\U01F600'b";
+        assert std.json.parse("\"0123456789abcdef0123456789\\n喵\"") == "0123456789abcdef0123456789\n喵";
+        assert std.json.parse("// comment\n [1, /* two\n */ 2 ,]  // end") == [1,2];
+        assert std.json.parse("\uFEFF[\n\n\t\n            \n                         1]") == [1];
+        assert catch( std.json.parse("1a") ) != null;
+        assert catch( std.json.parse("[1 2]") ) != null;
+        assert catch( std.json.parse("{a:1,a:2}") ) != null;
+        assert catch( std.json.parse("'abc") ) != null;
+        assert catch( std.json.parse("\"a\nb\"") ) != null;
+        assert catch( std.json.parse("\"\\q\"") ) != null;
+        assert catch( std.json.parse("/* 1") ) != null;
+        assert catch( std.json.parse("[undefined]") ) != null;
+        assert catch( std.json.parse("1e99999") ) != null;
+        assert std.string.find(catch( std.json.parse("[\n\n      1\n            2]") ), "[JSON text]:4:13") != null;
+
         var r = std.json.parse("[{a:1,b:[]},{c:{},d:4}]");
         assert r[0].a == 1;
         assert r[0].b == [];
@@ -103,6 +122,43 @@ int main()
         assert countof r[1].c == 0;
         assert r[1].d == 4;
 
+        // Parse a file that is larger than a chunk, so tokens straddle chunks.
+        var text = "[ // comment\n";
+        for(var i = 0; i < 3000; ++i)
+          text += std.string.format("  [ 'str$1\\u55B5喵', $1, /* $1 */ \"$2\" ],\n", i, "*" * (i % 23));
+        text += "]";
+
+        const path = __file + ".json.tmp";
+        std.filesystem.write(path, text);
+        var r = std.json.parse_file(path);
+        assert r == std.json.parse(text);
+        assert countof r == 3000;
+        assert r[2999] == [ "str2999喵喵", 2999, "*" * 9 ];
+
+        // Stream the same file, one element at a time.
+        std.filesystem.write(path, text);
+        var s = [];
+        assert std.json.stream_file(path, func(i, v) { assert i == countof s;  s[$] = v;  }) == 3000;
+        assert s == r;
+
+        // Stream JSON lines.
+        std.filesystem.write(path, "{a:1}\n[2]\n\n  'three'\n");
+        s = [];
+        assert std.json.stream_file(path, func(i, v) { s[$] = v;  }, true) == 3;
+        assert s[0].a == 1;
+        assert s[1] == [2];
+        assert s[2] == "three";
+
+        std.filesystem.write(path, "[1, 2, 3 4]");
+        s = [];
+        assert catch( std.json.stream_file(path, func(i, v) { s[$] = v;  }) ) != null;
+        assert s == [1,2,3];
+        std.filesystem.write(path, "[]");
+        assert std.json.stream_file(path, func(i, v) { assert false;  }) == 0;
+        std.filesystem.write(path, "{}");
+        assert catch( std.json.stream_file(path, func(i, v) { assert false;  }) ) != null;
+        std.filesystem.remove_file(path);
+
         const depth = 1000;
         var r = [];
         for(var i = 1; i < depth; ++i) {
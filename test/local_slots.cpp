@@ -0,0 +1,144 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // parameters and `this`
+        func sum3(a, b, c) {
+          return a + b + c;
+        }
+        assert sum3(1, 2, 3) == 6;
+        assert sum3(1, 2, 3.5) == 6.5;
+
+        var obj = {
+          value = 10;
+          add = func(x) { return this.value + x;  };
+        };
+        assert obj.add(5) == 15;
+
+        // lazy references
+        func vargs(x, ...) {
+          return [ __func, __varg(), x ];
+        }
+        assert vargs(1, 2, 3) == [ "vargs(x, ...)", 2, 1 ];
+
+        // shadowing
+        var s = 1;
+        {
+          assert s == 1;
+          var s = 2;
+          assert s == 2;
+          {
+            var t = s;
+            var s = 3;
+            assert t == 2;
+            assert s == 3;
+          }
+          assert s == 2;
+        }
+        assert s == 1;
+
+        // redeclaration in the same scope
+        var r = 1;
+        var r0 = r;
+        var r = r0 + 1;
+        assert r == 2;
+        assert r0 == 1;
+
+        // many locals, so the dictionary has to grow
+        {
+          var a0 = 0, a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, a6 = 6, a7 = 7;
+          var b0 = 10, b1 = 11, b2 = 12, b3 = 13, b4 = 14, b5 = 15, b6 = 16, b7 = 17;
+          var c0 = 20, c1 = 21, c2 = 22, c3 = 23, c4 = 24, c5 = 25, c6 = 26, c7 = 27;
+          assert a0 + a7 + b0 + b7 + c0 + c7 == 81;
+          var d0 = a1 + b1 + c1;
+          assert d0 == 33;
+          a3 = 100;
+          assert a3 + c3 == 123;
+        }
+
+        // references and structured bindings
+        var arr = [ 1, 2, 3 ];
+        ref e -> arr[1];
+        e = 42;
+        assert arr[1] == 42;
+        var [ x, y, z ] = arr;
+        assert x + y + z == 46;
+        var { p, q } = { p: 1, q: 2 };
+        assert p + q == 3;
+
+        // loops
+        var total = 0;
+        for(var i = 0;  i < 100;  ++i) {
+          var sq = i * i;
+          total += sq;
+        }
+        assert total == 328350;
+
+        total = 0;
+        for(each k, v -> [ 5, 6, 7 ]) {
+          var w = k * v;
+          total += w;
+        }
+        assert total == 20;
+
+        // exceptions
+        try
+          throw 42;
+        catch(ex) {
+          var copy = ex;
+          assert copy == 42;
+          assert typeof __backtrace == "array";
+        }
+
+        // closures
+        func counter() {
+          var n = 0;
+          return func() { return ++n;  };
+        }
+        var cnt = counter();
+        cnt();
+        cnt();
+        assert cnt() == 3;
+
+        // recursion
+        func fib(n) {
+          return n <= 1 ? n : fib(n - 1) + fib(n - 2);
+        }
+        assert fib(20) == 6765;
+
+        // deferred expressions
+        var log = [];
+        {
+          var d = "d";
+          defer log[$] = d;
+          d = "e";
+        }
+        assert log == [ "e" ];
+
+        // bypassed declarations
+        try {
+          switch(2) {
+            case 1:
+              var u = 1;
+            case 2:
+              u = 2;
+          }
+          assert false;
+        }
+        catch(ex)
+          assert std.string.find(ex, "bypassed") != null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+  }
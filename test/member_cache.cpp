@@ -0,0 +1,68 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func get_b(o) {
+          return o.b;
+        }
+
+        // same layout
+        var objs = [ { a: 1, b: 2 }, { a: 3, b: 4 }, { b: 5, a: 6 } ];
+        assert get_b(objs[0]) == 2;
+        assert get_b(objs[1]) == 4;
+        assert get_b(objs[2]) == 5;
+
+        // different layouts
+        var big = { };
+        for(var i = 0;  i < 100;  ++i)
+          big[std.string.format("k$1", i)] = i;
+        big.b = "big";
+        assert get_b(big) == "big";
+        assert get_b(objs[0]) == 2;
+        assert get_b({ b: 7, c: 8, d: 9, e: 10, f: 11, g: 12, h: 13 }) == 7;
+        assert get_b({ x: 1 }) == null;
+        assert get_b({ }) == null;
+        assert get_b(null) == null;
+        assert get_b(big) == "big";
+
+        // stale entries
+        var o = { a: 1, b: 2 };
+        assert get_b(o) == 2;
+        unset o.b;
+        assert get_b(o) == null;
+        o.c = 3;
+        assert get_b(o) == null;
+        o.b = 4;
+        assert get_b(o) == 4;
+
+        // writes through references
+        var p = { q: { r: 1 } };
+        for(var i = 0;  i < 5;  ++i)
+          p.q.r += i;
+        assert p.q.r == 11;
+        ref s -> p.q;
+        p.q = { r: 100, t: 2 };
+        assert s.r == 100;
+
+        // errors
+        try {
+          get_b(42);
+          assert false;
+        }
+        catch(e)
+          assert std.string.find(e, "not applicable") != null;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+  }
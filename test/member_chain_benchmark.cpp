@@ -0,0 +1,53 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    // Read the innermost member of nested objects, such as `o.k.k.k`. Each
+    // member shall take constant time, no matter how deep it is.
+    static constexpr int nloops = 20000;
+    double ns_per_member[3];
+    int depths[3] = { 4, 16, 64 };
+
+    for(int i = 0;  i != 3;  ++i) {
+      cow_string chain = sref("o");
+      for(int k = 0;  k != depths[i];  ++k)
+        chain += sref(".k");
+
+      char head[64];
+      ::snprintf(head, sizeof(head), "const depth = %d; const nloops = %d;", depths[i], nloops);
+      cow_string src(head);
+      src += sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        var o = 1;
+        for(var k = 0;  k < depth;  ++k)
+          o = { k: o, z: k };
+
+        var sum = 0;
+        for(var n = 0;  n < nloops;  ++n)
+          sum += )__");
+      src += chain;
+      src += sref(R"__(;
+
+        return sum;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__");
+
+      Simple_Script code;
+      code.reload_string(sref(__FILE__), __LINE__, src);
+      V_integer sum = 0;
+      double secs = asteria_test_measure(3,
+        [&] { sum = code.execute().dereference_readonly().as_integer();  });
+      ASTERIA_TEST_CHECK(sum == nloops);
+      ns_per_member[i] = secs * 1.0e9 / nloops / depths[i];
+    }
+
+    ::printf("member chain: ns per member: depth 4 = %.1f, depth 16 = %.1f, depth 64 = %.1f\n",
+             ns_per_member[0], ns_per_member[1], ns_per_member[2]);
+  }
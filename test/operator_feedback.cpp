@@ -0,0 +1,107 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        // Operands are elements of an array, so these operators are not
+        // lowered into register code.
+        var r = [ null, null ];
+        func add(x, y) { r[0] = x;  r[1] = y;  return r[0] + r[1];  }
+        func mul(x, y) { r[0] = x;  r[1] = y;  return r[0] * r[1];  }
+        func div(x, y) { r[0] = x;  r[1] = y;  return r[0] / r[1];  }
+        func mod(x, y) { r[0] = x;  r[1] = y;  return r[0] % r[1];  }
+        func xorb(x, y) { r[0] = x;  r[1] = y;  return r[0] ^ r[1];  }
+        func eq(x, y) { r[0] = x;  r[1] = y;  return r[0] == r[1];  }
+        func ne(x, y) { r[0] = x;  r[1] = y;  return r[0] != r[1];  }
+        func lt(x, y) { r[0] = x;  r[1] = y;  return r[0] < r[1];  }
+        func gte(x, y) { r[0] = x;  r[1] = y;  return r[0] >= r[1];  }
+
+        // integer operands
+        for(var i = 0;  i < 100;  ++i) {
+          assert add(i, 1) == i + 1;
+          assert mul(i, -3) == i * -3;
+          assert div(i, 7) == i / 7;
+          assert mod(-i, 7) == -i % 7;
+          assert xorb(i, 5) == (i ^ 5);
+          assert eq(i, 42) == (i == 42);
+          assert ne(i, 42) == (i != 42);
+          assert lt(i, 50) == (i < 50);
+          assert gte(i, 50) == (i >= 50);
+        }
+
+        // errors are still reported
+        assert catch( add(0x7FFFFFFFFFFFFFFF, 1) ) != null;
+        assert catch( mul(0x4000000000000000, 2) ) != null;
+        assert catch( div(1, 0) ) != null;
+        assert catch( mod(1, 0) ) != null;
+        assert catch( div(-0x7FFFFFFFFFFFFFFF - 1, -1) ) != null;
+        assert add(0x7FFFFFFFFFFFFFFE, 1) == 0x7FFFFFFFFFFFFFFF;
+
+        // operands of other types deoptimize operators
+        assert add(1.5, 2) == 3.5;
+        assert add(1, 2.5) == 3.5;
+        assert add("a", "b") == "ab";
+        assert mul(3, "ab") == "ababab";
+        assert xorb(true, true) == false;
+        assert eq(1, 1.0) == true;
+        assert eq(null, 0) == false;
+        assert lt(1, 1.5) == true;
+        assert catch( lt("a", 1) ) != null;
+
+        // real operands
+        for(var i = 0;  i < 100;  ++i) {
+          var x = i * 0.5;
+          assert add(x, 0.25) == x + 0.25;
+          assert mul(x, -2.0) == -i;
+          assert div(x, 4.0) == x / 4;
+          assert mod(x, 3.0) == x % 3.0;
+          assert eq(x, 10.0) == (i == 20);
+          assert ne(x, 10.0) == (i != 20);
+          assert lt(x, 10.0) == (i < 20);
+          assert gte(x, 10.0) == (i >= 20);
+        }
+
+        // unordered values
+        assert eq(nan, nan) == false;
+        assert ne(nan, nan) == true;
+        assert catch( lt(nan, 1.0) ) != null;
+        assert catch( gte(1.0, nan) ) != null;
+        assert div(1.0, 0.0) == infinity;
+        assert add(infinity, -infinity) != add(infinity, -infinity);
+        assert add(1, 2) == 3;
+
+        // operators that keep changing operand types
+        var s = "";
+        for(var i = 0;  i < 200;  ++i)
+          if(i % 20 == 19)
+            s = add(s, "x");
+          else
+            assert add(i, i) == i * 2;
+        assert s == "xxxxxxxxxx";
+        assert add(1.0, 2.0) == 3.0;
+
+        // compound assignment
+        var n = 0;
+        var f = 0.0;
+        for(var i = 0;  i < 1000;  ++i) {
+          n += i;
+          f += i;
+        }
+        assert n == 499500;
+        assert f == 499500.0;
+        n += 0.5;
+        assert n == 499500.5;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+  }
@@ -528,6 +528,27 @@ int main()
         assert __muls(iMin, -2) == iMax;
         assert __muls(-2, iMin) == iMax;
 
+        // errors are reported at the operator or operand that has failed
+        func bypass(k) {
+          switch(k) {
+          case 1:
+            var p = 1;
+          case 2:
+            return i * 2 + p;
+          }
+        }
+        var cols = [ ];
+        try { var x = (s - 1) * 2 + i;  }
+          catch(e) cols[$] = __backtrace[1].column;
+        try { var x = (i - 1) * 2 + s;  }
+          catch(e) cols[$] = __backtrace[1].column;
+        try { bypass(2);  }
+          catch(e) {
+            assert std.string.find(e, "Initialization of variable or reference `p` bypassed") != null;
+            cols[$] = __backtrace[1].column;
+          }
+        assert cols == [ 26, 35, 28 ];
+
 ///////////////////////////////////////////////////////////////////////////////
       )__"));
     code.execute();
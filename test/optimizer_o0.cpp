@@ -0,0 +1,169 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include "../asteria/compiler/token_stream.hpp"
+#include "../asteria/compiler/statement_sequence.hpp"
+#include "../asteria/runtime/air_optimizer.hpp"
+#include "../asteria/runtime/global_context.hpp"
+using namespace ::asteria;
+
+#ifndef ASTERIA_TEST_OPTIMIZER_O_
+#  define ASTERIA_TEST_OPTIMIZER_O_  0
+#endif
+
+static
+size_t
+count_nodes(const char* source)
+  {
+    Compiler_Options opts;
+    opts.optimization_level = ASTERIA_TEST_OPTIMIZER_O_;
+    Token_Stream tstrm(opts);
+    ::rocket::tinybuf_str cbuf(sref(source), tinybuf::open_read);
+    tstrm.reload(sref(__FILE__), __LINE__, ::std::move(cbuf));
+    Statement_Sequence sseq(opts);
+    sseq.reload(::std::move(tstrm));
+
+    Global_Context global;
+    AIR_Optimizer optmz(opts);
+    optmz.reload(nullptr, { }, global, sseq.get_statements());
+    return optmz.get_code().size();
+  }
+
+int main()
+  {
+    constexpr int level = ASTERIA_TEST_OPTIMIZER_O_;
+
+    // clear, 1, 2, `+`, 3, `*`, 4, `-`, `-`, return
+    // clear, 13, return
+    ASTERIA_TEST_CHECK(count_nodes("return (1 + 2) * 3 - -4;") == ((level >= 1) ? 3 : 9));
+
+    // clear, 1, 2, `<`, if
+    // clear, true, if
+    // clear, true, block
+    ASTERIA_TEST_CHECK(count_nodes("if(1 < 2) { return 1; } else { return 2; }") == ((level >= 1) ? 3 : 5));
+
+    // clear, true, `?:`, return
+    // clear, 1, return
+    ASTERIA_TEST_CHECK(count_nodes("return true ? 1 : 2;") == ((level >= 2) ? 3 : 4));
+
+    // clear, 1, 0, `/`, return
+    // clear, 1, `/ 0`, return
+    // clear, (register expression), return
+    ASTERIA_TEST_CHECK(count_nodes("return 1 / 0;") == ((level >= 3) ? 3 : (level >= 1) ? 4 : 5));
+
+    Simple_Script code;
+    code.mut_options().optimization_level = ASTERIA_TEST_OPTIMIZER_O_;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        assert (1 + 2) * 3 - -4 == 13;
+        assert 7 / 2 == 3;
+        assert 7.0 / 2 == 3.5;
+        assert 1 << 62 == 0x4000000000000000;
+        assert -(1 << 40) == -1099511627776;
+        assert ~5 == -6;
+        assert !0 == true;
+        assert __abs -3 == 3;
+        assert __sqrt 4.0 == 2;
+        assert countof null == 0;
+        assert typeof (1 + 2.5) == "real";
+        assert 3 <=> 4 == -1;
+        assert 10 % 3 == 1;
+        assert (1 == 1) == true;
+        assert 0x7FFFFFFF + 1 == 2147483648;
+        assert "a" + "b" == "ab";
+        assert "ab" * 3 == "ababab";
+
+        // Errors must be raised at run time.
+        assert catch(1 / 0) != null;
+        assert catch(0x7FFFFFFFFFFFFFFF + 1) != null;
+        assert catch(-(-0x7FFFFFFFFFFFFFFF - 1)) != null;
+        assert catch(__sqrt "4") != null;
+        assert catch(1 << -1) != null;
+        assert catch(1 << 1.5) != null;
+
+        var x = 5;
+        x += 1;
+        assert x == 6;
+        x = 7;
+        assert x * 2 == 14;
+        assert x - 0x100000000 == -4294967289;
+
+        // Constant conditions
+        var r = 0;
+        if(1 < 2)
+          r = 1;
+        else
+          r = 2;
+        assert r == 1;
+
+        if(!(1 < 2))
+          r = 3;
+        assert r == 1;
+
+        if(null) { }
+        else
+          r = 4;
+        assert r == 4;
+
+        assert (true ? 1 : 2) + 3 == 4;
+        assert (false ? 1 : 2) + 3 == 5;
+        assert (0 || 8) == 8;
+        assert (1 || 8) == 1;
+        assert (0 && 8) == 0;
+        assert (1 && 8) == 8;
+        assert (null ?? 9) == 9;
+        assert (1 ?? 9) == 1;
+        assert (false ?? 9) == false;
+        assert (true ? x : 2) == 7;
+        assert (false ? 2 : x) == 7;
+
+        r = 0;
+        r ?= 42 : 43;
+        assert r == 43;
+
+        // Unreachable code
+        func one() {
+          return 1;
+          r = 100;
+        }
+        assert one() == 1;
+        assert r == 43;
+
+        func two(c) {
+          if(c)
+            return 2;
+          else
+            return 3;
+          r = 200;
+        }
+        assert two(true) == 2;
+        assert two(false) == 3;
+        assert r == 43;
+
+        for(var i = 0;  i < 3;  ++i) {
+          if(i == 1)
+            continue;
+          r = i;
+          break;
+          r = 300;
+        }
+        assert r == 0;
+
+        switch(3) {
+          case 3:
+            r = 3;
+            break;
+            r = 400;
+          case 4:
+            r = 4;
+        }
+        assert r == 3;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+    code.execute();
+  }
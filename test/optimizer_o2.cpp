@@ -0,0 +1,5 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#define ASTERIA_TEST_OPTIMIZER_O_ 2
+#include "optimizer_o0.cpp"
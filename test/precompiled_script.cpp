@@ -0,0 +1,180 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include "../asteria/library/filesystem.hpp"
+#include "../asteria/library/checksum.hpp"
+#include <chrono>
+using namespace ::asteria;
+
+static constexpr char s_path[] = ".precompiled_script-test.ast";
+static constexpr char s_cache_path[] = ".precompiled_script-test.ast.air";
+
+static
+V_string
+do_execute(Simple_Script& code)
+  {
+    return code.execute().dereference_readonly().as_string();
+  }
+
+int main()
+  {
+    // Write a script that contains most kinds of nodes.
+    cow_string text = sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+      var out = [];
+      func make_counter(step) {
+        var n = 0;
+        return func() { n += step;  return n;  };
+      }
+      var c = make_counter(3);
+      c();
+      out[$] = c();
+
+      var [ a, b ] = [ 1.5, "str" ];
+      var { x, y } = { x: -7, y: [ null, true ] };
+      out[$] = a * 2 + x;
+      out[$] = b + std.string.format("$1", y);
+
+      for(each k, v -> { one: 1 })
+        out[$] = k + ":" + std.string.format("$1", v);
+
+      var sum = 0;
+      for(var i = 0;  i < 10;  ++i) {
+        if(i % 3 == 0)
+          continue;
+        sum += i * 0x10000;
+      }
+      out[$] = sum;
+
+      var w = 5;
+      do --w;
+        while(w > 2);
+      while(w < 4)
+        w++;
+      out[$] = w;
+
+      switch(w) {
+        case 3:
+          out[$] = "three";
+        case 4:
+          out[$] = "four";
+          break;
+        default:
+          out[$] = "other";
+      }
+
+      try
+        throw "oops";
+      catch(e)
+        out[$] = e;
+
+      func fail() { assert false : "message";  }
+      out[$] = catch( fail() ) != null;
+      out[$] = __varg() ?? "no args";
+      out[$] = (x > 0) ? "pos" : "neg";
+      out[$] = typeof make_counter;
+      out[$] = std.numeric.abs(-9) << 2;
+      return std.json.format({ ok: out });
+
+///////////////////////////////////////////////////////////////////////////////
+    )__");
+
+    std_filesystem_write(sref(s_path), nullopt, text);
+    ::remove(s_cache_path);
+
+    // This is the expected result.
+    Simple_Script ref;
+    ref.reload_file(s_path);
+    V_string expected = do_execute(ref);
+    ::fprintf(stderr, "result = %s\n", expected.c_str());
+
+    // There is no cache file, so the script is parsed.
+    Simple_Script code;
+    ASTERIA_TEST_CHECK(code.reload_file_cached(s_path, s_cache_path) == false);
+    ASTERIA_TEST_CHECK(do_execute(code) == expected);
+
+    // Write a cache file, then load it.
+    code.precompile_file(s_path, s_cache_path);
+    ASTERIA_TEST_CHECK(do_execute(code) == expected);
+    ASTERIA_TEST_CHECK(code.reload_file_cached(s_path, s_cache_path) == true);
+    ASTERIA_TEST_CHECK(do_execute(code) == expected);
+
+    // A cache file shall not be used with different options.
+    Simple_Script code_o0;
+    code_o0.mut_options().optimization_level = 0;
+    ASTERIA_TEST_CHECK(code_o0.reload_file_cached(s_path, s_cache_path) == false);
+    ASTERIA_TEST_CHECK(do_execute(code_o0) == expected);
+
+    Simple_Script code_o3;
+    code_o3.mut_options().optimization_level = 3;
+    code_o3.precompile_file(s_path, s_cache_path);
+    ASTERIA_TEST_CHECK(code_o3.reload_file_cached(s_path, s_cache_path) == true);
+    ASTERIA_TEST_CHECK(do_execute(code_o3) == expected);
+    ASTERIA_TEST_CHECK(code.reload_file_cached(s_path, s_cache_path) == false);
+
+    // A corrupted cache file shall be ignored.
+    code.precompile_file(s_path, s_cache_path);
+    V_string cache = std_filesystem_read(sref(s_cache_path), nullopt, nullopt);
+    std_filesystem_write(sref(s_cache_path), nullopt, cache.substr(0, cache.size() - 3));
+    ASTERIA_TEST_CHECK(code.reload_file_cached(s_path, s_cache_path) == false);
+    ASTERIA_TEST_CHECK(do_execute(code) == expected);
+
+    // A cache file whose payload does not match its checksum shall be ignored.
+    code_o3.precompile_file(s_path, s_cache_path);
+    cache = std_filesystem_read(sref(s_cache_path), nullopt, nullopt);
+    size_t offset = cache.find(cache.find('\n') + 1, '\n') + 1;
+    V_string bad = cache;
+    bad.mut(cache.size() - 1) ^= 0x20;
+    std_filesystem_write(sref(s_cache_path), nullopt, bad);
+    ASTERIA_TEST_CHECK(code_o3.reload_file_cached(s_path, s_cache_path) == false);
+    ASTERIA_TEST_CHECK(do_execute(code_o3) == expected);
+
+    // Precompiled code shall be validated even if its checksum matches.
+    uint32_t seed = 1;
+    for(int k = 0;  k != 3000;  ++k) {
+      seed = seed * 1103515245 + 12345;
+      size_t pos = offset + (seed >> 8) % (cache.size() - offset);
+      bad = cache;
+      bad.mut(pos) = static_cast<char>(seed >> 24);
+
+      V_string payload = bad.substr(offset);
+      uint32_t crc = static_cast<uint32_t>(std_checksum_crc32(payload));
+      ::snprintf(bad.mut_data() + offset - 9, 9, "%08X", crc);
+      bad.mut(offset - 1) = '\n';
+      std_filesystem_write(sref(s_cache_path), nullopt, bad);
+
+      // The code may happen to be still valid, but it shall not crash.
+      code_o3.reload_file_cached(s_path, s_cache_path);
+    }
+
+    // A cache file shall not be used after the script has been modified.
+    code.precompile_file(s_path, s_cache_path);
+    std_filesystem_append(sref(s_path), sref("\n// modified\n"), false);
+    ASTERIA_TEST_CHECK(code.reload_file_cached(s_path, s_cache_path) == false);
+    ASTERIA_TEST_CHECK(do_execute(code) == expected);
+
+    // Measure time for loading a large script.
+    cow_string large;
+    for(int k = 0;  k != 200;  ++k)
+      large += format_string("func f$1() { $2 }\n", k, text);
+    large += "return f199();";
+    std_filesystem_write(sref(s_path), nullopt, large);
+    code.precompile_file(s_path, s_cache_path);
+
+    auto t0 = ::std::chrono::steady_clock::now();
+    code.reload_file(s_path);
+    auto t1 = ::std::chrono::steady_clock::now();
+    ASTERIA_TEST_CHECK(code.reload_file_cached(s_path, s_cache_path) == true);
+    auto t2 = ::std::chrono::steady_clock::now();
+    ASTERIA_TEST_CHECK(do_execute(code) == expected);
+
+    ::fprintf(stderr, "precompiled script: %zu bytes: parse = %.2f ms, cached = %.2f ms\n",
+              large.size(), ::std::chrono::duration<double, ::std::milli>(t1 - t0).count(),
+              ::std::chrono::duration<double, ::std::milli>(t2 - t1).count());
+
+    ::remove(s_path);
+    ::remove(s_cache_path);
+  }
@@ -0,0 +1,55 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+#ifdef ROCKET_NONATOMIC_REFCOUNT
+    static constexpr char mode[] = "non-atomic";
+#else
+    static constexpr char mode[] = "atomic";
+#endif
+
+    // Reference counters behave the same in both modes.
+    ::rocket::reference_counter<int> nref;
+    ASTERIA_TEST_CHECK(nref.unique());
+    ASTERIA_TEST_CHECK(nref.increment() == 2);
+    ASTERIA_TEST_CHECK(nref.try_increment() == 3);
+    ASTERIA_TEST_CHECK(nref.decrement() == 2);
+    ASTERIA_TEST_CHECK(nref.decrement() == 1);
+    ASTERIA_TEST_CHECK(nref.get() == 1);
+
+    // Copy a string and an array, which increments and decrements their
+    // reference counts.
+    V_array arr(100, Value(sref("0123456789abcdef")));
+    Value sval = arr.at(7);
+    V_integer sum = 0;
+    double copy_secs = asteria_test_measure(1,
+      [&] {
+        for(int k = 0;  k != 1000000;  ++k) {
+          Value copy = sval;
+          V_array arr2 = arr;
+          sum += copy.as_string().ssize() + arr2.ssize();
+        }
+      });
+    ASTERIA_TEST_CHECK(sum == 116000000);
+    ASTERIA_TEST_CHECK(sval.as_string().unique() == false);
+
+    // Run 'profiling/fib_test.ast'.
+    cow_string path = sref(__FILE__);
+    path.erase(path.rfind('/') + 1);
+    path += "../profiling/fib_test.ast";
+
+    Simple_Script code;
+    code.reload_file(path);
+    cow_vector<Value> args;
+    args.emplace_back(sref("24"));
+    double fib_secs = asteria_test_measure(1, [&] { code.execute(::std::move(args));  });
+
+    // The script has made standard output wide-oriented.
+    ::fprintf(stderr, "refcount: %s: ns per copy = %.1f, fib(24) = %.1f ms\n",
+              mode, copy_secs * 1.0e9 / 2000000, fib_secs * 1000);
+  }
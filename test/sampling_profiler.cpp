@@ -0,0 +1,87 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/simple_script.hpp"
+#include "../asteria/runtime/sampling_profiler.hpp"
+using namespace ::asteria;
+
+int main()
+  {
+    Simple_Script code;
+    code.reload_string(
+      sref(__FILE__), __LINE__, sref(R"__(
+///////////////////////////////////////////////////////////////////////////////
+
+        func hot(n) {
+          var s = 0;
+          for(var i = 0;  i < n;  ++i)
+            s += i;
+          return s;
+        }
+
+        func fib(n) {
+          return (n <= 1) ? hot(n) + n : fib(n - 1) + fib(n - 2);
+        }
+
+        // This is not a tail call, so the caller is recorded.
+        var r = fib(16);
+        return r;
+
+///////////////////////////////////////////////////////////////////////////////
+      )__"));
+
+    // Samples are not taken before the profiler is started.
+    code.execute();
+    auto& prof = code.global().sampling_profiler();
+    ASTERIA_TEST_CHECK(prof.count_samples() == 0);
+    ASTERIA_TEST_CHECK(prof.top_frame_opt() == nullptr);
+
+    // Run the script until some samples have been taken.
+    code.start_profiling(500);
+    for(int k = 0;  (k != 1000) && (prof.count_samples() < 20);  ++k)
+      ASTERIA_TEST_CHECK(code.execute().dereference_readonly().as_integer() == 987);
+    code.stop_profiling();
+
+    ::rocket::tinyfmt_str fmt;
+    prof.print_folded(fmt);
+
+    // Each line denotes a call stack, outermost frame first, followed by its
+    // count. Counts shall add up to the number of samples.
+    ASTERIA_TEST_CHECK(prof.count_samples() >= 20);
+    const auto& folded = fmt.get_string();
+    size_t nlines = 0;
+    uint64_t total = 0;
+    size_t bpos = 0;
+    while(bpos != folded.size()) {
+      size_t epos = folded.find(bpos, '\n');
+      ASTERIA_TEST_CHECK(epos != cow_string::npos);
+      size_t spos = folded.rfind(epos, ' ');
+      ASTERIA_TEST_CHECK((spos != cow_string::npos) && (spos > bpos) && (spos + 1 < epos));
+
+      uint64_t count = 0;
+      for(size_t k = spos + 1;  k != epos;  ++k) {
+        ASTERIA_TEST_CHECK((folded[k] >= '0') && (folded[k] <= '9'));
+        count = count * 10 + (uint64_t) (folded[k] - '0');
+      }
+      ASTERIA_TEST_CHECK(count != 0);
+      total += count;
+      nlines ++;
+      bpos = epos + 1;
+    }
+    ASTERIA_TEST_CHECK(nlines == prof.count_stacks());
+    ASTERIA_TEST_CHECK(total == prof.count_samples());
+    ASTERIA_TEST_CHECK(folded.starts_with("[file scope] at "));
+    ASTERIA_TEST_CHECK(folded.find(sref(";fib(n) at ")) != cow_string::npos);
+    ASTERIA_TEST_CHECK(folded.find(sref(";hot(n) at ")) != cow_string::npos);
+    ASTERIA_TEST_CHECK(prof.top_frame_opt() == nullptr);
+
+    // Samples are not taken after the profiler is stopped.
+    uint64_t count = prof.count_samples();
+    code.execute();
+    ASTERIA_TEST_CHECK(prof.count_samples() == count);
+
+    prof.clear();
+    ASTERIA_TEST_CHECK(prof.count_samples() == 0);
+    ASTERIA_TEST_CHECK(prof.count_stacks() == 0);
+  }
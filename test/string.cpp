@@ -288,6 +288,9 @@ int main()
         assert std.string.utf8_validate("abcdАВГД甲乙丙丁") == true;
         assert std.string.utf8_validate("\xC0\x80\x61") == false;
         assert std.string.utf8_validate("\xFF\xFE\x62") == false;
+        assert std.string.utf8_validate("\xC3\x41") == false;
+        assert std.string.utf8_validate("0123456789abcdef甲乙丙丁0123456789abcdef" * 4) == true;
+        assert std.string.utf8_validate("0123456789abcdef甲乙丙丁0123456789abcdef" * 4 + "\xED\xA0\x80") == false;
 
         assert std.string.utf8_encode(30002) == "甲";
         assert catch( std.string.utf8_encode(0xFFFFFF) ) != null;
@@ -342,6 +345,16 @@ int main()
         assert std.string.pcre_replace("a11b2c333d4e555", '(\d{3})(\w)', '$2$1') == "a11b2cd3334e555";
         assert std.string.pcre_replace("a11b2c333d4e555", '\d{34}\w', '#') == "a11b2c333d4e555";
 
+        var st1 = std.string.pcre_cache_stats();
+        assert std.string.pcre_find("a11b2c333d4e555", '\d+\w') == [1,3];
+        assert std.string.pcre_find("A11B2", '[a-z]\d', ['caseless']) == [0,2];
+        assert std.string.pcre_find("A11B2", '[a-z]\d') == null;
+        var st2 = std.string.pcre_cache_stats();
+        assert st2.hits == st1.hits + 1;
+        assert st2.misses == st1.misses + 2;
+        assert st2.size == st1.size + 2;
+        assert st2.size <= st2.capacity;
+
         var M_dw = std.string.PCRE('\d+\w');
         assert M_dw.find("a11b2c333d4e555") == [1,3];
         assert M_dw.match("a11b2c333d4e555") == [ "11b" ];
@@ -362,6 +375,16 @@ int main()
         assert std.string.iconv("SHIFT-JIS", "CAT猫") == "\x43\x41\x54\x94\x4C";
         assert std.string.iconv("UTF-8", "\x43\x41\x54\xC3\xA8", "GB18030") == "CAT猫";
         assert std.string.iconv("UTF-8", "\x43\x41\x54\x94\x4C", "SHIFT-JIS") == "CAT猫";
+        assert std.string.iconv("UTF-16LE", "CAT猫😀") == "\x43\x00\x41\x00\x54\x00\x2B\x73\x3D\xD8\x00\xDE";
+        assert std.string.iconv("UTF-32LE", "CAT猫") == "\x43\x00\x00\x00\x41\x00\x00\x00\x54\x00\x00\x00\x2B\x73\x00\x00";
+        assert std.string.iconv("UTF-8", "\x43\x00\x41\x00\x54\x00\x2B\x73\x3D\xD8\x00\xDE", "UTF-16LE") == "CAT猫😀";
+        assert std.string.iconv("UTF-8", "\x43\x00\x00\x00\x41\x00\x00\x00\x54\x00\x00\x00\x2B\x73\x00\x00", "UTF-32LE") == "CAT猫";
+        assert catch( std.string.iconv("UTF-16LE", "CAT\xFF") ) != null;
+        assert catch( std.string.iconv("UTF-8", "\x43\x00\x00\xD8", "UTF-16LE") ) != null;
+        assert catch( std.string.iconv("UTF-8", "\x43\x00\x00", "UTF-32LE") ) != null;
+        var s = "0123456789abcdefАВГД甲乙丙丁😀" * 10;
+        assert std.string.iconv("UTF-8", std.string.iconv("UTF-16LE", s), "UTF-16LE") == s;
+        assert std.string.iconv("UTF-8", std.string.iconv("UTF-32LE", s), "UTF-32LE") == s;
 
 ///////////////////////////////////////////////////////////////////////////////
       )__"));
@@ -0,0 +1,135 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../rocket/cow_string.hpp"
+#include "../rocket/prehashed_string.hpp"
+#include <algorithm>
+#include <vector>
+using namespace ::asteria;
+
+using hash_function = uint32_t (const unsigned char*, size_t);
+
+static
+uint32_t
+do_hash(hash_function* func, const cow_string& str)
+  {
+    return func(reinterpret_cast<const unsigned char*>(str.data()), str.size());
+  }
+
+struct hash_stats
+  {
+    size_t ncollisions;  // pairs of distinct keys with equal hash values
+    size_t max_chain;    // longest chain in a table with 2^17 buckets
+    double ns_per_key;
+    double mib_per_sec;
+  };
+
+static
+hash_stats
+measure_hash(hash_function* func, const cow_vector<cow_string>& keys)
+  {
+    hash_stats stats = { };
+    ::std::vector<uint32_t> hvals;
+    for(const auto& key : keys)
+      hvals.push_back(do_hash(func, key));
+
+    ::std::sort(hvals.begin(), hvals.end());
+    for(size_t k = 1;  k < hvals.size();  ++k)
+      stats.ncollisions += hvals[k - 1] == hvals[k];
+
+    // Buckets are selected with the low-order bits, like `std::unordered_map`.
+    ::std::vector<size_t> chains(0x20000);
+    for(uint32_t hval : hvals)
+      stats.max_chain = ::std::max(stats.max_chain, ++ chains[hval & 0x1FFFF]);
+
+    size_t nbytes = 0;
+    for(const auto& key : keys)
+      nbytes += key.size();
+
+    volatile uint32_t sink = 0;
+    double secs = asteria_test_measure(20,
+        [&] {
+          for(const auto& key : keys)
+            sink = sink + do_hash(func, key);
+        });
+
+    stats.ns_per_key = secs * 1.0e9 / (double) keys.size();
+    stats.mib_per_sec = (double) nbytes / 1048576 / secs;
+    return stats;
+  }
+
+int main()
+  {
+    using namespace ::rocket::details_xstring;
+
+    // Check some values, which must not change within the same process.
+    ASTERIA_TEST_CHECK(ymemhash_fnv1a((const unsigned char*) "", 0) == 2166136261U);
+    ASTERIA_TEST_CHECK(ymemhash_fnv1a((const unsigned char*) "a", 1) == 0xE40C292CU);
+    ASTERIA_TEST_CHECK(ymemhash_wyhash((const unsigned char*) "", 0) == 0xE6B487D7U);
+    ASTERIA_TEST_CHECK(ymemhash_wyhash((const unsigned char*) "a", 1) == 0x21008002U);
+    ASTERIA_TEST_CHECK(ymemhash_wyhash((const unsigned char*) "abc", 3) == 0xC9F59DA5U);
+    ASTERIA_TEST_CHECK(ymemhash_wyhash((const unsigned char*) "message digest", 14) == 0x9EA9849FU);
+
+    cow_string str(100, 'x');
+    ASTERIA_TEST_CHECK(ymemhash_wyhash((const unsigned char*) str.data(), 100) == 0xDE2042A7U);
+    ASTERIA_TEST_CHECK(cow_string::hash()(str) == ::rocket::xmemhash(str.data(), str.size()));
+    ASTERIA_TEST_CHECK(phsh_string(str).rdhash() == cow_string::hash()(str));
+
+    // Every byte of a key of any length shall affect its hash value.
+    for(size_t len = 1;  len != 100;  ++len)
+      for(size_t k = 0;  k != len;  ++k) {
+        cow_string s1(len, 'a');
+        cow_string s2 = s1;
+        s2.mut(k) = 'b';
+        ASTERIA_TEST_CHECK(do_hash(ymemhash_wyhash, s1) != do_hash(ymemhash_wyhash, s2));
+      }
+
+    // Make some key distributions: identifiers in scripts, JSON object keys
+    // with numeric suffixes, decimal numbers, and long paths.
+    static constexpr char idents[][16] =
+      {
+        "i", "j", "k", "x", "y", "n", "str", "obj", "value", "count", "index",
+        "result", "callback", "__this", "__func", "m_data", "m_size", "length",
+      };
+
+    cow_vector<cow_string> ident_keys, json_keys, number_keys, path_keys;
+    for(size_t k = 0;  k != 100000;  ++k) {
+      ident_keys.emplace_back(format_string("$1$2", idents[k % 18], k / 18));
+      json_keys.emplace_back(format_string("$1_field_$2", (k % 3 == 0) ? "user" : "item", k));
+      number_keys.emplace_back(format_string("$1", k));
+      path_keys.emplace_back(format_string("/srv/data/archive/$1/$2/record-$3.json",
+                                           k % 7, k % 113, k));
+    }
+
+    const struct
+      {
+        const char* name;
+        const cow_vector<cow_string>* keys;
+      }
+    dists[] =
+      {
+        { "identifiers", &ident_keys },
+        { "JSON keys", &json_keys },
+        { "numbers", &number_keys },
+        { "paths", &path_keys },
+      };
+
+    for(const auto& dist : dists) {
+      hash_stats fnv1a = measure_hash(ymemhash_fnv1a, *(dist.keys));
+      hash_stats wyhash = measure_hash(ymemhash_wyhash, *(dist.keys));
+
+      // With 100000 random 32-bit values, about 1.2 collisions are expected,
+      // and chains in a table with 2^17 buckets are shorter than 10.
+      ASTERIA_TEST_CHECK(wyhash.ncollisions <= 10);
+      ASTERIA_TEST_CHECK(wyhash.max_chain <= 10);
+
+      ::printf("string hash: %-12s: collisions: fnv1a = %zu, wyhash = %zu; "
+               "max chain: fnv1a = %zu, wyhash = %zu; "
+               "ns per key: fnv1a = %.1f, wyhash = %.1f; "
+               "MiB/s: fnv1a = %.1f, wyhash = %.1f\n",
+               dist.name, fnv1a.ncollisions, wyhash.ncollisions,
+               fnv1a.max_chain, wyhash.max_chain, fnv1a.ns_per_key, wyhash.ns_per_key,
+               fnv1a.mib_per_sec, wyhash.mib_per_sec);
+    }
+  }
@@ -0,0 +1,162 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../asteria/utils.hpp"
+using namespace ::asteria;
+
+// These are the per-code-point loops that the bulk functions replace.
+static
+bool
+validate_by_code_point(const char*& pos, size_t avail)
+  {
+    const char* eptr = pos + avail;
+    while(pos != eptr) {
+      char32_t cp;
+      const char* tptr = pos;
+      if(!utf8_decode(cp, tptr, (size_t) (eptr - pos)))
+        return false;
+      pos = tptr;
+    }
+    return true;
+  }
+
+static
+void
+decode_by_code_point(cow_u32string& text, const cow_string& data)
+  {
+    size_t offset = 0;
+    while(offset != data.size()) {
+      char32_t cp;
+      if(!utf8_decode(cp, data, offset))
+        return;
+      text.push_back(cp);
+    }
+  }
+
+static
+void
+encode_by_code_point(cow_string& text, const cow_u32string& data)
+  {
+    for(char32_t cp : data)
+      utf8_encode(text, cp);
+  }
+
+static
+cow_string
+make_text(const char* pattern, size_t size)
+  {
+    cow_string text;
+    while(text.size() < size)
+      text += sref(pattern);
+    return text;
+  }
+
+int main()
+  {
+    // Results must match the per-code-point loop for any length, alignment
+    // and position of invalid sequences.
+    static constexpr char samples[][8] =
+      {
+        "a", "\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF",
+        "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+        "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC3\x41", "\xE0\x80\x80",
+        "\xED\xA0\x80", "\xF0\x80\x80\x80", "\xF4\x90\x80\x80", "\xF5\x80",
+        "\xFF", "\xE4\xB8", "\xF0\x9F\x98",
+      };
+
+    uint32_t seed = 1;
+    size_t nmismatches = 0;
+    for(int k = 0;  k != 20000;  ++k) {
+      cow_string str;
+      size_t len = (size_t) k % 200;
+      while(str.size() < len) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t pick = seed >> 16;
+        if(pick % 4 == 0)
+          str += sref(samples[pick / 4 % size(samples)]);
+        else if(pick % 4 == 1)
+          str += sref("甲乙丙丁");
+        else
+          str += sref("0123456789abcdef");
+      }
+
+      const char* ref = str.data();
+      bool ref_valid = validate_by_code_point(ref, str.size());
+      const char* pos = str.data();
+      bool valid = utf8_validate(pos, str.size());
+      if((valid != ref_valid) || (pos != ref))
+        nmismatches ++;
+
+      // If the string is valid, it shall survive round trips.
+      if(!valid)
+        continue;
+
+      cow_u16string u16;
+      pos = str.data();
+      utf8_to_utf16(u16, pos, str.size());
+      const char16_t* pos16 = u16.data();
+      cow_string u8;
+      if(!utf16_to_utf8(u8, pos16, u16.size()) || (u8 != str))
+        nmismatches ++;
+
+      cow_u32string u32;
+      pos = str.data();
+      utf8_to_utf32(u32, pos, str.size());
+      const char32_t* pos32 = u32.data();
+      u8.clear();
+      if(!utf32_to_utf8(u8, pos32, u32.size()) || (u8 != str))
+        nmismatches ++;
+    }
+    ASTERIA_TEST_CHECK(nmismatches == 0);
+
+    // Measure ASCII-heavy and CJK-heavy texts of 16 MiB each.
+    for(const char* pattern : { "The quick brown fox jumps over the lazy dog. 甲\n",
+                                "天地玄黄，宇宙洪荒。日月盈昃，辰宿列张。\n" }) {
+      cow_string data = make_text(pattern, 16777216);
+      cow_u32string u32;
+      cow_string u8;
+      size_t nfailures = 0;
+
+      double old_valid = asteria_test_mib_per_sec(data.size(), 4,
+          [&] {
+            const char* pos = data.data();
+            nfailures += !validate_by_code_point(pos, data.size());
+          });
+      double new_valid = asteria_test_mib_per_sec(data.size(), 4,
+          [&] {
+            const char* pos = data.data();
+            nfailures += !utf8_validate(pos, data.size());
+          });
+
+      double old_decode = asteria_test_mib_per_sec(data.size(), 2,
+          [&] {
+            u32.clear();
+            decode_by_code_point(u32, data);
+          });
+      double new_decode = asteria_test_mib_per_sec(data.size(), 2,
+          [&] {
+            u32.clear();
+            const char* pos = data.data();
+            nfailures += !utf8_to_utf32(u32, pos, data.size());
+          });
+
+      double old_encode = asteria_test_mib_per_sec(data.size(), 2,
+          [&] {
+            u8.clear();
+            encode_by_code_point(u8, u32);
+          });
+      double new_encode = asteria_test_mib_per_sec(data.size(), 2,
+          [&] {
+            u8.clear();
+            const char32_t* pos = u32.data();
+            nfailures += !utf32_to_utf8(u8, pos, u32.size());
+          });
+      ASTERIA_TEST_CHECK(nfailures == 0);
+      ASTERIA_TEST_CHECK(u8 == data);
+
+      ::printf("utf8 (%s): MiB/s: validate = %.1f -> %.1f, decode = %.1f -> %.1f, encode = %.1f -> %.1f\n",
+               (pattern[0] == 'T') ? "ASCII-heavy" : "CJK-heavy",
+               old_valid, new_valid, old_decode, new_decode, old_encode, new_encode);
+    }
+  }
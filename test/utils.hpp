@@ -7,6 +7,7 @@
 #include "../asteria/fwd.hpp"
 #include "../asteria/utils.hpp"
 #include <unistd.h>   // ::alarm()
+#include <chrono>
 
 #define ASTERIA_TEST_CHECK(expr)  \
     do  \
@@ -52,6 +53,30 @@
       }  \
     while(false)
 
+// Calls `func` for `nrounds` times, and returns the average time of each call
+// in seconds. This is used by benchmarks.
+template<typename FuncT>
+static
+double
+asteria_test_measure(int nrounds, FuncT&& func)
+  {
+    auto t0 = ::std::chrono::steady_clock::now();
+    for(int r = 0;  r != nrounds;  ++r)
+      func();
+    auto t1 = ::std::chrono::steady_clock::now();
+    return ::std::chrono::duration<double>(t1 - t0).count() / nrounds;
+  }
+
+// Calls `func`, which processes `nbytes` bytes each time, for `nrounds` times,
+// and returns the throughput in MiB/s.
+template<typename FuncT>
+static
+double
+asteria_test_mib_per_sec(size_t nbytes, int nrounds, FuncT&& func)
+  {
+    return (double) nbytes / 1048576 / asteria_test_measure(nrounds, func);
+  }
+
 // Set terminate handler.
 static const auto asteria_test_terminate = ::std::set_terminate(
     [] {
@@ -0,0 +1,148 @@
+// This file is part of Asteria.
+// Copyleft 2018 - 2023, LH_Mouse. All wrongs reserved.
+
+#include "utils.hpp"
+#include "../rocket/xmemory.hpp"
+#include <thread>
+#include <algorithm>
+#include <pthread.h>
+using namespace ::rocket;
+
+static
+void
+alloc_and_free(size_t size, size_t count)
+  {
+    ::std::vector<xmeminfo> blocks(count);
+    for(auto& info : blocks) {
+      info.element_size = 1;
+      info.count = size;
+      xmemalloc(info);
+      ::std::memset(info.data, 0x5A, info.count);
+    }
+
+    for(auto& info : blocks)
+      xmemfree(info);
+  }
+
+int main()
+  {
+    xmemclean();
+
+    xmemstats s1;
+    xmemstat(s1, 7);
+    ASTERIA_TEST_CHECK(s1.block_size == 128);
+    ASTERIA_TEST_CHECK(s1.bytes_cached == 0);
+
+    // The first round misses, and the second round is served from the cache
+    // of this thread.
+    alloc_and_free(100, 8);
+    xmemstats s2;
+    xmemstat(s2, 7);
+    ASTERIA_TEST_CHECK(s2.misses >= s1.misses + 1);
+    ASTERIA_TEST_CHECK(s2.bytes_cached == 8 * 128);
+
+    alloc_and_free(128, 8);
+    xmemstats s3;
+    xmemstat(s3, 7);
+    ASTERIA_TEST_CHECK(s3.hits == s2.hits + 8);
+    ASTERIA_TEST_CHECK(s3.misses == s2.misses);
+    ASTERIA_TEST_CHECK(s3.bytes_cached == 8 * 128);
+
+    // Magazines are bounded.
+    alloc_and_free(64, 1000);
+    xmemstats s4;
+    xmemstat(s4, 6);
+    ASTERIA_TEST_CHECK(s4.bytes_cached <= 32 * 64);
+
+    // Blocks are passed between threads via the global pools.
+    ::std::vector<::std::thread> threads;
+    for(int k = 0;  k != 4;  ++k)
+      threads.emplace_back([] {
+        for(int r = 0;  r != 100;  ++r)
+          for(size_t size = 16;  size <= 4096;  size *= 2)
+            alloc_and_free(size, 50);
+      });
+
+    for(auto& t : threads)
+      t.join();
+
+    xmemclean();
+    xmemstats s5;
+    xmemstat(s5, 7);
+    ASTERIA_TEST_CHECK(s5.bytes_cached == 0);
+
+    // A thread that only allocates memory shall return its magazine upon exit.
+    // The first thread puts 10 blocks into the global pool; the second thread
+    // takes all of them and keeps 9 in its magazine.
+    ::std::thread([] { alloc_and_free(512, 10);  }).join();
+
+    xmeminfo kept = { 1, nullptr, 512 };
+    ::std::thread([&] { xmemalloc(kept);  }).join();
+
+    xmeminfo info = { 1, nullptr, 512 };
+    xmemalloc(info);
+    xmemstats s6;
+    xmemstat(s6, 9);
+    ASTERIA_TEST_CHECK(s6.bytes_cached == 8 * 512);
+    xmemfree(info);
+    xmemfree(kept);
+    xmemclean();
+
+    // Draining a large pool shall take linear time. Each refill of the magazine
+    // takes a bounded batch, and puts the rest back without walking it.
+    ::std::vector<xmeminfo> many(200000);
+    for(auto& mi : many) {
+      mi = { 1, nullptr, 200 };
+      xmemalloc(mi);
+    }
+    ::std::vector<void*> freed;
+    for(auto& mi : many) {
+      freed.emplace_back(mi.data);
+      xmemfree(mi);
+    }
+
+    double secs = asteria_test_measure(1,
+        [&] {
+          for(auto& mi : many) {
+            mi = { 1, nullptr, 200 };
+            xmemalloc(mi);
+          }
+        });
+    ASTERIA_TEST_CHECK(secs < 1.0);
+
+    ::std::sort(freed.begin(), freed.end());
+    size_t nreused = 0;
+    for(auto& mi : many) {
+      nreused += ::std::binary_search(freed.begin(), freed.end(), mi.data);
+      xmemfree(mi);
+    }
+    ASTERIA_TEST_CHECK(nreused == many.size());
+    xmemclean();
+
+    // Blocks that are freed after the thread cache has been flushed shall go
+    // to the global pool. The destructor of this key runs after the one that
+    // flushes the thread cache, as keys are destroyed in the order they were
+    // created.
+    ::pthread_key_t key;
+    ::pthread_key_create(&key,
+        [](void* ptr) {
+          xmeminfo late = { 1, ptr, 1024 };
+          xmemfree(late);
+        });
+
+    void* late_ptr = nullptr;
+    ::std::thread(
+        [&] {
+          xmeminfo late = { 1, nullptr, 1024 };
+          xmemalloc(late);
+          late_ptr = late.data;
+          ::pthread_setspecific(key, late_ptr);
+        })
+      .join();
+
+    info = { 1, nullptr, 1024 };
+    xmemalloc(info);
+    ASTERIA_TEST_CHECK(info.data == late_ptr);
+    xmemfree(info);
+    ::pthread_key_delete(key);
+  }